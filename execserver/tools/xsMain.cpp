@@ -23,6 +23,7 @@
 
 #include "xsExecutionServer.hpp"
 #include "deCommandLine.hpp"
+#include "deStringUtil.hpp"
 #include "deString.h"
 
 #if (DE_OS == DE_OS_WIN32)
@@ -32,33 +33,56 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 namespace opt
 {
 
-DE_DECLARE_COMMAND_LINE_OPT(Port,		int);
-DE_DECLARE_COMMAND_LINE_OPT(SingleExec,	bool);
+DE_DECLARE_COMMAND_LINE_OPT(Port,			int);
+DE_DECLARE_COMMAND_LINE_OPT(SingleExec,		bool);
+DE_DECLARE_COMMAND_LINE_OPT(MaxProcesses,	int);
 
 void registerOptions (de::cmdline::Parser& parser)
 {
 	using de::cmdline::Option;
 	using de::cmdline::NamedValue;
 
-	parser << Option<Port>		("p", "port",	"Port", "50016")
-		   << Option<SingleExec>("s", "single",	"Kill execserver after first session");
+	parser << Option<Port>			("p", "port",			"Port", "50016")
+		   << Option<SingleExec>	("s", "single",			"Kill execserver after first session")
+		   << Option<MaxProcesses>	("m", "max-processes",	"Number of process slots for concurrent test execution", "1");
 }
 
 }
 
-int main (int argc, const char* const* argv)
-{
-	de::cmdline::CommandLine	cmdLine;
-
 #if (DE_OS == DE_OS_WIN32)
-	xs::Win32TestProcess		testProcess;
+typedef xs::Win32TestProcess	PlatformTestProcess;
 #else
-	xs::PosixTestProcess		testProcess;
+typedef xs::PosixTestProcess	PlatformTestProcess;
+#endif
+
+static void createTestProcesses (std::vector<xs::TestProcess*>& dst, int numProcesses)
+{
+	// \note Each process slot writes its own log file so that slots can share working directory.
+	for (int ndx = 0; ndx < numProcesses; ndx++)
+	{
+		const std::string logBaseName = ndx == 0 ? std::string("TestResults.qpa") : "TestResults-" + de::toString(ndx) + ".qpa";
+		dst.push_back(new PlatformTestProcess(logBaseName.c_str()));
+	}
+}
+
+static void destroyTestProcesses (std::vector<xs::TestProcess*>& processes)
+{
+	for (std::vector<xs::TestProcess*>::iterator i = processes.begin(); i != processes.end(); ++i)
+		delete *i;
+	processes.clear();
+}
 
+int main (int argc, const char* const* argv)
+{
+	de::cmdline::CommandLine		cmdLine;
+	std::vector<xs::TestProcess*>	testProcesses;
+
+#if (DE_OS != DE_OS_WIN32)
 	// Set line buffered mode to stdout so executor gets any log messages in a timely manner.
 	setvbuf(stdout, DE_NULL, _IOLBF, 4*1024);
 #endif
@@ -75,22 +99,36 @@ int main (int argc, const char* const* argv)
 		}
 	}
 
+	if (cmdLine.getOption<opt::MaxProcesses>() < 1)
+	{
+		std::cerr << "--max-processes must be at least 1\n";
+		return -1;
+	}
+
 	try
 	{
 		const xs::ExecutionServer::RunMode	runMode		= cmdLine.getOption<opt::SingleExec>()
 														? xs::ExecutionServer::RUNMODE_SINGLE_EXEC
 														: xs::ExecutionServer::RUNMODE_FOREVER;
 		const int							port		= cmdLine.getOption<opt::Port>();
-		xs::ExecutionServer					server		(&testProcess, DE_SOCKETFAMILY_INET4, port, runMode);
 
-		std::cout << "Listening on port " << port << ".\n";
-		server.runServer();
+		createTestProcesses(testProcesses, cmdLine.getOption<opt::MaxProcesses>());
+
+		{
+			xs::ExecutionServer				server		(testProcesses, DE_SOCKETFAMILY_INET4, port, runMode);
+
+			std::cout << "Listening on port " << port << ".\n";
+			server.runServer();
+		}
 	}
 	catch (const std::exception& e)
 	{
 		std::cerr << e.what() << "\n";
+		destroyTestProcesses(testProcesses);
 		return -1;
 	}
 
+	destroyTestProcesses(testProcesses);
+
 	return 0;
 }
@@ -105,7 +105,8 @@ void readBytes (de::Socket& socket, vector<deUint8>& dst, size_t numBytes)
 	}
 }
 
-Message* readMessage (de::Socket& socket)
+//! Read message, unwrapping SHARD_MESSAGE. shardNdx is set to process slot, or -1 if message was not wrapped.
+Message* readMessage (de::Socket& socket, int& shardNdx)
 {
 	// Header.
 	vector<deUint8> header;
@@ -115,6 +116,8 @@ Message* readMessage (de::Socket& socket)
 	size_t		messageSize;
 	Message::parseHeader(&header[0], (int)header.size(), type, messageSize);
 
+	shardNdx = -1;
+
 	// Simple messages without any data.
 	switch (type)
 	{
@@ -127,9 +130,23 @@ Message* readMessage (de::Socket& socket)
 	vector<deUint8> messageBuf;
 	readBytes(socket, messageBuf, messageSize-MESSAGE_HEADER_SIZE);
 
+	if (type == MESSAGETYPE_SHARD_MESSAGE)
+	{
+		const ShardMessage	shardMsg	(&messageBuf[0], messageBuf.size());
+		vector<deUint8>		wrappedBuf	(shardMsg.messageData, shardMsg.messageData + shardMsg.messageDataSize);
+
+		shardNdx	= shardMsg.shardNdx;
+		type		= shardMsg.messageType;
+		messageBuf.swap(wrappedBuf);
+
+		if (type == MESSAGETYPE_PROCESS_STARTED)
+			return new ProcessStartedMessage(messageBuf.empty() ? DE_NULL : &messageBuf[0], messageBuf.size());
+	}
+
 	switch (type)
 	{
 		case MESSAGETYPE_HELLO:					return new HelloMessage(&messageBuf[0], (int)messageBuf.size());
+		case MESSAGETYPE_HELLO_REPLY:			return new HelloReplyMessage(&messageBuf[0], (int)messageBuf.size());
 		case MESSAGETYPE_TEST:					return new TestMessage(&messageBuf[0], (int)messageBuf.size());
 		case MESSAGETYPE_PROCESS_LOG_DATA:		return new ProcessLogDataMessage(&messageBuf[0], (int)messageBuf.size());
 		case MESSAGETYPE_INFO:					return new InfoMessage(&messageBuf[0], (int)messageBuf.size());
@@ -140,6 +157,48 @@ Message* readMessage (de::Socket& socket)
 	}
 }
 
+Message* readMessage (de::Socket& socket)
+{
+	int			shardNdx	= -1;
+	Message*	msg			= readMessage(socket, shardNdx);
+
+	if (shardNdx >= 0)
+	{
+		delete msg;
+		XS_FAIL("Unexpected SHARD_MESSAGE");
+	}
+
+	return msg;
+}
+
+//! Send HELLO and return number of process slots from server's reply.
+int sayHello (de::Socket& socket)
+{
+	sendMessage(socket, HelloMessage());
+
+	for (;;)
+	{
+		ScopedMsgPtr msg(readMessage(socket));
+
+		if (msg->type == MESSAGETYPE_HELLO_REPLY)
+			return static_cast<const HelloReplyMessage*>(msg.get())->maxProcesses;
+		else if (msg->type != MESSAGETYPE_KEEPALIVE)
+			XS_FAIL("Expected HELLO_REPLY");
+	}
+}
+
+void sendExecuteShard (de::Socket& socket, int shardNdx, const string& name, const string& params, const string& caseList)
+{
+	ExecuteShardMessage execMsg;
+	execMsg.shardNdx	= shardNdx;
+	execMsg.name		= name;
+	execMsg.params		= params;
+	execMsg.caseList	= caseList;
+	execMsg.workDir		= "";
+
+	sendMessage(socket, execMsg);
+}
+
 class TestClock
 {
 public:
@@ -276,7 +335,7 @@ bool TestExecutor::runCase (TestCase* testCase)
 	{
 		if (m_testCtx.startServer)
 		{
-			string cmdLine = m_testCtx.serverPath + " --port=" + de::toString(m_testCtx.address.getPort());
+			string cmdLine = m_testCtx.serverPath + " --port=" + de::toString(m_testCtx.address.getPort()) + " --max-processes=2";
 			serverProc = deProcess_create();
 			XS_CHECK(serverProc);
 
@@ -359,8 +418,8 @@ public:
 
 	void runClient (de::Socket& socket)
 	{
-		xs::HelloMessage msg;
-		sendMessage(socket, (const xs::Message&)msg);
+		if (sayHello(socket) < 1)
+			XS_FAIL("Server reported no process slots");
 	}
 
 	void runProgram (void) { /* nothing */ }
@@ -813,6 +872,191 @@ public:
 	void runProgram (void) { /* nothing */ }
 };
 
+class ShardTest : public TestCase
+{
+public:
+	enum
+	{
+		NUM_SHARDS = 2
+	};
+
+	ShardTest (TestContext& testCtx)
+		: TestCase(testCtx, "shards")
+	{
+	}
+
+	void runClient (de::Socket& socket)
+	{
+		const int maxProcesses = sayHello(socket);
+
+		if (maxProcesses < NUM_SHARDS)
+			XS_FAIL("Server must be started with --max-processes=2 or more");
+
+		// Each slot echoes its case list to log, so misrouted data is detected.
+		for (int shardNdx = 0; shardNdx < NUM_SHARDS; shardNdx++)
+			sendExecuteShard(socket, shardNdx, m_testCtx.testerPath, "--program=shards", getShardData(shardNdx));
+
+		// Slot past --max-processes must be rejected without affecting others.
+		sendExecuteShard(socket, maxProcesses, m_testCtx.testerPath, "--program=shards", getShardData(maxProcesses));
+
+		const int		timeout						= 10000; // 10s.
+		TestClock		clock;
+
+		bool			gotProcessStarted[NUM_SHARDS]	= { false, false };
+		bool			gotProcessFinished[NUM_SHARDS]	= { false, false };
+		std::string		receivedData[NUM_SHARDS];
+		bool			gotRejected						= false;
+		int				numStartedBeforeFinish			= 0;
+		int				numFinished						= 0;
+
+		while (numFinished < NUM_SHARDS || !gotRejected)
+		{
+			if (clock.getMilliseconds() > timeout)
+				XS_FAIL("Timeout");
+
+			int				shardNdx	= -1;
+			ScopedMsgPtr	msg			(readMessage(socket, shardNdx));
+
+			if (msg->type == MESSAGETYPE_KEEPALIVE || (shardNdx >= 0 && msg->type == MESSAGETYPE_INFO))
+				continue;
+			else if (shardNdx == maxProcesses && msg->type == MESSAGETYPE_PROCESS_LAUNCH_FAILED)
+			{
+				XS_CHECK_MSG(!gotRejected, "Got PROCESS_LAUNCH_FAILED twice");
+				gotRejected = true;
+				continue;
+			}
+			else if (shardNdx < 0 || shardNdx >= NUM_SHARDS)
+				XS_FAIL((string("Invalid message: ") + de::toString(msg->type) + " for slot " + de::toString(shardNdx)).c_str());
+
+			if (msg->type == MESSAGETYPE_PROCESS_STARTED)
+			{
+				XS_CHECK_MSG(!gotProcessStarted[shardNdx], "Got PROCESS_STARTED twice");
+				gotProcessStarted[shardNdx] = true;
+
+				if (numFinished == 0)
+					numStartedBeforeFinish += 1;
+			}
+			else if (msg->type == MESSAGETYPE_PROCESS_LAUNCH_FAILED)
+				XS_FAIL("Got PROCESS_LAUNCH_FAILED");
+			else if (gotProcessStarted[shardNdx] && msg->type == MESSAGETYPE_PROCESS_LOG_DATA)
+				receivedData[shardNdx] += static_cast<const ProcessLogDataMessage*>(msg.get())->logData;
+			else if (gotProcessStarted[shardNdx] && !gotProcessFinished[shardNdx] && msg->type == MESSAGETYPE_PROCESS_FINISHED)
+			{
+				gotProcessFinished[shardNdx] = true;
+				numFinished += 1;
+			}
+			else
+				XS_FAIL((string("Invalid message: ") + de::toString(msg->type) + " for slot " + de::toString(shardNdx)).c_str());
+		}
+
+		if (numStartedBeforeFinish != NUM_SHARDS)
+			XS_FAIL("Shards were not executed concurrently");
+
+		for (int shardNdx = 0; shardNdx < NUM_SHARDS; shardNdx++)
+		{
+			if (receivedData[shardNdx] != getShardData(shardNdx))
+			{
+				printf("  slot %d received: '%s'\n  expected: '%s'\n", shardNdx, receivedData[shardNdx].c_str(), getShardData(shardNdx).c_str());
+				XS_FAIL("Log data doesn't match");
+			}
+		}
+	}
+
+	void runProgram (void)
+	{
+		deFile* file = deFile_create(m_testCtx.logFileName.c_str(), DE_FILEMODE_OPEN|DE_FILEMODE_CREATE|DE_FILEMODE_TRUNCATE|DE_FILEMODE_WRITE);
+		XS_CHECK(file);
+
+		const size_t	half		= m_testCtx.caseList.length() / 2;
+		deInt64			numWritten	= 0;
+
+		// Write in two parts so that both slots are producing log data at the same time.
+		XS_CHECK(deFile_write(file, m_testCtx.caseList.c_str(), (deInt64)half, &numWritten) == DE_FILERESULT_SUCCESS);
+		deSleep(500);
+		XS_CHECK(deFile_write(file, m_testCtx.caseList.c_str() + half, (deInt64)(m_testCtx.caseList.length() - half), &numWritten) == DE_FILERESULT_SUCCESS);
+
+		deFile_destroy(file);
+	}
+
+private:
+	static string getShardData (int shardNdx)
+	{
+		return "Slot " + de::toString(shardNdx) + " log data\n";
+	}
+};
+
+class ShardStopTest : public TestCase
+{
+public:
+	enum
+	{
+		NUM_SHARDS	= 2,
+		RUN_TIME	= 20000	//!< Program run time in ms, much longer than client waits for stop.
+	};
+
+	ShardStopTest (TestContext& testCtx)
+		: TestCase(testCtx, "shard-stop")
+	{
+	}
+
+	void runClient (de::Socket& socket)
+	{
+		if (sayHello(socket) < NUM_SHARDS)
+			XS_FAIL("Server must be started with --max-processes=2 or more");
+
+		for (int shardNdx = 0; shardNdx < NUM_SHARDS; shardNdx++)
+			sendExecuteShard(socket, shardNdx, m_testCtx.testerPath, "--program=shard-stop", "");
+
+		const int		timeout							= 5000; // 5s.
+		TestClock		clock;
+
+		bool			gotProcessStarted[NUM_SHARDS]	= { false, false };
+		bool			gotProcessFinished[NUM_SHARDS]	= { false, false };
+		int				numStarted						= 0;
+		int				numFinished						= 0;
+
+		while (numFinished < NUM_SHARDS)
+		{
+			if (clock.getMilliseconds() > timeout)
+				XS_FAIL(numStarted < NUM_SHARDS ? "Timeout waiting for PROCESS_STARTED" : "STOP_EXECUTION didn't stop all slots");
+
+			int				shardNdx	= -1;
+			ScopedMsgPtr	msg			(readMessage(socket, shardNdx));
+
+			if (msg->type == MESSAGETYPE_KEEPALIVE || (shardNdx >= 0 && msg->type == MESSAGETYPE_INFO))
+				continue;
+			else if (shardNdx < 0 || shardNdx >= NUM_SHARDS)
+				XS_FAIL((string("Invalid message: ") + de::toString(msg->type) + " for slot " + de::toString(shardNdx)).c_str());
+			else if (msg->type == MESSAGETYPE_PROCESS_STARTED && !gotProcessStarted[shardNdx])
+			{
+				gotProcessStarted[shardNdx] = true;
+				numStarted += 1;
+
+				// Stop once all slots are running, single STOP_EXECUTION must stop all of them.
+				if (numStarted == NUM_SHARDS)
+				{
+					sendMessage(socket, StopExecutionMessage());
+					clock.reset();
+				}
+			}
+			else if (msg->type == MESSAGETYPE_PROCESS_FINISHED && gotProcessStarted[shardNdx] && !gotProcessFinished[shardNdx])
+			{
+				if (numStarted < NUM_SHARDS)
+					XS_FAIL("Process finished before STOP_EXECUTION");
+
+				gotProcessFinished[shardNdx] = true;
+				numFinished += 1;
+			}
+			else if (msg->type == MESSAGETYPE_PROCESS_LAUNCH_FAILED)
+				XS_FAIL("Got PROCESS_LAUNCH_FAILED");
+			else
+				XS_FAIL((string("Invalid message: ") + de::toString(msg->type) + " for slot " + de::toString(shardNdx)).c_str());
+		}
+	}
+
+	void runProgram (void) { deSleep(RUN_TIME); }
+};
+
 void printHelp (const char* binName)
 {
 	printf("%s:\n", binName);
@@ -823,6 +1067,7 @@ void printHelp (const char* binName)
 	printf("  --tester-cmd=[cmd]    Launch tester with [cmd]\n");
 	printf("  --server-cmd=[cmd]    Launch server with [cmd]\n");
 	printf("  --start-server        Start server for test execution\n");
+	printf("  Server must have at least 2 process slots (--max-processes) for shard tests.\n");
 }
 
 struct CompareCaseName
@@ -898,6 +1143,8 @@ void runExecServerTests (int argc, const char* const* argv)
 	testCases.push_back(new LogDataTest(testCtx));
 	testCases.push_back(new KeepAliveTest(testCtx));
 	testCases.push_back(new BigLogDataTest(testCtx));
+	testCases.push_back(new ShardTest(testCtx));
+	testCases.push_back(new ShardStopTest(testCtx));
 
 	try
 	{
@@ -41,6 +41,8 @@ enum
 
 	SERVER_IDLE_THRESHOLD		= 10,
 	SERVER_IDLE_SLEEP			= 50,
+	SERVER_WAIT_TIMEOUT			= 100,		//!< Max time to wait for events, bounds timeout checks.
+	TEST_DRIVER_ACQUIRE_TIMEOUT	= 1000,		//!< Max time to wait for previous session to release test driver.
 	FILEREADER_IDLE_SLEEP		= 100,
 
 	LOG_BUFFER_BLOCK_SIZE		= 1024,
@@ -49,11 +51,14 @@ enum
 	INFO_BUFFER_BLOCK_SIZE		= 64,
 	INFO_BUFFER_NUM_BLOCKS		= 128,
 
-	SEND_BUFFER_SIZE			= 16*1024,
+	SEND_BUFFER_SIZE			= 128*1024,
 	RECV_BUFFER_SIZE			= 4*1024,
 
+	LOG_DATA_WINDOW_MIN			= 4*1024,	//!< Initial max amount of log data per message.
+	LOG_DATA_WINDOW_MAX			= 64*1024,	//!< Window grows up to this while test log data is backlogged.
+
 	FILEREADER_TMP_BUFFER_SIZE	= 1024,
-	SEND_RECV_TMP_BUFFER_SIZE	= 4*1024,
+	SEND_RECV_TMP_BUFFER_SIZE	= 16*1024,
 
 	MIN_MSG_PAYLOAD_SIZE		= 32
 };
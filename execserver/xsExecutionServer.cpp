@@ -99,29 +99,67 @@ void MessageBuilder::clear (void)
 }
 
 ExecutionServer::ExecutionServer (xs::TestProcess* testProcess, deSocketFamily family, int port, RunMode runMode)
-	: TcpServer		(family, port)
-	, m_testDriver	(testProcess)
-	, m_runMode		(runMode)
+	: TcpServer			(family, port)
+	, m_testDriverLock	(1)
+	, m_runMode			(runMode)
 {
+	createTestDrivers(vector<xs::TestProcess*>(1, testProcess));
+}
+
+ExecutionServer::ExecutionServer (const vector<xs::TestProcess*>& testProcesses, deSocketFamily family, int port, RunMode runMode)
+	: TcpServer			(family, port)
+	, m_testDriverLock	(1)
+	, m_runMode			(runMode)
+{
+	createTestDrivers(testProcesses);
 }
 
 ExecutionServer::~ExecutionServer (void)
 {
+	for (vector<TestDriver*>::iterator i = m_testDrivers.begin(); i != m_testDrivers.end(); ++i)
+		delete *i;
+}
+
+void ExecutionServer::createTestDrivers (const vector<xs::TestProcess*>& testProcesses)
+{
+	XS_CHECK(!testProcesses.empty());
+
+	try
+	{
+		for (vector<xs::TestProcess*>::const_iterator i = testProcesses.begin(); i != testProcesses.end(); ++i)
+			m_testDrivers.push_back(new TestDriver(*i));
+	}
+	catch (...)
+	{
+		for (vector<TestDriver*>::iterator i = m_testDrivers.begin(); i != m_testDrivers.end(); ++i)
+			delete *i;
+		m_testDrivers.clear();
+		throw;
+	}
 }
 
 TestDriver* ExecutionServer::acquireTestDriver (void)
 {
-	if (!m_testDriverLock.tryLock())
-		throw Error("Failed to acquire test driver");
+	// \note Client may reconnect before handler of previous session has noticed disconnect and released the driver.
+	//		 Waiting is bounded so that handler of a client rejected while another session runs doesn't block.
+	const deUint64 startTime = deGetMicroseconds();
+
+	while (!m_testDriverLock.tryDecrement())
+	{
+		if (deGetMicroseconds() - startTime > TEST_DRIVER_ACQUIRE_TIMEOUT*1000)
+			throw Error("Failed to acquire test driver");
+
+		deSleep(1);
+	}
 
-	return &m_testDriver;
+	return m_testDrivers[0];
 }
 
 void ExecutionServer::releaseTestDriver (TestDriver* driver)
 {
-	DE_ASSERT(&m_testDriver == driver);
+	DE_ASSERT(m_testDrivers[0] == driver);
 	DE_UNREF(driver);
-	m_testDriverLock.unlock();
+	m_testDriverLock.increment();
 }
 
 ConnectionHandler* ExecutionServer::createHandler (de::Socket* socket, const de::SocketAddress& clientAddress)
@@ -145,6 +183,9 @@ ExecutionRequestHandler::ExecutionRequestHandler (ExecutionServer* server, de::S
 	, m_bufferIn		(RECV_BUFFER_SIZE)
 	, m_bufferOut		(SEND_BUFFER_SIZE)
 	, m_run				(false)
+	, m_compressLogData	(false)
+	, m_nextPolledDriver(0)
+	, m_isEventDriven	(WakeupEvent::isSupported())
 	, m_sendRecvTmpBuf	(SEND_RECV_TMP_BUFFER_SIZE)
 {
 	// Set flags.
@@ -157,7 +198,7 @@ ExecutionRequestHandler::ExecutionRequestHandler (ExecutionServer* server, de::S
 ExecutionRequestHandler::~ExecutionRequestHandler (void)
 {
 	if (m_testDriver)
-		m_execServer->releaseTestDriver(m_testDriver);
+		releaseTestDriver();
 }
 
 void ExecutionRequestHandler::handle (void)
@@ -176,18 +217,20 @@ void ExecutionRequestHandler::handle (void)
 
 	DBG_PRINT(("ExecutionRequestHandler::handle(): Done!\n"));
 
-	// Release test driver.
+	// Release test drivers.
 	if (m_testDriver)
 	{
-		try
+		for (int ndx = 0; ndx < m_execServer->getNumTestDrivers(); ndx++)
 		{
-			m_testDriver->reset();
+			try
+			{
+				m_execServer->getTestDriver(ndx)->reset();
+			}
+			catch (...)
+			{
+			}
 		}
-		catch (...)
-		{
-		}
-		m_execServer->releaseTestDriver(m_testDriver);
-		m_testDriver = DE_NULL;
+		releaseTestDriver();
 	}
 
 	// Close connection.
@@ -199,11 +242,36 @@ void ExecutionRequestHandler::acquireTestDriver (void)
 {
 	DE_ASSERT(!m_testDriver);
 
-	// Try to acquire test driver - may fail.
+	// Wait for previous session to release test driver, throws if it is busy.
 	m_testDriver = m_execServer->acquireTestDriver();
 	DE_ASSERT(m_testDriver);
 	m_testDriver->reset();
 
+	// Fall back to polling if any of the test processes can't signal events.
+	for (int ndx = 0; ndx < m_execServer->getNumTestDrivers(); ndx++)
+	{
+		TestDriver* const driver = m_execServer->getTestDriver(ndx);
+
+		if (!driver->setWakeupEvent(m_isEventDriven ? &m_wakeupEvent : DE_NULL))
+			m_isEventDriven = false;
+
+		driver->setLogDataCompression(m_compressLogData);
+	}
+}
+
+void ExecutionRequestHandler::releaseTestDriver (void)
+{
+	DE_ASSERT(m_testDriver);
+
+	for (int ndx = 0; ndx < m_execServer->getNumTestDrivers(); ndx++)
+	{
+		m_execServer->getTestDriver(ndx)->setWakeupEvent(DE_NULL);
+		m_execServer->getTestDriver(ndx)->setLogDataCompression(false);
+	}
+
+	m_execServer->releaseTestDriver(m_testDriver);
+	m_testDriver = DE_NULL;
+	m_rejectedShards.clear();
 }
 
 void ExecutionRequestHandler::processSession (void)
@@ -240,15 +308,17 @@ void ExecutionRequestHandler::processSession (void)
 		// Keepalives, anyone?
 		pollKeepAlives();
 
-		// Poll test driver for IO.
+		// Poll test drivers for IO.
 		if (m_testDriver)
-			anyIO = getTestDriver()->poll(m_bufferOut) || anyIO;
+			anyIO = pollTestDrivers() || anyIO;
 
-		// If no IO happens in a reasonable amount of time, go to sleep.
+		// Wait for IO, or if events are not supported, go to sleep if no IO happens in a reasonable amount of time.
 		{
 			deUint64 curTime = deGetMicroseconds();
 			if (anyIO)
 				lastIoTime = curTime;
+			else if (m_isEventDriven)
+				waitForEvents();
 			else if (curTime-lastIoTime > SERVER_IDLE_THRESHOLD*1000)
 				deSleep(SERVER_IDLE_SLEEP); // Too long since last IO, sleep for a while.
 			else
@@ -264,9 +334,25 @@ void ExecutionRequestHandler::processMessage (MessageType type, const deUint8* d
 		case MESSAGETYPE_HELLO:
 		{
 			HelloMessage msg(data, dataSize);
-			DBG_PRINT(("HelloMessage: version = %d\n", msg.version));
+			DBG_PRINT(("HelloMessage: version = %d, flags = 0x%x\n", msg.version, msg.flags));
 			if (msg.version != PROTOCOL_VERSION)
 				throw ProtocolError("Unsupported protocol version");
+
+			// \note Applied to test drivers when they are acquired.
+			if (m_testDriver)
+				throw ProtocolError("HELLO after test execution has started");
+
+			m_compressLogData = (msg.flags & HELLO_FLAG_COMPRESSED_LOG_DATA) != 0;
+
+			// Confirm flags, client must not rely on them before reply. Unknown flags are ignored.
+			// \note Clients detect older servers by lack of reply. Only keepalives can be queued before test
+			//		 execution starts, so reply always fits.
+			{
+				vector<deUint8> buf;
+				HelloReplyMessage(m_execServer->getNumTestDrivers(), HELLO_FLAGS_SUPPORTED, msg.flags & HELLO_FLAGS_SUPPORTED).write(buf);
+				XS_CHECK(m_bufferOut.getNumFree() >= (int)buf.size());
+				m_bufferOut.pushFront(&buf[0], (int)buf.size());
+			}
 			break;
 		}
 
@@ -294,11 +380,22 @@ void ExecutionRequestHandler::processMessage (MessageType type, const deUint8* d
 			break;
 		}
 
+		case MESSAGETYPE_EXECUTE_SHARD:
+		{
+			ExecuteShardMessage msg(data, dataSize);
+			DBG_PRINT(("ExecuteShardMessage: %d, '%s', '%s', '%s', '%s'\n", msg.shardNdx, msg.name.c_str(), msg.params.c_str(), msg.workDir.c_str(), msg.caseList.substr(0, 10).c_str()));
+			startShard(msg);
+			keepAliveReceived();
+			break;
+		}
+
 		case MESSAGETYPE_STOP_EXECUTION:
 		{
 			StopExecutionMessage msg(data, dataSize);
 			DBG_PRINT(("StopExecutionMessage\n"));
-			getTestDriver()->stopProcess();
+			getTestDriver();
+			for (int ndx = 0; ndx < m_execServer->getNumTestDrivers(); ndx++)
+				m_execServer->getTestDriver(ndx)->stopProcess();
 			break;
 		}
 
@@ -307,6 +404,54 @@ void ExecutionRequestHandler::processMessage (MessageType type, const deUint8* d
 	}
 }
 
+void ExecutionRequestHandler::startShard (const ExecuteShardMessage& msg)
+{
+	getTestDriver();
+
+	if (msg.shardNdx < 0)
+		throw ProtocolError("Invalid process slot");
+
+	if (msg.shardNdx < m_execServer->getNumTestDrivers())
+		m_execServer->getTestDriver(msg.shardNdx)->startShard(msg.shardNdx, msg.name.c_str(), msg.params.c_str(), msg.workDir.c_str(), msg.caseList.c_str());
+	else
+		m_rejectedShards.push_back(msg.shardNdx); // Reported as launch failure, client can reassign cases to other slots.
+}
+
+bool ExecutionRequestHandler::pollTestDrivers (void)
+{
+	const int	numDrivers	= m_execServer->getNumTestDrivers();
+	bool		anyIO		= pollRejectedShards();
+
+	for (int ndx = 0; ndx < numDrivers; ndx++)
+		anyIO = m_execServer->getTestDriver((m_nextPolledDriver + ndx) % numDrivers)->poll(m_bufferOut) || anyIO;
+
+	m_nextPolledDriver = (m_nextPolledDriver + 1) % numDrivers;
+
+	return anyIO;
+}
+
+bool ExecutionRequestHandler::pollRejectedShards (void)
+{
+	bool anyIO = false;
+
+	while (!m_rejectedShards.empty())
+	{
+		vector<deUint8> buf(SHARD_MESSAGE_HEADER_SIZE);
+
+		ProcessLaunchFailedMessage("No such process slot").write(buf);
+		ShardMessage::writeHeader(m_rejectedShards.back(), buf.size()-SHARD_MESSAGE_HEADER_SIZE, &buf[0], SHARD_MESSAGE_HEADER_SIZE);
+
+		if (m_bufferOut.getNumFree() < (int)buf.size())
+			break;
+
+		m_bufferOut.pushFront(&buf[0], (int)buf.size());
+		m_rejectedShards.pop_back();
+		anyIO = true;
+	}
+
+	return anyIO;
+}
+
 void ExecutionRequestHandler::initKeepAlives (void)
 {
 	deUint64 curTime = deGetMicroseconds();
@@ -370,6 +515,20 @@ bool ExecutionRequestHandler::receive (void)
 		return false;
 }
 
+void ExecutionRequestHandler::waitForEvents (void)
+{
+	deUint32 flags = 0;
+
+	if (m_bufferIn.getNumFree() > 0)
+		flags |= WakeupEvent::WAITFLAG_READ;
+
+	if (m_bufferOut.getNumElements() > 0)
+		flags |= WakeupEvent::WAITFLAG_WRITE;
+
+	// \note Timeout is needed only for keepalives and test process timeouts.
+	m_wakeupEvent.wait((int)m_socket->getHandle(), flags, SERVER_WAIT_TIMEOUT);
+}
+
 bool ExecutionRequestHandler::send (void)
 {
 	size_t maxLen = de::min(m_sendRecvTmpBuf.size(), (size_t)m_bufferOut.getNumElements());
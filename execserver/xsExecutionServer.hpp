@@ -28,6 +28,8 @@
 #include "xsTestDriver.hpp"
 #include "xsProtocol.hpp"
 #include "xsTestProcess.hpp"
+#include "xsWakeupEvent.hpp"
+#include "deSemaphore.hpp"
 
 #include <vector>
 
@@ -46,19 +48,30 @@ public:
 	};
 
 							ExecutionServer			(xs::TestProcess* testProcess, deSocketFamily family, int port, RunMode runMode);
+							ExecutionServer			(const std::vector<xs::TestProcess*>& testProcesses, deSocketFamily family, int port, RunMode runMode);
 							~ExecutionServer		(void);
 
 	ConnectionHandler*		createHandler			(de::Socket* socket, const de::SocketAddress& clientAddress);
 
+	//! Acquire test drivers for all process slots. Returns driver for first slot.
 	TestDriver*				acquireTestDriver		(void);
 	void					releaseTestDriver		(TestDriver* driver);
 
+	//! Test driver for process slot, valid only between acquireTestDriver() and releaseTestDriver().
+	int						getNumTestDrivers		(void) const	{ return (int)m_testDrivers.size();	}
+	TestDriver*				getTestDriver			(int ndx)		{ return m_testDrivers[ndx];		}
+
 	void					connectionDone			(ConnectionHandler* handler);
 
 private:
-	TestDriver				m_testDriver;
-	de::Mutex				m_testDriverLock;
-	RunMode					m_runMode;
+							ExecutionServer			(const ExecutionServer& other);
+	ExecutionServer&		operator=				(const ExecutionServer& other);
+
+	void					createTestDrivers		(const std::vector<xs::TestProcess*>& testProcesses);
+
+	std::vector<TestDriver*>	m_testDrivers;
+	de::Semaphore				m_testDriverLock;	//!< Held by the session using test drivers, released by handler thread when session ends.
+	RunMode						m_runMode;
 };
 
 class MessageBuilder
@@ -100,6 +113,7 @@ private:
 
 	inline TestDriver*			getTestDriver					(void) { if (!m_testDriver) acquireTestDriver(); return m_testDriver; }
 	void						acquireTestDriver				(void);
+	void						releaseTestDriver				(void);
 
 	void						initKeepAlives					(void);
 	void						keepAliveReceived				(void);
@@ -107,6 +121,11 @@ private:
 
 	bool						receive							(void);
 	bool						send							(void);
+	void						waitForEvents					(void);
+
+	void						startShard						(const ExecuteShardMessage& msg);
+	bool						pollTestDrivers					(void);
+	bool						pollRejectedShards				(void);
 
 	ExecutionServer*			m_execServer;
 	TestDriver*					m_testDriver;
@@ -116,6 +135,13 @@ private:
 
 	bool						m_run;
 	MessageBuilder				m_msgBuilder;
+	bool						m_compressLogData;				//!< Requested by client in HELLO
+
+	int							m_nextPolledDriver;				//!< Drivers are polled round-robin so that one can't starve others
+	std::vector<int>			m_rejectedShards;				//!< Shards requested for non-existing process slots
+
+	WakeupEvent					m_wakeupEvent;
+	bool						m_isEventDriven;				//!< Wait for IO events instead of polling
 
 	// \todo [2011-09-30 pyry] Move to some watchdog class instead.
 	deUint64					m_lastKeepAliveSent;
@@ -0,0 +1,168 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test log data compression.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsLogDataCompression.hpp"
+#include "deMemory.h"
+
+#include <zlib.h>
+
+namespace xs
+{
+
+enum
+{
+	// Test process is running on the same device, favor speed over ratio.
+	LOG_DATA_COMPRESSION_LEVEL	= Z_BEST_SPEED,
+
+	// Empty stored block emitted by Z_SYNC_FLUSH, plus pending bits.
+	SYNC_FLUSH_OVERHEAD			= 6
+};
+
+static z_stream* createStream (void)
+{
+	z_stream* stream = new z_stream;
+	deMemset(stream, 0, sizeof(z_stream));
+	return stream;
+}
+
+// LogDataCompressor
+
+LogDataCompressor::LogDataCompressor (void)
+	: m_stream(createStream())
+{
+	if (deflateInit(m_stream, LOG_DATA_COMPRESSION_LEVEL) != Z_OK)
+	{
+		delete m_stream;
+		XS_FAIL("Failed to initialize log data compression");
+	}
+}
+
+LogDataCompressor::~LogDataCompressor (void)
+{
+	deflateEnd(m_stream);
+	delete m_stream;
+}
+
+void LogDataCompressor::reset (void)
+{
+	XS_CHECK(deflateReset(m_stream) == Z_OK);
+}
+
+size_t LogDataCompressor::compress (const deUint8* src, size_t srcSize, deUint8* dst, size_t dstSize)
+{
+	DE_ASSERT(srcSize > 0);
+
+	m_stream->next_in	= const_cast<Bytef*>(src);
+	m_stream->avail_in	= (uInt)srcSize;
+	m_stream->next_out	= dst;
+	m_stream->avail_out	= (uInt)dstSize;
+
+	// \note Output is complete only if there is space left after flush.
+	XS_CHECK_MSG(deflate(m_stream, Z_SYNC_FLUSH) == Z_OK && m_stream->avail_in == 0 && m_stream->avail_out > 0,
+				 "Failed to compress log data");
+
+	return dstSize - (size_t)m_stream->avail_out;
+}
+
+size_t LogDataCompressor::getMaxCompressedSize (size_t srcSize)
+{
+	return (size_t)compressBound((uLong)srcSize) + SYNC_FLUSH_OVERHEAD;
+}
+
+size_t LogDataCompressor::getMaxSourceSize (size_t dstSize)
+{
+	// \note Overhead grows monotonically with source size, so overhead of dstSize is an upper bound.
+	const size_t overhead = getMaxCompressedSize(dstSize) - dstSize;
+	return dstSize > overhead ? dstSize - overhead : 0;
+}
+
+// LogDataDecompressor
+
+LogDataDecompressor::LogDataDecompressor (void)
+	: m_stream				(createStream())
+	, m_hasPendingOutput	(false)
+{
+	if (inflateInit(m_stream) != Z_OK)
+	{
+		delete m_stream;
+		XS_FAIL("Failed to initialize log data decompression");
+	}
+}
+
+LogDataDecompressor::~LogDataDecompressor (void)
+{
+	inflateEnd(m_stream);
+	delete m_stream;
+}
+
+void LogDataDecompressor::reset (void)
+{
+	XS_CHECK(inflateReset(m_stream) == Z_OK);
+
+	m_stream->next_in	= DE_NULL;
+	m_stream->avail_in	= 0;
+	m_hasPendingOutput	= false;
+}
+
+void LogDataDecompressor::setInput (const deUint8* src, size_t srcSize)
+{
+	DE_ASSERT(m_stream->avail_in == 0);
+
+	m_stream->next_in	= const_cast<Bytef*>(src);
+	m_stream->avail_in	= (uInt)srcSize;
+}
+
+size_t LogDataDecompressor::decompress (deUint8* dst, size_t dstSize)
+{
+	DE_ASSERT(dstSize > 0);
+
+	while (m_stream->avail_in > 0 || m_hasPendingOutput)
+	{
+		const uInt	numInBefore	= m_stream->avail_in;
+		int			result;
+		size_t		numWritten;
+
+		m_stream->next_out	= dst;
+		m_stream->avail_out	= (uInt)dstSize;
+
+		result				= inflate(m_stream, Z_NO_FLUSH);
+		numWritten			= dstSize - (size_t)m_stream->avail_out;
+		m_hasPendingOutput	= m_stream->avail_out == 0;
+
+		if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+			XS_FAIL("Corrupt compressed log data");
+
+		if (numWritten > 0)
+			return numWritten;
+		else if (m_stream->avail_in == numInBefore)
+		{
+			// No progress, remaining data is after end of stream.
+			XS_CHECK_MSG(m_stream->avail_in == 0, "Unexpected data after end of compressed log data");
+			break;
+		}
+	}
+
+	return 0;
+}
+
+} // xs
@@ -0,0 +1,87 @@
+#ifndef _XSLOGDATACOMPRESSION_HPP
+#define _XSLOGDATACOMPRESSION_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test log data compression.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsDefs.hpp"
+
+struct z_stream_s;
+
+namespace xs
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Compressor for COMPRESSED_LOG_DATA messages
+ *
+ * Log data of a single test process is compressed as one zlib stream.
+ * Each compress() call is flushed to a byte boundary so that receiver
+ * can decompress the data as soon as the message arrives.
+ *//*--------------------------------------------------------------------*/
+class LogDataCompressor
+{
+public:
+							LogDataCompressor		(void);
+							~LogDataCompressor		(void);
+
+	//! Start new stream.
+	void					reset					(void);
+
+	//! Compress and flush all of src. dst must have room for getMaxCompressedSize(srcSize) bytes.
+	size_t					compress				(const deUint8* src, size_t srcSize, deUint8* dst, size_t dstSize);
+
+	static size_t			getMaxCompressedSize	(size_t srcSize);
+	static size_t			getMaxSourceSize		(size_t dstSize);
+
+private:
+							LogDataCompressor		(const LogDataCompressor& other);
+	LogDataCompressor&		operator=				(const LogDataCompressor& other);
+
+	z_stream_s*				m_stream;
+};
+
+class LogDataDecompressor
+{
+public:
+							LogDataDecompressor		(void);
+							~LogDataDecompressor	(void);
+
+	//! Start new stream.
+	void					reset					(void);
+
+	//! Set next chunk of compressed data. Data is not copied and must be valid until decompress() returns 0.
+	void					setInput				(const deUint8* src, size_t srcSize);
+
+	//! Decompress into dst. Returns number of bytes written, or 0 when all input has been consumed.
+	size_t					decompress				(deUint8* dst, size_t dstSize);
+
+private:
+							LogDataDecompressor		(const LogDataDecompressor& other);
+	LogDataDecompressor&	operator=				(const LogDataDecompressor& other);
+
+	z_stream_s*				m_stream;
+	bool					m_hasPendingOutput;		//!< Last decompress() filled dst, more output may be buffered
+};
+
+} // xs
+
+#endif // _XSLOGDATACOMPRESSION_HPP
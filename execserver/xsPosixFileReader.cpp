@@ -22,18 +22,96 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xsPosixFileReader.hpp"
+#include "deFilePath.hpp"
 
 #include <vector>
 
+#if (DE_OS == DE_OS_UNIX) || (DE_OS == DE_OS_ANDROID)
+#	define XS_USE_INOTIFY 1
+#endif
+
+#if defined(XS_USE_INOTIFY)
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#	include <fcntl.h>
+#endif
+
 namespace xs
 {
 namespace posix
 {
 
+#if defined(XS_USE_INOTIFY)
+
+namespace
+{
+
+class FileNotify
+{
+public:
+	FileNotify (void)
+		: m_fd		(inotify_init())
+		, m_watch	(-1)
+	{
+		if (m_fd >= 0)
+		{
+			fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL, 0) | O_NONBLOCK);
+			fcntl(m_fd, F_SETFD, fcntl(m_fd, F_GETFD, 0) | FD_CLOEXEC);
+		}
+	}
+
+	~FileNotify (void)
+	{
+		if (m_fd >= 0)
+			close(m_fd);
+	}
+
+	//! Replace current watch. Returns false if path can not be watched.
+	bool watch (const char* path, deUint32 mask)
+	{
+		if (m_fd < 0)
+			return false;
+
+		if (m_watch >= 0)
+			inotify_rm_watch(m_fd, m_watch);
+
+		m_watch = inotify_add_watch(m_fd, path, mask);
+		return m_watch >= 0;
+	}
+
+	//! Wait for notification. If nothing is being watched, falls back to sleeping.
+	void wait (WakeupEvent& wakeup)
+	{
+		if (m_watch < 0)
+		{
+			wakeup.wait(-1, 0, FILEREADER_IDLE_SLEEP);
+			return;
+		}
+
+		if (wakeup.wait(m_fd, WakeupEvent::WAITFLAG_READ, -1))
+		{
+			// Discard events, we only care that something happened.
+			deUint8 buf[1024];
+			while (::read(m_fd, &buf[0], sizeof(buf)) > 0);
+		}
+	}
+
+private:
+	const int	m_fd;
+	int			m_watch;
+};
+
+} // anonymous
+
+#endif // XS_USE_INOTIFY
+
 FileReader::FileReader (int blockSize, int numBlocks)
-	: m_file		(DE_NULL)
-	, m_buf			(blockSize, numBlocks)
-	, m_isRunning	(false)
+	: m_file			(DE_NULL)
+	, m_buf				(blockSize, numBlocks)
+	, m_isRunning		(false)
+	, m_dataEvent		(DE_NULL)
+	, m_writerFinished	(false)
+	, m_isFinished		(false)
 {
 }
 
@@ -41,6 +119,15 @@ FileReader::~FileReader (void)
 {
 }
 
+bool FileReader::isEventDriven (void)
+{
+#if defined(XS_USE_INOTIFY)
+	return WakeupEvent::isSupported();
+#else
+	return false;
+#endif
+}
+
 void FileReader::start (const char* filename)
 {
 	DE_ASSERT(!m_isRunning);
@@ -58,12 +145,51 @@ void FileReader::start (const char* filename)
 	}
 #endif
 
-	m_isRunning	= true;
+	m_filename			= filename;
+	m_dataEvent			= DE_NULL;
+	m_writerFinished	= false;
+	m_isFinished		= false;
+	m_isRunning			= true;
+
+	de::Thread::start();
+}
+
+void FileReader::start (const char* filename, WakeupEvent* dataEvent)
+{
+	DE_ASSERT(!m_isRunning);
+	DE_ASSERT(isEventDriven());
+
+	// \note File is opened by reader thread once it has been created.
+	m_filename			= filename;
+	m_dataEvent			= dataEvent;
+	m_writerFinished	= false;
+	m_isFinished		= false;
+	m_isRunning			= true;
 
 	de::Thread::start();
 }
 
+void FileReader::writerFinished (void)
+{
+	m_writerFinished = true;
+	m_wakeup.signal();
+}
+
+void FileReader::dataWritten (void)
+{
+	if (m_dataEvent)
+		m_dataEvent->signal();
+}
+
 void FileReader::run (void)
+{
+	if (m_file)
+		runPolling();
+	else
+		runEventDriven();
+}
+
+void FileReader::runPolling (void)
 {
 	std::vector<deUint8>	tmpBuf		(FILEREADER_TMP_BUFFER_SIZE);
 	deInt64					numRead		= 0;
@@ -97,19 +223,103 @@ void FileReader::run (void)
 	}
 }
 
+void FileReader::runEventDriven (void)
+{
+#if defined(XS_USE_INOTIFY)
+	std::vector<deUint8>	tmpBuf		(FILEREADER_TMP_BUFFER_SIZE);
+	deInt64					numRead		= 0;
+	FileNotify				notify;
+
+	// Wait until file has been created.
+	notify.watch(de::FilePath(m_filename).getDirName().c_str(), IN_CREATE|IN_MOVED_TO);
+
+	while (!m_buf.isCanceled())
+	{
+		// \note Flag must be sampled before open attempt, file may be created just before writer finishes.
+		const bool		writerFinished	= m_writerFinished;
+		deFile* const	file			= deFile_create(m_filename.c_str(), DE_FILEMODE_OPEN|DE_FILEMODE_READ);
+
+		if (file)
+		{
+			m_file = file;
+			break;
+		}
+		else if (writerFinished)
+		{
+			// Writer exited without creating file.
+			m_isFinished = true;
+			dataWritten();
+			return;
+		}
+		else
+			notify.wait(m_wakeup);
+	}
+
+	if (!m_file)
+		return; // Canceled.
+
+	notify.watch(m_filename.c_str(), IN_MODIFY|IN_CLOSE_WRITE);
+
+	while (!m_buf.isCanceled())
+	{
+		const bool		writerFinished	= m_writerFinished;
+		deFileResult	result			= deFile_read(m_file, &tmpBuf[0], (deInt64)tmpBuf.size(), &numRead);
+
+		if (result == DE_FILERESULT_SUCCESS)
+		{
+			// Write to buffer.
+			try
+			{
+				m_buf.write((int)numRead, &tmpBuf[0]);
+				m_buf.flush();
+			}
+			catch (const ThreadedByteBuffer::CanceledException&)
+			{
+				// Canceled.
+				break;
+			}
+
+			dataWritten();
+		}
+		else if (result == DE_FILERESULT_END_OF_FILE ||
+				 result == DE_FILERESULT_WOULD_BLOCK)
+		{
+			if (writerFinished)
+			{
+				// Everything has been read.
+				m_isFinished = true;
+				dataWritten();
+				break;
+			}
+
+			// Wait for more data.
+			notify.wait(m_wakeup);
+		}
+		else
+			break; // Error.
+	}
+#else
+	DE_ASSERT(DE_FALSE);
+#endif
+}
+
 void FileReader::stop (void)
 {
 	if (!m_isRunning)
 		return; // Nothing to do.
 
 	m_buf.cancel();
+	m_wakeup.signal();
 
 	// Join thread.
 	join();
 
 	// Destroy file.
-	deFile_destroy(m_file);
-	m_file = DE_NULL;
+	if (m_file)
+	{
+		deFile_destroy(m_file);
+		m_file = DE_NULL;
+	}
 
 	// Reset buffer.
 	m_buf.clear();
@@ -24,9 +24,12 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xsDefs.hpp"
+#include "xsWakeupEvent.hpp"
 #include "deFile.h"
 #include "deThread.hpp"
 
+#include <string>
+
 namespace xs
 {
 namespace posix
@@ -38,18 +41,37 @@ public:
 							FileReader			(int blockSize, int numBlocks);
 							~FileReader			(void);
 
+	//! Check if start(filename, dataEvent) is supported.
+	static bool				isEventDriven		(void);
+
 	void					start				(const char* filename);
+	//! Start event-driven reader. File doesn't need to exist yet, reader waits until it is created.
+	void					start				(const char* filename, WakeupEvent* dataEvent);
 	void					stop				(void);
+	//! Notify that file will not be written anymore. Reader finishes once all data has been read.
+	void					writerFinished		(void);
 
 	bool					isRunning			(void) const					{ return m_isRunning;					}
+	bool					isFileOpen			(void) const					{ return m_file != DE_NULL;				}
+	bool					isFinished			(void) const					{ return m_isFinished;					}
 	int						read				(deUint8* dst, int numBytes)	{ return m_buf.tryRead(numBytes, dst);	}
 
 	void					run					(void);
 
 private:
-	deFile*					m_file;
+	void					runPolling			(void);
+	void					runEventDriven		(void);
+	void					dataWritten			(void);
+
+	std::string				m_filename;
+	deFile* volatile		m_file;
 	ThreadedByteBuffer		m_buf;
 	bool					m_isRunning;
+
+	WakeupEvent*			m_dataEvent;		//!< Signaled when new data is available, or DE_NULL
+	WakeupEvent				m_wakeup;			//!< Wakes up reader thread on writerFinished() and stop()
+	volatile bool			m_writerFinished;
+	volatile bool			m_isFinished;
 };
 
 } // posix
@@ -24,9 +24,12 @@
 #include "xsPosixTestProcess.hpp"
 #include "deFilePath.hpp"
 #include "deClock.h"
+#include "deMemory.h"
 
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
+#include <sys/wait.h>
 
 using std::string;
 using std::vector;
@@ -76,7 +79,12 @@ void CaseListWriter::run (void)
 		if (result == DE_FILERESULT_SUCCESS)
 			pos += numWritten;
 		else if (result == DE_FILERESULT_WOULD_BLOCK)
-			deSleep(1); // Yield.
+		{
+			if (WakeupEvent::isSupported())
+				m_wakeup.wait((int)deFile_getHandle(m_file), WakeupEvent::WAITFLAG_WRITE, -1);
+			else
+				deSleep(1); // Yield.
+		}
 		else
 			break; // Error.
 	}
@@ -88,6 +96,7 @@ void CaseListWriter::stop (void)
 		return; // Nothing to do.
 
 	m_run = false;
+	m_wakeup.signal();
 
 	// Join thread.
 	join();
@@ -96,8 +105,10 @@ void CaseListWriter::stop (void)
 }
 
 PipeReader::PipeReader (ThreadedByteBuffer* dst)
-	: m_file	(DE_NULL)
-	, m_buf		(dst)
+	: m_file		(DE_NULL)
+	, m_buf			(dst)
+	, m_dataEvent	(DE_NULL)
+	, m_isFinished	(false)
 {
 }
 
@@ -105,7 +116,7 @@ PipeReader::~PipeReader (void)
 {
 }
 
-void PipeReader::start (deFile* file)
+void PipeReader::start (deFile* file, WakeupEvent* dataEvent)
 {
 	DE_ASSERT(!isStarted());
 
@@ -113,7 +124,9 @@ void PipeReader::start (deFile* file)
 	if (!deFile_setFlags(file, DE_FILE_NONBLOCKING))
 		XS_FAIL("Failed to set non-blocking mode");
 
-	m_file = file;
+	m_file			= file;
+	m_dataEvent		= dataEvent;
+	m_isFinished	= false;
 
 	de::Thread::start();
 }
@@ -140,12 +153,25 @@ void PipeReader::run (void)
 				// Canceled.
 				break;
 			}
+
+			if (m_dataEvent)
+				m_dataEvent->signal();
+		}
+		else if (result == DE_FILERESULT_END_OF_FILE && m_dataEvent)
+		{
+			// All writers have closed the pipe.
+			m_isFinished = true;
+			m_dataEvent->signal();
+			break;
 		}
 		else if (result == DE_FILERESULT_END_OF_FILE ||
 				 result == DE_FILERESULT_WOULD_BLOCK)
 		{
 			// Wait for more data.
-			deSleep(FILEREADER_IDLE_SLEEP);
+			if (m_dataEvent)
+				m_wakeup.wait((int)deFile_getHandle(m_file), WakeupEvent::WAITFLAG_READ, -1);
+			else
+				deSleep(FILEREADER_IDLE_SLEEP);
 		}
 		else
 			break; // Error.
@@ -159,6 +185,7 @@ void PipeReader::stop (void)
 
 	// Buffer must be in canceled state or otherwise stopping reader might block.
 	DE_ASSERT(m_buf->isCanceled());
+	m_wakeup.signal();
 
 	// Join thread.
 	join();
@@ -166,12 +193,105 @@ void PipeReader::stop (void)
 	m_file = DE_NULL;
 }
 
+ExitWatcher::ExitWatcher (void)
+	: m_process		(DE_NULL)
+	, m_logReader	(DE_NULL)
+	, m_exitEvent	(DE_NULL)
+	, m_hasExited	(false)
+	, m_exitCode	(-1)
+{
+}
+
+ExitWatcher::~ExitWatcher (void)
+{
+}
+
+void ExitWatcher::start (de::Process* process, FileReader* logReader, WakeupEvent* exitEvent)
+{
+	DE_ASSERT(!isStarted());
+
+	m_process	= process;
+	m_logReader	= logReader;
+	m_exitEvent	= exitEvent;
+	m_hasExited	= false;
+	m_exitCode	= -1;
+
+	de::Thread::start();
+}
+
+void ExitWatcher::run (void)
+{
+	const pid_t	pid			= (pid_t)m_process->getHandle();
+	int			exitCode	= -1;
+	siginfo_t	info;
+
+	// Wait for exit without reaping. Process stays a zombie and its pid can't be reused until it is reaped below.
+	deMemset(&info, 0, sizeof(info));
+	while (waitid(P_PID, (id_t)pid, &info, WEXITED|WNOWAIT) != 0 && errno == EINTR)
+		continue;
+
+	{
+		de::ScopedLock lock(m_lock);
+
+		try
+		{
+			m_process->waitForFinish();
+			exitCode = m_process->getExitCode();
+		}
+		catch (const de::ProcessError& e)
+		{
+			printf("ExitWatcher::run(): Failed to wait for process: %s\n", e.what());
+		}
+
+		m_hasExited	= true;
+		m_exitCode	= exitCode;
+	}
+
+	m_logReader->writerFinished();
+	m_exitEvent->signal();
+}
+
+void ExitWatcher::stop (void)
+{
+	if (!isStarted())
+		return; // Nothing to do.
+
+	// \note Process must have been killed, otherwise this blocks until it exits.
+	join();
+
+	m_process	= DE_NULL;
+	m_logReader	= DE_NULL;
+	m_exitEvent	= DE_NULL;
+}
+
+bool ExitWatcher::hasExited (void) const
+{
+	de::ScopedLock lock(m_lock);
+	return m_hasExited;
+}
+
+int ExitWatcher::getExitCode (void) const
+{
+	de::ScopedLock lock(m_lock);
+	return m_exitCode;
+}
+
+void ExitWatcher::killProcess (void)
+{
+	de::ScopedLock lock(m_lock);
+
+	if (!m_hasExited)
+		m_process->kill();
+}
+
 } // unix
 
-PosixTestProcess::PosixTestProcess (void)
+PosixTestProcess::PosixTestProcess (const char* logBaseName)
 	: m_process				(DE_NULL)
 	, m_processStartTime	(0)
+	, m_logBaseName			(logBaseName)
 	, m_infoBuffer			(INFO_BUFFER_BLOCK_SIZE, INFO_BUFFER_NUM_BLOCKS)
+	, m_wakeupEvent			(DE_NULL)
 	, m_stdOutReader		(&m_infoBuffer)
 	, m_stdErrReader		(&m_infoBuffer)
 	, m_logReader			(LOG_BUFFER_BLOCK_SIZE, LOG_BUFFER_NUM_BLOCKS)
@@ -189,7 +309,7 @@ void PosixTestProcess::start (const char* name, const char* params, const char*
 
 	XS_CHECK(!m_process);
 
-	de::FilePath logFilePath = de::FilePath::join(workingDir, "TestResults.qpa");
+	de::FilePath logFilePath = de::FilePath::join(workingDir, m_logBaseName);
 	m_logFileName = logFilePath.getPath();
 
 	// Remove old file if such exists.
@@ -227,10 +347,17 @@ void PosixTestProcess::start (const char* name, const char* params, const char*
 
 	// Create stdout & stderr readers.
 	if (m_process->getStdOut())
-		m_stdOutReader.start(m_process->getStdOut());
+		m_stdOutReader.start(m_process->getStdOut(), m_wakeupEvent);
 
 	if (m_process->getStdErr())
-		m_stdErrReader.start(m_process->getStdErr());
+		m_stdErrReader.start(m_process->getStdErr(), m_wakeupEvent);
+
+	if (isEventDriven())
+	{
+		// Log reader waits until process creates the log file.
+		m_logReader.start(m_logFileName.c_str(), m_wakeupEvent);
+		m_exitWatcher.start(m_process, &m_logReader, m_wakeupEvent);
+	}
 
 	// Start case list writer.
 	if (hasCaseList)
@@ -252,7 +379,11 @@ void PosixTestProcess::terminate (void)
 	{
 		try
 		{
-			m_process->kill();
+			// \note Exit watcher reaps the process concurrently, kill through it.
+			if (m_exitWatcher.isStarted())
+				m_exitWatcher.killProcess();
+			else
+				m_process->kill();
 		}
 		catch (const std::exception& e)
 		{
@@ -279,7 +410,12 @@ void PosixTestProcess::cleanup (void)
 	{
 		try
 		{
-			if (m_process->isRunning())
+			if (m_exitWatcher.isStarted())
+			{
+				// Exit watcher reaps the process.
+				m_exitWatcher.killProcess();
+			}
+			else if (m_process->isRunning())
 			{
 				m_process->kill();
 				m_process->waitForFinish();
@@ -290,6 +426,8 @@ void PosixTestProcess::cleanup (void)
 			printf("PosixTestProcess::stop(): Failed to kill process: %s\n", e.what());
 		}
 
+		m_exitWatcher.stop();
+
 		delete m_process;
 		m_process = DE_NULL;
 	}
@@ -297,20 +435,44 @@ void PosixTestProcess::cleanup (void)
 
 bool PosixTestProcess::isRunning (void)
 {
-	if (m_process)
+	if (m_exitWatcher.isStarted())
+		return !m_exitWatcher.hasExited();
+	else if (m_process)
 		return m_process->isRunning();
 	else
 		return false;
 }
 
+bool PosixTestProcess::isOutputComplete (void)
+{
+	if (!m_exitWatcher.isStarted() || !m_exitWatcher.hasExited())
+		return false;
+
+	// \note Pipes may be kept open by child processes, in which case completion is never reported.
+	return (!m_process->getStdOut() || m_stdOutReader.isFinished())	&&
+		   (!m_process->getStdErr() || m_stdErrReader.isFinished())	&&
+		   m_logReader.isFinished();
+}
+
 int PosixTestProcess::getExitCode (void) const
 {
-	if (m_process)
+	if (m_exitWatcher.isStarted())
+		return m_exitWatcher.getExitCode();
+	else if (m_process)
 		return m_process->getExitCode();
 	else
 		return -1;
 }
 
+bool PosixTestProcess::setWakeupEvent (WakeupEvent* event)
+{
+	DE_ASSERT(!m_process);
+
+	m_wakeupEvent = (event && posix::FileReader::isEventDriven()) ? event : DE_NULL;
+
+	return isEventDriven();
+}
+
 int PosixTestProcess::readTestLog (deUint8* dst, int numBytes)
 {
 	if (!m_logReader.isRunning())
@@ -328,6 +490,14 @@ int PosixTestProcess::readTestLog (deUint8* dst, int numBytes)
 		// Start reader.
 		m_logReader.start(m_logFileName.c_str());
 	}
+	else if (!m_logReader.isFileOpen())
+	{
+		// Event-driven reader is still waiting for the log file.
+		if (deGetMicroseconds() - m_processStartTime > LOG_FILE_TIMEOUT*1000)
+			terminate();
+
+		return 0;
+	}
 
 	DE_ASSERT(m_logReader.isRunning());
 	return m_logReader.read(dst, numBytes);
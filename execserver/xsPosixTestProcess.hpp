@@ -26,8 +26,10 @@
 #include "xsDefs.hpp"
 #include "xsTestProcess.hpp"
 #include "xsPosixFileReader.hpp"
+#include "xsWakeupEvent.hpp"
 #include "deProcess.hpp"
 #include "deThread.hpp"
+#include "deMutex.hpp"
 
 #include <vector>
 #include <string>
@@ -52,6 +54,7 @@ private:
 	deFile*					m_file;
 	std::vector<char>		m_caseList;
 	bool					m_run;
+	WakeupEvent				m_wakeup;
 };
 
 class PipeReader : public de::Thread
@@ -60,14 +63,46 @@ public:
 							PipeReader			(ThreadedByteBuffer* dst);
 							~PipeReader			(void);
 
-	void					start				(deFile* file);
+	void					start				(deFile* file, WakeupEvent* dataEvent);
 	void					stop				(void);
 
+	//! Check if end of pipe has been reached. Only supported if dataEvent was given.
+	bool					isFinished			(void) const { return m_isFinished; }
+
 	void					run					(void);
 
 private:
 	deFile*					m_file;
 	ThreadedByteBuffer*		m_buf;
+	WakeupEvent*			m_dataEvent;
+	WakeupEvent				m_wakeup;
+	volatile bool			m_isFinished;
+};
+
+//! Waits for process to finish and notifies waiters immediately.
+class ExitWatcher : public de::Thread
+{
+public:
+							ExitWatcher			(void);
+							~ExitWatcher		(void);
+
+	void					start				(de::Process* process, FileReader* logReader, WakeupEvent* exitEvent);
+	void					stop				(void);
+
+	bool					hasExited			(void) const;
+	int						getExitCode			(void) const;
+	void					killProcess			(void);
+
+	void					run					(void);
+
+private:
+	de::Process*			m_process;
+	FileReader*				m_logReader;
+	WakeupEvent*			m_exitEvent;
+
+	mutable de::Mutex		m_lock;				//!< Held while reaping process, so killProcess() never signals a reused pid.
+	bool					m_hasExited;
+	int						m_exitCode;
 };
 
 } // posix
@@ -75,7 +110,7 @@ private:
 class PosixTestProcess : public TestProcess
 {
 public:
-							PosixTestProcess		(void);
+							PosixTestProcess		(const char* logBaseName = "TestResults.qpa");
 	virtual					~PosixTestProcess		(void);
 
 	virtual void			start					(const char* name, const char* params, const char* workingDir, const char* caseList);
@@ -83,26 +118,34 @@ public:
 	virtual void			cleanup					(void);
 
 	virtual bool			isRunning				(void);
+	virtual bool			isOutputComplete		(void);
 
 	virtual int				getExitCode				(void) const;
 
 	virtual int				readTestLog				(deUint8* dst, int numBytes);
 	virtual int				readInfoLog				(deUint8* dst, int numBytes) { return m_infoBuffer.tryRead(numBytes, dst); }
 
+	virtual bool			setWakeupEvent			(WakeupEvent* event);
+
 private:
 							PosixTestProcess		(const PosixTestProcess& other);
 	PosixTestProcess&		operator=				(const PosixTestProcess& other);
 
+	bool					isEventDriven			(void) const { return m_wakeupEvent != DE_NULL; }
+
 	de::Process*			m_process;
 	deUint64				m_processStartTime;		//!< Used for determining log file timeout.
 	std::string				m_logFileName;
+	const std::string		m_logBaseName;			//!< Log file name in working directory.
 	ThreadedByteBuffer		m_infoBuffer;
+	WakeupEvent*			m_wakeupEvent;			//!< Signaled on new data and process exit, or DE_NULL if polled.
 
 	// Threads.
 	posix::CaseListWriter	m_caseListWriter;
 	posix::PipeReader		m_stdOutReader;
 	posix::PipeReader		m_stdErrReader;
 	posix::FileReader		m_logReader;
+	posix::ExitWatcher		m_exitWatcher;
 };
 
 } // xs
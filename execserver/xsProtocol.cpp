@@ -76,6 +76,11 @@ public:
 		m_pos += 1;
 	}
 
+	bool isAtEnd (void) const
+	{
+		return m_pos == m_size;
+	}
+
 	void assumEnd (void)
 	{
 		if (m_pos != m_size)
@@ -92,7 +97,8 @@ class MessageWriter
 {
 public:
 	MessageWriter (MessageType msgType, std::vector<deUint8>& buf)
-		: m_buf(buf)
+		: m_buf			(buf)
+		, m_startPos	(buf.size())
 	{
 		// Place for size.
 		put<int>(0);
@@ -108,11 +114,11 @@ public:
 
 	void finalize (void)
 	{
-		DE_ASSERT(m_buf.size() >= MESSAGE_HEADER_SIZE);
+		DE_ASSERT(m_buf.size() >= m_startPos + MESSAGE_HEADER_SIZE);
 
 		// Write actual size.
-		int size = hostToNetwork((int)m_buf.size());
-		deMemcpy(&m_buf[0], &size, sizeof(int));
+		int size = hostToNetwork((int)(m_buf.size() - m_startPos));
+		deMemcpy(&m_buf[m_startPos], &size, sizeof(int));
 	}
 
 	template <typename T>
@@ -125,7 +131,8 @@ public:
 	}
 
 private:
-	std::vector<deUint8>& m_buf;
+	std::vector<deUint8>&	m_buf;
+	const size_t			m_startPos;
 };
 
 template <>
@@ -164,7 +171,8 @@ HelloMessage::HelloMessage (const deUint8* data, size_t dataSize)
 	: Message(MESSAGETYPE_HELLO)
 {
 	MessageParser parser(data, dataSize);
-	version = parser.get<int>();
+	version	= parser.get<int>();
+	flags	= parser.isAtEnd() ? 0 : parser.get<int>();
 	parser.assumEnd();
 }
 
@@ -172,6 +180,28 @@ void HelloMessage::write (vector<deUint8>& buf) const
 {
 	MessageWriter writer(type, buf);
 	writer.put(version);
+
+	// \note Flags are omitted if not used, older servers don't accept them.
+	if (flags != 0)
+		writer.put(flags);
+}
+
+HelloReplyMessage::HelloReplyMessage (const deUint8* data, size_t dataSize)
+	: Message(MESSAGETYPE_HELLO_REPLY)
+{
+	MessageParser parser(data, dataSize);
+	maxProcesses	= parser.get<int>();
+	supportedFlags	= parser.get<int>();
+	acceptedFlags	= parser.get<int>();
+	parser.assumEnd();
+}
+
+void HelloReplyMessage::write (vector<deUint8>& buf) const
+{
+	MessageWriter writer(type, buf);
+	writer.put(maxProcesses);
+	writer.put(supportedFlags);
+	writer.put(acceptedFlags);
 }
 
 TestMessage::TestMessage (const deUint8* data, size_t dataSize)
@@ -208,6 +238,64 @@ void ExecuteBinaryMessage::write (vector<deUint8>& buf) const
 	writer.put(caseList.c_str());
 }
 
+ExecuteShardMessage::ExecuteShardMessage (const deUint8* data, size_t dataSize)
+	: Message(MESSAGETYPE_EXECUTE_SHARD)
+{
+	MessageParser parser(data, dataSize);
+	shardNdx = parser.get<int>();
+	parser.getString(name);
+	parser.getString(params);
+	parser.getString(workDir);
+	parser.getString(caseList);
+	parser.assumEnd();
+}
+
+void ExecuteShardMessage::write (vector<deUint8>& buf) const
+{
+	MessageWriter writer(type, buf);
+	writer.put(shardNdx);
+	writer.put(name.c_str());
+	writer.put(params.c_str());
+	writer.put(workDir.c_str());
+	writer.put(caseList.c_str());
+}
+
+ShardMessage::ShardMessage (const deUint8* data, size_t dataSize)
+	: Message(MESSAGETYPE_SHARD_MESSAGE)
+{
+	const size_t	wrappedOffset	= SHARD_MESSAGE_HEADER_SIZE - MESSAGE_HEADER_SIZE;
+	size_t			wrappedSize		= 0;
+
+	XS_CHECK_MSG(dataSize >= wrappedOffset, "Invalid payload size");
+	shardNdx = MessageParser(data, wrappedOffset).get<int>();
+
+	Message::parseHeader(data + wrappedOffset, dataSize - wrappedOffset, messageType, wrappedSize);
+	XS_CHECK_MSG(wrappedSize == dataSize - wrappedOffset, "Invalid payload size");
+
+	messageData		= wrappedSize > MESSAGE_HEADER_SIZE ? data + wrappedOffset + MESSAGE_HEADER_SIZE : DE_NULL;
+	messageDataSize	= wrappedSize - MESSAGE_HEADER_SIZE;
+}
+
+void ShardMessage::write (vector<deUint8>& buf) const
+{
+	const size_t curPos = buf.size();
+
+	buf.resize(curPos + SHARD_MESSAGE_HEADER_SIZE + MESSAGE_HEADER_SIZE + messageDataSize);
+	writeHeader(shardNdx, MESSAGE_HEADER_SIZE + messageDataSize, &buf[curPos], SHARD_MESSAGE_HEADER_SIZE);
+	Message::writeHeader(messageType, MESSAGE_HEADER_SIZE + messageDataSize, &buf[curPos + SHARD_MESSAGE_HEADER_SIZE], MESSAGE_HEADER_SIZE);
+
+	if (messageDataSize > 0)
+		deMemcpy(&buf[curPos + SHARD_MESSAGE_HEADER_SIZE + MESSAGE_HEADER_SIZE], messageData, messageDataSize);
+}
+
+void ShardMessage::writeHeader (int shardNdx, size_t messageSize, deUint8* dst, size_t bufSize)
+{
+	XS_CHECK_MSG(bufSize >= SHARD_MESSAGE_HEADER_SIZE, "Incomplete header");
+	int netShardNdx = hostToNetwork(shardNdx);
+	Message::writeHeader(MESSAGETYPE_SHARD_MESSAGE, SHARD_MESSAGE_HEADER_SIZE + messageSize, dst, MESSAGE_HEADER_SIZE);
+	deMemcpy(dst+MESSAGE_HEADER_SIZE, &netShardNdx, sizeof(netShardNdx));
+}
+
 ProcessLogDataMessage::ProcessLogDataMessage (const deUint8* data, size_t dataSize)
 	: Message(MESSAGETYPE_PROCESS_LOG_DATA)
 {
@@ -36,21 +36,30 @@ enum
 {
 	PROTOCOL_VERSION			= 18,
 	MESSAGE_HEADER_SIZE			= 8,
+	SHARD_MESSAGE_HEADER_SIZE	= MESSAGE_HEADER_SIZE + 4,	//!< Header and process slot index preceding wrapped message.
 
 	// Times are in milliseconds.
 	KEEPALIVE_SEND_INTERVAL		= 5000,
 	KEEPALIVE_TIMEOUT			= 30000,
 };
 
+enum HelloFlags
+{
+	HELLO_FLAG_COMPRESSED_LOG_DATA	= (1<<0),	//!< Client accepts COMPRESSED_LOG_DATA in place of PROCESS_LOG_DATA.
+
+	HELLO_FLAGS_SUPPORTED			= HELLO_FLAG_COMPRESSED_LOG_DATA	//!< Flags understood by this ExecServer, listed in HELLO_REPLY.
+};
+
 enum MessageType
 {
 	MESSAGETYPE_NONE					= 0,	//!< Not valid.
 
 	// Commands (from Client to ExecServer).
-	MESSAGETYPE_HELLO					= 100,	//!< First message from client, specifies the protocol version
+	MESSAGETYPE_HELLO					= 100,	//!< First message from client, specifies the protocol version and optional HelloFlags (only if listed in HELLO_REPLY)
 	MESSAGETYPE_TEST					= 101,	//!< Debug only
 	MESSAGETYPE_EXECUTE_BINARY			= 111,	//!< Request execution of a test package binary.
-	MESSAGETYPE_STOP_EXECUTION			= 112,	//!< Request cancellation of the currently executing binary.
+	MESSAGETYPE_STOP_EXECUTION			= 112,	//!< Request cancellation of the currently executing binary (in all process slots).
+	MESSAGETYPE_EXECUTE_SHARD			= 113,	//!< Request execution of a test package binary in given process slot, concurrently with other slots.
 
 	// Responses (from ExecServer to Client)
 	MESSAGETYPE_PROCESS_STARTED			= 200,	//!< Requested process has started.
@@ -58,6 +67,9 @@ enum MessageType
 	MESSAGETYPE_PROCESS_FINISHED		= 202,	//!< Requested process has finished (for any reason).
 	MESSAGETYPE_PROCESS_LOG_DATA		= 203,	//!< Unprocessed log data from TestResults.qpa.
 	MESSAGETYPE_INFO					= 204,	//!< Generic info message from ExecServer (for debugging purposes).
+	MESSAGETYPE_SHARD_MESSAGE			= 205,	//!< Response from a process slot, wraps one of PROCESS_*, COMPRESSED_LOG_DATA or INFO messages.
+	MESSAGETYPE_COMPRESSED_LOG_DATA		= 206,	//!< Log data from TestResults.qpa as next chunk of zlib stream (restarted for each process).
+	MESSAGETYPE_HELLO_REPLY				= 207,	//!< Reply to HELLO, describes optional features of ExecServer and confirms HelloFlags. Older servers don't reply.
 
 	MESSAGETYPE_KEEPALIVE				= 102	//!< Keep-alive packet
 };
@@ -104,14 +116,29 @@ class HelloMessage : public Message
 {
 public:
 	int				version;
+	int				flags;			//!< HelloFlags, omitted from message if 0.
 
 					HelloMessage	(const deUint8* data, size_t dataSize);
-					HelloMessage	(void) : Message(MESSAGETYPE_HELLO), version(PROTOCOL_VERSION) {}
+					HelloMessage	(void) : Message(MESSAGETYPE_HELLO), version(PROTOCOL_VERSION), flags(0) {}
 					~HelloMessage	(void) {}
 
 	void			write			(std::vector<deUint8>& buf) const;
 };
 
+class HelloReplyMessage : public Message
+{
+public:
+	int				maxProcesses;	//!< Number of process slots available for EXECUTE_SHARD.
+	int				supportedFlags;	//!< HelloFlags the server understands.
+	int				acceptedFlags;	//!< HelloFlags of the replied HELLO, in effect from now on.
+
+					HelloReplyMessage	(const deUint8* data, size_t dataSize);
+					HelloReplyMessage	(int maxProcesses_, int supportedFlags_, int acceptedFlags_) : Message(MESSAGETYPE_HELLO_REPLY), maxProcesses(maxProcesses_), supportedFlags(supportedFlags_), acceptedFlags(acceptedFlags_) {}
+					~HelloReplyMessage	(void) {}
+
+	void			write				(std::vector<deUint8>& buf) const;
+};
+
 class ExecuteBinaryMessage : public Message
 {
 public:
@@ -127,6 +154,40 @@ public:
 	void			write			(std::vector<deUint8>& buf) const;
 };
 
+class ExecuteShardMessage : public Message
+{
+public:
+	int				shardNdx;
+	std::string		name;
+	std::string		params;
+	std::string		workDir;
+	std::string		caseList;
+
+					ExecuteShardMessage		(const deUint8* data, size_t dataSize);
+					ExecuteShardMessage		(void) : Message(MESSAGETYPE_EXECUTE_SHARD), shardNdx(0) {}
+					~ExecuteShardMessage	(void) {}
+
+	void			write					(std::vector<deUint8>& buf) const;
+};
+
+// \note Wrapped message data is not copied and must outlive ShardMessage.
+class ShardMessage : public Message
+{
+public:
+	int				shardNdx;
+	MessageType		messageType;
+	const deUint8*	messageData;
+	size_t			messageDataSize;
+
+					ShardMessage		(const deUint8* data, size_t dataSize);
+					~ShardMessage		(void) {}
+
+	void			write				(std::vector<deUint8>& buf) const;
+
+	//! Write SHARD_MESSAGE header for wrapped message of messageSize bytes (including its header).
+	static void		writeHeader			(int shardNdx, size_t messageSize, deUint8* dst, size_t bufSize);
+};
+
 class ProcessLogDataMessage : public Message
 {
 public:
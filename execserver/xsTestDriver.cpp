@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xsTestDriver.hpp"
+#include "xsLogDataCompression.hpp"
 #include "deClock.h"
 
 #include <string>
@@ -42,10 +43,12 @@ namespace xs
 
 TestDriver::TestDriver (xs::TestProcess* testProcess)
 	: m_state				(STATE_NOT_STARTED)
+	, m_shardNdx			(-1)
 	, m_lastExitCode		(0)
 	, m_process				(testProcess)
 	, m_lastProcessDataTime	(0)
-	, m_dataMsgTmpBuf		(SEND_RECV_TMP_BUFFER_SIZE)
+	, m_logDataWindow		(LOG_DATA_WINDOW_MIN)
+	, m_dataMsgTmpBuf		(SHARD_MESSAGE_HEADER_SIZE + MESSAGE_HEADER_SIZE + LogDataCompressor::getMaxCompressedSize(LOG_DATA_WINDOW_MAX))
 {
 }
 
@@ -63,6 +66,18 @@ void TestDriver::reset (void)
 
 void TestDriver::startProcess (const char* name, const char* params, const char* workingDir, const char* caseList)
 {
+	startShard(-1, name, params, workingDir, caseList);
+}
+
+void TestDriver::startShard (int shardNdx, const char* name, const char* params, const char* workingDir, const char* caseList)
+{
+	// \note Responses are wrapped into SHARD_MESSAGEs until next start.
+	m_shardNdx		= shardNdx;
+	m_logDataWindow	= LOG_DATA_WINDOW_MIN;
+
+	if (m_logCompressor)
+		m_logCompressor->reset();
+
 	try
 	{
 		m_process->start(name, params, workingDir, caseList);
@@ -81,6 +96,17 @@ void TestDriver::stopProcess (void)
 	m_process->terminate();
 }
 
+void TestDriver::setLogDataCompression (bool enable)
+{
+	if (enable && !m_logCompressor)
+	{
+		m_logCompressor = de::newMovePtr<LogDataCompressor>();
+		m_logDataTmpBuf.resize(LOG_DATA_WINDOW_MAX);
+	}
+	else if (!enable)
+		m_logCompressor.clear();
+}
+
 bool TestDriver::poll (ByteBuffer& messageBuffer)
 {
 	switch (m_state)
@@ -139,6 +165,9 @@ bool TestDriver::poll (ByteBuffer& messageBuffer)
 			DBG_PRINT(("  STATE_READING_DATA\n"));
 			bool gotProcessData = false;
 
+			// \note Must be checked before reading, otherwise data arriving in between would be lost.
+			const bool outputComplete = m_process->isOutputComplete();
+
 			// Poll log file and info buffer.
 			gotProcessData = pollLogFile(messageBuffer)	|| gotProcessData;
 			gotProcessData = pollInfo(messageBuffer)	|| gotProcessData;
@@ -149,9 +178,9 @@ bool TestDriver::poll (ByteBuffer& messageBuffer)
 				m_lastProcessDataTime = deGetMicroseconds();
 				return true;
 			}
-			else if (deGetMicroseconds() - m_lastProcessDataTime > READ_DATA_TIMEOUT*1000)
+			else if (outputComplete || deGetMicroseconds() - m_lastProcessDataTime > READ_DATA_TIMEOUT*1000)
 			{
-				// Read timeout occurred.
+				// All data read or read timeout occurred.
 				m_state = STATE_PROCESS_FINISHED;
 				return true; // State change.
 			}
@@ -191,35 +220,68 @@ bool TestDriver::pollInfo (ByteBuffer& messageBuffer)
 
 bool TestDriver::pollBuffer (ByteBuffer& messageBuffer, MessageType msgType)
 {
-	const int minBytesAvailable = MESSAGE_HEADER_SIZE + MIN_MSG_PAYLOAD_SIZE;
+	const bool	isLogData			= msgType == MESSAGETYPE_PROCESS_LOG_DATA;
+	const bool	compress			= isLogData && m_logCompressor;
+	const int	headerSize			= m_shardNdx >= 0 ? SHARD_MESSAGE_HEADER_SIZE+MESSAGE_HEADER_SIZE : MESSAGE_HEADER_SIZE;
+	const int	minBytesAvailable	= headerSize + MIN_MSG_PAYLOAD_SIZE;
 
 	if (messageBuffer.getNumFree() < minBytesAvailable)
 		return false; // Not enough space in message buffer.
 
-	const int	maxMsgSize	= de::min((int)m_dataMsgTmpBuf.size(), messageBuffer.getNumFree());
-	int			numRead		= 0;
-	int			msgSize		= MESSAGE_HEADER_SIZE+1; // One byte is reserved for terminating 0.
+	// \note Last byte of uncompressed data is reserved for 0, compressed data must always fit.
+	const int		maxPayloadSize	= de::min((int)m_dataMsgTmpBuf.size(), messageBuffer.getNumFree()) - headerSize;
+	const int		maxReadSize		= compress	? de::min(m_logDataWindow, (int)LogDataCompressor::getMaxSourceSize((size_t)maxPayloadSize))
+									: isLogData	? de::min(m_logDataWindow, maxPayloadSize-1)
+												: maxPayloadSize-1;
+	deUint8* const	readDst			= compress ? &m_logDataTmpBuf[0] : &m_dataMsgTmpBuf[headerSize];
+	int				numRead			= 0;
+	int				msgSize			= 0;
+
+	if (maxReadSize <= 0)
+		return false;
 
-	// Fill in data \note Last byte is reserved for 0.
-	numRead = msgType == MESSAGETYPE_PROCESS_LOG_DATA
-			? m_process->readTestLog(&m_dataMsgTmpBuf[MESSAGE_HEADER_SIZE], maxMsgSize-MESSAGE_HEADER_SIZE-1)
-			: m_process->readInfoLog(&m_dataMsgTmpBuf[MESSAGE_HEADER_SIZE], maxMsgSize-MESSAGE_HEADER_SIZE-1);
+	numRead = isLogData
+			? m_process->readTestLog(readDst, maxReadSize)
+			: m_process->readInfoLog(readDst, maxReadSize);
 
 	if (numRead <= 0)
 		return false; // Didn't get any data.
 
-	msgSize += numRead;
+	if (isLogData)
+	{
+		// Grow window while log has backlog, shrink it back when data is trickling in.
+		if (numRead == m_logDataWindow)
+			m_logDataWindow = de::min(m_logDataWindow*2, (int)LOG_DATA_WINDOW_MAX);
+		else if (numRead < m_logDataWindow/4)
+			m_logDataWindow = de::max(m_logDataWindow/2, (int)LOG_DATA_WINDOW_MIN);
+	}
+
+	if (compress)
+	{
+		msgType	= MESSAGETYPE_COMPRESSED_LOG_DATA;
+		msgSize	= headerSize + (int)m_logCompressor->compress(&m_logDataTmpBuf[0], (size_t)numRead, &m_dataMsgTmpBuf[headerSize], (size_t)maxPayloadSize);
+	}
+	else
+	{
+		msgSize = headerSize + numRead + 1;
 
-	// Terminate with 0.
-	m_dataMsgTmpBuf[msgSize-1] = 0;
+		// Terminate with 0.
+		m_dataMsgTmpBuf[msgSize-1] = 0;
+	}
 
-	// Write header.
-	Message::writeHeader(msgType, msgSize, &m_dataMsgTmpBuf[0], MESSAGE_HEADER_SIZE);
+	// Write header(s).
+	if (m_shardNdx >= 0)
+	{
+		ShardMessage::writeHeader(m_shardNdx, msgSize-SHARD_MESSAGE_HEADER_SIZE, &m_dataMsgTmpBuf[0], SHARD_MESSAGE_HEADER_SIZE);
+		Message::writeHeader(msgType, msgSize-SHARD_MESSAGE_HEADER_SIZE, &m_dataMsgTmpBuf[SHARD_MESSAGE_HEADER_SIZE], MESSAGE_HEADER_SIZE);
+	}
+	else
+		Message::writeHeader(msgType, msgSize, &m_dataMsgTmpBuf[0], MESSAGE_HEADER_SIZE);
 
 	// Write to messagebuffer.
 	messageBuffer.pushFront(&m_dataMsgTmpBuf[0], msgSize);
 
-	DBG_PRINT(("  wrote %d bytes of %s data\n", msgSize, msgType == MESSAGETYPE_INFO ? "info" : "log"));
+	DBG_PRINT(("  wrote %d bytes of %s data\n", msgSize, isLogData ? "log" : "info"));
 
 	return true;
 }
@@ -227,8 +289,15 @@ bool TestDriver::pollBuffer (ByteBuffer& messageBuffer, MessageType msgType)
 bool TestDriver::writeMessage (ByteBuffer& messageBuffer, const Message& message)
 {
 	vector<deUint8> buf;
+
+	if (m_shardNdx >= 0)
+		buf.resize(SHARD_MESSAGE_HEADER_SIZE);
+
 	message.write(buf);
 
+	if (m_shardNdx >= 0)
+		ShardMessage::writeHeader(m_shardNdx, buf.size()-SHARD_MESSAGE_HEADER_SIZE, &buf[0], SHARD_MESSAGE_HEADER_SIZE);
+
 	if (messageBuffer.getNumFree() < (int)buf.size())
 		return false;
 
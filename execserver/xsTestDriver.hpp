@@ -26,12 +26,15 @@
 #include "xsDefs.hpp"
 #include "xsProtocol.hpp"
 #include "xsTestProcess.hpp"
+#include "deUniquePtr.hpp"
 
 #include <vector>
 
 namespace xs
 {
 
+class LogDataCompressor;
+
 class TestDriver
 {
 public:
@@ -41,10 +44,15 @@ public:
 	void					reset				(void);
 
 	void					startProcess		(const char* name, const char* params, const char* workingDir, const char* caseList);
+	void					startShard			(int shardNdx, const char* name, const char* params, const char* workingDir, const char* caseList);
 	void					stopProcess			(void);
 
+	void					setLogDataCompression	(bool enable);
+
 	bool					poll				(ByteBuffer& messageBuffer);
 
+	bool					setWakeupEvent		(WakeupEvent* event) { return m_process->setWakeupEvent(event); }
+
 private:
 	enum State
 	{
@@ -65,6 +73,7 @@ private:
 	bool					writeMessage		(ByteBuffer& messageBuffer, const Message& message);
 
 	State					m_state;
+	int						m_shardNdx;			//!< Process slot messages are wrapped for, or -1 if not executing a shard.
 
 	std::string				m_lastLaunchFailure;
 	int						m_lastExitCode;
@@ -72,7 +81,11 @@ private:
 	xs::TestProcess*		m_process;
 	deUint64				m_lastProcessDataTime;
 
+	de::MovePtr<LogDataCompressor>	m_logCompressor;	//!< Set if client requested compressed log data.
+	int						m_logDataWindow;	//!< Max amount of log data to read into next message, adapts to log backlog.
+
 	std::vector<deUint8>	m_dataMsgTmpBuf;
+	std::vector<deUint8>	m_logDataTmpBuf;	//!< Uncompressed log data.
 };
 
 } // xs
@@ -24,6 +24,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xsDefs.hpp"
+#include "xsWakeupEvent.hpp"
 
 #include <stdexcept>
 
@@ -51,6 +52,11 @@ public:
 	virtual int				readTestLog				(deUint8* dst, int numBytes)	= DE_NULL;
 	virtual int				readInfoLog				(deUint8* dst, int numBytes)	= DE_NULL;
 
+	//! Set event to signal when data is available or process exits. Returns false if not supported, in which case process must be polled.
+	virtual bool			setWakeupEvent			(WakeupEvent* event)			{ DE_UNREF(event); return false;	}
+	//! Check if process has exited and all of its output has been read. Processes that don't support this are drained with timeout.
+	virtual bool			isOutputComplete		(void)							{ return false;						}
+
 protected:
 							TestProcess				(void) {}
 };
@@ -0,0 +1,151 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Wake-up event for event-driven IO.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsWakeupEvent.hpp"
+#include "deThread.h"
+
+#if (DE_OS == DE_OS_UNIX) || (DE_OS == DE_OS_OSX) || (DE_OS == DE_OS_ANDROID) || (DE_OS == DE_OS_QNX)
+#	define XS_USE_POLL 1
+#endif
+
+#if defined(XS_USE_POLL)
+#	include <poll.h>
+#	include <unistd.h>
+#	include <fcntl.h>
+#	include <errno.h>
+#endif
+
+namespace xs
+{
+
+#if defined(XS_USE_POLL)
+
+static bool setPipeFlags (int fd)
+{
+	return fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) == 0 &&
+		   fcntl(fd, F_SETFD, fcntl(fd, F_GETFD, 0) | FD_CLOEXEC) == 0;
+}
+
+WakeupEvent::WakeupEvent (void)
+{
+	if (pipe(m_pipe) != 0)
+		XS_FAIL("Failed to create wake-up pipe");
+
+	if (!setPipeFlags(m_pipe[0]) || !setPipeFlags(m_pipe[1]))
+	{
+		close(m_pipe[0]);
+		close(m_pipe[1]);
+		XS_FAIL("Failed to set wake-up pipe flags");
+	}
+}
+
+WakeupEvent::~WakeupEvent (void)
+{
+	close(m_pipe[0]);
+	close(m_pipe[1]);
+}
+
+bool WakeupEvent::isSupported (void)
+{
+	return true;
+}
+
+void WakeupEvent::signal (void)
+{
+	const deUint8	value	= 0;
+	const ssize_t	result	= write(m_pipe[1], &value, sizeof(value));
+
+	// \note Pipe being full (EAGAIN) means that event is already signaled.
+	DE_UNREF(result);
+}
+
+bool WakeupEvent::wait (int fd, deUint32 flags, int timeoutMs)
+{
+	struct pollfd	fds[2];
+	int				numFds	= 1;
+	int				result	= 0;
+
+	fds[0].fd		= m_pipe[0];
+	fds[0].events	= POLLIN;
+	fds[0].revents	= 0;
+
+	if (fd >= 0)
+	{
+		fds[1].fd		= fd;
+		fds[1].events	= (short)(((flags & WAITFLAG_READ) ? POLLIN : 0) | ((flags & WAITFLAG_WRITE) ? POLLOUT : 0));
+		fds[1].revents	= 0;
+		numFds			= 2;
+	}
+
+	do
+	{
+		result = poll(&fds[0], (nfds_t)numFds, timeoutMs);
+	} while (result < 0 && errno == EINTR);
+
+	if (result < 0)
+		XS_FAIL("poll() failed");
+
+	if (fds[0].revents & POLLIN)
+	{
+		// Consume all pending signals.
+		deUint8 buf[64];
+		while (read(m_pipe[0], &buf[0], sizeof(buf)) > 0);
+	}
+
+	return numFds > 1 && fds[1].revents != 0;
+}
+
+#else // !XS_USE_POLL
+
+WakeupEvent::WakeupEvent (void)
+{
+	m_pipe[0] = -1;
+	m_pipe[1] = -1;
+}
+
+WakeupEvent::~WakeupEvent (void)
+{
+}
+
+bool WakeupEvent::isSupported (void)
+{
+	return false;
+}
+
+void WakeupEvent::signal (void)
+{
+}
+
+bool WakeupEvent::wait (int fd, deUint32 flags, int timeoutMs)
+{
+	DE_UNREF(fd);
+	DE_UNREF(flags);
+	DE_ASSERT(timeoutMs >= 0);
+
+	deSleep((deUint32)timeoutMs);
+	return false;
+}
+
+#endif // XS_USE_POLL
+
+} // xs
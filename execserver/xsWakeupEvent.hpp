@@ -0,0 +1,69 @@
+#ifndef _XSWAKEUPEVENT_HPP
+#define _XSWAKEUPEVENT_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Wake-up event for event-driven IO.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsDefs.hpp"
+
+namespace xs
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Event that can be waited on together with a file descriptor
+ *
+ * signal() can be called from any thread and causes the current or next
+ * wait() to return. Signals are not counted; multiple signals before
+ * wait() wake it up only once. Only one thread may wait on the event.
+ *
+ * Event-driven waiting is available only if isSupported() returns true.
+ * Otherwise wait() simply sleeps and callers should use polling instead.
+ *//*--------------------------------------------------------------------*/
+class WakeupEvent
+{
+public:
+	enum WaitFlags
+	{
+		WAITFLAG_READ	= (1<<0),	//!< Wait until descriptor is readable
+		WAITFLAG_WRITE	= (1<<1)	//!< Wait until descriptor is writable
+	};
+
+							WakeupEvent		(void);
+							~WakeupEvent	(void);
+
+	static bool				isSupported		(void);
+
+	void					signal			(void);
+
+	//! Wait until fd is ready, event is signaled or timeout (-1 for none) expires. Returns true if fd is ready.
+	bool					wait			(int fd, deUint32 flags, int timeoutMs);
+
+private:
+							WakeupEvent		(const WakeupEvent& other);
+	WakeupEvent&			operator=		(const WakeupEvent& other);
+
+	int						m_pipe[2];		//!< Self-pipe, signal() writes to m_pipe[1]
+};
+
+} // xs
+
+#endif // _XSWAKEUPEVENT_HPP
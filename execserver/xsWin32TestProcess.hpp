@@ -179,7 +179,7 @@ private:
 class Win32TestProcess : public TestProcess
 {
 public:
-							Win32TestProcess		(void);
+							Win32TestProcess		(const char* logBaseName = "TestResults.qpa");
 	virtual					~Win32TestProcess		(void);
 
 	virtual void			start					(const char* name, const char* params, const char* workingDir, const char* caseList);
@@ -199,6 +199,7 @@ private:
 	win32::Process*			m_process;
 	deUint64				m_processStartTime;
 	std::string				m_logFileName;
+	const std::string		m_logBaseName;			//!< Log file name in working directory.
 
 	ThreadedByteBuffer		m_infoBuffer;
 
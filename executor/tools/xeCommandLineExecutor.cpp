@@ -74,6 +74,8 @@ DE_DECLARE_COMMAND_LINE_OPT(Summary,		bool);
 DE_DECLARE_COMMAND_LINE_OPT(BinaryName,		string);
 DE_DECLARE_COMMAND_LINE_OPT(WorkingDir,		string);
 DE_DECLARE_COMMAND_LINE_OPT(CmdLineArgs,	string);
+DE_DECLARE_COMMAND_LINE_OPT(NumProcesses,	int);
+DE_DECLARE_COMMAND_LINE_OPT(CompressLog,	bool);
 
 void parseCommaSeparatedList (const char* src, vector<string>* dst)
 {
@@ -107,7 +109,9 @@ void registerOptions (de::cmdline::Parser& parser)
 		   << Option<Summary>		(DE_NULL,	"summary",		"Print summary after running tests.",									s_yesNo, "yes")
 		   << Option<BinaryName>	("b",		"binaryname",	"Test binary path. Relative to working directory.",						"<Unused>")
 		   << Option<WorkingDir>	("wd",		"workdir",		"Working directory for the test execution.",							".")
-		   << Option<CmdLineArgs>	(DE_NULL,	"cmdline",		"Additional command line arguments for the test binary.",				"");
+		   << Option<CmdLineArgs>	(DE_NULL,	"cmdline",		"Additional command line arguments for the test binary.",				"")
+		   << Option<NumProcesses>	("j",		"processes",	"Number of concurrently executing test processes.",						"1")
+		   << Option<CompressLog>	(DE_NULL,	"compress-log",	"Request compressed test log data. Only with --connect, ignored by older execservers.",		s_yesNo, "no");
 }
 
 } // opt
@@ -121,8 +125,9 @@ enum RunMode
 struct CommandLine
 {
 	CommandLine (void)
-		: port		(0)
-		, summary	(false)
+		: port			(0)
+		, summary		(false)
+		, compressLog	(false)
 	{
 	}
 
@@ -137,6 +142,7 @@ struct CommandLine
 	string					outFile;
 	string					infoFile;
 	bool					summary;
+	bool					compressLog;
 };
 
 bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
@@ -201,55 +207,19 @@ bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
 	cmdLine.outFile					= opts.getOption<opt::TestLogFile>();
 	cmdLine.infoFile				= opts.getOption<opt::InfoLogFile>();
 	cmdLine.summary					= opts.getOption<opt::Summary>();
+	cmdLine.compressLog				= opts.getOption<opt::CompressLog>();
 	cmdLine.targetCfg.binaryName	= opts.getOption<opt::BinaryName>();
 	cmdLine.targetCfg.workingDir	= opts.getOption<opt::WorkingDir>();
 	cmdLine.targetCfg.cmdLineArgs	= opts.getOption<opt::CmdLineArgs>();
+	cmdLine.targetCfg.numProcesses	= opts.getOption<opt::NumProcesses>();
 
-	return true;
-}
-
-bool checkCasePathPatternMatch (const char* pattern, const char* casePath, bool isTestGroup)
-{
-	int ptrnPos = 0;
-	int casePos = 0;
-
-	for (;;)
+	if (cmdLine.targetCfg.numProcesses < 1)
 	{
-		char c = casePath[casePos];
-		char p = pattern[ptrnPos];
-
-		if (p == '*')
-		{
-			/* Recurse to rest of positions. */
-			int next = casePos;
-			for (;;)
-			{
-				if (checkCasePathPatternMatch(pattern+ptrnPos+1, casePath+next, isTestGroup))
-					return DE_TRUE;
-
-				if (casePath[next] == 0)
-					return DE_FALSE; /* No match found. */
-				else
-					next += 1;
-			}
-			DE_ASSERT(DE_FALSE);
-		}
-		else if (c == 0 && p == 0)
-			return true;
-		else if (c == 0)
-		{
-			/* Incomplete match is ok for test groups. */
-			return isTestGroup;
-		}
-		else if (c != p)
-			return false;
-
-		casePos += 1;
-		ptrnPos += 1;
+		std::cout << "Invalid command line arguments. --processes must be at least 1." << std::endl;
+		return false;
 	}
 
-	DE_ASSERT(false);
-	return false;
+	return true;
 }
 
 void readCaseList (xe::TestGroup* root, const char* filename)
@@ -310,7 +280,7 @@ void addMatchingCases (const xe::TestGroup& group, xe::TestSet& testSet, const c
 		const bool			isGroup		= child->getNodeType() == xe::TESTNODETYPE_GROUP;
 		const string		fullPath	= child->getFullPath();
 
-		if (checkCasePathPatternMatch(filter, fullPath.c_str(), isGroup))
+		if (xe::checkCasePathPatternMatch(filter, fullPath.c_str(), isGroup))
 		{
 			if (isGroup)
 			{
@@ -334,7 +304,7 @@ void removeMatchingCases (const xe::TestGroup& group, xe::TestSet& testSet, cons
 		const bool			isGroup		= child->getNodeType() == xe::TESTNODETYPE_GROUP;
 		const string		fullPath	= child->getFullPath();
 
-		if (checkCasePathPatternMatch(filter, fullPath.c_str(), isGroup))
+		if (xe::checkCasePathPatternMatch(filter, fullPath.c_str(), isGroup))
 		{
 			if (isGroup)
 			{
@@ -463,7 +433,7 @@ xe::CommLink* createCommLink (const CommandLine& cmdLine)
 		xe::LocalTcpIpLink* link = new xe::LocalTcpIpLink();
 		try
 		{
-			link->start(cmdLine.serverBinOrAddress.c_str(), DE_NULL, cmdLine.port);
+			link->start(cmdLine.serverBinOrAddress.c_str(), DE_NULL, cmdLine.port, cmdLine.targetCfg.numProcesses);
 			return link;
 		}
 		catch (...)
@@ -486,7 +456,7 @@ xe::CommLink* createCommLink (const CommandLine& cmdLine)
 		{
 			std::string error;
 
-			link->connect(address);
+			link->connect(address, cmdLine.compressLog);
 			return link;
 		}
 		catch (const std::exception& error)
@@ -159,7 +159,7 @@ public:
 			xe::TestResultParser::ParseResult	parseResult;
 
 			m_testResultParser.init(&fullResult);
-			parseResult = m_testResultParser.parse(caseData->getData(), caseData->getDataSize());
+			parseResult = m_testResultParser.parseDocument(caseData->getData(), caseData->getDataSize());
 			DE_UNREF(parseResult);
 
 			extractShaderPrograms(m_cmdLine, caseData->getTestCasePath(), fullResult);
@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xeTestLogParser.hpp"
+#include "xeTestLogIndex.hpp"
 #include "xeTestResultParser.hpp"
 #include "deFilePath.hpp"
 #include "deString.h"
@@ -48,6 +49,7 @@ struct CommandLine
 
 	string			filename;
 	vector<string>	tagNames;
+	vector<string>	casePatterns;
 	bool			statusCode;
 };
 
@@ -123,11 +125,26 @@ static Value findValueByTag (const xe::ri::List& items, const string& tagName)
 	return Value();
 }
 
+static bool matchesAnyPattern (const vector<string>& patterns, const char* casePath)
+{
+	if (patterns.empty())
+		return true;
+
+	for (vector<string>::const_iterator pattern = patterns.begin(); pattern != patterns.end(); ++pattern)
+	{
+		if (xe::checkCasePathPatternMatch(pattern->c_str(), casePath, false))
+			return true;
+	}
+
+	return false;
+}
+
 class TagParser : public xe::TestLogHandler
 {
 public:
-	TagParser (BatchResultValues& result)
-		: m_result(result)
+	TagParser (BatchResultValues& result, const vector<string>& casePatterns)
+		: m_result			(result)
+		, m_casePatterns	(casePatterns)
 	{
 	}
 
@@ -151,6 +168,9 @@ public:
 		const vector<string>&	tagNames	= m_result.getTagNames();
 		CaseValues				tagResult;
 
+		if (!matchesAnyPattern(m_casePatterns, caseData->getTestCasePath()))
+			return;
+
 		tagResult.casePath		= caseData->getTestCasePath();
 		tagResult.caseType		= xe::TESTCASETYPE_SELF_VALIDATE;
 		tagResult.statusCode	= caseData->getStatusCode();
@@ -163,7 +183,7 @@ public:
 			xe::TestResultParser::ParseResult	parseResult;
 
 			m_testResultParser.init(&fullResult);
-			parseResult = m_testResultParser.parse(caseData->getData(), caseData->getDataSize());
+			parseResult = m_testResultParser.parseDocument(caseData->getData(), caseData->getDataSize());
 
 			if ((parseResult != xe::TestResultParser::PARSERESULT_ERROR && fullResult.statusCode != xe::TESTSTATUSCODE_LAST) ||
 				(tagResult.statusCode == xe::TESTSTATUSCODE_LAST && fullResult.statusCode != xe::TESTSTATUSCODE_LAST))
@@ -190,13 +210,45 @@ public:
 
 private:
 	BatchResultValues&		m_result;
+	const vector<string>&	m_casePatterns;
 	xe::TestResultParser	m_testResultParser;
 };
 
-static void readLogFile (BatchResultValues& batchResult, const char* filename)
+// Read only matching cases using case index.
+static void readIndexedLogFile (BatchResultValues& batchResult, const char* filename, const xe::TestLogIndex& index, const vector<string>& casePatterns)
+{
+	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
+	TagParser			resultHandler	(batchResult, casePatterns);
+
+	if (!in.good())
+		throw std::runtime_error(string("Failed to open '") + filename + "'");
+
+	for (int entryNdx = 0; entryNdx < index.getNumEntries(); entryNdx++)
+	{
+		const xe::TestLogIndexEntry& entry = index.getEntry(entryNdx);
+
+		if (matchesAnyPattern(casePatterns, entry.casePath.c_str()))
+		{
+			xe::TestCaseResultPtr caseData (new xe::TestCaseResultData(entry.casePath.c_str()));
+
+			xe::readTestCaseResult(in, entry, *caseData);
+			resultHandler.testCaseResultComplete(caseData);
+		}
+	}
+}
+
+static void readLogFile (BatchResultValues& batchResult, const char* filename, const vector<string>& casePatterns)
 {
+	xe::TestLogIndex	index;
+
+	if (xe::readTestLogIndex(index, filename))
+	{
+		readIndexedLogFile(batchResult, filename, index, casePatterns);
+		return;
+	}
+
 	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
-	TagParser			resultHandler	(batchResult);
+	TagParser			resultHandler	(batchResult, casePatterns);
 	xe::TestLogParser	parser			(&resultHandler);
 	deUint8				buf				[1024];
 	int					numRead			= 0;
@@ -222,7 +274,7 @@ static void printTaggedValues (const CommandLine& cmdLine, std::ostream& dst)
 {
 	BatchResultValues values(cmdLine.tagNames);
 
-	readLogFile(values, cmdLine.filename.c_str());
+	readLogFile(values, cmdLine.filename.c_str(), cmdLine.casePatterns);
 
 	// Header
 	{
@@ -255,6 +307,7 @@ static void printHelp (const char* binName)
 {
 	printf("%s: [filename] [name 1] [[name 2]...]\n", binName);
 	printf(" --statuscode     Include status code as first entry.\n");
+	printf(" --case=[pattern] Only include cases matching pattern. Can be given multiple times.\n");
 }
 
 static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
@@ -265,6 +318,8 @@ static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const*
 
 		if (deStringEqual(arg, "--statuscode"))
 			cmdLine.statusCode = true;
+		else if (deStringBeginsWith(arg, "--case="))
+			cmdLine.casePatterns.push_back(arg+7);
 		else if (!deStringBeginsWith(arg, "--"))
 		{
 			if (cmdLine.filename.empty())
@@ -20,10 +20,12 @@
  * \file
  * \brief Merge two test logs.
  *
- * \todo [2013-11-08 pyry] Write variant that can operate with less memory.
+ * \note Logs that have a case index are merged by copying case data
+ *       directly, without loading whole logs into memory.
  *//*--------------------------------------------------------------------*/
 
 #include "xeTestLogParser.hpp"
+#include "xeTestLogIndex.hpp"
 #include "xeTestResultParser.hpp"
 #include "xeTestLogWriter.hpp"
 #include "deString.h"
@@ -34,6 +36,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 using std::vector;
@@ -120,33 +123,187 @@ private:
 	const deUint32			m_flags;
 };
 
-static void readLogFile (xe::BatchResult* dstResult, const char* filename, deUint32 flags)
+static void readLogFile (xe::BatchResult* dstResult, const char* filename, deUint32 flags, deUint64 maxSize = ~(deUint64)0)
 {
 	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
 	LogHandler			resultHandler	(dstResult, flags);
 	xe::TestLogParser	parser			(&resultHandler);
 	deUint8				buf				[2048];
+	deUint64			numLeft			= maxSize;
 	int					numRead			= 0;
 
 	if (!in.good())
 		throw std::runtime_error(string("Failed to open '") + filename + "'");
 
-	for (;;)
+	while (numLeft > 0)
 	{
-		in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
+		in.read((char*)&buf[0], (std::streamsize)de::min<deUint64>(DE_LENGTH_OF_ARRAY(buf), numLeft));
 		numRead = (int)in.gcount();
 
 		if (numRead <= 0)
 			break;
 
 		parser.parse(&buf[0], numRead);
+		numLeft -= (deUint64)numRead;
 	}
 
 	in.close();
 }
 
+static void copyLogData (std::istream& src, deUint64 offset, deUint64 size, std::ostream& dst)
+{
+	deUint8 buf[16*1024];
+
+	src.clear();
+	src.seekg((std::streamoff)offset);
+
+	while (size > 0)
+	{
+		const std::streamsize numToCopy = (std::streamsize)de::min<deUint64>(DE_LENGTH_OF_ARRAY(buf), size);
+
+		src.read((char*)&buf[0], numToCopy);
+
+		if (src.gcount() != numToCopy)
+			throw std::runtime_error("Failed to read test log data");
+
+		dst.write((const char*)&buf[0], numToCopy);
+		size -= (deUint64)numToCopy;
+	}
+}
+
+struct MergedCase
+{
+	MergedCase (int srcNdx_, const xe::TestLogIndexEntry& entry_) : srcNdx(srcNdx_), entry(entry_) {}
+
+	int						srcNdx;
+	xe::TestLogIndexEntry	entry;
+};
+
+static void mergeIndexedTestLogs (const CommandLine& cmdLine, const vector<xe::TestLogIndex>& srcIndices, std::ostream& dst)
+{
+	xe::BatchResult				sessionResult;
+	vector<MergedCase>			cases;
+	map<string, int>			caseMap;
+	xe::TestLogIndex			dstIndex;
+	deUint64					dstOffset		= 0;
+
+	// Session info is in log header, before first case.
+	for (int srcNdx = 0; srcNdx < (int)srcIndices.size(); srcNdx++)
+	{
+		const xe::TestLogIndex&	index		= srcIndices[srcNdx];
+		deUint64				headerSize	= index.getLogSize();
+
+		for (int entryNdx = 0; entryNdx < index.getNumEntries(); entryNdx++)
+			headerSize = de::min(headerSize, index.getEntry(entryNdx).offset);
+
+		readLogFile(&sessionResult, cmdLine.srcFilenames[srcNdx].c_str(), cmdLine.flags, headerSize);
+	}
+
+	// Later results replace earlier ones, but keep position of first result.
+	for (int srcNdx = 0; srcNdx < (int)srcIndices.size(); srcNdx++)
+	{
+		const xe::TestLogIndex& index = srcIndices[srcNdx];
+
+		for (int entryNdx = 0; entryNdx < index.getNumEntries(); entryNdx++)
+		{
+			const xe::TestLogIndexEntry&			entry	= index.getEntry(entryNdx);
+			const map<string, int>::const_iterator	pos		= caseMap.find(entry.casePath);
+
+			if (pos != caseMap.end())
+				cases[pos->second] = MergedCase(srcNdx, entry);
+			else
+			{
+				caseMap[entry.casePath] = (int)cases.size();
+				cases.push_back(MergedCase(srcNdx, entry));
+			}
+		}
+	}
+
+	{
+		std::ostringstream header;
+
+		xe::writeSessionInfo(sessionResult.getSessionInfo(), header);
+		header << "#beginSession\n";
+
+		dst << header.str();
+		dstOffset += (deUint64)header.str().size();
+	}
+
+	{
+		vector<std::ifstream*> srcFiles (srcIndices.size(), DE_NULL);
+
+		try
+		{
+			for (int srcNdx = 0; srcNdx < (int)srcFiles.size(); srcNdx++)
+			{
+				srcFiles[srcNdx] = new std::ifstream(cmdLine.srcFilenames[srcNdx].c_str(), std::ifstream::binary|std::ifstream::in);
+
+				if (!srcFiles[srcNdx]->good())
+					throw std::runtime_error(string("Failed to open '") + cmdLine.srcFilenames[srcNdx] + "'");
+			}
+
+			for (vector<MergedCase>::const_iterator mergedCase = cases.begin(); mergedCase != cases.end(); ++mergedCase)
+			{
+				xe::TestLogIndexEntry dstEntry = mergedCase->entry;
+
+				copyLogData(*srcFiles[mergedCase->srcNdx], mergedCase->entry.offset, mergedCase->entry.size, dst);
+
+				dstEntry.offset	 = dstOffset;
+				dstOffset		+= mergedCase->entry.size;
+				dstIndex.addEntry(dstEntry);
+			}
+		}
+		catch (...)
+		{
+			for (vector<std::ifstream*>::iterator srcFile = srcFiles.begin(); srcFile != srcFiles.end(); ++srcFile)
+				delete *srcFile;
+			throw;
+		}
+
+		for (vector<std::ifstream*>::iterator srcFile = srcFiles.begin(); srcFile != srcFiles.end(); ++srcFile)
+			delete *srcFile;
+	}
+
+	{
+		const string endSession = "\n#endSession\n";
+
+		dst << endSession;
+		dstOffset += (deUint64)endSession.size();
+	}
+
+	dst.flush();
+
+	if (!dst.good())
+		throw std::runtime_error("Failed to write merged test log");
+
+	if (!cmdLine.dstFilename.empty())
+	{
+		dstIndex.setLogSize(dstOffset);
+		xe::writeTestLogIndex(dstIndex, cmdLine.dstFilename.c_str());
+	}
+}
+
 static void mergeTestLogs (const CommandLine& cmdLine)
 {
+	vector<xe::TestLogIndex>	srcIndices	(cmdLine.srcFilenames.size());
+	bool						allIndexed	= true;
+
+	for (int srcNdx = 0; srcNdx < (int)cmdLine.srcFilenames.size() && allIndexed; srcNdx++)
+		allIndexed = xe::readTestLogIndex(srcIndices[srcNdx], cmdLine.srcFilenames[srcNdx].c_str());
+
+	if (allIndexed)
+	{
+		if (!cmdLine.dstFilename.empty())
+		{
+			std::ofstream out (cmdLine.dstFilename.c_str(), std::ofstream::binary|std::ofstream::trunc);
+			mergeIndexedTestLogs(cmdLine, srcIndices, out);
+		}
+		else
+			mergeIndexedTestLogs(cmdLine, srcIndices, std::cout);
+
+		return;
+	}
+
 	xe::BatchResult batchResult;
 
 	for (vector<string>::const_iterator filename = cmdLine.srcFilenames.begin(); filename != cmdLine.srcFilenames.end(); ++filename)
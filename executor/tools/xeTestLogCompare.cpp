@@ -22,10 +22,12 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xeTestLogParser.hpp"
+#include "xeTestLogIndex.hpp"
 #include "xeTestResultParser.hpp"
 #include "deFilePath.hpp"
 #include "deString.h"
 #include "deThread.hpp"
+#include "deThreadSafeRingBuffer.hpp"
 #include "deCommandLine.hpp"
 
 #include <vector>
@@ -34,12 +36,11 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
-#include <set>
+#include <deque>
 #include <map>
 
 using std::vector;
 using std::string;
-using std::set;
 using std::map;
 
 enum OutputMode
@@ -118,15 +119,28 @@ struct CommandLine
 
 struct ShortBatchResult
 {
-	vector<xe::TestCaseResultHeader>	resultHeaders;
-	map<string, int>					resultMap;
+	// \note Deque, since parser threads fill in results while reader appends new ones.
+	std::deque<xe::TestCaseResultHeader>	resultHeaders;
 };
 
+//! Test case result data to be parsed into result header. Job with null dst terminates parser thread.
+struct ParseJob
+{
+								ParseJob	(void) : dst(DE_NULL) {}
+								ParseJob	(xe::TestCaseResultHeader* dst_, const xe::TestCaseResultPtr& caseData_) : dst(dst_), caseData(caseData_) {}
+
+	xe::TestCaseResultHeader*	dst;
+	xe::TestCaseResultPtr		caseData;
+};
+
+typedef de::ThreadSafeRingBuffer<ParseJob> ParseJobQueue;
+
 class ShortResultHandler : public xe::TestLogHandler
 {
 public:
-	ShortResultHandler (ShortBatchResult& result)
-		: m_result(result)
+	ShortResultHandler (ShortBatchResult& result, ParseJobQueue& parseQueue)
+		: m_result		(result)
+		, m_parseQueue	(parseQueue)
 	{
 	}
 
@@ -147,39 +161,31 @@ public:
 
 	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
 	{
-		xe::TestCaseResultHeader	header;
-		int							caseNdx	= (int)m_result.resultHeaders.size();
+		xe::TestCaseResultHeader header;
 
 		header.casePath			= caseData->getTestCasePath();
 		header.caseType			= xe::TESTCASETYPE_SELF_VALIDATE;
 		header.statusCode		= caseData->getStatusCode();
 		header.statusDetails	= caseData->getStatusDetails();
 
-		if (header.statusCode == xe::TESTSTATUSCODE_LAST)
-		{
-			xe::TestCaseResult fullResult;
-
-			xe::parseTestCaseResultFromData(&m_testResultParser, &fullResult, *caseData.get());
-
-			header = xe::TestCaseResultHeader(fullResult);
-		}
-
-		// Insert into result list & map.
 		m_result.resultHeaders.push_back(header);
-		m_result.resultMap[header.casePath] = caseNdx;
+
+		// Status is in result data, leave parsing to parser threads.
+		if (header.statusCode == xe::TESTSTATUSCODE_LAST)
+			m_parseQueue.pushFront(ParseJob(&m_result.resultHeaders.back(), caseData));
 	}
 
 private:
 	ShortBatchResult&		m_result;
-	xe::TestResultParser	m_testResultParser;
+	ParseJobQueue&			m_parseQueue;
 };
 
-static void readLogFile (ShortBatchResult& batchResult, const char* filename)
+static void readLogFile (ShortBatchResult& batchResult, ParseJobQueue& parseQueue, const char* filename)
 {
 	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
-	ShortResultHandler	resultHandler	(batchResult);
+	ShortResultHandler	resultHandler	(batchResult, parseQueue);
 	xe::TestLogParser	parser			(&resultHandler);
-	deUint8				buf				[1024];
+	deUint8				buf				[16*1024];
 	int					numRead			= 0;
 
 	for (;;)
@@ -196,61 +202,115 @@ static void readLogFile (ShortBatchResult& batchResult, const char* filename)
 	in.close();
 }
 
+static void readLogIndex (ShortBatchResult& batchResult, const xe::TestLogIndex& index)
+{
+	for (int entryNdx = 0; entryNdx < index.getNumEntries(); entryNdx++)
+	{
+		const xe::TestLogIndexEntry&	entry	= index.getEntry(entryNdx);
+		xe::TestCaseResultHeader		header;
+
+		header.casePath		= entry.casePath;
+		header.caseType		= xe::TESTCASETYPE_SELF_VALIDATE;
+		header.statusCode	= entry.statusCode;
+
+		batchResult.resultHeaders.push_back(header);
+	}
+}
+
 class LogFileReader : public de::Thread
 {
 public:
-	LogFileReader (ShortBatchResult& batchResult, const char* filename)
+	LogFileReader (ShortBatchResult& batchResult, ParseJobQueue& parseQueue, const char* filename, bool useIndex)
 		: m_batchResult	(batchResult)
+		, m_parseQueue	(parseQueue)
 		, m_filename	(filename)
+		, m_useIndex	(useIndex)
 	{
 	}
 
 	void run (void)
 	{
-		readLogFile(m_batchResult, m_filename.c_str());
+		xe::TestLogIndex index;
+
+		// Status codes can be taken directly from case index.
+		if (m_useIndex && xe::readTestLogIndex(index, m_filename.c_str()))
+			readLogIndex(m_batchResult, index);
+		else
+			readLogFile(m_batchResult, m_parseQueue, m_filename.c_str());
 	}
 
 private:
 	ShortBatchResult&	m_batchResult;
+	ParseJobQueue&		m_parseQueue;
 	std::string			m_filename;
+	bool				m_useIndex;
 };
 
-static void computeCaseList (vector<string>& cases, const vector<ShortBatchResult>& batchResults)
+class CaseResultParser : public de::Thread
 {
-	// \todo [2012-07-10 pyry] Do proper case ordering (eg. handle missing cases nicely).
-	set<string> addedCases;
+public:
+	CaseResultParser (ParseJobQueue& parseQueue)
+		: m_parseQueue(parseQueue)
+	{
+	}
 
-	for (vector<ShortBatchResult>::const_iterator batchIter = batchResults.begin(); batchIter != batchResults.end(); batchIter++)
+	void run (void)
 	{
-		for (vector<xe::TestCaseResultHeader>::const_iterator caseIter = batchIter->resultHeaders.begin(); caseIter != batchIter->resultHeaders.end(); caseIter++)
+		for (;;)
 		{
-			if (addedCases.find(caseIter->casePath) == addedCases.end())
-			{
-				cases.push_back(caseIter->casePath);
-				addedCases.insert(caseIter->casePath);
-			}
+			const ParseJob		job		= m_parseQueue.popBack();
+			xe::TestCaseResult	fullResult;
+
+			if (!job.dst)
+				break;
+
+			xe::parseTestCaseResultFromData(&m_testResultParser, &fullResult, *job.caseData.get());
+
+			*job.dst = xe::TestCaseResultHeader(fullResult);
 		}
 	}
-}
 
-static void getTestResultHeaders (vector<xe::TestCaseResultHeader>& headers, const vector<ShortBatchResult>& batchResults, const char* casePath)
+private:
+	ParseJobQueue&			m_parseQueue;
+	xe::TestResultParser	m_testResultParser;
+};
+
+//! Unified case list. Cases are in order of first appearance, results[batchNdx][caseNdx] is null for missing results.
+struct CaseList
 {
-	headers.resize(batchResults.size());
+	vector<string>										casePaths;
+	vector<vector<const xe::TestCaseResultHeader*> >	results;
+};
+
+static void computeCaseList (CaseList& caseList, const vector<ShortBatchResult>& batchResults)
+{
+	// \todo [2012-07-10 pyry] Do proper case ordering (eg. handle missing cases nicely).
+	map<string, int> caseNdxMap;
 
-	for (int ndx = 0; ndx < (int)batchResults.size(); ndx++)
+	caseList.results.resize(batchResults.size());
+
+	for (int batchNdx = 0; batchNdx < (int)batchResults.size(); batchNdx++)
 	{
-		const ShortBatchResult&				batchResult	= batchResults[ndx];
-		map<string, int>::const_iterator	resultPos	= batchResult.resultMap.find(casePath);
+		const std::deque<xe::TestCaseResultHeader>&	headers	= batchResults[batchNdx].resultHeaders;
+		vector<const xe::TestCaseResultHeader*>&		results	= caseList.results[batchNdx];
 
-		if (resultPos != batchResult.resultMap.end())
-			headers[ndx] = batchResult.resultHeaders[resultPos->second];
-		else
+		for (std::deque<xe::TestCaseResultHeader>::const_iterator caseIter = headers.begin(); caseIter != headers.end(); ++caseIter)
 		{
-			headers[ndx].casePath	= casePath;
-			headers[ndx].caseType	= xe::TESTCASETYPE_SELF_VALIDATE;
-			headers[ndx].statusCode	= xe::TESTSTATUSCODE_LAST;
+			const std::pair<map<string, int>::iterator, bool> pos = caseNdxMap.insert(std::make_pair(caseIter->casePath, (int)caseList.casePaths.size()));
+
+			if (pos.second)
+				caseList.casePaths.push_back(caseIter->casePath);
+
+			if ((int)results.size() <= pos.first->second)
+				results.resize(caseList.casePaths.size(), DE_NULL);
+
+			// Last result wins.
+			results[pos.first->second] = &(*caseIter);
 		}
 	}
+
+	for (int batchNdx = 0; batchNdx < (int)batchResults.size(); batchNdx++)
+		caseList.results[batchNdx].resize(caseList.casePaths.size(), DE_NULL);
 }
 
 static const char* getStatusCodeName (xe::TestStatusCode code)
@@ -263,6 +323,8 @@ static const char* getStatusCodeName (xe::TestStatusCode code)
 
 static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 {
+	static const xe::TestCaseResultHeader	s_missingResult;
+
 	vector<ShortBatchResult>	results;
 	vector<string>				batchNames;
 	bool						compareOk	= true;
@@ -271,14 +333,25 @@ static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 
 	try
 	{
-		// Read in batch results
+		// Read in batch results. Log files are split into cases by reader threads, and case data is parsed by parser threads.
 		results.resize(cmdLine.filenames.size());
 		{
-			std::vector<de::SharedPtr<LogFileReader> > readers;
+			// Details are not stored in case index.
+			const bool										useIndex	= cmdLine.outFormat == OUTPUTFORMAT_CSV && cmdLine.outValue == OUTPUTVALUE_STATUS_CODE;
+			const int										numParsers	= de::max(1, (int)deGetNumAvailableLogicalCores());
+			ParseJobQueue									parseQueue	(4*numParsers);
+			std::vector<de::SharedPtr<LogFileReader> >		readers;
+			std::vector<de::SharedPtr<CaseResultParser> >	parsers;
+
+			for (int ndx = 0; ndx < numParsers; ndx++)
+			{
+				parsers.push_back(de::SharedPtr<CaseResultParser>(new CaseResultParser(parseQueue)));
+				parsers.back()->start();
+			}
 
 			for (int ndx = 0; ndx < (int)cmdLine.filenames.size(); ndx++)
 			{
-				readers.push_back(de::SharedPtr<LogFileReader>(new LogFileReader(results[ndx], cmdLine.filenames[ndx].c_str())));
+				readers.push_back(de::SharedPtr<LogFileReader>(new LogFileReader(results[ndx], parseQueue, cmdLine.filenames[ndx].c_str(), useIndex)));
 				readers.back()->start();
 			}
 
@@ -289,14 +362,20 @@ static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 				// Use file name as batch name.
 				batchNames.push_back(de::FilePath(cmdLine.filenames[ndx].c_str()).getBaseName());
 			}
+
+			for (int ndx = 0; ndx < numParsers; ndx++)
+				parseQueue.pushFront(ParseJob());
+
+			for (int ndx = 0; ndx < numParsers; ndx++)
+				parsers[ndx]->join();
 		}
 
 		// Compute unified case list.
-		vector<string> caseList;
+		CaseList caseList;
 		computeCaseList(caseList, results);
 
 		// Stats.
-		int		numCases		= (int)caseList.size();
+		int		numCases		= (int)caseList.casePaths.size();
 		int		numEqual		= 0;
 
 		if (cmdLine.outFormat == OUTPUTFORMAT_CSV)
@@ -308,17 +387,21 @@ static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 		}
 
 		// Compare cases.
-		for (vector<string>::const_iterator caseIter = caseList.begin(); caseIter != caseList.end(); caseIter++)
+		for (int caseNdx = 0; caseNdx < numCases; caseNdx++)
 		{
-			const string&						caseName	= *caseIter;
-			vector<xe::TestCaseResultHeader>	headers;
-			bool								allEqual	= true;
+			const string&							caseName	= caseList.casePaths[caseNdx];
+			vector<const xe::TestCaseResultHeader*>	headers		(results.size());
+			bool									allEqual	= true;
 
-			getTestResultHeaders(headers, results, caseName.c_str());
+			for (int batchNdx = 0; batchNdx < (int)results.size(); batchNdx++)
+			{
+				const xe::TestCaseResultHeader* result = caseList.results[batchNdx][caseNdx];
+				headers[batchNdx] = result ? result : &s_missingResult;
+			}
 
-			for (vector<xe::TestCaseResultHeader>::const_iterator iter = headers.begin()+1; iter != headers.end(); iter++)
+			for (vector<const xe::TestCaseResultHeader*>::const_iterator iter = headers.begin()+1; iter != headers.end(); iter++)
 			{
-				if (iter->statusCode != headers[0].statusCode)
+				if ((*iter)->statusCode != headers[0]->statusCode)
 				{
 					allEqual = false;
 					break;
@@ -334,14 +417,14 @@ static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 				{
 					dst << caseName << "\n";
 					for (int ndx = 0; ndx < (int)headers.size(); ndx++)
-						dst << "  " << batchNames[ndx] << ": " << getStatusCodeName(headers[ndx].statusCode) << " (" << headers[ndx].statusDetails << ")\n";
+						dst << "  " << batchNames[ndx] << ": " << getStatusCodeName(headers[ndx]->statusCode) << " (" << headers[ndx]->statusDetails << ")\n";
 					dst << "\n";
 				}
 				else if (cmdLine.outFormat == OUTPUTFORMAT_CSV)
 				{
 					dst << caseName;
-					for (vector<xe::TestCaseResultHeader>::const_iterator iter = headers.begin(); iter != headers.end(); iter++)
-						dst << "," << (cmdLine.outValue == OUTPUTVALUE_STATUS_CODE ? getStatusCodeName(iter->statusCode) : iter->statusDetails.c_str());
+					for (vector<const xe::TestCaseResultHeader*>::const_iterator iter = headers.begin(); iter != headers.end(); iter++)
+						dst << "," << (cmdLine.outValue == OUTPUTVALUE_STATUS_CODE ? getStatusCodeName((*iter)->statusCode) : (*iter)->statusDetails.c_str());
 					dst << "\n";
 				}
 			}
@@ -25,6 +25,7 @@
 #include "xeTestResultParser.hpp"
 
 #include <sstream>
+#include <limits>
 #include <cstdio>
 
 namespace xe
@@ -36,7 +37,8 @@ using std::vector;
 enum
 {
 	TEST_LOG_TMP_BUFFER_SIZE	= 1024,
-	INFO_LOG_TMP_BUFFER_SIZE	= 256
+	INFO_LOG_TMP_BUFFER_SIZE	= 256,
+	MIN_SHARD_SESSION_SIZE		= 32	//!< Avoid process launch overhead dominating at the end of the run.
 };
 
 // \todo [2012-11-01 pyry] Update execute set in handler.
@@ -121,6 +123,45 @@ static int removeExecuted (TestSet& set, const TestNode* root, const BatchResult
 	return numRemoved;
 }
 
+static int countCases (const TestSet& set, const TestNode* root)
+{
+	ConstTestNodeIterator	iter		= ConstTestNodeIterator::begin(root);
+	ConstTestNodeIterator	end			= ConstTestNodeIterator::end(root);
+	int						numCases	= 0;
+
+	for (; iter != end; ++iter)
+	{
+		if ((*iter)->getNodeType() == TESTNODETYPE_TEST_CASE && set.hasNode(*iter))
+			numCases += 1;
+	}
+
+	return numCases;
+}
+
+//! Move up to maxCases cases from src to dst. Returns number of cases moved.
+static int moveCases (TestSet& dst, TestSet& src, const TestNode* root, int maxCases)
+{
+	ConstTestNodeIterator	iter		= ConstTestNodeIterator::begin(root);
+	ConstTestNodeIterator	end			= ConstTestNodeIterator::end(root);
+	int						numMoved	= 0;
+
+	for (; (iter != end) && (numMoved < maxCases); ++iter)
+	{
+		const TestNode* node = *iter;
+
+		if (node->getNodeType() == TESTNODETYPE_TEST_CASE && src.hasNode(node))
+		{
+			const TestCase* testCase = static_cast<const TestCase*>(node);
+
+			dst.addCase(testCase);
+			src.removeCase(testCase);
+			numMoved += 1;
+		}
+	}
+
+	return numMoved;
+}
+
 BatchExecutorLogHandler::BatchExecutorLogHandler (BatchResult* batchResult)
 	: m_batchResult(batchResult)
 {
@@ -169,6 +210,7 @@ BatchExecutor::BatchExecutor (const TargetConfiguration& config, CommLink* commL
 
 BatchExecutor::~BatchExecutor (void)
 {
+	destroyShards();
 }
 
 void BatchExecutor::run (void)
@@ -194,18 +236,35 @@ void BatchExecutor::run (void)
 	// Compute initial execute set.
 	computeExecuteSet(m_casesToExecute, m_root, m_testSet, m_batchResult);
 
+	// Split execution to concurrent test processes if possible.
+	if (m_config.numProcesses > 1)
+	{
+		const int numShards = de::min(m_config.numProcesses, m_commLink->getMaxShards());
+
+		if (numShards > 1)
+			createShards(numShards);
+	}
+
 	// Register callbacks.
 	m_commLink->setCallbacks(enqueueStateChanged, enqueueTestLogData, enqueueInfoLogData, this);
 
+	if (isSharded())
+		m_commLink->setShardCallbacks(enqueueShardStateChanged, enqueueShardTestLogData, this);
+
 	try
 	{
 		if (!m_casesToExecute.empty())
 		{
-			TestSet batchRequest;
-			computeBatchRequest(batchRequest, m_casesToExecute, m_root, m_config.maxCasesPerSession);
-			launchTestSet(batchRequest);
-
 			m_state = STATE_STARTED;
+
+			if (isSharded())
+				launchShards();
+			else
+			{
+				TestSet batchRequest;
+				computeBatchRequest(batchRequest, m_casesToExecute, m_root, m_config.maxCasesPerSession);
+				launchTestSet(batchRequest);
+			}
 		}
 		else
 			m_state = STATE_FINISHED;
@@ -217,11 +276,13 @@ void BatchExecutor::run (void)
 	catch (...)
 	{
 		m_commLink->setCallbacks(DE_NULL, DE_NULL, DE_NULL, DE_NULL);
+		m_commLink->setShardCallbacks(DE_NULL, DE_NULL, DE_NULL);
 		throw;
 	}
 
 	// De-register callbacks.
 	m_commLink->setCallbacks(DE_NULL, DE_NULL, DE_NULL, DE_NULL);
+	m_commLink->setShardCallbacks(DE_NULL, DE_NULL, DE_NULL);
 }
 
 void BatchExecutor::cancel (void)
@@ -303,6 +364,132 @@ void BatchExecutor::onInfoLogData (const deUint8* bytes, size_t numBytes)
 		m_infoLog->append(bytes, numBytes);
 }
 
+void BatchExecutor::onShardStateChanged (int shardNdx, CommLinkState state, const char* message)
+{
+	XE_CHECK(de::inBounds(shardNdx, 0, (int)m_shards.size()));
+
+	switch (state)
+	{
+		case COMMLINKSTATE_READY:
+		case COMMLINKSTATE_TEST_PROCESS_LAUNCHING:
+		case COMMLINKSTATE_TEST_PROCESS_RUNNING:
+			break; // Ignore.
+
+		case COMMLINKSTATE_TEST_PROCESS_FINISHED:
+		{
+			// Feed end of string to parser. This terminates open test case if such exists.
+			{
+				deUint8 eos = 0;
+				onShardTestLogData(shardNdx, &eos, 1);
+			}
+
+			finishShardSession(shardNdx, false);
+			break;
+		}
+
+		case COMMLINKSTATE_TEST_PROCESS_LAUNCH_FAILED:
+			printf("Failed to start test process %d: '%s'\n", shardNdx, message);
+			finishShardSession(shardNdx, true);
+			break;
+
+		default:
+			XE_FAIL("Unknown state");
+	}
+}
+
+void BatchExecutor::onShardTestLogData (int shardNdx, const deUint8* bytes, size_t numBytes)
+{
+	XE_CHECK(de::inBounds(shardNdx, 0, (int)m_shards.size()));
+
+	try
+	{
+		m_shards[shardNdx]->testLogParser.parse(bytes, numBytes);
+	}
+	catch (const ParseError& e)
+	{
+		DE_UNREF(e);
+	}
+}
+
+void BatchExecutor::createShards (int numShards)
+{
+	DE_ASSERT(m_shards.empty());
+
+	for (int shardNdx = 0; shardNdx < numShards; shardNdx++)
+		m_shards.push_back(new Shard(&m_logHandler));
+}
+
+void BatchExecutor::destroyShards (void)
+{
+	for (vector<Shard*>::iterator i = m_shards.begin(); i != m_shards.end(); ++i)
+		delete *i;
+	m_shards.clear();
+}
+
+void BatchExecutor::finishShardSession (int shardNdx, bool isLaunchFailure)
+{
+	Shard&		shard		= *m_shards[shardNdx];
+	const int	numExecuted	= removeExecuted(shard.casesInSession, m_root, m_batchResult);
+
+	DE_ASSERT(shard.isRunning);
+	shard.isRunning = false;
+
+	// Return cases that were not executed, for example due to a crash, so that any shard can pick them up.
+	moveCases(m_casesToExecute, shard.casesInSession, m_root, std::numeric_limits<int>::max());
+	DE_ASSERT(shard.casesInSession.empty());
+
+	// \note Shard is not relaunched if no cases were executed in last session. Otherwise executor
+	//		 could end up in infinite loop.
+	if (isLaunchFailure || numExecuted == 0)
+		shard.isDisabled = true;
+
+	launchShards();
+}
+
+void BatchExecutor::launchShards (void)
+{
+	int numActive	= 0;
+	int numPending	= countCases(m_casesToExecute, m_root);
+
+	for (vector<Shard*>::const_iterator i = m_shards.begin(); i != m_shards.end(); ++i)
+	{
+		if (!(*i)->isDisabled)
+			numActive += 1;
+	}
+
+	// Split remaining cases evenly so that shards finish at roughly the same time.
+	const int sessionSize = numActive > 0 ? de::clamp((numPending + numActive - 1) / numActive,
+													  de::min<int>(MIN_SHARD_SESSION_SIZE, m_config.maxCasesPerSession),
+													  m_config.maxCasesPerSession)
+										  : 0;
+
+	for (int shardNdx = 0; shardNdx < (int)m_shards.size() && numPending > 0; shardNdx++)
+	{
+		Shard& shard = *m_shards[shardNdx];
+
+		if (shard.isRunning || shard.isDisabled)
+			continue;
+
+		numPending -= moveCases(shard.casesInSession, m_casesToExecute, m_root, sessionSize);
+
+		shard.testLogParser.reset();
+		shard.isRunning = true;
+
+		launchShard(shardNdx);
+	}
+
+	// Finish once no shard is running anymore.
+	{
+		bool anyRunning = false;
+
+		for (vector<Shard*>::const_iterator i = m_shards.begin(); i != m_shards.end(); ++i)
+			anyRunning = anyRunning || (*i)->isRunning;
+
+		if (!anyRunning)
+			m_state = STATE_FINISHED;
+	}
+}
+
 static void writeCaseListNode (std::ostream& str, const TestNode* node, const TestSet& testSet)
 {
 	DE_ASSERT(testSet.hasNode(node));
@@ -347,6 +534,17 @@ void BatchExecutor::launchTestSet (const TestSet& testSet)
 	m_commLink->startTestProcess(m_config.binaryName.c_str(), m_config.cmdLineArgs.c_str(), m_config.workingDir.c_str(), caseList.str().c_str());
 }
 
+void BatchExecutor::launchShard (int shardNdx)
+{
+	std::ostringstream	caseList;
+	const TestSet&		testSet		= m_shards[shardNdx]->casesInSession;
+	XE_CHECK(testSet.hasNode(m_root));
+	XE_CHECK(m_root->getNodeType() == TESTNODETYPE_ROOT);
+	writeCaseListNode(caseList, m_root, testSet);
+
+	m_commLink->startShard(shardNdx, m_config.binaryName.c_str(), m_config.cmdLineArgs.c_str(), m_config.workingDir.c_str(), caseList.str().c_str());
+}
+
 void BatchExecutor::enqueueStateChanged (void* userPtr, CommLinkState state, const char* message)
 {
 	BatchExecutor*	executor	= static_cast<BatchExecutor*>(userPtr);
@@ -383,6 +581,32 @@ void BatchExecutor::enqueueInfoLogData (void* userPtr, const deUint8* bytes, siz
 	writer.enqueue();
 }
 
+void BatchExecutor::enqueueShardStateChanged (void* userPtr, int shardNdx, CommLinkState state, const char* message)
+{
+	BatchExecutor*	executor	= static_cast<BatchExecutor*>(userPtr);
+	CallWriter		writer		(&executor->m_dispatcher, BatchExecutor::dispatchShardStateChanged);
+
+	writer << executor
+		   << shardNdx
+		   << state
+		   << message;
+
+	writer.enqueue();
+}
+
+void BatchExecutor::enqueueShardTestLogData (void* userPtr, int shardNdx, const deUint8* bytes, size_t numBytes)
+{
+	BatchExecutor*	executor	= static_cast<BatchExecutor*>(userPtr);
+	CallWriter		writer		(&executor->m_dispatcher, BatchExecutor::dispatchShardTestLogData);
+
+	writer << executor
+		   << shardNdx
+		   << numBytes;
+
+	writer.write(bytes, numBytes);
+	writer.enqueue();
+}
+
 void BatchExecutor::dispatchStateChanged (CallReader& data)
 {
 	BatchExecutor*	executor	= DE_NULL;
@@ -418,4 +642,32 @@ void BatchExecutor::dispatchInfoLogData (CallReader& data)
 	executor->onInfoLogData(data.getDataBlock(numBytes), numBytes);
 }
 
+void BatchExecutor::dispatchShardStateChanged (CallReader& data)
+{
+	BatchExecutor*	executor	= DE_NULL;
+	int				shardNdx	= 0;
+	CommLinkState	state		= COMMLINKSTATE_LAST;
+	std::string		message;
+
+	data >> executor
+		 >> shardNdx
+		 >> state
+		 >> message;
+
+	executor->onShardStateChanged(shardNdx, state, message.c_str());
+}
+
+void BatchExecutor::dispatchShardTestLogData (CallReader& data)
+{
+	BatchExecutor*	executor	= DE_NULL;
+	int				shardNdx	= 0;
+	size_t			numBytes;
+
+	data >> executor
+		 >> shardNdx
+		 >> numBytes;
+
+	executor->onShardTestLogData(shardNdx, data.getDataBlock(numBytes), numBytes);
+}
+
 } // xe
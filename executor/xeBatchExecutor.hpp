@@ -38,7 +38,8 @@ namespace xe
 struct TargetConfiguration
 {
 	TargetConfiguration (void)
-		: maxCasesPerSession(1000)
+		: maxCasesPerSession	(1000)
+		, numProcesses			(1)
 	{
 	}
 
@@ -46,6 +47,7 @@ struct TargetConfiguration
 	std::string		workingDir;
 	std::string		cmdLineArgs;
 	int				maxCasesPerSession;
+	int				numProcesses;		//!< Number of concurrent test processes, limited by CommLink::getMaxShards().
 };
 
 class BatchExecutorLogHandler : public TestLogHandler
@@ -83,18 +85,34 @@ private:
 	void					onTestLogData		(const deUint8* bytes, size_t numBytes);
 	void					onInfoLogData		(const deUint8* bytes, size_t numBytes);
 
+	void					onShardStateChanged	(int shardNdx, CommLinkState state, const char* message);
+	void					onShardTestLogData	(int shardNdx, const deUint8* bytes, size_t numBytes);
+
 	void					launchTestSet		(const TestSet& testSet);
 
+	bool					isSharded			(void) const { return !m_shards.empty(); }
+	void					createShards		(int numShards);
+	void					destroyShards		(void);
+	void					finishShardSession	(int shardNdx, bool isLaunchFailure);
+	void					launchShards		(void);
+	void					launchShard			(int shardNdx);
+
 	// Callbacks for CommLink.
 	static void				enqueueStateChanged	(void* userPtr, CommLinkState state, const char* message);
 	static void				enqueueTestLogData	(void* userPtr, const deUint8* bytes, size_t numBytes);
 	static void				enqueueInfoLogData	(void* userPtr, const deUint8* bytes, size_t numBytes);
 
+	static void				enqueueShardStateChanged	(void* userPtr, int shardNdx, CommLinkState state, const char* message);
+	static void				enqueueShardTestLogData		(void* userPtr, int shardNdx, const deUint8* bytes, size_t numBytes);
+
 	// Called in CallQueue dispatch.
 	static void				dispatchStateChanged	(CallReader& data);
 	static void				dispatchTestLogData		(CallReader& data);
 	static void				dispatchInfoLogData		(CallReader& data);
 
+	static void				dispatchShardStateChanged	(CallReader& data);
+	static void				dispatchShardTestLogData	(CallReader& data);
+
 	enum State
 	{
 		STATE_NOT_STARTED,
@@ -119,6 +137,19 @@ private:
 
 	TestLogParser			m_testLogParser;
 
+	// Concurrent test process, identified by process slot index.
+	struct Shard
+	{
+		Shard (TestLogHandler* logHandler) : testLogParser(logHandler), isRunning(false), isDisabled(false) {}
+
+		TestLogParser		testLogParser;
+		TestSet				casesInSession;		//!< Cases requested in current session, not available to other shards
+		bool				isRunning;
+		bool				isDisabled;			//!< Failed to launch, or last session didn't execute any cases
+	};
+
+	std::vector<Shard*>		m_shards;
+
 	CallQueue				m_dispatcher;
 };
 
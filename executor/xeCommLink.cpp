@@ -50,4 +50,18 @@ CommLink::~CommLink (void)
 {
 }
 
+void CommLink::setShardCallbacks (ShardStateChangedFunc stateChangedCallback, ShardLogDataFunc testLogDataCallback, void* userPtr)
+{
+	// Nothing to report.
+	DE_UNREF(stateChangedCallback);
+	DE_UNREF(testLogDataCallback);
+	DE_UNREF(userPtr);
+}
+
+void CommLink::startShard (int shardNdx, const char* name, const char* params, const char* workingDir, const char* caseList)
+{
+	DE_UNREF(shardNdx && name && params && workingDir && caseList);
+	XE_FAIL("Concurrent test processes are not supported");
+}
+
 } // xe
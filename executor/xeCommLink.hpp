@@ -47,8 +47,10 @@ const char* getCommLinkStateName (CommLinkState state);
 class CommLink
 {
 public:
-	typedef void (*StateChangedFunc)	(void* userPtr, CommLinkState state, const char* message);
-	typedef void (*LogDataFunc)			(void* userPtr, const deUint8* bytes, size_t numBytes);
+	typedef void (*StateChangedFunc)		(void* userPtr, CommLinkState state, const char* message);
+	typedef void (*LogDataFunc)				(void* userPtr, const deUint8* bytes, size_t numBytes);
+	typedef void (*ShardStateChangedFunc)	(void* userPtr, int shardNdx, CommLinkState state, const char* message);
+	typedef void (*ShardLogDataFunc)		(void* userPtr, int shardNdx, const deUint8* bytes, size_t numBytes);
 
 								CommLink				(void);
 	virtual						~CommLink				(void);
@@ -61,6 +63,14 @@ public:
 
 	virtual void				startTestProcess		(const char* name, const char* params, const char* workingDir, const char* caseList) = DE_NULL;
 	virtual void				stopTestProcess			(void)							= DE_NULL;
+
+	// Concurrent test processes (shards), each identified by process slot index.
+	// Shard states go from READY through LAUNCHING and RUNNING to FINISHED (or LAUNCH_FAILED), after which
+	// shard can be started again. Link errors and info log data are reported with regular callbacks.
+	// stopTestProcess() stops all shards. getMaxShards() returns number of process slots, 0 if shards are not supported.
+	virtual int					getMaxShards			(void) const					{ return 0; }
+	virtual void				setShardCallbacks		(ShardStateChangedFunc stateChangedCallback, ShardLogDataFunc testLogDataCallback, void* userPtr);
+	virtual void				startShard				(int shardNdx, const char* name, const char* params, const char* workingDir, const char* caseList);
 };
 
 } // xe
@@ -46,13 +46,17 @@ LocalTcpIpLink::~LocalTcpIpLink (void)
 	stop();
 }
 
-void LocalTcpIpLink::start (const char* execServerPath, const char* workDir, int port)
+void LocalTcpIpLink::start (const char* execServerPath, const char* workDir, int port, int maxProcesses)
 {
 	XE_CHECK(!m_process);
+	XE_CHECK(maxProcesses >= 1);
 
 	std::ostringstream cmdLine;
 	cmdLine << execServerPath << " --single --port=" << port;
 
+	if (maxProcesses > 1)
+		cmdLine << " --max-processes=" << maxProcesses;
+
 	m_process = deProcess_create();
 	XE_CHECK(m_process);
 
@@ -174,4 +178,17 @@ void LocalTcpIpLink::stopTestProcess (void)
 		XE_FAIL("Not started");
 }
 
+void LocalTcpIpLink::setShardCallbacks (ShardStateChangedFunc stateChangedCallback, ShardLogDataFunc testLogDataCallback, void* userPtr)
+{
+	m_link.setShardCallbacks(stateChangedCallback, testLogDataCallback, userPtr);
+}
+
+void LocalTcpIpLink::startShard (int shardNdx, const char* name, const char* params, const char* workingDir, const char* caseList)
+{
+	if (m_process)
+		m_link.startShard(shardNdx, name, params, workingDir, caseList);
+	else
+		XE_FAIL("Not started");
+}
+
 } // xe
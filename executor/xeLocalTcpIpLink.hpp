@@ -38,7 +38,7 @@ public:
 								~LocalTcpIpLink			(void);
 
 	// LocalTcpIpLink -specific API
-	void						start					(const char* execServerPath, const char* workDir, int port);
+	void						start					(const char* execServerPath, const char* workDir, int port, int maxProcesses = 1);
 	void						stop					(void);
 
 	// CommLink API
@@ -52,6 +52,10 @@ public:
 	void						startTestProcess		(const char* name, const char* params, const char* workingDir, const char* caseList);
 	void						stopTestProcess			(void);
 
+	int							getMaxShards			(void) const { return m_link.getMaxShards(); }
+	void						setShardCallbacks		(ShardStateChangedFunc stateChangedCallback, ShardLogDataFunc testLogDataCallback, void* userPtr);
+	void						startShard				(int shardNdx, const char* name, const char* params, const char* workingDir, const char* caseList);
+
 private:
 	TcpIpLink					m_link;
 	deProcess*					m_process;
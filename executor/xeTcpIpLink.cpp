@@ -32,7 +32,9 @@ namespace xe
 enum
 {
 	SEND_BUFFER_BLOCK_SIZE		= 1024,
-	SEND_BUFFER_NUM_BLOCKS		= 64
+	SEND_BUFFER_NUM_BLOCKS		= 64,
+
+	LOG_DATA_TMP_BUFFER_SIZE	= 64*1024
 };
 
 // Utilities for writing messages out.
@@ -44,6 +46,18 @@ static void writeMessageHeader (de::BlockBuffer<deUint8>& dst, xs::MessageType t
 	dst.write(xs::MESSAGE_HEADER_SIZE, &hdr[0]);
 }
 
+static void writeHello (de::BlockBuffer<deUint8>& dst, int flags)
+{
+	xs::HelloMessage		msg;
+	std::vector<deUint8>	buf;
+
+	msg.flags = flags;
+	msg.write(buf);
+
+	dst.write((int)buf.size(), &buf[0]);
+	dst.flush();
+}
+
 static void writeKeepalive (de::BlockBuffer<deUint8>& dst)
 {
 	writeMessageHeader(dst, xs::MESSAGETYPE_KEEPALIVE, xs::MESSAGE_HEADER_SIZE);
@@ -66,6 +80,22 @@ static void writeExecuteBinary (de::BlockBuffer<deUint8>& dst, const char* name,
 	dst.flush();
 }
 
+static void writeExecuteShard (de::BlockBuffer<deUint8>& dst, int shardNdx, const char* name, const char* params, const char* workDir, const char* caseList)
+{
+	xs::ExecuteShardMessage	msg;
+	std::vector<deUint8>	buf;
+
+	msg.shardNdx	= shardNdx;
+	msg.name		= name;
+	msg.params		= params;
+	msg.workDir		= workDir;
+	msg.caseList	= caseList;
+	msg.write(buf);
+
+	dst.write((int)buf.size(), &buf[0]);
+	dst.flush();
+}
+
 static void writeStopExecution (de::BlockBuffer<deUint8>& dst)
 {
 	writeMessageHeader(dst, xs::MESSAGETYPE_STOP_EXECUTION, xs::MESSAGE_HEADER_SIZE);
@@ -78,10 +108,17 @@ TcpIpLinkState::TcpIpLinkState (CommLinkState initialState, const char* initialE
 	: m_state					(initialState)
 	, m_error					(initialErr)
 	, m_lastKeepaliveReceived	(0)
+	, m_helloPending			(false)
+	, m_hasHelloReply			(false)
+	, m_serverMaxProcesses		(0)
+	, m_serverHelloFlags		(0)
 	, m_stateChangedCallback	(DE_NULL)
 	, m_testLogDataCallback		(DE_NULL)
 	, m_infoLogDataCallback		(DE_NULL)
 	, m_userPtr					(DE_NULL)
+	, m_shardStateChangedCallback	(DE_NULL)
+	, m_shardTestLogDataCallback	(DE_NULL)
+	, m_shardUserPtr				(DE_NULL)
 {
 }
 
@@ -114,6 +151,15 @@ void TcpIpLinkState::setCallbacks (CommLink::StateChangedFunc stateChangedCallba
 	m_userPtr					= userPtr;
 }
 
+void TcpIpLinkState::setShardCallbacks (CommLink::ShardStateChangedFunc stateChangedCallback, CommLink::ShardLogDataFunc testLogDataCallback, void* userPtr)
+{
+	de::ScopedLock lock(m_lock);
+
+	m_shardStateChangedCallback	= stateChangedCallback;
+	m_shardTestLogDataCallback	= testLogDataCallback;
+	m_shardUserPtr				= userPtr;
+}
+
 void TcpIpLinkState::setState (CommLinkState state, const char* error)
 {
 	CommLink::StateChangedFunc	callback	= DE_NULL;
@@ -161,6 +207,56 @@ void TcpIpLinkState::onInfoLogData (const deUint8* bytes, size_t numBytes) const
 		callback(userPtr, bytes, numBytes);
 }
 
+CommLinkState TcpIpLinkState::getShardState (int shardNdx) const
+{
+	de::ScopedLock lock(m_lock);
+
+	DE_ASSERT(shardNdx >= 0);
+	return shardNdx < (int)m_shardStates.size() ? m_shardStates[shardNdx] : COMMLINKSTATE_READY;
+}
+
+void TcpIpLinkState::setShardState (int shardNdx, CommLinkState state, const char* error)
+{
+	CommLink::ShardStateChangedFunc	callback	= DE_NULL;
+	void*							userPtr		= DE_NULL;
+
+	{
+		de::ScopedLock lock(m_lock);
+
+		DE_ASSERT(shardNdx >= 0);
+		if (shardNdx >= (int)m_shardStates.size())
+			m_shardStates.resize(shardNdx+1, COMMLINKSTATE_READY);
+
+		m_shardStates[shardNdx] = state;
+
+		callback	= m_shardStateChangedCallback;
+		userPtr		= m_shardUserPtr;
+	}
+
+	if (callback)
+		callback(userPtr, shardNdx, state, error);
+}
+
+void TcpIpLinkState::resetShardStates (void)
+{
+	de::ScopedLock lock(m_lock);
+	m_shardStates.clear();
+}
+
+void TcpIpLinkState::onShardTestLogData (int shardNdx, const deUint8* bytes, size_t numBytes) const
+{
+	CommLink::ShardLogDataFunc	callback	= DE_NULL;
+	void*						userPtr		= DE_NULL;
+
+	m_lock.lock();
+	callback	= m_shardTestLogDataCallback;
+	userPtr		= m_shardUserPtr;
+	m_lock.unlock();
+
+	if (callback)
+		callback(userPtr, shardNdx, bytes, numBytes);
+}
+
 void TcpIpLinkState::onKeepaliveReceived (void)
 {
 	de::ScopedLock lock(m_lock);
@@ -173,6 +269,57 @@ deUint64 TcpIpLinkState::getLastKeepaliveRecevied (void) const
 	return m_lastKeepaliveReceived;
 }
 
+void TcpIpLinkState::resetHelloState (void)
+{
+	de::ScopedLock lock(m_lock);
+	m_helloPending			= false;
+	m_hasHelloReply			= false;
+	m_serverMaxProcesses	= 0;
+	m_serverHelloFlags		= 0;
+}
+
+void TcpIpLinkState::setHelloPending (void)
+{
+	de::ScopedLock lock(m_lock);
+	m_helloPending = true;
+}
+
+void TcpIpLinkState::setHelloReply (int maxProcesses, int supportedFlags)
+{
+	de::ScopedLock lock(m_lock);
+	m_helloPending			= false;
+	m_hasHelloReply			= true;
+	m_serverMaxProcesses	= maxProcesses;
+	m_serverHelloFlags		= supportedFlags;
+}
+
+void TcpIpLinkState::setNoHelloReply (void)
+{
+	de::ScopedLock lock(m_lock);
+
+	// \note Once server has replied, it replies to every HELLO.
+	if (!m_hasHelloReply)
+		m_helloPending = false;
+}
+
+bool TcpIpLinkState::isHelloPending (void) const
+{
+	de::ScopedLock lock(m_lock);
+	return m_helloPending;
+}
+
+int TcpIpLinkState::getServerMaxProcesses (void) const
+{
+	de::ScopedLock lock(m_lock);
+	return m_serverMaxProcesses;
+}
+
+int TcpIpLinkState::getServerHelloFlags (void) const
+{
+	de::ScopedLock lock(m_lock);
+	return m_serverHelloFlags;
+}
+
 // TcpIpSendThread
 
 TcpIpSendThread::TcpIpSendThread (de::Socket& socket, TcpIpLinkState& state)
@@ -263,8 +410,10 @@ void TcpIpSendThread::stop (void)
 TcpIpRecvThread::TcpIpRecvThread (de::Socket& socket, TcpIpLinkState& state)
 	: m_socket		(socket)
 	, m_state		(state)
-	, m_curMsgPos	(0)
-	, m_isRunning	(false)
+	, m_curMsgPos		(0)
+	, m_inflateLogData	(false)
+	, m_logDataTmpBuf	(LOG_DATA_TMP_BUFFER_SIZE)
+	, m_isRunning		(false)
 {
 }
 
@@ -278,6 +427,9 @@ void TcpIpRecvThread::start (void)
 
 	// Reset state.
 	m_curMsgPos = 0;
+	m_inflateLogData = false;
+	m_logDecompressor.reset();
+	m_shardLogDecompressors.clear();
 	m_isRunning = true;
 
 	de::Thread::start();
@@ -361,14 +513,29 @@ void TcpIpRecvThread::stop (void)
 
 void TcpIpRecvThread::handleMessage (xs::MessageType messageType, const deUint8* data, size_t dataSize)
 {
+	// \note Server replies to HELLO before sending anything else. Older servers don't reply, and send only
+	//		 keepalives until test execution starts.
+	if (messageType != xs::MESSAGETYPE_HELLO_REPLY && m_state.isHelloPending())
+		m_state.setNoHelloReply();
+
 	switch (messageType)
 	{
 		case xs::MESSAGETYPE_KEEPALIVE:
 			m_state.onKeepaliveReceived();
 			break;
 
+		case xs::MESSAGETYPE_HELLO_REPLY:
+		{
+			xs::HelloReplyMessage msg(data, dataSize);
+			XE_CHECK_MSG(m_state.isHelloPending(), "Unexpected HELLO_REPLY message");
+			m_inflateLogData = (msg.acceptedFlags & xs::HELLO_FLAG_COMPRESSED_LOG_DATA) != 0;
+			m_state.setHelloReply(msg.maxProcesses, msg.supportedFlags);
+			break;
+		}
+
 		case xs::MESSAGETYPE_PROCESS_STARTED:
 			XE_CHECK_MSG(m_state.getState() == COMMLINKSTATE_TEST_PROCESS_LAUNCHING, "Unexpected PROCESS_STARTED message");
+			getLogDecompressor(-1).reset();
 			m_state.setState(COMMLINKSTATE_TEST_PROCESS_RUNNING);
 			break;
 
@@ -404,11 +571,113 @@ void TcpIpRecvThread::handleMessage (xs::MessageType messageType, const deUint8*
 				m_state.onInfoLogData(&data[0], dataSize);
 			break;
 
+		case xs::MESSAGETYPE_COMPRESSED_LOG_DATA:
+			XE_CHECK_MSG(m_inflateLogData && m_state.getState() == COMMLINKSTATE_TEST_PROCESS_RUNNING, "Unexpected COMPRESSED_LOG_DATA message");
+			handleCompressedLogData(-1, data, dataSize);
+			break;
+
+		case xs::MESSAGETYPE_SHARD_MESSAGE:
+		{
+			xs::ShardMessage msg(data, dataSize);
+			XE_CHECK_MSG(msg.shardNdx >= 0, "Invalid process slot in SHARD_MESSAGE");
+			handleShardMessage(msg.shardNdx, msg.messageType, msg.messageData, msg.messageDataSize);
+			break;
+		}
+
 		default:
 			XE_FAIL("Unknown message");
 	}
 }
 
+void TcpIpRecvThread::handleShardMessage (int shardNdx, xs::MessageType messageType, const deUint8* data, size_t dataSize)
+{
+	switch (messageType)
+	{
+		case xs::MESSAGETYPE_PROCESS_STARTED:
+			XE_CHECK_MSG(m_state.getShardState(shardNdx) == COMMLINKSTATE_TEST_PROCESS_LAUNCHING, "Unexpected PROCESS_STARTED message");
+			getLogDecompressor(shardNdx).reset();
+			m_state.setShardState(shardNdx, COMMLINKSTATE_TEST_PROCESS_RUNNING);
+			break;
+
+		case xs::MESSAGETYPE_PROCESS_LAUNCH_FAILED:
+		{
+			xs::ProcessLaunchFailedMessage msg(data, dataSize);
+			XE_CHECK_MSG(m_state.getShardState(shardNdx) == COMMLINKSTATE_TEST_PROCESS_LAUNCHING, "Unexpected PROCESS_LAUNCH_FAILED message");
+			m_state.setShardState(shardNdx, COMMLINKSTATE_TEST_PROCESS_LAUNCH_FAILED, msg.reason.c_str());
+			break;
+		}
+
+		case xs::MESSAGETYPE_PROCESS_FINISHED:
+		{
+			XE_CHECK_MSG(m_state.getShardState(shardNdx) == COMMLINKSTATE_TEST_PROCESS_RUNNING, "Unexpected PROCESS_FINISHED message");
+			xs::ProcessFinishedMessage msg(data, dataSize);
+			m_state.setShardState(shardNdx, COMMLINKSTATE_TEST_PROCESS_FINISHED);
+			DE_UNREF(msg);
+			break;
+		}
+
+		case xs::MESSAGETYPE_PROCESS_LOG_DATA:
+		case xs::MESSAGETYPE_INFO:
+			XE_CHECK_MSG(dataSize > 0, "Empty log data message");
+
+			// Ignore trailing \0 if such is present.
+			if (data[dataSize-1] == 0)
+				dataSize -= 1;
+
+			if (messageType == xs::MESSAGETYPE_PROCESS_LOG_DATA)
+			{
+				XE_CHECK_MSG(m_state.getShardState(shardNdx) == COMMLINKSTATE_TEST_PROCESS_RUNNING, "Unexpected PROCESS_LOG_DATA message");
+				m_state.onShardTestLogData(shardNdx, &data[0], dataSize);
+			}
+			else
+				m_state.onInfoLogData(&data[0], dataSize);
+			break;
+
+		case xs::MESSAGETYPE_COMPRESSED_LOG_DATA:
+			XE_CHECK_MSG(m_inflateLogData && m_state.getShardState(shardNdx) == COMMLINKSTATE_TEST_PROCESS_RUNNING, "Unexpected COMPRESSED_LOG_DATA message");
+			handleCompressedLogData(shardNdx, data, dataSize);
+			break;
+
+		default:
+			XE_FAIL("Unknown message in SHARD_MESSAGE");
+	}
+}
+
+xs::LogDataDecompressor& TcpIpRecvThread::getLogDecompressor (int shardNdx)
+{
+	if (shardNdx < 0)
+		return m_logDecompressor;
+
+	// \note Decompressors are created on demand, most sessions use only one process.
+	while ((int)m_shardLogDecompressors.size() <= shardNdx)
+		m_shardLogDecompressors.push_back(de::SharedPtr<xs::LogDataDecompressor>(new xs::LogDataDecompressor()));
+
+	return *m_shardLogDecompressors[shardNdx];
+}
+
+void TcpIpRecvThread::handleCompressedLogData (int shardNdx, const deUint8* data, size_t dataSize)
+{
+	xs::LogDataDecompressor& decompressor = getLogDecompressor(shardNdx);
+
+	XE_CHECK_MSG(dataSize > 0, "Empty log data message");
+
+	// Pass decompressed data on as soon as it is available.
+	decompressor.setInput(data, dataSize);
+
+	for (;;)
+	{
+		const size_t numBytes = decompressor.decompress(&m_logDataTmpBuf[0], m_logDataTmpBuf.size());
+
+		if (numBytes == 0)
+			break;
+
+		if (shardNdx < 0)
+			m_state.onTestLogData(&m_logDataTmpBuf[0], numBytes);
+		else
+			m_state.onShardTestLogData(shardNdx, &m_logDataTmpBuf[0], numBytes);
+	}
+}
+
 // TcpIpLink
 
 TcpIpLink::TcpIpLink (void)
@@ -455,7 +724,7 @@ void TcpIpLink::closeConnection (void)
 		m_socket.close();
 }
 
-void TcpIpLink::connect (const de::SocketAddress& address)
+void TcpIpLink::connect (const de::SocketAddress& address, bool compressLogData)
 {
 	XE_CHECK(m_socket.getState() == DE_SOCKETSTATE_CLOSED);
 	XE_CHECK(m_state.getState() == COMMLINKSTATE_ERROR);
@@ -469,11 +738,29 @@ void TcpIpLink::connect (const de::SocketAddress& address)
 		// Clear error and set state to ready.
 		m_state.setState(COMMLINKSTATE_READY, "");
 		m_state.onKeepaliveReceived();
+		m_state.resetHelloState();
 
 		// Launch threads.
 		m_sendThread.start();
 		m_recvThread.start();
 
+		// \note Execserver doesn't require HELLO, it is sent only to negotiate optional features. Flags are
+		//		 sent only if server lists them in reply to first HELLO, older servers reject them.
+		m_state.setHelloPending();
+		writeHello(m_sendThread.getBuffer(), 0);
+
+		if (compressLogData)
+		{
+			waitForHelloReply();
+
+			if (m_state.getServerHelloFlags() & xs::HELLO_FLAG_COMPRESSED_LOG_DATA)
+			{
+				m_state.setHelloPending();
+				writeHello(m_sendThread.getBuffer(), xs::HELLO_FLAG_COMPRESSED_LOG_DATA);
+				waitForHelloReply();
+			}
+		}
+
 		XE_CHECK(deTimer_scheduleInterval(m_keepaliveTimer, xs::KEEPALIVE_SEND_INTERVAL));
 	}
 	catch (const std::exception& e)
@@ -503,6 +790,7 @@ void TcpIpLink::reset (void)
 	if (m_socket.getState() == DE_SOCKETSTATE_CONNECTED)
 	{
 		m_state.setState(COMMLINKSTATE_READY, "");
+		m_state.resetShardStates();
 
 		// \todo [2012-07-10 pyry] Do we need to reset send/receive buffers?
 	}
@@ -510,6 +798,20 @@ void TcpIpLink::reset (void)
 		disconnect(); // Abnormal state/usage. Disconnect socket.
 }
 
+void TcpIpLink::waitForHelloReply (void) const
+{
+	// \note Older servers don't reply, but their first keepalive ends the wait.
+	const deUint64 startTime = deGetMicroseconds();
+
+	while (m_state.isHelloPending() && m_state.getState() != COMMLINKSTATE_ERROR)
+	{
+		if (deGetMicroseconds() - startTime > xs::KEEPALIVE_TIMEOUT*1000)
+			XE_FAIL("No reply to HELLO");
+
+		deSleep(10);
+	}
+}
+
 void TcpIpLink::keepaliveTimerCallback (void* ptr)
 {
 	TcpIpLink*	link			= static_cast<TcpIpLink*>(ptr);
@@ -560,4 +862,29 @@ void TcpIpLink::stopTestProcess (void)
 	writeStopExecution(m_sendThread.getBuffer());
 }
 
+int TcpIpLink::getMaxShards (void) const
+{
+	waitForHelloReply();
+	return m_state.getServerMaxProcesses();
+}
+
+void TcpIpLink::setShardCallbacks (ShardStateChangedFunc stateChangedCallback, ShardLogDataFunc testLogDataCallback, void* userPtr)
+{
+	m_state.setShardCallbacks(stateChangedCallback, testLogDataCallback, userPtr);
+}
+
+void TcpIpLink::startShard (int shardNdx, const char* name, const char* params, const char* workingDir, const char* caseList)
+{
+	XE_CHECK(m_state.getState() == COMMLINKSTATE_READY);
+	XE_CHECK(shardNdx >= 0);
+
+	{
+		const CommLinkState shardState = m_state.getShardState(shardNdx);
+		XE_CHECK(shardState != COMMLINKSTATE_TEST_PROCESS_LAUNCHING && shardState != COMMLINKSTATE_TEST_PROCESS_RUNNING);
+	}
+
+	m_state.setShardState(shardNdx, COMMLINKSTATE_TEST_PROCESS_LAUNCHING);
+	writeExecuteShard(m_sendThread.getBuffer(), shardNdx, name, params, workingDir, caseList);
+}
+
 } // xe
@@ -29,7 +29,9 @@
 #include "deRingBuffer.hpp"
 #include "deBlockBuffer.hpp"
 #include "xsProtocol.hpp"
+#include "xsLogDataCompression.hpp"
 #include "deThread.hpp"
+#include "deSharedPtr.hpp"
 #include "deTimer.h"
 
 #include <vector>
@@ -47,14 +49,28 @@ public:
 	CommLinkState				getState					(std::string& error) const;
 
 	void						setCallbacks				(CommLink::StateChangedFunc stateChangedCallback, CommLink::LogDataFunc testLogDataCallback, CommLink::LogDataFunc infoLogDataCallback, void* userPtr);
+	void						setShardCallbacks			(CommLink::ShardStateChangedFunc stateChangedCallback, CommLink::ShardLogDataFunc testLogDataCallback, void* userPtr);
 
 	void						setState					(CommLinkState state, const char* error = "");
 	void						onTestLogData				(const deUint8* bytes, size_t numBytes) const;
 	void						onInfoLogData				(const deUint8* bytes, size_t numBytes) const;
 
+	CommLinkState				getShardState				(int shardNdx) const;
+	void						setShardState				(int shardNdx, CommLinkState state, const char* error = "");
+	void						resetShardStates			(void);
+	void						onShardTestLogData			(int shardNdx, const deUint8* bytes, size_t numBytes) const;
+
 	void						onKeepaliveReceived			(void);
 	deUint64					getLastKeepaliveRecevied	(void) const;
 
+	void						resetHelloState				(void);
+	void						setHelloPending				(void);
+	void						setHelloReply				(int maxProcesses, int supportedFlags);
+	void						setNoHelloReply				(void);
+	bool						isHelloPending				(void) const;
+	int							getServerMaxProcesses		(void) const;
+	int							getServerHelloFlags			(void) const;
+
 private:
 	mutable de::Mutex					m_lock;
 	volatile CommLinkState				m_state;
@@ -62,10 +78,20 @@ private:
 
 	volatile deUint64					m_lastKeepaliveReceived;
 
+	bool								m_helloPending;			//!< HELLO sent, waiting for reply
+	bool								m_hasHelloReply;		//!< Server has replied to HELLO, false for older servers
+	int									m_serverMaxProcesses;	//!< From HELLO_REPLY, 0 if server didn't reply
+	int									m_serverHelloFlags;		//!< HelloFlags supported by server
+
 	volatile CommLink::StateChangedFunc	m_stateChangedCallback;
 	volatile CommLink::LogDataFunc		m_testLogDataCallback;
 	volatile CommLink::LogDataFunc		m_infoLogDataCallback;
 	void* volatile						m_userPtr;
+
+	std::vector<CommLinkState>					m_shardStates;		//!< Slots beyond end are READY
+	volatile CommLink::ShardStateChangedFunc	m_shardStateChangedCallback;
+	volatile CommLink::ShardLogDataFunc			m_shardTestLogDataCallback;
+	void* volatile								m_shardUserPtr;
 };
 
 class TcpIpSendThread : public de::Thread
@@ -105,6 +131,10 @@ public:
 
 private:
 	void						handleMessage			(xs::MessageType messageType, const deUint8* data, size_t dataSize);
+	void						handleShardMessage		(int shardNdx, xs::MessageType messageType, const deUint8* data, size_t dataSize);
+	void						handleCompressedLogData	(int shardNdx, const deUint8* data, size_t dataSize);
+
+	xs::LogDataDecompressor&	getLogDecompressor		(int shardNdx);
 
 	de::Socket&					m_socket;
 	TcpIpLinkState&				m_state;
@@ -112,6 +142,11 @@ private:
 	std::vector<deUint8>		m_curMsgBuf;
 	size_t						m_curMsgPos;
 
+	bool						m_inflateLogData;		//!< Server confirmed HELLO_FLAG_COMPRESSED_LOG_DATA
+	xs::LogDataDecompressor		m_logDecompressor;
+	std::vector<de::SharedPtr<xs::LogDataDecompressor> >	m_shardLogDecompressors;
+	std::vector<deUint8>		m_logDataTmpBuf;		//!< Decompressed log data
+
 	bool						m_isRunning;
 };
 
@@ -122,7 +157,7 @@ public:
 								~TcpIpLink				(void);
 
 	// TcpIpLink -specific API
-	void						connect					(const de::SocketAddress& address);
+	void						connect					(const de::SocketAddress& address, bool compressLogData = false);
 	void						disconnect				(void);
 
 	// CommLink API
@@ -136,8 +171,13 @@ public:
 	void						startTestProcess		(const char* name, const char* params, const char* workingDir, const char* caseList);
 	void						stopTestProcess			(void);
 
+	int							getMaxShards			(void) const;
+	void						setShardCallbacks		(ShardStateChangedFunc stateChangedCallback, ShardLogDataFunc testLogDataCallback, void* userPtr);
+	void						startShard				(int shardNdx, const char* name, const char* params, const char* workingDir, const char* caseList);
+
 private:
 	void						closeConnection			(void);
+	void						waitForHelloReply		(void) const;
 
 	static void					keepaliveTimerCallback	(void* ptr);
 
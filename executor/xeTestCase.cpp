@@ -505,4 +505,48 @@ bool ConstTestNodeIterator::operator!= (const ConstTestNodeIterator& other) cons
 	return m_root != other.m_root || m_iterStack != other.m_iterStack;
 }
 
+bool checkCasePathPatternMatch (const char* pattern, const char* casePath, bool isTestGroup)
+{
+	int ptrnPos = 0;
+	int casePos = 0;
+
+	for (;;)
+	{
+		char c = casePath[casePos];
+		char p = pattern[ptrnPos];
+
+		if (p == '*')
+		{
+			/* Recurse to rest of positions. */
+			int next = casePos;
+			for (;;)
+			{
+				if (checkCasePathPatternMatch(pattern+ptrnPos+1, casePath+next, isTestGroup))
+					return DE_TRUE;
+
+				if (casePath[next] == 0)
+					return DE_FALSE; /* No match found. */
+				else
+					next += 1;
+			}
+			DE_ASSERT(DE_FALSE);
+		}
+		else if (c == 0 && p == 0)
+			return true;
+		else if (c == 0)
+		{
+			/* Incomplete match is ok for test groups. */
+			return isTestGroup;
+		}
+		else if (c != p)
+			return false;
+
+		casePos += 1;
+		ptrnPos += 1;
+	}
+
+	DE_ASSERT(false);
+	return false;
+}
+
 } // xe
@@ -217,6 +217,9 @@ private:
 //  - ConstTestSetIterator
 //  - TestSetIterator
 
+//! Check if case path matches pattern. '*' matches any sequence of characters. Partial match is accepted for test groups.
+bool checkCasePathPatternMatch (const char* pattern, const char* casePath, bool isTestGroup);
+
 } // xe
 
 #endif // _XETESTCASE_HPP
@@ -0,0 +1,349 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test log case index.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeTestLogIndex.hpp"
+#include "xeContainerFormatParser.hpp"
+#include "xeTestResultParser.hpp"
+#include "deString.h"
+
+#include <fstream>
+
+using std::string;
+using std::vector;
+
+namespace xe
+{
+
+// \note Must match case index format in qpTestLog.c.
+static const char* const	CASE_INDEX_MAGIC		= "qpaIdx01";
+static const int			CASE_INDEX_MAGIC_LEN	= 8;
+
+enum
+{
+	CASE_INDEX_RECORD_CASE	= 1,
+	CASE_INDEX_RECORD_END	= 2
+};
+
+// TestLogIndex
+
+TestLogIndex::TestLogIndex (void)
+	: m_logSize(0)
+{
+}
+
+TestLogIndex::~TestLogIndex (void)
+{
+}
+
+void TestLogIndex::clear (void)
+{
+	m_logSize = 0;
+	m_entries.clear();
+	m_entryMap.clear();
+}
+
+const TestLogIndexEntry* TestLogIndex::findEntry (const char* casePath) const
+{
+	std::map<string, int>::const_iterator pos = m_entryMap.find(casePath);
+	return pos != m_entryMap.end() ? &m_entries[pos->second] : DE_NULL;
+}
+
+void TestLogIndex::addEntry (const TestLogIndexEntry& entry)
+{
+	std::map<string, int>::const_iterator pos = m_entryMap.find(entry.casePath);
+
+	if (pos != m_entryMap.end())
+		m_entries[pos->second] = entry;
+	else
+	{
+		m_entryMap[entry.casePath] = (int)m_entries.size();
+		m_entries.push_back(entry);
+	}
+}
+
+// Index file reading and writing
+
+namespace
+{
+
+class IndexReader
+{
+public:
+	IndexReader (const deUint8* begin, const deUint8* end)
+		: m_cur	(begin)
+		, m_end	(end)
+	{
+	}
+
+	bool isAtEnd (void) const
+	{
+		return m_cur == m_end;
+	}
+
+	bool getUint (deUint64& dst, int numBytes)
+	{
+		if ((int)(m_end - m_cur) < numBytes)
+			return false;
+
+		dst = 0;
+		for (int ndx = 0; ndx < numBytes; ndx++)
+			dst |= (deUint64)m_cur[ndx] << (8*ndx);
+
+		m_cur += numBytes;
+		return true;
+	}
+
+	bool getString (string& dst, int lengthBytes)
+	{
+		deUint64 length = 0;
+
+		if (!getUint(length, lengthBytes) || (deUint64)(m_end - m_cur) < length)
+			return false;
+
+		dst.assign((const char*)m_cur, (size_t)length);
+		m_cur += (size_t)length;
+		return true;
+	}
+
+private:
+	const deUint8*	m_cur;
+	const deUint8*	m_end;
+};
+
+void appendUint (vector<deUint8>& dst, deUint64 value, int numBytes)
+{
+	for (int ndx = 0; ndx < numBytes; ndx++)
+		dst.push_back((deUint8)(value >> (8*ndx)));
+}
+
+void appendString (vector<deUint8>& dst, const string& str, int lengthBytes)
+{
+	appendUint(dst, (deUint64)str.size(), lengthBytes);
+	dst.insert(dst.end(), str.begin(), str.end());
+}
+
+bool readFile (vector<deUint8>& dst, const char* filename)
+{
+	std::ifstream in(filename, std::ifstream::binary|std::ifstream::in);
+
+	if (!in.good())
+		return false;
+
+	in.seekg(0, std::ifstream::end);
+	dst.resize((size_t)in.tellg());
+	in.seekg(0, std::ifstream::beg);
+
+	if (!dst.empty())
+		in.read((char*)&dst[0], (std::streamsize)dst.size());
+
+	return in.good();
+}
+
+deUint64 getFileSize (const char* filename)
+{
+	std::ifstream in(filename, std::ifstream::binary|std::ifstream::in);
+
+	XE_CHECK_MSG(in.good(), (string("Failed to open '") + filename + "'").c_str());
+
+	in.seekg(0, std::ifstream::end);
+	return (deUint64)in.tellg();
+}
+
+TestStatusCode getIndexStatusCode (const char* statusCode)
+{
+	try
+	{
+		return getTestStatusCode(statusCode);
+	}
+	catch (const ParseError&)
+	{
+		return TESTSTATUSCODE_TERMINATED;
+	}
+}
+
+} // anonymous
+
+string getTestLogIndexFilename (const char* logFilename)
+{
+	return string(logFilename) + ".idx";
+}
+
+bool readTestLogIndex (TestLogIndex& dst, const char* logFilename)
+{
+	vector<deUint8>	data;
+	bool			isComplete	= false;
+
+	dst.clear();
+
+	if (!readFile(data, getTestLogIndexFilename(logFilename).c_str()) ||
+		(int)data.size() < CASE_INDEX_MAGIC_LEN ||
+		!deMemoryEqual(&data[0], CASE_INDEX_MAGIC, CASE_INDEX_MAGIC_LEN))
+		return false;
+
+	{
+		IndexReader reader (&data[0] + CASE_INDEX_MAGIC_LEN, &data[0] + data.size());
+
+		while (!reader.isAtEnd() && !isComplete)
+		{
+			deUint64 recordType = 0;
+
+			if (!reader.getUint(recordType, 1))
+				break;
+
+			if (recordType == CASE_INDEX_RECORD_CASE)
+			{
+				TestLogIndexEntry	entry;
+				string				statusCode;
+
+				if (!reader.getUint(entry.offset, 8)		||
+					!reader.getUint(entry.size, 8)			||
+					!reader.getUint(entry.duration, 8)		||
+					!reader.getString(statusCode, 1)		||
+					!reader.getString(entry.casePath, 2))
+					break; // Truncated record, process was probably killed.
+
+				entry.statusCode = getIndexStatusCode(statusCode.c_str());
+				dst.addEntry(entry);
+			}
+			else if (recordType == CASE_INDEX_RECORD_END)
+			{
+				deUint64 logSize = 0;
+
+				if (!reader.getUint(logSize, 8))
+					break;
+
+				dst.setLogSize(logSize);
+				isComplete = true;
+			}
+			else
+				break; // Unknown record.
+		}
+	}
+
+	// \note Index is usable only if session was ended properly and log has not been modified since.
+	if (!isComplete || dst.getLogSize() != getFileSize(logFilename))
+	{
+		dst.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void writeTestLogIndex (const TestLogIndex& index, const char* logFilename)
+{
+	const string	filename	= getTestLogIndexFilename(logFilename);
+	vector<deUint8>	data;
+
+	data.insert(data.end(), CASE_INDEX_MAGIC, CASE_INDEX_MAGIC + CASE_INDEX_MAGIC_LEN);
+
+	for (int entryNdx = 0; entryNdx < index.getNumEntries(); entryNdx++)
+	{
+		const TestLogIndexEntry& entry = index.getEntry(entryNdx);
+
+		appendUint(data, CASE_INDEX_RECORD_CASE, 1);
+		appendUint(data, entry.offset, 8);
+		appendUint(data, entry.size, 8);
+		appendUint(data, entry.duration, 8);
+		appendString(data, getTestStatusCodeName(entry.statusCode), 1);
+		appendString(data, entry.casePath, 2);
+	}
+
+	appendUint(data, CASE_INDEX_RECORD_END, 1);
+	appendUint(data, index.getLogSize(), 8);
+
+	{
+		std::ofstream out(filename.c_str(), std::ofstream::binary|std::ofstream::trunc);
+
+		out.write((const char*)&data[0], (std::streamsize)data.size());
+		out.close();
+
+		XE_CHECK_MSG(out.good(), (string("Failed to write '") + filename + "'").c_str());
+	}
+}
+
+void readTestCaseResult (std::istream& log, const TestLogIndexEntry& entry, TestCaseResultData& dst)
+{
+	vector<deUint8>			data	((size_t)entry.size);
+	ContainerFormatParser	parser;
+	bool					inCase	= false;
+
+	XE_CHECK_MSG(!data.empty(), "Empty test case result in test log index");
+
+	log.clear();
+	log.seekg((std::streamoff)entry.offset);
+	log.read((char*)&data[0], (std::streamsize)data.size());
+
+	XE_CHECK_MSG(log.good(), "Failed to read test case result from log");
+
+	dst.setDataSize(0);
+	dst.setTestResult(TESTSTATUSCODE_TERMINATED, "Unexpected end of test case result");
+
+	parser.feed(&data[0], data.size());
+
+	for (;;)
+	{
+		const ContainerElement element = parser.getElement();
+
+		if (element == CONTAINERELEMENT_INCOMPLETE || element == CONTAINERELEMENT_END_OF_STRING)
+			break;
+
+		switch (element)
+		{
+			case CONTAINERELEMENT_BEGIN_TEST_CASE_RESULT:
+				XE_CHECK_MSG(!inCase && entry.casePath == parser.getTestCasePath(), "Test log index does not match log");
+				inCase = true;
+				break;
+
+			case CONTAINERELEMENT_END_TEST_CASE_RESULT:
+				XE_CHECK_MSG(inCase, "Test log index does not match log");
+				dst.setTestResult(TESTSTATUSCODE_LAST, "");
+				inCase = false;
+				break;
+
+			case CONTAINERELEMENT_TERMINATE_TEST_CASE_RESULT:
+				XE_CHECK_MSG(inCase, "Test log index does not match log");
+				dst.setTestResult(getIndexStatusCode(parser.getTerminateReason()), parser.getTerminateReason());
+				inCase = false;
+				break;
+
+			case CONTAINERELEMENT_TEST_LOG_DATA:
+				if (inCase)
+				{
+					const int	offset			= dst.getDataSize();
+					const int	numDataBytes	= parser.getDataSize();
+
+					dst.setDataSize(offset+numDataBytes);
+					parser.getData(dst.getData()+offset, numDataBytes, 0);
+				}
+				break;
+
+			default:
+				XE_FAIL("Test log index does not match log");
+		}
+
+		parser.advance();
+	}
+}
+
+} // xe
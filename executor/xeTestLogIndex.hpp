@@ -0,0 +1,93 @@
+#ifndef _XETESTLOGINDEX_HPP
+#define _XETESTLOGINDEX_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test log case index.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeDefs.hpp"
+#include "xeTestCaseResult.hpp"
+#include "xeBatchResult.hpp"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <istream>
+
+namespace xe
+{
+
+struct TestLogIndexEntry
+{
+						TestLogIndexEntry	(void) : offset(0), size(0), statusCode(TESTSTATUSCODE_LAST), duration(0) {}
+
+	std::string			casePath;
+	deUint64			offset;			//!< Offset of case in log file.
+	deUint64			size;			//!< Size of case in log file, including container lines.
+	TestStatusCode		statusCode;
+	deUint64			duration;		//!< Case execution time in microseconds.
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Case index of test log
+ *
+ * Index is written by qpTestLog into <log file name>.idx when
+ * QP_TEST_LOG_WRITE_CASE_INDEX is set. It allows reading individual test
+ * case results without parsing the whole log.
+ *//*--------------------------------------------------------------------*/
+class TestLogIndex
+{
+public:
+								TestLogIndex		(void);
+								~TestLogIndex		(void);
+
+	void						clear				(void);
+
+	deUint64					getLogSize			(void) const	{ return m_logSize;				}
+	void						setLogSize			(deUint64 size)	{ m_logSize = size;				}
+
+	int							getNumEntries		(void) const	{ return (int)m_entries.size();	}
+	const TestLogIndexEntry&	getEntry			(int ndx) const	{ return m_entries[ndx];		}
+
+	//! Find entry by case path. Returns null if case is not in index.
+	const TestLogIndexEntry*	findEntry			(const char* casePath) const;
+
+	//! Add entry. If case is already in index, the existing entry is replaced.
+	void						addEntry			(const TestLogIndexEntry& entry);
+
+private:
+	deUint64						m_logSize;
+	std::vector<TestLogIndexEntry>	m_entries;
+	std::map<std::string, int>		m_entryMap;
+};
+
+std::string		getTestLogIndexFilename		(const char* logFilename);
+
+//! Read index of log file. Returns false if log has no complete index or index is out of date.
+bool			readTestLogIndex			(TestLogIndex& dst, const char* logFilename);
+void			writeTestLogIndex			(const TestLogIndex& index, const char* logFilename);
+
+//! Read and parse single test case result from log.
+void			readTestCaseResult			(std::istream& log, const TestLogIndexEntry& entry, TestCaseResultData& dst);
+
+} // xe
+
+#endif // _XETESTLOGINDEX_HPP
@@ -321,6 +321,16 @@ void TestResultParser::init (TestCaseResult* dstResult)
 }
 
 TestResultParser::ParseResult TestResultParser::parse (const deUint8* bytes, int numBytes)
+{
+	return parseData(bytes, numBytes, false);
+}
+
+TestResultParser::ParseResult TestResultParser::parseDocument (const deUint8* bytes, int numBytes)
+{
+	return parseData(bytes, numBytes, true);
+}
+
+TestResultParser::ParseResult TestResultParser::parseData (const deUint8* bytes, int numBytes, bool isDocument)
 {
 	DE_ASSERT(m_result && m_state != STATE_NOT_INITIALIZED);
 
@@ -328,7 +338,10 @@ TestResultParser::ParseResult TestResultParser::parse (const deUint8* bytes, int
 	{
 		bool resultChanged = false;
 
-		m_xmlParser.feed(bytes, numBytes);
+		if (isDocument)
+			m_xmlParser.setDocument(bytes, numBytes);
+		else
+			m_xmlParser.feed(bytes, numBytes);
 
 		for (;;)
 		{
@@ -882,7 +895,7 @@ void parseTestCaseResultFromData (TestResultParser* parser, TestCaseResult* resu
 	{
 		parser->init(result);
 
-		const TestResultParser::ParseResult parseResult = parser->parse(data.getData(), data.getDataSize());
+		const TestResultParser::ParseResult parseResult = parser->parseDocument(data.getData(), data.getDataSize());
 
 		if (result->statusCode == TESTSTATUSCODE_LAST)
 		{
@@ -68,12 +68,14 @@ public:
 
 	void					init						(TestCaseResult* dstResult);
 	ParseResult				parse						(const deUint8* bytes, int numBytes);
+	ParseResult				parseDocument				(const deUint8* bytes, int numBytes);	//!< Parse complete data without copying. Data must stay valid until next init().
 
 private:
 							TestResultParser			(const TestResultParser& other);
 	TestResultParser&		operator=					(const TestResultParser& other);
 
 	void					clear						(void);
+	ParseResult				parseData					(const deUint8* bytes, int numBytes, bool isDocument);
 
 	void					handleElementStart			(void);
 	void					handleElementEnd			(void);
@@ -23,6 +23,7 @@
 
 #include "xeXMLParser.hpp"
 #include "deInt32.h"
+#include "deMemory.h"
 
 namespace xe
 {
@@ -59,6 +60,9 @@ Tokenizer::Tokenizer (void)
 	, m_curTokenLen	(0)
 	, m_state		(STATE_DATA)
 	, m_buf			(TOKENIZER_INITIAL_BUFFER_SIZE)
+	, m_document	(DE_NULL)
+	, m_documentSize(0)
+	, m_documentPos	(0)
 {
 }
 
@@ -72,6 +76,9 @@ void Tokenizer::clear (void)
 	m_curTokenLen	= 0;
 	m_state			= STATE_DATA;
 	m_buf.clear();
+	m_document		= DE_NULL;
+	m_documentSize	= 0;
+	m_documentPos	= 0;
 }
 
 void Tokenizer::error (const std::string& what)
@@ -81,6 +88,8 @@ void Tokenizer::error (const std::string& what)
 
 void Tokenizer::feed (const deUint8* bytes, int numBytes)
 {
+	DE_ASSERT(!m_document);
+
 	// Grow buffer if necessary.
 	if (m_buf.getNumFree() < numBytes)
 	{
@@ -95,16 +104,79 @@ void Tokenizer::feed (const deUint8* bytes, int numBytes)
 		advance();
 }
 
+void Tokenizer::setDocument (const deUint8* bytes, int numBytes)
+{
+	DE_ASSERT(m_curToken == TOKEN_INCOMPLETE && m_curTokenLen == 0 && m_buf.getNumElements() == 0 && !m_document);
+
+	m_document		= bytes;
+	m_documentSize	= numBytes;
+	m_documentPos	= 0;
+
+	advance();
+}
+
 int Tokenizer::getChar (int offset) const
 {
-	DE_ASSERT(de::inRange(offset, 0, m_buf.getNumElements()));
+	DE_ASSERT(de::inRange(offset, 0, getNumBytes()));
 
-	if (offset < m_buf.getNumElements())
-		return m_buf.peekBack(offset);
+	if (offset < getNumBytes())
+		return getByte(offset);
 	else
 		return END_OF_BUFFER;
 }
 
+void Tokenizer::consume (int numBytes)
+{
+	if (m_document)
+		m_documentPos += numBytes;
+	else
+		m_buf.popBack(numBytes);
+}
+
+static inline bool hasZeroByte (deUint64 v)
+{
+	return ((v - 0x0101010101010101ull) & ~v & 0x8080808080808080ull) != 0;
+}
+
+static inline bool isDataEndChar (deUint8 ch)
+{
+	return ch == '<' || ch == '&' || ch == 0;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Find end of data token in document
+ *
+ * Returns offset of first '<', '&' or 0 starting from offset, or number
+ * of remaining bytes. Data is scanned 8 bytes at a time as data tokens
+ * make up most of large logs.
+ *//*--------------------------------------------------------------------*/
+int Tokenizer::findDataEnd (int offset) const
+{
+	const deUint64		lt		= 0x3c3c3c3c3c3c3c3cull;	// '<'
+	const deUint64		amp		= 0x2626262626262626ull;	// '&'
+	const deUint8*		begin	= m_document + m_documentPos;
+	const deUint8*		end		= m_document + m_documentSize;
+	const deUint8*		ptr		= begin + offset;
+
+	DE_ASSERT(m_document);
+
+	while (end - ptr >= (int)sizeof(deUint64))
+	{
+		deUint64 word;
+		deMemcpy(&word, ptr, sizeof(word));
+
+		if (hasZeroByte(word) || hasZeroByte(word ^ lt) || hasZeroByte(word ^ amp))
+			break;
+
+		ptr += sizeof(deUint64);
+	}
+
+	while (ptr != end && !isDataEndChar(*ptr))
+		ptr++;
+
+	return (int)(ptr - begin);
+}
+
 void Tokenizer::advance (void)
 {
 	if (m_curToken != TOKEN_INCOMPLETE)
@@ -121,7 +193,7 @@ void Tokenizer::advance (void)
 			m_state = STATE_DATA;
 
 		// Advance buffer by length of last token.
-		m_buf.popBack(m_curTokenLen);
+		consume(m_curTokenLen);
 
 		// Reset state.
 		m_curToken		= TOKEN_INCOMPLETE;
@@ -167,6 +239,13 @@ void Tokenizer::advance (void)
 					continue;
 				}
 			}
+			else if (m_document)
+			{
+				// Skip directly to next special character.
+				m_curTokenLen	= findDataEnd(m_curTokenLen);
+				curChar			= getChar(m_curTokenLen);
+				continue;
+			}
 		}
 		else
 		{
@@ -175,7 +254,7 @@ void Tokenizer::advance (void)
 			{
 				while (isWhitespaceChar(curChar))
 				{
-					m_buf.popBack();
+					consume(1);
 					curChar = getChar(0);
 				}
 			}
@@ -338,6 +417,13 @@ void Tokenizer::advance (void)
 void Tokenizer::getString (std::string& dst) const
 {
 	DE_ASSERT(m_curToken == TOKEN_STRING);
+
+	if (m_document)
+	{
+		dst.assign((const char*)getTokenPtr() + 1, (size_t)(m_curTokenLen-2));
+		return;
+	}
+
 	dst.resize(m_curTokenLen-2);
 	for (int ndx = 0; ndx < m_curTokenLen-2; ndx++)
 		dst[ndx] = m_buf.peekBack(ndx+1);
@@ -378,6 +464,14 @@ void Parser::feed (const deUint8* bytes, int numBytes)
 		advance();
 }
 
+void Parser::setDocument (const deUint8* bytes, int numBytes)
+{
+	DE_ASSERT(m_element == ELEMENT_INCOMPLETE);
+
+	m_tokenizer.setDocument(bytes, numBytes);
+	advance();
+}
+
 void Parser::advance (void)
 {
 	if (m_element == ELEMENT_START)
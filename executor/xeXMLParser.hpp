@@ -89,21 +89,29 @@ public:
 	void				clear				(void);		//!< Resets tokenizer to initial state.
 
 	void				feed				(const deUint8* bytes, int numBytes);
+	void				setDocument			(const deUint8* bytes, int numBytes);	//!< Tokenize complete document in place. Data must stay valid until clear().
 	void				advance				(void);
 
 	Token				getToken			(void) const		{ return m_curToken;	}
 	int					getTokenLen			(void) const		{ return m_curTokenLen;	}
-	deUint8				getTokenByte		(int offset) const	{ DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING); return m_buf.peekBack(offset); }
+	deUint8				getTokenByte		(int offset) const	{ DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING); return getByte(offset); }
+	const deUint8*		getTokenPtr			(void) const		{ DE_ASSERT(m_document && m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING); return m_document + m_documentPos; }
 	void				getTokenStr			(std::string& dst) const;
 	void				appendTokenStr		(std::string& dst) const;
 
 	void				getString			(std::string& dst) const;
 
+	bool				isDocument			(void) const		{ return m_document != DE_NULL; }
+
 private:
 						Tokenizer			(const Tokenizer& other);
 	Tokenizer&			operator=			(const Tokenizer& other);
 
+	int					getNumBytes			(void) const		{ return m_document ? m_documentSize - m_documentPos : m_buf.getNumElements(); }
+	deUint8				getByte				(int offset) const	{ return m_document ? m_document[m_documentPos + offset] : m_buf.peekBack(offset); }
 	int					getChar				(int offset) const;
+	void				consume				(int numBytes);
+	int					findDataEnd			(int offset) const;
 
 	void				error				(const std::string& what);
 
@@ -130,7 +138,11 @@ private:
 
 	State						m_state;			//!< Tokenization state.
 
-	de::RingBuffer<deUint8>		m_buf;
+	de::RingBuffer<deUint8>		m_buf;				//!< Fed data, not used for documents.
+
+	const deUint8*				m_document;			//!< Document tokenized in place, null if data is fed.
+	int							m_documentSize;
+	int							m_documentPos;		//!< Start of current token in document.
 };
 
 class Parser
@@ -145,6 +157,7 @@ public:
 	void				clear				(void);		//!< Resets parser to initial state.
 
 	void				feed				(const deUint8* bytes, int numBytes);
+	void				setDocument			(const deUint8* bytes, int numBytes);	//!< Parse complete document in place. Data must stay valid until clear().
 	void				advance				(void);
 
 	Element				getElement			(void) const						{ return m_element;										}
@@ -203,6 +216,13 @@ private:
 inline void Tokenizer::getTokenStr (std::string& dst) const
 {
 	DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING);
+
+	if (m_document)
+	{
+		dst.assign((const char*)getTokenPtr(), (size_t)m_curTokenLen);
+		return;
+	}
+
 	dst.resize(m_curTokenLen);
 	for (int ndx = 0; ndx < m_curTokenLen; ndx++)
 		dst[ndx] = m_buf.peekBack(ndx);
@@ -212,6 +232,12 @@ inline void Tokenizer::appendTokenStr (std::string& dst) const
 {
 	DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING);
 
+	if (m_document)
+	{
+		dst.append((const char*)getTokenPtr(), (size_t)m_curTokenLen);
+		return;
+	}
+
 	size_t oldLen = dst.size();
 	dst.resize(oldLen+m_curTokenLen);
 
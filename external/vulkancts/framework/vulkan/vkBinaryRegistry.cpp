@@ -32,6 +32,8 @@
 #include "deFile.h"
 #include "deMemory.h"
 
+#include <zlib.h>
+
 #include <sstream>
 #include <fstream>
 #include <stdexcept>
@@ -106,6 +108,17 @@ string getIndexPath (const std::string& dirName)
 	return de::FilePath::join(dirName, "index.bin").getPath();
 }
 
+string getPackPath (const std::string& dirName)
+{
+	return de::FilePath::join(dirName, "programs.pack").getPath();
+}
+
+void deleteFileIfExists (const std::string& path)
+{
+	if (de::FilePath(path).exists())
+		deDeleteFile(path.c_str());
+}
+
 void writeBinary (const ProgramBinary& binary, const std::string& dstPath)
 {
 	const de::FilePath	filePath(dstPath);
@@ -384,6 +397,21 @@ void buildBinaryIndex (std::vector<BinaryIndexNode>* dst, size_t numEntries, con
 	buildFinalIndex(dst, sparseIndex.get());
 }
 
+//! Compress binary with zlib. Returns false if compressed data wouldn't be smaller.
+bool compressBinary (const ProgramBinary& binary, std::vector<deUint8>* dst)
+{
+	uLongf	compressedSize	= compressBound((uLong)binary.getSize());
+
+	dst->resize((size_t)compressedSize);
+
+	if (compress2(&(*dst)[0], &compressedSize, binary.getBinary(), (uLong)binary.getSize(), Z_BEST_COMPRESSION) != Z_OK ||
+		(size_t)compressedSize >= binary.getSize())
+		return false;
+
+	dst->resize((size_t)compressedSize);
+	return true;
+}
+
 } // anonymous
 
 // BinaryIndexHash
@@ -512,11 +540,19 @@ void BinaryRegistryWriter::write (void) const
 	writeToPath(m_dstPath);
 }
 
+void BinaryRegistryWriter::writePacked (bool compressBinaries) const
+{
+	writePackedToPath(m_dstPath, compressBinaries);
+}
+
 void BinaryRegistryWriter::writeToPath (const std::string& dstPath) const
 {
 	if (!de::FilePath(dstPath).exists())
 		de::createDirectoryAndParents(dstPath.c_str());
 
+	// Packed binaries would take precedence over the files written here
+	deleteFileIfExists(getPackPath(dstPath));
+
 	DE_ASSERT(m_binaries.size() <= 0xffffffffu);
 	for (size_t binaryNdx = 0; binaryNdx < m_binaries.size(); ++binaryNdx)
 	{
@@ -562,6 +598,100 @@ void BinaryRegistryWriter::writeToPath (const std::string& dstPath) const
 	}
 }
 
+void BinaryRegistryWriter::writePackedToPath (const std::string& dstPath, bool compressBinaries) const
+{
+	// Unreferenced slots are dropped, so packed binary indices differ from slot indices
+	std::vector<deUint32>				packedNdx		(m_binaries.size(), ~0u);
+	std::vector<const ProgramBinary*>	binaries;
+	ProgIdIndexVector					packedIndices;
+	std::vector<BinaryIndexNode>		index;
+
+	for (size_t binaryNdx = 0; binaryNdx < m_binaries.size(); ++binaryNdx)
+	{
+		if (m_binaries[binaryNdx].referenceCount > 0)
+		{
+			DE_ASSERT(m_binaries[binaryNdx].binary);
+			packedNdx[binaryNdx] = (deUint32)binaries.size();
+			binaries.push_back(m_binaries[binaryNdx].binary);
+		}
+	}
+
+	packedIndices.reserve(m_binaryIndices.size());
+
+	for (ProgIdIndexVector::const_iterator iter = m_binaryIndices.begin(); iter != m_binaryIndices.end(); ++iter)
+		packedIndices.push_back(ProgramIdentifierIndex(iter->id, packedNdx[iter->index]));
+
+	buildBinaryIndex(&index, packedIndices.size(), !packedIndices.empty() ? &packedIndices[0] : DE_NULL);
+	DE_ASSERT(!index.empty());
+
+	{
+		std::vector<PackedBinaryEntry>		entries			(binaries.size());
+		std::vector<std::vector<deUint8> >	compressed		(binaries.size());
+		PackedBinaryHeader					header;
+		size_t								dataOffset;
+
+		header.magic			= PACKED_BINARY_MAGIC;
+		header.version			= PACKED_BINARY_VERSION;
+		header.numIndexNodes	= (deUint32)index.size();
+		header.numBinaries		= (deUint32)binaries.size();
+
+		dataOffset = sizeof(PackedBinaryHeader) + index.size()*sizeof(BinaryIndexNode) + entries.size()*sizeof(PackedBinaryEntry);
+
+		for (size_t binaryNdx = 0; binaryNdx < binaries.size(); ++binaryNdx)
+		{
+			PackedBinaryEntry&	entry	= entries[binaryNdx];
+
+			if (!compressBinaries || !compressBinary(*binaries[binaryNdx], &compressed[binaryNdx]))
+				compressed[binaryNdx].clear();
+
+			entry.offset			= (deUint32)dataOffset;
+			entry.uncompressedSize	= (deUint32)binaries[binaryNdx]->getSize();
+			entry.compression		= compressed[binaryNdx].empty() ? PACKED_BINARY_COMPRESSION_NONE : PACKED_BINARY_COMPRESSION_ZLIB;
+			entry.size				= compressed[binaryNdx].empty() ? entry.uncompressedSize : (deUint32)compressed[binaryNdx].size();
+
+			dataOffset += entry.size;
+
+			// tcu::Resource positions are ints
+			if (dataOffset > (size_t)std::numeric_limits<int>::max())
+				throw tcu::InternalError("Packed program binaries exceed maximum file size");
+		}
+
+		if (!de::FilePath(dstPath).exists())
+			de::createDirectoryAndParents(dstPath.c_str());
+
+		{
+			const string	packPath	= getPackPath(dstPath);
+			std::ofstream	out			(packPath.c_str(), std::ios_base::binary);
+
+			if (!out.is_open() || !out.good())
+				throw tcu::InternalError(string("Failed to open packed program binary file ") + packPath);
+
+			out.write((const char*)&header, sizeof(header));
+			out.write((const char*)&index[0], index.size()*sizeof(BinaryIndexNode));
+
+			if (!entries.empty())
+				out.write((const char*)&entries[0], entries.size()*sizeof(PackedBinaryEntry));
+
+			for (size_t binaryNdx = 0; binaryNdx < binaries.size(); ++binaryNdx)
+			{
+				if (compressed[binaryNdx].empty())
+					out.write((const char*)binaries[binaryNdx]->getBinary(), binaries[binaryNdx]->getSize());
+				else
+					out.write((const char*)&compressed[binaryNdx][0], compressed[binaryNdx].size());
+			}
+
+			if (!out.good())
+				throw tcu::InternalError(string("Failed to write packed program binary file ") + packPath);
+		}
+	}
+
+	// Remove index and binaries written in per-file format
+	deleteFileIfExists(getIndexPath(dstPath));
+
+	for (size_t binaryNdx = 0; binaryNdx < m_binaries.size(); ++binaryNdx)
+		deleteFileIfExists(getProgramPath(dstPath, (deUint32)binaryNdx));
+}
+
 // BinaryRegistryReader
 
 BinaryRegistryReader::BinaryRegistryReader (const tcu::Archive& archive, const std::string& srcPath)
@@ -574,16 +704,116 @@ BinaryRegistryReader::~BinaryRegistryReader (void)
 {
 }
 
+void BinaryRegistryReader::openIndex (void) const
+{
+	// Prefer packed binaries if present
+	try
+	{
+		m_packResource = ResourcePtr(m_archive.getResource(getPackPath(m_srcPath).c_str()));
+	}
+	catch (const tcu::ResourceError&)
+	{
+	}
+
+	if (m_packResource)
+	{
+		PackedBinaryHeader	header;
+		const size_t		packSize	= (size_t)m_packResource->getSize();
+
+		TCU_CHECK_AND_THROW(ResourceError, packSize >= sizeof(header), "Malformed packed program binary file");
+		m_packResource->read((deUint8*)&header, (int)sizeof(header));
+
+		TCU_CHECK_AND_THROW(ResourceError, header.magic == PACKED_BINARY_MAGIC && header.version == PACKED_BINARY_VERSION, "Unsupported packed program binary file");
+		TCU_CHECK_AND_THROW(ResourceError, header.numIndexNodes > 0 &&
+										   header.numIndexNodes <= (packSize - sizeof(header)) / sizeof(BinaryIndexNode) &&
+										   header.numBinaries <= (packSize - sizeof(header) - header.numIndexNodes*sizeof(BinaryIndexNode)) / sizeof(PackedBinaryEntry),
+							"Malformed packed program binary file");
+
+		// Entry table is small compared to the index, so it is read completely
+		m_packedBinaries.resize(header.numBinaries);
+
+		if (header.numBinaries > 0)
+		{
+			m_packResource->setPosition((int)(sizeof(header) + header.numIndexNodes*sizeof(BinaryIndexNode)));
+			m_packResource->read((deUint8*)&m_packedBinaries[0], (int)(m_packedBinaries.size()*sizeof(PackedBinaryEntry)));
+		}
+
+		m_binaryIndex = BinaryIndexPtr(new BinaryIndexAccess(*m_packResource, sizeof(header), header.numIndexNodes));
+	}
+	else
+		m_binaryIndex = BinaryIndexPtr(new BinaryIndexAccess(de::MovePtr<tcu::Resource>(m_archive.getResource(getIndexPath(m_srcPath).c_str()))));
+}
+
+ProgramBinary* BinaryRegistryReader::loadBinaryFile (const ProgramIdentifier& id, deUint32 index) const
+{
+	const string	fullPath	= getProgramPath(m_srcPath, index);
+
+	try
+	{
+		de::UniquePtr<tcu::Resource>	progRes		(m_archive.getResource(fullPath.c_str()));
+		const int						progSize	= progRes->getSize();
+		vector<deUint8>					bytes		(progSize);
+
+		TCU_CHECK_INTERNAL(!bytes.empty());
+
+		progRes->read(&bytes[0], progSize);
+
+		return new ProgramBinary(vk::PROGRAM_FORMAT_SPIRV, bytes.size(), &bytes[0]);
+	}
+	catch (const tcu::ResourceError& e)
+	{
+		throw ProgramNotFoundException(id, e.what());
+	}
+}
+
+ProgramBinary* BinaryRegistryReader::loadPackedBinary (const ProgramIdentifier& id, deUint32 index) const
+{
+	if ((size_t)index >= m_packedBinaries.size())
+		throw ProgramNotFoundException(id, "Invalid binary index in packed program binaries");
+
+	const PackedBinaryEntry&	entry		= m_packedBinaries[index];
+	const size_t				packSize	= (size_t)m_packResource->getSize();
+	vector<deUint8>				stored		(entry.size);
+
+	if (entry.size == 0 || entry.uncompressedSize == 0 || entry.offset > packSize || entry.size > packSize - entry.offset)
+		throw ProgramNotFoundException(id, "Malformed entry in packed program binaries");
+
+	m_packResource->setPosition((int)entry.offset);
+	m_packResource->read(&stored[0], (int)stored.size());
+
+	if (entry.compression == PACKED_BINARY_COMPRESSION_NONE)
+	{
+		if (entry.size != entry.uncompressedSize)
+			throw ProgramNotFoundException(id, "Malformed entry in packed program binaries");
+
+		return new ProgramBinary(vk::PROGRAM_FORMAT_SPIRV, stored.size(), &stored[0]);
+	}
+	else if (entry.compression == PACKED_BINARY_COMPRESSION_ZLIB)
+	{
+		vector<deUint8>	bytes		(entry.uncompressedSize);
+		uLongf			numBytes	= (uLongf)bytes.size();
+
+		if (uncompress(&bytes[0], &numBytes, &stored[0], (uLong)stored.size()) != Z_OK || (size_t)numBytes != bytes.size())
+			throw ProgramNotFoundException(id, "Failed to decompress binary");
+
+		return new ProgramBinary(vk::PROGRAM_FORMAT_SPIRV, bytes.size(), &bytes[0]);
+	}
+	else
+		throw ProgramNotFoundException(id, "Unknown compression in packed program binaries");
+}
+
 ProgramBinary* BinaryRegistryReader::loadProgram (const ProgramIdentifier& id) const
 {
 	if (!m_binaryIndex)
 	{
 		try
 		{
-			m_binaryIndex = BinaryIndexPtr(new BinaryIndexAccess(de::MovePtr<tcu::Resource>(m_archive.getResource(getIndexPath(m_srcPath).c_str()))));
+			openIndex();
 		}
 		catch (const tcu::ResourceError& e)
 		{
+			m_packResource.clear();
+			m_packedBinaries.clear();
 			throw ProgramNotFoundException(id, string("Failed to open binary index (") + e.what() + ")");
 		}
 	}
@@ -591,29 +821,13 @@ ProgramBinary* BinaryRegistryReader::loadProgram (const ProgramIdentifier& id) c
 	{
 		const deUint32*	indexPos	= findBinaryIndex(m_binaryIndex.get(), id);
 
-		if (indexPos)
-		{
-			const string	fullPath	= getProgramPath(m_srcPath, *indexPos);
-
-			try
-			{
-				de::UniquePtr<tcu::Resource>	progRes		(m_archive.getResource(fullPath.c_str()));
-				const int						progSize	= progRes->getSize();
-				vector<deUint8>					bytes		(progSize);
-
-				TCU_CHECK_INTERNAL(!bytes.empty());
-
-				progRes->read(&bytes[0], progSize);
+		if (!indexPos)
+			throw ProgramNotFoundException(id, "Program not found in index");
 
-				return new ProgramBinary(vk::PROGRAM_FORMAT_SPIRV, bytes.size(), &bytes[0]);
-			}
-			catch (const tcu::ResourceError& e)
-			{
-				throw ProgramNotFoundException(id, e.what());
-			}
-		}
+		if (m_packResource)
+			return loadPackedBinary(id, *indexPos);
 		else
-			throw ProgramNotFoundException(id, "Program not found in index");
+			return loadBinaryFile(id, *indexPos);
 	}
 }
 
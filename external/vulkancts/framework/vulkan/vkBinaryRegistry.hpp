@@ -98,11 +98,57 @@ struct BinaryIndexNode
 	deUint32	index;		//!< Binary index if word ends with 0 bytes, or index of first child node otherwise.
 };
 
+// Packed Program Binaries
+// -----------------------
+//
+// Instead of storing index and each binary in separate files, all of them can
+// be packed into a single file. That avoids opening a file for each program and
+// makes deploying prebuilt binaries much cheaper. Packed file consists of:
+//
+//  PackedBinaryHeader
+//  BinaryIndexNode[numIndexNodes]		(same index as above)
+//  PackedBinaryEntry[numBinaries]		(binary index -> location of binary data)
+//  Binary data
+//
+// Binaries may be individually compressed with zlib. Compression is only used
+// when it makes the binary smaller.
+
+enum
+{
+	PACKED_BINARY_MAGIC		= 0x42504b56u,	//!< "VKPB"
+	PACKED_BINARY_VERSION	= 1
+};
+
+enum PackedBinaryCompression
+{
+	PACKED_BINARY_COMPRESSION_NONE = 0,
+	PACKED_BINARY_COMPRESSION_ZLIB,
+
+	PACKED_BINARY_COMPRESSION_LAST
+};
+
+struct PackedBinaryHeader
+{
+	deUint32	magic;
+	deUint32	version;
+	deUint32	numIndexNodes;
+	deUint32	numBinaries;
+};
+
+struct PackedBinaryEntry
+{
+	deUint32	offset;				//!< Offset of binary data from the beginning of the file.
+	deUint32	size;				//!< Size of stored (possibly compressed) data.
+	deUint32	uncompressedSize;	//!< Size of binary.
+	deUint32	compression;		//!< PackedBinaryCompression
+};
+
 template<typename Element>
 class LazyResource
 {
 public:
 									LazyResource		(de::MovePtr<tcu::Resource> resource);
+									LazyResource		(tcu::Resource& resource, size_t offset, size_t numElements);
 
 	const Element&					operator[]			(size_t ndx);
 	size_t							size				(void) const { return m_elements.size();	}
@@ -118,7 +164,9 @@ private:
 
 	void							makePageResident	(size_t pageNdx);
 
-	de::UniquePtr<tcu::Resource>	m_resource;
+	de::UniquePtr<tcu::Resource>	m_ownedResource;
+	tcu::Resource&					m_resource;
+	const size_t					m_offset;			//!< Offset of first element in resource
 
 	std::vector<Element>			m_elements;
 	std::vector<bool>				m_isPageResident;
@@ -126,9 +174,11 @@ private:
 
 template<typename Element>
 LazyResource<Element>::LazyResource (de::MovePtr<tcu::Resource> resource)
-	: m_resource(resource)
+	: m_ownedResource	(resource.release())
+	, m_resource		(*m_ownedResource)
+	, m_offset			(0)
 {
-	const size_t	resSize		= m_resource->getSize();
+	const size_t	resSize		= m_resource.getSize();
 	const size_t	numElements	= resSize/sizeof(Element);
 	const size_t	numPages	= (numElements >> ELEMENTS_PER_PAGE_LOG2) + ((numElements & ((1u<<ELEMENTS_PER_PAGE_LOG2)-1u)) == 0 ? 0 : 1);
 
@@ -138,6 +188,21 @@ LazyResource<Element>::LazyResource (de::MovePtr<tcu::Resource> resource)
 	m_isPageResident.resize(numPages, false);
 }
 
+//! Access elements stored in part of resource. Resource is not owned and must outlive LazyResource.
+template<typename Element>
+LazyResource<Element>::LazyResource (tcu::Resource& resource, size_t offset, size_t numElements)
+	: m_ownedResource	(DE_NULL)
+	, m_resource		(resource)
+	, m_offset			(offset)
+{
+	const size_t	numPages	= (numElements >> ELEMENTS_PER_PAGE_LOG2) + ((numElements & ((1u<<ELEMENTS_PER_PAGE_LOG2)-1u)) == 0 ? 0 : 1);
+
+	TCU_CHECK_INTERNAL(offset + numElements*sizeof(Element) <= (size_t)m_resource.getSize());
+
+	m_elements.resize(numElements);
+	m_isPageResident.resize(numPages, false);
+}
+
 template<typename Element>
 const Element& LazyResource<Element>::operator[] (size_t ndx)
 {
@@ -161,10 +226,10 @@ void LazyResource<Element>::makePageResident (size_t pageNdx)
 
 	DE_ASSERT(!isPageResident(pageNdx));
 
-	if ((size_t)m_resource->getPosition() != pageOffset)
-		m_resource->setPosition((int)pageOffset);
+	if ((size_t)m_resource.getPosition() != m_offset + pageOffset)
+		m_resource.setPosition((int)(m_offset + pageOffset));
 
-	m_resource->read((deUint8*)&m_elements[pageNdx << ELEMENTS_PER_PAGE_LOG2], (int)numBytesToRead);
+	m_resource.read((deUint8*)&m_elements[pageNdx << ELEMENTS_PER_PAGE_LOG2], (int)numBytesToRead);
 	m_isPageResident[pageNdx] = true;
 }
 
@@ -179,12 +244,20 @@ public:
 	ProgramBinary*			loadProgram				(const ProgramIdentifier& id) const;
 
 private:
-	typedef de::MovePtr<BinaryIndexAccess> BinaryIndexPtr;
+	typedef de::MovePtr<BinaryIndexAccess>		BinaryIndexPtr;
+	typedef de::MovePtr<tcu::Resource>			ResourcePtr;
+	typedef std::vector<PackedBinaryEntry>		PackedBinaryVector;
+
+	void					openIndex				(void) const;
+	ProgramBinary*			loadBinaryFile			(const ProgramIdentifier& id, deUint32 index) const;
+	ProgramBinary*			loadPackedBinary		(const ProgramIdentifier& id, deUint32 index) const;
 
-	const tcu::Archive&		m_archive;
-	const std::string		m_srcPath;
+	const tcu::Archive&			m_archive;
+	const std::string			m_srcPath;
 
-	mutable BinaryIndexPtr	m_binaryIndex;
+	mutable ResourcePtr			m_packResource;		//!< Packed binaries, if present
+	mutable PackedBinaryVector	m_packedBinaries;
+	mutable BinaryIndexPtr		m_binaryIndex;
 };
 
 struct ProgramIdentifierIndex
@@ -226,10 +299,12 @@ public:
 
 	void				addProgram				(const ProgramIdentifier& id, const ProgramBinary& binary);
 	void				write					(void) const;
+	void				writePacked				(bool compressBinaries) const;
 
 private:
 	void				initFromPath			(const std::string& srcPath);
 	void				writeToPath				(const std::string& dstPath) const;
+	void				writePackedToPath		(const std::string& dstPath, bool compressBinaries) const;
 
 	deUint32*			findBinary				(const ProgramBinary& binary) const;
 	deUint32			getNextSlot				(void) const;
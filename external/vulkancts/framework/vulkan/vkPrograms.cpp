@@ -37,10 +37,37 @@
 #include "deArrayUtil.hpp"
 #include "deMemory.h"
 #include "deInt32.h"
+#include "deAtomic.h"
+#include "deFile.h"
+#include "deRandom.hpp"
+#include "deStringUtil.hpp"
 
 #include "tcuCommandLine.hpp"
 
 #include <map>
+#include <algorithm>
+#include <limits>
+#include <cstdio>
+
+#if (DE_OS == DE_OS_UNIX) || (DE_OS == DE_OS_OSX) || (DE_OS == DE_OS_IOS) || (DE_OS == DE_OS_ANDROID) || (DE_OS == DE_OS_QNX)
+#	include <sys/types.h>
+#	include <sys/stat.h>
+#	include <sys/mman.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#	define SHADER_CACHE_USE_MMAP	1
+#else
+#	define SHADER_CACHE_USE_MMAP	0
+#endif
+
+// 64-bit file offsets, long is 32 bits on Windows
+#if (DE_OS == DE_OS_WIN32)
+#	define SHADER_CACHE_FSEEK	_fseeki64
+#	define SHADER_CACHE_FTELL	_ftelli64
+#else
+#	define SHADER_CACHE_FSEEK	fseeko
+#	define SHADER_CACHE_FTELL	ftello
+#endif
 
 namespace vk
 {
@@ -335,8 +362,583 @@ ProgramBinary* createProgramBinaryFromSpirV (const vector<deUint32>& binary)
 
 #endif // defined(DEQP_HAVE_SPIRV_TOOLS)
 
+// Shader cache file
+//
+// The cache file is a log of chunks, each holding one compiled program:
+//
+//   deUint32	chunkSize		(size of the whole chunk, including this field)
+//   deUint32	hash			(deStringHash() of the cache key)
+//   deInt32	format
+//   deUint32	binaryLength
+//   deUint8	binary[binaryLength]
+//   deUint32	sourceLength
+//   char		source[sourceLength]	(cache key, not null-terminated)
+//
+// A file written by compactShaderCache() begins with ShaderCacheHeader and
+// an index of all chunks in the compacted part, sorted by hash, so that the
+// file doesn't need to be scanned on open. Chunks appended after compaction
+// are stored after the compacted part, starting at logOffset. Files without
+// the header are plain chunk logs.
+//
+// Chunks are appended with a single unbuffered write to a file opened in
+// append mode, which allows multiple processes to share one cache file.
+// A chunk that is still being written by another process is seen as
+// truncated and is ignored.
+
+enum
+{
+	SHADER_CACHE_MAGIC			= 0x43565053u,	//!< "SPVC"
+	SHADER_CACHE_VERSION		= 1,
+	SHADER_CACHE_CHUNK_HEADER	= 4 * 4,		//!< chunkSize, hash, format, binaryLength
+	SHADER_CACHE_MIN_CHUNK_SIZE	= SHADER_CACHE_CHUNK_HEADER + 4,
+	SHADER_CACHE_READ_SIZE		= 1024 * 1024	//!< Max bytes per read call when loading cache file
+};
+
+struct ShaderCacheHeader
+{
+	deUint32	magic;
+	deUint32	version;
+	deUint32	numEntries;
+	deUint32	reserved;
+	deUint64	logOffset;
+};
+
+struct ShaderCacheIndexEntry
+{
+	deUint32	hash;
+	deUint32	chunkSize;
+	deUint64	offset;
+
+	bool operator< (const ShaderCacheIndexEntry& other) const
+	{
+		return (hash != other.hash) ? (hash < other.hash) : (offset < other.offset);
+	}
+};
+
+DE_STATIC_ASSERT(sizeof(ShaderCacheHeader) == 24);
+DE_STATIC_ASSERT(sizeof(ShaderCacheIndexEntry) == 16);
+
+struct ShaderCacheChunk
+{
+	deUint32		hash;
+	deInt32			format;
+	const deUint8*	binary;
+	deUint32		binaryLength;
+	const char*		source;
+	deUint32		sourceLength;
+};
+
+struct CompareIndexEntryHash
+{
+	bool operator() (const ShaderCacheIndexEntry& entry, deUint32 hash) const { return entry.hash < hash; }
+	bool operator() (deUint32 hash, const ShaderCacheIndexEntry& entry) const { return hash < entry.hash; }
+};
+
+inline deUint32 readUint32 (const deUint8* ptr)
+{
+	deUint32 value;
+	deMemcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+inline void writeUint32 (deUint8* ptr, deUint32 value)
+{
+	deMemcpy(ptr, &value, sizeof(value));
+}
+
+//! Read-only view of the whole cache file. Memory-mapped where supported, so
+//! that processes sharing a cache also share its pages.
+//!
+//! \note Other processes only append to the file or replace it with rename(),
+//!		  neither of which affects the mapped range. The file must never be
+//!		  truncated in place, as accessing the mapping would then fault.
+class ShaderCacheFile
+{
+public:
+							ShaderCacheFile		(void);
+							~ShaderCacheFile	(void);
+
+	void					open				(const char* filename);
+
+	const deUint8*			getData				(void) const { return m_data;	}
+	size_t					getSize				(void) const { return m_size;	}
+
+private:
+							ShaderCacheFile		(const ShaderCacheFile&);
+	ShaderCacheFile&		operator=			(const ShaderCacheFile&);
+
+	void					close				(void);
+
+	const deUint8*			m_data;
+	size_t					m_size;
+#if SHADER_CACHE_USE_MMAP
+	void*					m_mapping;
+#else
+	std::vector<deUint8>	m_buffer;
+#endif
+};
+
+ShaderCacheFile::ShaderCacheFile (void)
+	: m_data	(DE_NULL)
+	, m_size	(0)
+#if SHADER_CACHE_USE_MMAP
+	, m_mapping	(DE_NULL)
+#endif
+{
+}
+
+ShaderCacheFile::~ShaderCacheFile (void)
+{
+	close();
+}
+
+void ShaderCacheFile::close (void)
+{
+#if SHADER_CACHE_USE_MMAP
+	if (m_mapping)
+		munmap(m_mapping, m_size);
+	m_mapping = DE_NULL;
+#else
+	m_buffer.clear();
+#endif
+	m_data = DE_NULL;
+	m_size = 0;
+}
+
+void ShaderCacheFile::open (const char* filename)
+{
+	close();
+
+#if SHADER_CACHE_USE_MMAP
+	const int fd = ::open(filename, O_RDONLY);
+
+	if (fd < 0)
+		return;
+
+	struct stat st;
+
+	if (fstat(fd, &st) == 0 && st.st_size > 0 && (deUint64)st.st_size <= (deUint64)std::numeric_limits<size_t>::max())
+	{
+		void* const mapping = mmap(DE_NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+		if (mapping != MAP_FAILED)
+		{
+			m_mapping	= mapping;
+			m_data		= (const deUint8*)mapping;
+			m_size		= (size_t)st.st_size;
+		}
+	}
+
+	::close(fd);
+#else
+	deFile* const file = deFile_create(filename, DE_FILEMODE_OPEN|DE_FILEMODE_READ);
+
+	if (!file)
+		return;
+
+	const deInt64	size		= deFile_getSize(file);
+	deInt64			numRead		= 0;
+
+	if (size > 0 && (deUint64)size <= (deUint64)std::numeric_limits<size_t>::max())
+	{
+		m_buffer.resize((size_t)size);
+
+		while (numRead < size)
+		{
+			const deInt64	readSize		= de::min<deInt64>(size - numRead, SHADER_CACHE_READ_SIZE);
+			deInt64			numReadNow		= 0;
+
+			if (deFile_read(file, &m_buffer[(size_t)numRead], readSize, &numReadNow) != DE_FILERESULT_SUCCESS || numReadNow <= 0)
+				break;
+
+			numRead += numReadNow;
+		}
+
+		// File may have been truncated after querying size. Truncated chunks are skipped by indexShaderCache().
+		m_buffer.resize((size_t)numRead);
+
+		if (!m_buffer.empty())
+		{
+			m_data	= &m_buffer[0];
+			m_size	= m_buffer.size();
+		}
+	}
+
+	deFile_destroy(file);
+#endif
+}
+
+//! Build sorted index of all chunks in cache file data. A truncated last chunk is skipped.
+void indexShaderCache (const deUint8* data, size_t size, vector<ShaderCacheIndexEntry>& index)
+{
+	size_t offset = 0;
+
+	index.clear();
+
+	if (size >= sizeof(ShaderCacheHeader) && readUint32(data) == SHADER_CACHE_MAGIC)
+	{
+		ShaderCacheHeader header;
+		deMemcpy(&header, data, sizeof(header));
+
+		const size_t indexEnd = sizeof(ShaderCacheHeader) + (size_t)header.numEntries * sizeof(ShaderCacheIndexEntry);
+
+		// Unknown version or corrupted header: ignore the whole file
+		if (header.version != SHADER_CACHE_VERSION || header.numEntries > (size - sizeof(ShaderCacheHeader)) / sizeof(ShaderCacheIndexEntry) ||
+			header.logOffset < indexEnd || header.logOffset > size)
+			return;
+
+		index.resize(header.numEntries);
+		if (header.numEntries > 0)
+			deMemcpy(&index[0], data + sizeof(ShaderCacheHeader), header.numEntries * sizeof(ShaderCacheIndexEntry));
+
+		offset = (size_t)header.logOffset;
+	}
+
+	{
+		const size_t numIndexed = index.size();
+
+		while (size - offset >= 8)
+		{
+			ShaderCacheIndexEntry entry;
+
+			entry.chunkSize	= readUint32(data + offset);
+			entry.hash		= readUint32(data + offset + 4);
+			entry.offset	= offset;
+
+			if (entry.chunkSize < SHADER_CACHE_MIN_CHUNK_SIZE || entry.chunkSize > size - offset)
+				break;
+
+			index.push_back(entry);
+			offset += entry.chunkSize;
+		}
+
+		if (numIndexed != index.size())
+		{
+			std::sort(index.begin() + numIndexed, index.end());
+			std::inplace_merge(index.begin(), index.begin() + numIndexed, index.end());
+		}
+	}
+}
+
+//! Parse and validate chunk at given offset.
+bool readShaderCacheChunk (const deUint8* data, size_t size, deUint64 offset, ShaderCacheChunk* chunk)
+{
+	if (offset > size || size - (size_t)offset < SHADER_CACHE_MIN_CHUNK_SIZE)
+		return false;
+
+	const deUint8* const	ptr				= data + (size_t)offset;
+	const deUint32			chunkSize		= readUint32(ptr);
+	const deUint32			binaryLength	= readUint32(ptr + 12);
+
+	if (chunkSize < SHADER_CACHE_MIN_CHUNK_SIZE || chunkSize > size - (size_t)offset)
+		return false;
+
+	if (binaryLength == 0 || binaryLength > chunkSize - SHADER_CACHE_MIN_CHUNK_SIZE)
+		return false;
+
+	const deUint32			sourceLength	= readUint32(ptr + SHADER_CACHE_CHUNK_HEADER + binaryLength);
+
+	if (sourceLength != chunkSize - SHADER_CACHE_MIN_CHUNK_SIZE - binaryLength)
+		return false;
+
+	chunk->hash			= readUint32(ptr + 4);
+	chunk->format		= (deInt32)readUint32(ptr + 8);
+	chunk->binary		= ptr + SHADER_CACHE_CHUNK_HEADER;
+	chunk->binaryLength	= binaryLength;
+	chunk->source		= (const char*)(ptr + SHADER_CACHE_MIN_CHUNK_SIZE + binaryLength);
+	chunk->sourceLength	= sourceLength;
+
+	return true;
+}
+
+inline bool isSameSource (const ShaderCacheChunk& chunk, const char* source, size_t sourceLength)
+{
+	return chunk.sourceLength == sourceLength && deMemCmp(chunk.source, source, sourceLength) == 0;
+}
+
+//! Find chunk for source in indexed cache file data. There may be more than one candidate if there were hash collisions.
+bool findShaderCacheChunk (const deUint8* data, size_t size, const vector<ShaderCacheIndexEntry>& index, const std::string& source, ShaderCacheChunk* chunk)
+{
+	const deUint32																									hash	= deStringHash(source.c_str());
+	const std::pair<vector<ShaderCacheIndexEntry>::const_iterator, vector<ShaderCacheIndexEntry>::const_iterator>	range	= std::equal_range(index.begin(), index.end(), hash, CompareIndexEntryHash());
+
+	for (vector<ShaderCacheIndexEntry>::const_iterator entry = range.first; entry != range.second; ++entry)
+	{
+		if (readShaderCacheChunk(data, size, entry->offset, chunk) &&
+			chunk->hash == hash && isSameSource(*chunk, source.c_str(), source.length()))
+			return true;
+	}
+
+	return false;
+}
+
+//! Serialize chunk for source into dst.
+void buildShaderCacheChunk (deInt32 format, const deUint8* binary, deUint32 binaryLength, const std::string& source, vector<deUint8>& dst)
+{
+	const deUint32	sourceLength	= (deUint32)source.length();
+	const deUint32	chunkSize		= SHADER_CACHE_MIN_CHUNK_SIZE + binaryLength + sourceLength;
+
+	dst.resize(chunkSize);
+
+	writeUint32(&dst[0],	chunkSize);
+	writeUint32(&dst[4],	deStringHash(source.c_str()));
+	writeUint32(&dst[8],	(deUint32)format);
+	writeUint32(&dst[12],	binaryLength);
+	deMemcpy(&dst[SHADER_CACHE_CHUNK_HEADER], binary, binaryLength);
+	writeUint32(&dst[SHADER_CACHE_CHUNK_HEADER + binaryLength], sourceLength);
+	deMemcpy(&dst[SHADER_CACHE_MIN_CHUNK_SIZE + binaryLength], source.c_str(), sourceLength);
+}
+
 } // anonymous
 
+deUint32 compactShaderCache (const char* shaderCacheFilename)
+{
+	const std::string				tmpFilename		= std::string(shaderCacheFilename) + ".tmp";
+	ShaderCacheFile					src;
+	vector<ShaderCacheIndexEntry>	srcIndex;
+	vector<ShaderCacheIndexEntry>	dstIndex;
+	vector<deUint64>				srcOffsets;
+	deUint64						dstOffset;
+
+	src.open(shaderCacheFilename);
+	indexShaderCache(src.getData(), src.getSize(), srcIndex);
+
+	// Drop invalid chunks and duplicates written by concurrent processes. The source
+	// index is sorted by hash, so candidates for duplicates are consecutive.
+	for (size_t groupStart = 0; groupStart < srcIndex.size();)
+	{
+		const deUint32	hash		= srcIndex[groupStart].hash;
+		const size_t	firstKept	= dstIndex.size();
+		size_t			groupEnd	= groupStart;
+
+		for (; groupEnd < srcIndex.size() && srcIndex[groupEnd].hash == hash; groupEnd++)
+		{
+			ShaderCacheChunk	chunk;
+			bool				isDuplicate	= false;
+
+			if (!readShaderCacheChunk(src.getData(), src.getSize(), srcIndex[groupEnd].offset, &chunk) || chunk.hash != hash)
+				continue;
+
+			for (size_t keptNdx = firstKept; keptNdx < dstIndex.size() && !isDuplicate; keptNdx++)
+			{
+				ShaderCacheChunk kept;
+				readShaderCacheChunk(src.getData(), src.getSize(), srcOffsets[keptNdx], &kept);
+				isDuplicate = isSameSource(kept, chunk.source, chunk.sourceLength);
+			}
+
+			if (!isDuplicate)
+			{
+				ShaderCacheIndexEntry entry;
+
+				entry.hash		= hash;
+				entry.chunkSize	= readUint32(src.getData() + (size_t)srcIndex[groupEnd].offset);
+				entry.offset	= 0;
+
+				dstIndex.push_back(entry);
+				srcOffsets.push_back(srcIndex[groupEnd].offset);
+			}
+		}
+
+		groupStart = groupEnd;
+	}
+
+	dstOffset = sizeof(ShaderCacheHeader) + dstIndex.size() * sizeof(ShaderCacheIndexEntry);
+
+	for (size_t ndx = 0; ndx < dstIndex.size(); ndx++)
+	{
+		dstIndex[ndx].offset	 = dstOffset;
+		dstOffset				+= dstIndex[ndx].chunkSize;
+	}
+
+	{
+		ShaderCacheHeader	header;
+		FILE*				file	= fopen(tmpFilename.c_str(), "wb");
+		bool				ok		= file != DE_NULL;
+
+		header.magic		= SHADER_CACHE_MAGIC;
+		header.version		= SHADER_CACHE_VERSION;
+		header.numEntries	= (deUint32)dstIndex.size();
+		header.reserved		= 0;
+		header.logOffset	= dstOffset;
+
+		if (ok) ok = fwrite(&header, sizeof(header), 1, file) == 1;
+		if (ok && !dstIndex.empty()) ok = fwrite(&dstIndex[0], sizeof(ShaderCacheIndexEntry), dstIndex.size(), file) == dstIndex.size();
+
+		for (size_t ndx = 0; ok && ndx < dstIndex.size(); ndx++)
+			ok = fwrite(src.getData() + (size_t)srcOffsets[ndx], 1, dstIndex[ndx].chunkSize, file) == dstIndex[ndx].chunkSize;
+
+		if (file && fclose(file) != 0)
+			ok = false;
+
+		if (!ok)
+		{
+			deDeleteFile(tmpFilename.c_str());
+			TCU_THROW(ResourceError, ("Failed to write " + tmpFilename).c_str());
+		}
+	}
+
+	// Processes that still have the old file open keep reading it. Rename doesn't
+	// replace existing files on all platforms, so fall back to delete and rename.
+	if (rename(tmpFilename.c_str(), shaderCacheFilename) != 0)
+	{
+		deDeleteFile(shaderCacheFilename);
+
+		if (rename(tmpFilename.c_str(), shaderCacheFilename) != 0)
+			TCU_THROW(ResourceError, ("Failed to replace " + std::string(shaderCacheFilename)).c_str());
+	}
+
+	return (deUint32)dstIndex.size();
+}
+
+namespace
+{
+
+//! Removes shader cache test files when going out of scope.
+struct ShaderCacheTestFiles
+{
+	const std::string	filename;
+
+	ShaderCacheTestFiles (const std::string& filename_)
+		: filename(filename_)
+	{
+		deDeleteFile(filename.c_str());
+	}
+
+	~ShaderCacheTestFiles (void)
+	{
+		deDeleteFile(filename.c_str());
+		deDeleteFile((filename + ".tmp").c_str());
+	}
+};
+
+void writeShaderCacheTestFile (const std::string& filename, const vector<deUint8>& data, const char* mode)
+{
+	FILE* const	file	= fopen(filename.c_str(), mode);
+	bool		ok		= file != DE_NULL;
+
+	if (ok && !data.empty())
+		ok = fwrite(&data[0], 1, data.size(), file) == data.size();
+
+	if (file && fclose(file) != 0)
+		ok = false;
+
+	if (!ok)
+		TCU_THROW(ResourceError, ("Failed to write " + filename).c_str());
+}
+
+//! Check that exactly sources [0, numExpected) are found from file, with matching binaries.
+void checkShaderCacheContents (const std::string& filename, const vector<std::string>& sources, const vector<vector<deUint8> >& binaries, size_t numExpected)
+{
+	ShaderCacheFile					file;
+	vector<ShaderCacheIndexEntry>	index;
+
+	file.open(filename.c_str());
+	indexShaderCache(file.getData(), file.getSize(), index);
+
+	for (size_t ndx = 0; ndx < sources.size(); ndx++)
+	{
+		ShaderCacheChunk	chunk;
+		const bool			found	= findShaderCacheChunk(file.getData(), file.getSize(), index, sources[ndx], &chunk);
+
+		DE_TEST_ASSERT(found == (ndx < numExpected));
+
+		if (found)
+		{
+			DE_TEST_ASSERT(chunk.format == (deInt32)(ndx % 2));
+			DE_TEST_ASSERT(chunk.binaryLength == (deUint32)binaries[ndx].size());
+			DE_TEST_ASSERT(deMemCmp(chunk.binary, &binaries[ndx][0], binaries[ndx].size()) == 0);
+		}
+	}
+}
+
+} // anonymous
+
+void shaderCacheSelfTest (void)
+{
+	const ShaderCacheTestFiles	files		("vk-shadercache-selftest.bin");
+	const int					numSources	= 8;
+	de::Random					rnd			(0x5ade4ca);
+	vector<std::string>			sources;
+	vector<vector<deUint8> >	binaries;
+	vector<deUint8>				log;
+	size_t						lastChunkSize	= 0;
+
+	for (int ndx = 0; ndx < numSources; ndx++)
+	{
+		vector<deUint8>	binary	(4 * rnd.getInt(1, 64));
+		vector<deUint8>	chunk;
+
+		for (size_t byteNdx = 0; byteNdx < binary.size(); byteNdx++)
+			binary[byteNdx] = rnd.getUint8();
+
+		sources.push_back("#version 450\n// shader " + de::toString(ndx) + "\n" + std::string(rnd.getInt(0, 200), 'x'));
+		binaries.push_back(binary);
+
+		buildShaderCacheChunk((deInt32)(ndx % 2), &binary[0], (deUint32)binary.size(), sources.back(), chunk);
+		lastChunkSize = chunk.size();
+
+		log.insert(log.end(), chunk.begin(), chunk.end());
+
+		// Same program saved twice by concurrent processes
+		if (ndx == 2)
+			log.insert(log.end(), chunk.begin(), chunk.end());
+	}
+
+	// Plain chunk log
+	writeShaderCacheTestFile(files.filename, log, "wb");
+	checkShaderCacheContents(files.filename, sources, binaries, numSources);
+
+	// Last chunk partially written
+	{
+		const vector<deUint8> truncated (log.begin(), log.end() - lastChunkSize / 2);
+
+		writeShaderCacheTestFile(files.filename, truncated, "wb");
+		checkShaderCacheContents(files.filename, sources, binaries, numSources - 1);
+
+		// Compaction drops the truncated chunk and the duplicate
+		DE_TEST_ASSERT(compactShaderCache(files.filename.c_str()) == (deUint32)(numSources - 1));
+		checkShaderCacheContents(files.filename, sources, binaries, numSources - 1);
+
+		// Compacting again doesn't change anything
+		DE_TEST_ASSERT(compactShaderCache(files.filename.c_str()) == (deUint32)(numSources - 1));
+		checkShaderCacheContents(files.filename, sources, binaries, numSources - 1);
+	}
+
+	// Chunk appended after compaction is found by scanning the log part
+	{
+		const vector<deUint8>	lastChunk	(log.end() - lastChunkSize, log.end());
+
+		writeShaderCacheTestFile(files.filename, lastChunk, "ab");
+		checkShaderCacheContents(files.filename, sources, binaries, numSources);
+	}
+
+	// Unknown version or magic: file is ignored
+	{
+		vector<deUint8> compacted;
+
+		DE_TEST_ASSERT(compactShaderCache(files.filename.c_str()) == (deUint32)numSources);
+
+		{
+			ShaderCacheFile file;
+			file.open(files.filename.c_str());
+			DE_TEST_ASSERT(file.getSize() >= sizeof(ShaderCacheHeader));
+			DE_TEST_ASSERT(readUint32(file.getData()) == SHADER_CACHE_MAGIC);
+			compacted.assign(file.getData(), file.getData() + file.getSize());
+		}
+
+		checkShaderCacheContents(files.filename, sources, binaries, numSources);
+
+		writeUint32(&compacted[4], SHADER_CACHE_VERSION + 1);
+		writeShaderCacheTestFile(files.filename, compacted, "wb");
+		checkShaderCacheContents(files.filename, sources, binaries, 0);
+
+		writeUint32(&compacted[4], SHADER_CACHE_VERSION);
+		writeUint32(&compacted[0], SHADER_CACHE_MAGIC ^ 0xffu);
+		writeShaderCacheTestFile(files.filename, compacted, "wb");
+		checkShaderCacheContents(files.filename, sources, binaries, 0);
+	}
+}
+
 #if defined(DEQP_HAVE_SPIRV_TOOLS)
 
 void validateCompiledBinary(const vector<deUint32>& binary, glu::ShaderProgramInfo* buildInfo, const SpirvValidatorOptions& options)
@@ -365,48 +967,43 @@ void validateCompiledBinary(const vector<deUint32>& binary, SpirVProgramInfo* bu
 	}
 }
 
+// Snapshot of the cache file taken on first use. It is immutable once
+// cacheFileOpened is set and is read without locking. Chunks appended by
+// this process afterwards are tracked in cacheFileAppended.
 de::Mutex							cacheFileMutex;
-map<deUint32, vector<deUint32> >	cacheFileIndex;
-bool								cacheFileFirstRun = true;
+volatile deUint32					cacheFileOpened		= 0;
+ShaderCacheFile						cacheFile;
+vector<ShaderCacheIndexEntry>		cacheFileIndex;
+map<deUint32, vector<deUint64> >	cacheFileAppended;		//!< Protected by cacheFileMutex
 
 void shaderCacheFirstRunCheck (const char* shaderCacheFile, bool truncate)
 {
-	cacheFileMutex.lock();
-	if (cacheFileFirstRun)
+	if (cacheFileOpened)
+	{
+		// Pairs with the fence before publishing the snapshot below
+		deMemoryReadWriteFence();
+		return;
+	}
+
+	de::ScopedLock lock (cacheFileMutex);
+
+	if (!cacheFileOpened)
 	{
-		cacheFileFirstRun = false;
 		if (truncate)
 		{
-			// Open file with "w" access to truncate it
-			FILE* f = fopen(shaderCacheFile, "wb");
-			if (f)
-				fclose(f);
+			// Remove instead of truncating in place: other processes may have the old file mapped.
+			// Saving creates a new file.
+			deDeleteFile(shaderCacheFile);
 		}
 		else
 		{
-			// Parse chunked shader cache file for hashes and offsets
-			FILE* file = fopen(shaderCacheFile, "rb");
-			int count = 0;
-			if (file)
-			{
-				deUint32 chunksize	= 0;
-				deUint32 hash		= 0;
-				deUint32 offset		= 0;
-				bool ok				= true;
-				while (ok)
-				{
-					offset = (deUint32)ftell(file);
-					if (ok) ok = fread(&chunksize, 1, 4, file)				== 4;
-					if (ok) ok = fread(&hash, 1, 4, file)					== 4;
-					if (ok) cacheFileIndex[hash].push_back(offset);
-					if (ok) ok = fseek(file, offset + chunksize, SEEK_SET)	== 0;
-					count++;
-				}
-				fclose(file);
-			}
+			cacheFile.open(shaderCacheFile);
+			indexShaderCache(cacheFile.getData(), cacheFile.getSize(), cacheFileIndex);
 		}
+
+		deMemoryReadWriteFence();
+		cacheFileOpened = 1;
 	}
-	cacheFileMutex.unlock();
 }
 
 std::string intToString (deUint32 integer)
@@ -420,104 +1017,82 @@ std::string intToString (deUint32 integer)
 
 vk::ProgramBinary* shadercacheLoad (const std::string& shaderstring, const char* shaderCacheFilename)
 {
-	deUint32		hash		= deStringHash(shaderstring.c_str());
-	deInt32			format;
-	deInt32			length;
-	deInt32			sourcelength;
-	deUint32		i;
-	deUint32		temp;
-	deUint8*		bin			= 0;
-	char*			source		= 0;
-	bool			ok			= true;
-	cacheFileMutex.lock();
-
-	if (cacheFileIndex.count(hash) == 0)
-	{
-		cacheFileMutex.unlock();
-		return 0;
-	}
-	FILE*			file		= fopen(shaderCacheFilename, "rb");
-	ok				= file											!= 0;
-
-	for (i = 0; i < cacheFileIndex[hash].size(); i++)
-	{
-		if (ok) ok = fseek(file, cacheFileIndex[hash][i], SEEK_SET)	== 0;
-		if (ok) ok = fread(&temp, 1, 4, file)						== 4; // Chunk size (skip)
-		if (ok) ok = fread(&temp, 1, 4, file)						== 4; // Stored hash
-		if (ok) ok = temp											== hash; // Double check
-		if (ok) ok = fread(&format, 1, 4, file)						== 4;
-		if (ok) ok = fread(&length, 1, 4, file)						== 4;
-		if (ok) ok = length											> 0; // sanity check
-		if (ok) bin = new deUint8[length];
-		if (ok) ok = fread(bin, 1, length, file)					== (size_t)length;
-		if (ok) ok = fread(&sourcelength, 1, 4, file)				== 4;
-		if (ok && sourcelength > 0)
-		{
-			source = new char[sourcelength + 1];
-			ok = fread(source, 1, sourcelength, file)				== (size_t)sourcelength;
-			source[sourcelength] = 0;
-		}
-		if (!ok || shaderstring != std::string(source))
-		{
-			// Mismatch, but may still exist in cache if there were hash collisions
-			delete[] source;
-			delete[] bin;
-		}
-		else
+	const deUint32		hash	= deStringHash(shaderstring.c_str());
+	ShaderCacheChunk	chunk;
+
+	// Chunks in the snapshot
+	if (findShaderCacheChunk(cacheFile.getData(), cacheFile.getSize(), cacheFileIndex, shaderstring, &chunk))
+		return new vk::ProgramBinary((vk::ProgramFormat)chunk.format, chunk.binaryLength, chunk.binary);
+
+	// Chunks appended by this process
+	{
+		de::ScopedLock										lock		(cacheFileMutex);
+		const map<deUint32, vector<deUint64> >::const_iterator	appended	= cacheFileAppended.find(hash);
+
+		if (appended == cacheFileAppended.end())
+			return 0;
+
+		FILE*				file		= fopen(shaderCacheFilename, "rb");
+		vk::ProgramBinary*	res			= 0;
+		vector<deUint8>		buffer;
+
+		for (size_t i = 0; file && !res && i < appended->second.size(); i++)
 		{
-			delete[] source;
-			if (file) fclose(file);
-			cacheFileMutex.unlock();
-			vk::ProgramBinary* res = new vk::ProgramBinary((vk::ProgramFormat)format, length, bin);
-			delete[] bin;
-			return res;
+			deUint8		chunkSize[4];
+			bool		ok			= true;
+
+			if (ok) ok = SHADER_CACHE_FSEEK(file, (deInt64)appended->second[i], SEEK_SET)	== 0;
+			if (ok) ok = fread(chunkSize, 1, 4, file)							== 4;
+			if (ok) ok = readUint32(chunkSize)									>= SHADER_CACHE_MIN_CHUNK_SIZE;
+			if (ok) buffer.resize(readUint32(chunkSize));
+			if (ok) deMemcpy(&buffer[0], chunkSize, 4);
+			if (ok) ok = fread(&buffer[4], 1, buffer.size() - 4, file)			== buffer.size() - 4;
+			if (ok) ok = readShaderCacheChunk(&buffer[0], buffer.size(), 0, &chunk);
+
+			if (ok && chunk.hash == hash && isSameSource(chunk, shaderstring.c_str(), shaderstring.length()))
+				res = new vk::ProgramBinary((vk::ProgramFormat)chunk.format, chunk.binaryLength, chunk.binary);
 		}
+
+		if (file)
+			fclose(file);
+
+		return res;
 	}
-	if (file) fclose(file);
-	cacheFileMutex.unlock();
-	return 0;
 }
 
 void shadercacheSave (const vk::ProgramBinary* binary, const std::string& shaderstring, const char* shaderCacheFilename)
 {
 	if (binary == 0)
 		return;
-	deUint32			hash		= deStringHash(shaderstring.c_str());
-	deInt32				format		= binary->getFormat();
-	deUint32			length		= (deUint32)binary->getSize();
-	deUint32			chunksize;
-	deUint32			offset;
-	const deUint8*		bin			= binary->getBinary();
-	const de::FilePath	filePath	(shaderCacheFilename);
 
-	cacheFileMutex.lock();
+	const deUint32		hash			= deStringHash(shaderstring.c_str());
+	const de::FilePath	filePath		(shaderCacheFilename);
+	vector<deUint8>		chunk;
+
+	buildShaderCacheChunk((deInt32)binary->getFormat(), binary->getBinary(), (deUint32)binary->getSize(), shaderstring, chunk);
+
+	const deUint32		chunkSize		= (deUint32)chunk.size();
+
+	de::ScopedLock		lock			(cacheFileMutex);
 
 	if (!de::FilePath(filePath.getDirName()).exists())
 		de::createDirectoryAndParents(filePath.getDirName().c_str());
 
-	FILE*				file		= fopen(shaderCacheFilename, "ab");
+	FILE*				file			= fopen(shaderCacheFilename, "ab");
 	if (!file)
-	{
-		cacheFileMutex.unlock();
 		return;
-	}
-	// Append mode starts writing from the end of the file,
-	// but unless we do a seek, ftell returns 0.
-	fseek(file, 0, SEEK_END);
-	offset		= (deUint32)ftell(file);
-	chunksize	= 4 + 4 + 4 + 4 + length + 4 + (deUint32)shaderstring.length();
-	fwrite(&chunksize, 1, 4, file);
-	fwrite(&hash, 1, 4, file);
-	fwrite(&format, 1, 4, file);
-	fwrite(&length, 1, 4, file);
-	fwrite(bin, 1, length, file);
-	length = (deUint32)shaderstring.length();
-	fwrite(&length, 1, 4, file);
-	fwrite(shaderstring.c_str(), 1, length, file);
+
+	// Unbuffered, so that the chunk is appended with a single write and
+	// can't interleave with chunks written by other processes.
+	setvbuf(file, DE_NULL, _IONBF, 0);
+
+	const bool			ok				= fwrite(&chunk[0], 1, chunk.size(), file) == chunk.size();
+	const deInt64		end				= (deInt64)SHADER_CACHE_FTELL(file);
+
 	fclose(file);
-	cacheFileIndex[hash].push_back(offset);
 
-	cacheFileMutex.unlock();
+	if (ok && end >= (deInt64)chunkSize)
+		cacheFileAppended[hash].push_back((deUint64)(end - (deInt64)chunkSize));
 }
 
 // Insert any information that may affect compilation into the shader string.
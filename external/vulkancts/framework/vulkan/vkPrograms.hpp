@@ -213,6 +213,10 @@ ProgramBinary*			assembleProgram		(const vk::SpirVAsmSource& program, SpirVProgr
 void					disassembleProgram	(const ProgramBinary& program, std::ostream* dst);
 bool					validateProgram		(const ProgramBinary& program, std::ostream* dst, const SpirvValidatorOptions&);
 
+//! Rewrite shader cache file without duplicates and with a hash index. Must not be used while other processes write to the cache. Returns number of entries.
+deUint32				compactShaderCache	(const char* shaderCacheFilename);
+void					shaderCacheSelfTest	(void);
+
 Move<VkShaderModule>	createShaderModule	(const DeviceInterface& deviceInterface, VkDevice device, const ProgramBinary& binary, VkShaderModuleCreateFlags flags);
 
 glu::ShaderType			getGluShaderType	(VkShaderStageFlagBits shaderStage);
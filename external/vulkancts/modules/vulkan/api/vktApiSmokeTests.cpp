@@ -293,6 +293,8 @@ public:
 		: rr::FragmentShader(0, 1)
 	{
 		m_outputs[0].type = rr::GENERICVECTYPE_FLOAT;
+
+		m_threadSafe = true;
 	}
 
 	void shadeFragments (rr::FragmentPacket*, const int numPackets, const rr::FragmentShadingContext& context) const
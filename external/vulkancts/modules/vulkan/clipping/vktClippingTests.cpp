@@ -716,6 +716,8 @@ public:
 	{
 		m_inputs[0].type = rr::GENERICVECTYPE_FLOAT;
 		m_outputs[0].type = rr::GENERICVECTYPE_FLOAT;
+
+		m_threadSafe = true;
 	}
 
 	void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
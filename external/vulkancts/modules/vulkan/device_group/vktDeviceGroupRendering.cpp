@@ -106,6 +106,8 @@ public:
 		: rr::FragmentShader(0, 1)
 	{
 		m_outputs[0].type = rr::GENERICVECTYPE_FLOAT;
+
+		m_threadSafe = true;
 	}
 
 	virtual	~RefFragmentShader(void) {}
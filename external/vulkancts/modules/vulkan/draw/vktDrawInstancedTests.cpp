@@ -191,6 +191,8 @@ public:
 	{
 		m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
 		m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+
+		m_threadSafe = true;
 	}
 
 	void shadeFragments (rr::FragmentPacket* packets,
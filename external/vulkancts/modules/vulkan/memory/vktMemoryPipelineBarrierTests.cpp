@@ -672,9 +672,14 @@ public:
 	void	setUndefined	(size_t offset, size_t size);
 	void	setData			(size_t offset, size_t size, const void* data);
 
+	//! Find first defined byte in [0, size) that differs from data. Returns size if all defined bytes match.
+	size_t	findMismatch	(size_t size, const void* data) const;
+
 	size_t	getSize			(void) const { return m_data.size(); }
 
 private:
+	void	markDefined		(size_t offset, size_t size, bool defined);
+
 	vector<deUint8>		m_data;
 	vector<deUint64>	m_defined;
 };
@@ -693,26 +698,93 @@ void ReferenceMemory::set (size_t pos, deUint8 val)
 	m_defined[pos / 64] |= 0x1ull << (pos % 64);
 }
 
-void ReferenceMemory::setData (size_t offset, size_t size, const void* data_)
+void ReferenceMemory::markDefined (size_t offset, size_t size, bool defined)
 {
-	const deUint8* data = (const deUint8*)data_;
+	if (size == 0)
+		return;
 
-	DE_ASSERT(offset < m_data.size());
 	DE_ASSERT(offset + size <= m_data.size());
 
-	// \todo [2016-03-09 mika] Optimize
-	for (size_t pos = 0; pos < size; pos++)
+	const size_t	last		= offset + size - 1;
+	const size_t	firstWord	= offset / 64;
+	const size_t	lastWord	= last / 64;
+	const deUint64	headMask	= ~0ull << (offset % 64);
+	const deUint64	tailMask	= ~0ull >> (63 - last % 64);
+
+	if (firstWord == lastWord)
 	{
-		m_data[offset + pos] = data[pos];
-		m_defined[(offset + pos) / 64] |= 0x1ull << ((offset + pos) % 64);
+		if (defined)
+			m_defined[firstWord] |= headMask & tailMask;
+		else
+			m_defined[firstWord] &= ~(headMask & tailMask);
 	}
+	else
+	{
+		if (defined)
+		{
+			m_defined[firstWord]	|= headMask;
+			m_defined[lastWord]		|= tailMask;
+		}
+		else
+		{
+			m_defined[firstWord]	&= ~headMask;
+			m_defined[lastWord]		&= ~tailMask;
+		}
+
+		for (size_t word = firstWord + 1; word < lastWord; word++)
+			m_defined[word] = defined ? ~0ull : 0ull;
+	}
+}
+
+void ReferenceMemory::setData (size_t offset, size_t size, const void* data)
+{
+	DE_ASSERT(offset < m_data.size());
+	DE_ASSERT(offset + size <= m_data.size());
+
+	deMemcpy(&m_data[offset], data, size);
+	markDefined(offset, size, true);
 }
 
 void ReferenceMemory::setUndefined	(size_t offset, size_t size)
 {
-	// \todo [2016-03-09 mika] Optimize
-	for (size_t pos = 0; pos < size; pos++)
-		m_defined[(offset + pos) / 64] |= 0x1ull << ((offset + pos) % 64);
+	markDefined(offset, size, false);
+}
+
+size_t ReferenceMemory::findMismatch (size_t size, const void* data_) const
+{
+	const deUint8* const	data	= (const deUint8*)data_;
+
+	DE_ASSERT(size <= m_data.size());
+
+	// Compare 8 bytes at a time and locate mismatching byte only once a word differs.
+	for (size_t wordPos = 0; wordPos < size; wordPos += 8)
+	{
+		const size_t	numBytes	= de::min<size_t>(8, size - wordPos);
+		const deUint32	definedMask	= (deUint32)((m_defined[wordPos / 64] >> (wordPos % 64)) & ((1u << numBytes) - 1u));
+
+		if (definedMask == 0)
+			continue;
+
+		if (numBytes == 8 && definedMask == 0xffu)
+		{
+			deUint64 a;
+			deUint64 b;
+
+			deMemcpy(&a, data + wordPos, sizeof(a));
+			deMemcpy(&b, &m_data[wordPos], sizeof(b));
+
+			if (a == b)
+				continue;
+		}
+
+		for (size_t byteNdx = 0; byteNdx < numBytes; byteNdx++)
+		{
+			if ((definedMask & (1u << byteNdx)) != 0 && data[wordPos + byteNdx] != m_data[wordPos + byteNdx])
+				return wordPos + byteNdx;
+		}
+	}
+
+	return size;
 }
 
 deUint8 ReferenceMemory::get (size_t pos) const
@@ -1401,61 +1473,53 @@ void HostMemoryAccess::verify (VerifyContext& context, size_t commandIndex)
 
 	if (m_read && m_write)
 	{
-		for (size_t pos = 0; pos < m_size; pos++)
+		const size_t mismatchPos = reference.findMismatch(m_size, &m_readData[0]);
+
+		if (mismatchPos != m_size)
+		{
+			resultCollector.fail(
+					de::toString(commandIndex) + ":" + getName()
+					+ " Result differs from reference, Expected: "
+					+ de::toString(tcu::toHex<8>(reference.get(mismatchPos)))
+					+ ", Got: "
+					+ de::toString(tcu::toHex<8>(m_readData[mismatchPos]))
+					+ ", At offset: "
+					+ de::toString(mismatchPos));
+		}
+
+		// Reference is updated up to first mismatch.
+		for (size_t pos = 0; pos < mismatchPos; pos++)
 		{
 			const deUint8	mask	= rng.getUint8();
-			const deUint8	value	= m_readData[pos];
 
 			if (reference.isDefined(pos))
-			{
-				if (value != reference.get(pos))
-				{
-					resultCollector.fail(
-							de::toString(commandIndex) + ":" + getName()
-							+ " Result differs from reference, Expected: "
-							+ de::toString(tcu::toHex<8>(reference.get(pos)))
-							+ ", Got: "
-							+ de::toString(tcu::toHex<8>(value))
-							+ ", At offset: "
-							+ de::toString(pos));
-					break;
-				}
-
 				reference.set(pos, reference.get(pos) ^ mask);
-			}
 		}
 	}
 	else if (m_read)
 	{
-		for (size_t pos = 0; pos < m_size; pos++)
-		{
-			const deUint8	value	= m_readData[pos];
+		const size_t mismatchPos = reference.findMismatch(m_size, &m_readData[0]);
 
-			if (reference.isDefined(pos))
-			{
-				if (value != reference.get(pos))
-				{
-					resultCollector.fail(
-							de::toString(commandIndex) + ":" + getName()
-							+ " Result differs from reference, Expected: "
-							+ de::toString(tcu::toHex<8>(reference.get(pos)))
-							+ ", Got: "
-							+ de::toString(tcu::toHex<8>(value))
-							+ ", At offset: "
-							+ de::toString(pos));
-					break;
-				}
-			}
+		if (mismatchPos != m_size)
+		{
+			resultCollector.fail(
+					de::toString(commandIndex) + ":" + getName()
+					+ " Result differs from reference, Expected: "
+					+ de::toString(tcu::toHex<8>(reference.get(mismatchPos)))
+					+ ", Got: "
+					+ de::toString(tcu::toHex<8>(m_readData[mismatchPos]))
+					+ ", At offset: "
+					+ de::toString(mismatchPos));
 		}
 	}
 	else if (m_write)
 	{
+		vector<deUint8> data (m_size);
+
 		for (size_t pos = 0; pos < m_size; pos++)
-		{
-			const deUint8	value	= rng.getUint8();
+			data[pos] = rng.getUint8();
 
-			reference.set(pos, value);
-		}
+		reference.setData(0, m_size, &data[0]);
 	}
 	else
 		DE_FATAL("Host memory access without read or write.");
@@ -2174,15 +2238,18 @@ void FillBuffer::submit (SubmitContext& context)
 void FillBuffer::verify (VerifyContext& context, size_t)
 {
 	ReferenceMemory&	reference	= context.getReference();
+	vector<deUint8>		data		((size_t)m_bufferSize);
 
 	for (size_t ndx = 0; ndx < m_bufferSize; ndx++)
 	{
 #if (DE_ENDIANNESS == DE_LITTLE_ENDIAN)
-		reference.set(ndx, (deUint8)(0xffu & (m_value >> (8*(ndx % 4)))));
+		data[ndx] = (deUint8)(0xffu & (m_value >> (8*(ndx % 4))));
 #else
-		reference.set(ndx, (deUint8)(0xffu & (m_value >> (8*(3 - (ndx % 4))))));
+		data[ndx] = (deUint8)(0xffu & (m_value >> (8*(3 - (ndx % 4)))));
 #endif
 	}
+
+	reference.setData(0, data.size(), &data[0]);
 }
 
 class UpdateBuffer : public CmdCommand
@@ -2340,25 +2407,19 @@ void BufferCopyToBuffer::verify (VerifyContext& context, size_t commandIndex)
 		vk::invalidateMappedMemoryRange(vkd, device, *m_memory, 0, m_bufferSize);
 
 		{
-			const deUint8* const data = (const deUint8*)ptr;
+			const deUint8* const	data		= (const deUint8*)ptr;
+			const size_t			mismatchPos	= reference.findMismatch((size_t)m_bufferSize, data);
 
-			for (size_t pos = 0; pos < (size_t)m_bufferSize; pos++)
+			if (mismatchPos != (size_t)m_bufferSize)
 			{
-				if (reference.isDefined(pos))
-				{
-					if (data[pos] != reference.get(pos))
-					{
-						resultCollector.fail(
-								de::toString(commandIndex) + ":" + getName()
-								+ " Result differs from reference, Expected: "
-								+ de::toString(tcu::toHex<8>(reference.get(pos)))
-								+ ", Got: "
-								+ de::toString(tcu::toHex<8>(data[pos]))
-								+ ", At offset: "
-								+ de::toString(pos));
-						break;
-					}
-				}
+				resultCollector.fail(
+						de::toString(commandIndex) + ":" + getName()
+						+ " Result differs from reference, Expected: "
+						+ de::toString(tcu::toHex<8>(reference.get(mismatchPos)))
+						+ ", Got: "
+						+ de::toString(tcu::toHex<8>(data[mismatchPos]))
+						+ ", At offset: "
+						+ de::toString(mismatchPos));
 			}
 		}
 
@@ -2444,9 +2505,12 @@ void BufferCopyFromBuffer::verify (VerifyContext& context, size_t)
 {
 	ReferenceMemory&	reference	(context.getReference());
 	de::Random			rng			(m_seed);
+	vector<deUint8>		data		((size_t)m_bufferSize);
+
+	for (size_t ndx = 0; ndx < data.size(); ndx++)
+		data[ndx] = rng.getUint8();
 
-	for (size_t ndx = 0; ndx < (size_t)m_bufferSize; ndx++)
-		reference.set(ndx, rng.getUint8());
+	reference.setData(0, data.size(), &data[0]);
 }
 
 class BufferCopyToImage : public CmdCommand
@@ -2667,25 +2731,20 @@ void BufferCopyToImage::verify (VerifyContext& context, size_t commandIndex)
 		vk::invalidateMappedMemoryRange(vkd, device, *memory, 0,  4 * m_imageWidth * m_imageHeight);
 
 		{
-			const deUint8* const	data = (const deUint8*)ptr;
+			const deUint8* const	data		= (const deUint8*)ptr;
+			const size_t			size		= (size_t)(4 * m_imageWidth * m_imageHeight);
+			const size_t			mismatchPos	= reference.findMismatch(size, data);
 
-			for (size_t pos = 0; pos < (size_t)( 4 * m_imageWidth * m_imageHeight); pos++)
+			if (mismatchPos != size)
 			{
-				if (reference.isDefined(pos))
-				{
-					if (data[pos] != reference.get(pos))
-					{
-						resultCollector.fail(
-								de::toString(commandIndex) + ":" + getName()
-								+ " Result differs from reference, Expected: "
-								+ de::toString(tcu::toHex<8>(reference.get(pos)))
-								+ ", Got: "
-								+ de::toString(tcu::toHex<8>(data[pos]))
-								+ ", At offset: "
-								+ de::toString(pos));
-						break;
-					}
-				}
+				resultCollector.fail(
+						de::toString(commandIndex) + ":" + getName()
+						+ " Result differs from reference, Expected: "
+						+ de::toString(tcu::toHex<8>(reference.get(mismatchPos)))
+						+ ", Got: "
+						+ de::toString(tcu::toHex<8>(data[mismatchPos]))
+						+ ", At offset: "
+						+ de::toString(mismatchPos));
 			}
 		}
 
@@ -2890,9 +2949,12 @@ void BufferCopyFromImage::verify (VerifyContext& context, size_t)
 {
 	ReferenceMemory&	reference		(context.getReference());
 	de::Random			rng	(m_seed);
+	vector<deUint8>		data			((size_t)(4 * m_imageWidth * m_imageHeight));
+
+	for (size_t ndx = 0; ndx < data.size(); ndx++)
+		data[ndx] = rng.getUint8();
 
-	for (size_t ndx = 0; ndx < (size_t)(4 * m_imageWidth * m_imageHeight); ndx++)
-		reference.set(ndx, rng.getUint8());
+	reference.setData(0, data.size(), &data[0]);
 }
 
 class ImageCopyToBuffer : public CmdCommand
@@ -132,6 +132,8 @@ public:
 		m_outputs[0].type	= (channelClass == tcu::TEXTURECHANNELCLASS_SIGNED_INTEGER)? rr::GENERICVECTYPE_INT32 :
 							  (channelClass == tcu::TEXTURECHANNELCLASS_UNSIGNED_INTEGER)? rr::GENERICVECTYPE_UINT32
 							  : rr::GENERICVECTYPE_FLOAT;
+
+		m_threadSafe = true;
 	}
 
 	virtual ~ColorFragmentShader (void) {}
@@ -171,6 +173,8 @@ public:
 		m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
 		m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
 		m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+
+		m_threadSafe = true;
 	}
 
 	virtual ~CoordinateCaptureFragmentShader (void)
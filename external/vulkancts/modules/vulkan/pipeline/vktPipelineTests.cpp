@@ -60,29 +60,29 @@ void createChildren (tcu::TestCaseGroup* pipelineTests)
 {
 	tcu::TestContext&	testCtx	= pipelineTests->getTestContext();
 
-	pipelineTests->addChild(createStencilTests					(testCtx));
-	pipelineTests->addChild(createBlendTests					(testCtx));
-	pipelineTests->addChild(createDepthTests					(testCtx));
-	pipelineTests->addChild(createDynamicOffsetTests			(testCtx));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"stencil", "Stencil tests", createStencilTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"blend", "Blend tests", createBlendTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"depth", "Depth tests", createDepthTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"dynamic_offset", "Dynamic offset tests", createDynamicOffsetTests));
 	pipelineTests->addChild(createEarlyDestroyTests				(testCtx));
-	pipelineTests->addChild(createImageTests					(testCtx));
-	pipelineTests->addChild(createSamplerTests					(testCtx));
-	pipelineTests->addChild(createImageViewTests				(testCtx));
-	pipelineTests->addChild(createPushConstantTests				(testCtx));
-	pipelineTests->addChild(createPushDescriptorTests			(testCtx));
-	pipelineTests->addChild(createSpecConstantTests				(testCtx));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"image", "Image tests", createImageTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"sampler", "Sampler tests", createSamplerTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"image_view", "Image tests", createImageViewTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"push_constant", "PushConstant tests", createPushConstantTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"push_descriptor", "Push descriptor tests", createPushDescriptorTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"spec_constant", "Specialization constants tests", createSpecConstantTests));
 	pipelineTests->addChild(createMatchedAttachmentsTests		(testCtx));
-	pipelineTests->addChild(createMultisampleTests				(testCtx));
-	pipelineTests->addChild(createMultisampleInterpolationTests	(testCtx));
-	pipelineTests->addChild(createMultisampleShaderBuiltInTests	(testCtx));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"multisample", "", createMultisampleTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"multisample_interpolation", "Multisample Interpolation", createMultisampleInterpolationTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"multisample_shader_builtin", "Multisample Shader BuiltIn Tests", createMultisampleShaderBuiltInTests));
 	pipelineTests->addChild(createTestGroup						(testCtx,	"vertex_input", "", createVertexInputTests));
-	pipelineTests->addChild(createInputAssemblyTests			(testCtx));
-	pipelineTests->addChild(createTimestampTests				(testCtx));
-	pipelineTests->addChild(createCacheTests					(testCtx));
-	pipelineTests->addChild(createRenderToImageTests			(testCtx));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"input_assembly", "Input assembly tests", createInputAssemblyTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"timestamp", "timestamp tests", createTimestampTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"cache", "pipeline cache tests", createCacheTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"render_to_image", "Render to image tests", createRenderToImageTests));
 	pipelineTests->addChild(createFramebufferAttachmentTests	(testCtx));
-	pipelineTests->addChild(createStencilExportTests			(testCtx));
-	pipelineTests->addChild(createDerivativeTests				(testCtx));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"shader_stencil_export", "", createStencilExportTests));
+	pipelineTests->addChild(createDeferredTestGroup				(testCtx,	"derivative", "pipeline derivative tests", createDerivativeTests));
 }
 
 } // anonymous
@@ -389,8 +389,18 @@ struct BuildStats
 	}
 };
 
+enum BinaryFormat
+{
+	BINARY_FORMAT_FILES = 0,			//!< Index and a separate file for each binary
+	BINARY_FORMAT_PACKED,				//!< Single file containing index and binaries
+	BINARY_FORMAT_PACKED_COMPRESSED,	//!< Single file, binaries compressed with zlib
+
+	BINARY_FORMAT_LAST
+};
+
 BuildStats buildPrograms (tcu::TestContext&			testCtx,
 						  const std::string&		dstPath,
+						  const BinaryFormat		binaryFormat,
 						  const bool				validateBinaries,
 						  const deUint32			usedVulkanVersion,
 						  const vk::SpirvVersion	baselineSpirvVersion,
@@ -519,7 +529,10 @@ BuildStats buildPrograms (tcu::TestContext&			testCtx,
 				registryWriter.addProgram(progIter->id, *progIter->binary);
 		}
 
-		registryWriter.write();
+		if (binaryFormat == BINARY_FORMAT_FILES)
+			registryWriter.write();
+		else
+			registryWriter.writePacked(binaryFormat == BINARY_FORMAT_PACKED_COMPRESSED);
 	}
 
 	{
@@ -553,12 +566,14 @@ namespace opt
 {
 
 DE_DECLARE_COMMAND_LINE_OPT(DstPath,				std::string);
+DE_DECLARE_COMMAND_LINE_OPT(BinaryFormat,			vkt::BinaryFormat);
 DE_DECLARE_COMMAND_LINE_OPT(Cases,					std::string);
 DE_DECLARE_COMMAND_LINE_OPT(Validate,				bool);
 DE_DECLARE_COMMAND_LINE_OPT(VulkanVersion,			deUint32);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCache,			bool);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCacheFilename,	std::string);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCacheTruncate,	bool);
+DE_DECLARE_COMMAND_LINE_OPT(ShaderCacheCompact,		bool);
 DE_DECLARE_COMMAND_LINE_OPT(SpirvOptimize,			bool);
 DE_DECLARE_COMMAND_LINE_OPT(SpirvOptimizationRecipe,std::string);
 
@@ -579,15 +594,24 @@ void registerOptions (de::cmdline::Parser& parser)
 		{ "1.1",	VK_MAKE_VERSION(1, 1, 0)	},
 	};
 
+	static const NamedValue<vkt::BinaryFormat> s_binaryFormats[] =
+	{
+		{ "files",				vkt::BINARY_FORMAT_FILES				},
+		{ "packed",				vkt::BINARY_FORMAT_PACKED				},
+		{ "packed-compressed",	vkt::BINARY_FORMAT_PACKED_COMPRESSED	},
+	};
+
 	DE_STATIC_ASSERT(vk::SPIRV_VERSION_1_3 + 1 == vk::SPIRV_VERSION_LAST);
 
 	parser << Option<opt::DstPath>("d", "dst-path", "Destination path", "out")
+		<< Option<opt::BinaryFormat>("b", "binary-format", "Format of written binaries", s_binaryFormats, "files")
 		<< Option<opt::Cases>("n", "deqp-case", "Case path filter (works as in test binaries)")
 		<< Option<opt::Validate>("v", "validate-spv", "Validate generated SPIR-V binaries")
 		<< Option<opt::VulkanVersion>("t", "target-vulkan-version", "Target Vulkan version", s_vulkanVersion, "1.1")
 		<< Option<opt::ShaderCache>("s", "shadercache", "Enable or disable shader cache", s_enableNames, "enable")
 		<< Option<opt::ShaderCacheFilename>("r", "shadercache-filename", "Write shader cache to given file", "shadercache.bin")
 		<< Option<opt::ShaderCacheTruncate>("x", "shadercache-truncate", "Truncate shader cache before running", s_enableNames, "enable")
+		<< Option<opt::ShaderCacheCompact>("c", "shadercache-compact", "Compact shader cache after building programs", s_enableNames, "disable")
 		<< Option<opt::SpirvOptimize>("o", "deqp-optimize-spirv", "Enable optimization for SPIR-V", s_enableNames, "disable")
 		<< Option<opt::SpirvOptimizationRecipe>("p","deqp-optimization-recipe", "Shader optimization recipe");
 }
@@ -678,6 +702,7 @@ int main (int argc, const char* argv[])
 
 		const vkt::BuildStats	stats		= vkt::buildPrograms(testCtx,
 																 cmdLine.getOption<opt::DstPath>(),
+																 cmdLine.getOption<opt::BinaryFormat>(),
 																 cmdLine.getOption<opt::Validate>(),
 																 cmdLine.getOption<opt::VulkanVersion>(),
 																 baselineSpirvVersion,
@@ -685,6 +710,13 @@ int main (int argc, const char* argv[])
 
 		tcu::print("DONE: %d passed, %d failed, %d not supported\n", stats.numSucceeded, stats.numFailed, stats.notSupported);
 
+		if (cmdLine.getOption<opt::ShaderCacheCompact>() && deqpCmdLine.isShadercacheEnabled())
+		{
+			const deUint32	numEntries	= vk::compactShaderCache(deqpCmdLine.getShaderCacheFilename());
+
+			tcu::print("Shader cache compacted: %u entries\n", numEntries);
+		}
+
 		return stats.numFailed == 0 ? 0 : -1;
 	}
 	catch (const std::exception& e)
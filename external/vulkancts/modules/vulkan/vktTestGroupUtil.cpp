@@ -22,6 +22,9 @@
  *//*--------------------------------------------------------------------*/
 
 #include "vktTestGroupUtil.hpp"
+#include "deUniquePtr.hpp"
+
+#include <vector>
 
 namespace vkt
 {
@@ -44,4 +47,61 @@ void TestGroupHelper0::init (void)
 	m_createChildren(this);
 }
 
+DeferredTestGroup::DeferredTestGroup (tcu::TestContext&	testCtx,
+									  const std::string&	name,
+									  const std::string&	description,
+									  CreateGroupFunc		createGroup)
+	: tcu::TestCaseGroup	(testCtx, name.c_str(), description.c_str())
+	, m_createGroup			(createGroup)
+	, m_group				(DE_NULL)
+{
+}
+
+DeferredTestGroup::~DeferredTestGroup (void)
+{
+	DeferredTestGroup::deinit();
+}
+
+void DeferredTestGroup::init (void)
+{
+	DE_ASSERT(!m_group);
+
+	de::MovePtr<tcu::TestCaseGroup>	group		(m_createGroup(m_testCtx));
+	std::vector<tcu::TestNode*>		children;
+
+	TCU_CHECK_INTERNAL(m_name == group->getName());
+
+	group->init();
+	group->releaseChildren(children);
+
+	m_group = group.release();
+
+	for (size_t ndx = 0; ndx < children.size(); ++ndx)
+	{
+		try
+		{
+			addChild(children[ndx]);
+		}
+		catch (...)
+		{
+			for (; ndx < children.size(); ++ndx)
+				delete children[ndx];
+			throw;
+		}
+	}
+}
+
+void DeferredTestGroup::deinit (void)
+{
+	// Children may reference state owned by the original group
+	tcu::TestCaseGroup::deinit();
+
+	if (m_group)
+	{
+		m_group->deinit();
+		delete m_group;
+		m_group = DE_NULL;
+	}
+}
+
 } // vkt
@@ -69,6 +69,34 @@ private:
 	const Arg0					m_arg0;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Group whose subtree is built only when the group is entered
+ *
+ * Wraps a factory that builds a complete group eagerly. The name and
+ * description are declared up front so that the case list filter can
+ * prune the group without calling the factory. On init() the factory is
+ * called and the children of the returned group are adopted; on deinit()
+ * the whole subtree is released again.
+ *//*--------------------------------------------------------------------*/
+class DeferredTestGroup : public tcu::TestCaseGroup
+{
+public:
+	typedef tcu::TestCaseGroup* (*CreateGroupFunc) (tcu::TestContext& testCtx);
+
+								DeferredTestGroup	(tcu::TestContext&		testCtx,
+													 const std::string&		name,
+													 const std::string&		description,
+													 CreateGroupFunc		createGroup);
+								~DeferredTestGroup	(void);
+
+	void						init				(void);
+	void						deinit				(void);
+
+private:
+	const CreateGroupFunc		m_createGroup;
+	tcu::TestCaseGroup*			m_group;			//!< Original group, kept alive while its children are in use
+};
+
 inline tcu::TestCaseGroup* createTestGroup (tcu::TestContext&						testCtx,
 											const std::string&						name,
 											const std::string&						description,
@@ -87,6 +115,14 @@ tcu::TestCaseGroup* createTestGroup (tcu::TestContext&										testCtx,
 	return new TestGroupHelper1<Arg0>(testCtx, name, description, createChildren, arg0);
 }
 
+inline tcu::TestCaseGroup* createDeferredTestGroup (tcu::TestContext&					testCtx,
+													const std::string&					name,
+													const std::string&					description,
+													DeferredTestGroup::CreateGroupFunc	createGroup)
+{
+	return new DeferredTestGroup(testCtx, name, description, createGroup);
+}
+
 inline void addTestGroup (tcu::TestCaseGroup*					parent,
 						  const std::string&					name,
 						  const std::string&					description,
@@ -471,31 +471,31 @@ void TestPackage::init (void)
 	addChild(BindingModel::createTests		(m_testCtx));
 	addChild(SpirVAssembly::createTests		(m_testCtx));
 	addChild(createTestGroup				(m_testCtx, "glsl", "GLSL shader execution tests", createGlslTests));
-	addChild(createRenderPassTests			(m_testCtx));
-	addChild(createRenderPass2Tests			(m_testCtx));
+	addChild(createDeferredTestGroup		(m_testCtx, "renderpass", "RenderPass Tests", createRenderPassTests));
+	addChild(createDeferredTestGroup		(m_testCtx, "renderpass2", "RenderPass2 Tests", createRenderPass2Tests));
 	addChild(ubo::createTests				(m_testCtx));
 	addChild(DynamicState::createTests		(m_testCtx));
-	addChild(ssbo::createTests				(m_testCtx));
+	addChild(createDeferredTestGroup		(m_testCtx, "ssbo", "Shader Storage Buffer Object Tests", ssbo::createTests));
 	addChild(QueryPool::createTests			(m_testCtx));
 	addChild(Draw::createTests				(m_testCtx));
 	addChild(compute::createTests			(m_testCtx));
 	addChild(image::createTests				(m_testCtx));
 	addChild(wsi::createTests				(m_testCtx));
 	addChild(synchronization::createTests	(m_testCtx));
-	addChild(sparse::createTests			(m_testCtx));
+	addChild(createDeferredTestGroup		(m_testCtx, "sparse_resources", "Sparse Resources Tests", sparse::createTests));
 	addChild(tessellation::createTests		(m_testCtx));
 	addChild(rasterization::createTests		(m_testCtx));
 	addChild(clipping::createTests			(m_testCtx));
 	addChild(FragmentOperations::createTests(m_testCtx));
 	addChild(texture::createTests			(m_testCtx));
 	addChild(geometry::createTests			(m_testCtx));
-	addChild(robustness::createTests		(m_testCtx));
+	addChild(createDeferredTestGroup		(m_testCtx, "robustness", "", robustness::createTests));
 	addChild(MultiView::createTests			(m_testCtx));
 	addChild(subgroups::createTests			(m_testCtx));
 	addChild(ycbcr::createTests				(m_testCtx));
-	addChild(ProtectedMem::createTests		(m_testCtx));
+	addChild(createDeferredTestGroup		(m_testCtx, "protected_memory", "Protected Memory Tests", ProtectedMem::createTests));
 	addChild(DeviceGroup::createTests		(m_testCtx));
-	addChild(MemoryModel::createTests		(m_testCtx));
+	addChild(createDeferredTestGroup		(m_testCtx, "memory_model", "Memory model tests", MemoryModel::createTests));
 	addChild(conditional::createTests		(m_testCtx));
 	addChild(vkrunner::createTests			(m_testCtx));
 }
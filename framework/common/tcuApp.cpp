@@ -28,6 +28,8 @@
 #include "tcuTestHierarchyUtil.hpp"
 #include "tcuCommandLine.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuWorkerPool.hpp"
+#include "tcuCompressedTexture.hpp"
 
 #include "qpInfo.h"
 #include "qpDebugOut.h"
@@ -105,6 +107,12 @@ App::App (Platform& platform, Archive& archive, TestLog& log, const CommandLine&
 		if (cmdLine.isCrashHandlingEnabled())
 			TCU_CHECK_INTERNAL(m_crashHandler = qpCrashHandler_create(onCrash, this));
 
+		// Start CPU worker threads
+		setNumWorkerThreads(cmdLine.getNumWorkerThreads());
+
+		// Share decompressed reference textures between cases
+		setDecompressionCacheSize((size_t)de::max(0, cmdLine.getDecompressionCacheSize()) << 20);
+
 		// Create test context
 		m_testCtx = new TestContext(m_platform, archive, log, cmdLine, m_watchDog);
 
@@ -141,6 +149,9 @@ void App::cleanup (void)
 	delete m_testRoot;
 	delete m_testCtx;
 
+	setNumWorkerThreads(1);
+	setDecompressionCacheSize(0);
+
 	if (m_crashHandler)
 		qpCrashHandler_destroy(m_crashHandler);
 
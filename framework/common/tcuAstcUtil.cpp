@@ -1273,14 +1273,24 @@ void interpolateWeights (TexelWeightPair* dst, const deUint32 (&unquantizedWeigh
 	const deUint32	scaleX				= (1024 + blockWidth/2) / (blockWidth-1);
 	const deUint32	scaleY				= (1024 + blockHeight/2) / (blockHeight-1);
 
+	deUint32		gridX[MAX_BLOCK_WIDTH];
+	deUint32		gridY[MAX_BLOCK_HEIGHT];
+
 	DE_ASSERT(blockMode.weightGridWidth*blockMode.weightGridHeight*numWeightsPerTexel <= DE_LENGTH_OF_ARRAY(unquantizedWeights));
 
+	// Grid coordinates are separable, compute them once per column and row.
+	for (int texelX = 0; texelX < blockWidth; texelX++)
+		gridX[texelX] = (scaleX*texelX*(blockMode.weightGridWidth-1) + 32) >> 6;
+
+	for (int texelY = 0; texelY < blockHeight; texelY++)
+		gridY[texelY] = (scaleY*texelY*(blockMode.weightGridHeight-1) + 32) >> 6;
+
 	for (int texelY = 0; texelY < blockHeight; texelY++)
 	{
 		for (int texelX = 0; texelX < blockWidth; texelX++)
 		{
-			const deUint32 gX	= (scaleX*texelX*(blockMode.weightGridWidth-1) + 32) >> 6;
-			const deUint32 gY	= (scaleY*texelY*(blockMode.weightGridHeight-1) + 32) >> 6;
+			const deUint32 gX	= gridX[texelX];
+			const deUint32 gY	= gridY[texelY];
 			const deUint32 jX	= gX >> 4;
 			const deUint32 jY	= gY >> 4;
 			const deUint32 fX	= gX & 0xf;
@@ -1585,26 +1595,40 @@ void decompress (const PixelBufferAccess& dst, const deUint8* data, bool isSRGB,
 	decompressBlock(isSRGB ? (void*)&decompressedBuffer.sRGB[0] : (void*)&decompressedBuffer.linear[0],
 					blockData, dst.getWidth(), dst.getHeight(), isSRGB, isLDR);
 
+	const PixelRowAccess	dstRows	(dst);
+
 	if (isSRGB)
 	{
+		IVec4 row[MAX_BLOCK_WIDTH];
+
 		for (int i = 0; i < blockHeight; i++)
-		for (int j = 0; j < blockWidth; j++)
 		{
-			dst.setPixel(IVec4(decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 0],
+			for (int j = 0; j < blockWidth; j++)
+			{
+				row[j] = IVec4(decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 0],
 							   decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 1],
 							   decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 2],
-							   decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 3]), j, i);
+							   decompressedBuffer.sRGB[(i*blockWidth + j) * 4 + 3]);
+			}
+
+			dstRows.writeRow(0, i, 0, blockWidth, &row[0]);
 		}
 	}
 	else
 	{
+		Vec4 row[MAX_BLOCK_WIDTH];
+
 		for (int i = 0; i < blockHeight; i++)
-		for (int j = 0; j < blockWidth; j++)
 		{
-			dst.setPixel(Vec4(decompressedBuffer.linear[(i*blockWidth + j) * 4 + 0],
+			for (int j = 0; j < blockWidth; j++)
+			{
+				row[j] = Vec4(decompressedBuffer.linear[(i*blockWidth + j) * 4 + 0],
 							  decompressedBuffer.linear[(i*blockWidth + j) * 4 + 1],
 							  decompressedBuffer.linear[(i*blockWidth + j) * 4 + 2],
-							  decompressedBuffer.linear[(i*blockWidth + j) * 4 + 3]), j, i);
+							  decompressedBuffer.linear[(i*blockWidth + j) * 4 + 3]);
+			}
+
+			dstRows.writeRow(0, i, 0, blockWidth, &row[0]);
 		}
 	}
 }
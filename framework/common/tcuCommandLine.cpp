@@ -29,6 +29,7 @@
 #include "deStringUtil.hpp"
 #include "deString.h"
 #include "deInt32.h"
+#include "deMemory.h"
 #include "deCommandLine.h"
 #include "qpTestLog.h"
 #include "qpDebugOut.h"
@@ -88,6 +89,8 @@ DE_DECLARE_COMMAND_LINE_OPT(TestOOM,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(VKDeviceID,					int);
 DE_DECLARE_COMMAND_LINE_OPT(VKDeviceGroupID,			int);
 DE_DECLARE_COMMAND_LINE_OPT(LogFlush,					bool);
+DE_DECLARE_COMMAND_LINE_OPT(LogAsync,					bool);
+DE_DECLARE_COMMAND_LINE_OPT(LogCaseIndex,				bool);
 DE_DECLARE_COMMAND_LINE_OPT(Validation,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCache,				bool);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCacheFilename,		std::string);
@@ -95,6 +98,8 @@ DE_DECLARE_COMMAND_LINE_OPT(Optimization,				int);
 DE_DECLARE_COMMAND_LINE_OPT(OptimizeSpirv,				bool);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCacheTruncate,		bool);
 DE_DECLARE_COMMAND_LINE_OPT(RenderDoc,					bool);
+DE_DECLARE_COMMAND_LINE_OPT(WorkerThreads,				int);
+DE_DECLARE_COMMAND_LINE_OPT(DecompressCacheSize,		int);
 
 static void parseIntList (const char* src, std::vector<int>* dst)
 {
@@ -183,13 +188,17 @@ void registerOptions (de::cmdline::Parser& parser)
 		<< Option<LogShaderSources>		(DE_NULL,	"deqp-log-shader-sources",		"Enable or disable logging of shader sources",		s_enableNames,		"enable")
 		<< Option<TestOOM>				(DE_NULL,	"deqp-test-oom",				"Run tests that exhaust memory on purpose",			s_enableNames,		TEST_OOM_DEFAULT)
 		<< Option<LogFlush>				(DE_NULL,	"deqp-log-flush",				"Enable or disable log file fflush",				s_enableNames,		"enable")
+		<< Option<LogAsync>				(DE_NULL,	"deqp-log-async",				"Enable or disable writing log in a background thread",	s_enableNames,	"disable")
+		<< Option<LogCaseIndex>			(DE_NULL,	"deqp-log-case-index",			"Enable or disable writing case index next to log file",	s_enableNames,	"disable")
 		<< Option<Validation>			(DE_NULL,	"deqp-validation",				"Enable or disable test case validation",			s_enableNames,		"disable")
 		<< Option<Optimization>			(DE_NULL,	"deqp-optimization-recipe",		"Shader optimization recipe (0=disabled)",								"0")
 		<< Option<OptimizeSpirv>		(DE_NULL,	"deqp-optimize-spirv",			"Apply optimization to spir-v shaders as well",		s_enableNames,		"disable")
 		<< Option<ShaderCache>			(DE_NULL,	"deqp-shadercache",				"Enable or disable shader cache",					s_enableNames,		"enable")
 		<< Option<ShaderCacheFilename>	(DE_NULL,	"deqp-shadercache-filename",	"Write shader cache to given file",										"shadercache.bin")
 		<< Option<ShaderCacheTruncate>	(DE_NULL,	"deqp-shadercache-truncate",	"Truncate shader cache before running tests",		s_enableNames,		"enable")
-		<< Option<RenderDoc>			(DE_NULL,	"deqp-renderdoc",				"Enable RenderDoc frame markers",					s_enableNames,		"disable");
+		<< Option<RenderDoc>			(DE_NULL,	"deqp-renderdoc",				"Enable RenderDoc frame markers",					s_enableNames,		"disable")
+		<< Option<WorkerThreads>		(DE_NULL,	"deqp-worker-threads",			"Number of threads for CPU reference rendering and verification (0=number of cores)",	"1")
+		<< Option<DecompressCacheSize>	(DE_NULL,	"deqp-decompression-cache-size",	"Size of cache for decompressed reference textures in megabytes (0=disabled)",			"0");
 }
 
 void registerLegacyOptions (de::cmdline::Parser& parser)
@@ -261,65 +270,143 @@ void DebugOutStreambuf::flushLine (void)
 	m_curLine.str("");
 }
 
-class CaseTreeNode
+/*--------------------------------------------------------------------*//*!
+ * \brief Test case name trie
+ *
+ * Nodes are stored in a single array and node names in a single character
+ * buffer. Children are found through a hash table keyed by parent node and
+ * name, so lookups cost O(1) per path component and don't need temporary
+ * strings.
+ *//*--------------------------------------------------------------------*/
+class CaseTree
 {
 public:
-										CaseTreeNode		(const std::string& name) : m_name(name) {}
-										~CaseTreeNode		(void);
+	enum
+	{
+		ROOT		= 0,
+		NOT_FOUND	= -1
+	};
 
-	const std::string&					getName				(void) const { return m_name;				}
-	bool								hasChildren			(void) const { return !m_children.empty();	}
+							CaseTree			(void);
 
-	bool								hasChild			(const std::string& name) const;
-	const CaseTreeNode*					getChild			(const std::string& name) const;
-	CaseTreeNode*						getChild			(const std::string& name);
+	int						findChild			(int parentNdx, const char* name, int nameLen) const;
+	int						addChild			(int parentNdx, const char* name, int nameLen);
+	bool					hasChildren			(int nodeNdx) const { return m_nodes[nodeNdx].numChildren > 0; }
+	bool					isNamed				(int nodeNdx, const string& name) const;
 
-	void								addChild			(CaseTreeNode* child) { m_children.push_back(child); }
+	//! Find node by full path, or NOT_FOUND if any of the components is missing.
+	int						findNode			(const char* path) const;
 
 private:
-										CaseTreeNode		(const CaseTreeNode&);
-	CaseTreeNode&						operator=			(const CaseTreeNode&);
-
-	enum { NOT_FOUND = -1 };
+	struct Node
+	{
+		int			parentNdx;
+		deUint32	nameOffset;
+		int			nameLen;
+		int			numChildren;
+	};
 
-	// \todo [2014-10-30 pyry] Speed up with hash / sorting
-	int									findChildNdx		(const std::string& name) const;
+	static deUint32			hashKey				(int parentNdx, const char* name, int nameLen);
+	bool					nodeMatches			(int nodeNdx, int parentNdx, const char* name, int nameLen) const;
+	void					insertToHash		(int nodeNdx);
+	void					rehash				(size_t tableSize);
 
-	std::string							m_name;
-	std::vector<CaseTreeNode*>			m_children;
+	std::vector<Node>		m_nodes;
+	std::vector<char>		m_names;
+	std::vector<int>		m_hashTable;		//!< Node indices, NOT_FOUND for empty slots. Size is a power of two.
 };
 
-CaseTreeNode::~CaseTreeNode (void)
+CaseTree::CaseTree (void)
+{
+	const Node root = { NOT_FOUND, 0u, 0, 0 };
+
+	m_nodes.push_back(root);
+	m_hashTable.resize(64, NOT_FOUND);
+}
+
+deUint32 CaseTree::hashKey (int parentNdx, const char* name, int nameLen)
 {
-	for (vector<CaseTreeNode*>::const_iterator i = m_children.begin(); i != m_children.end(); ++i)
-		delete *i;
+	deUint32 hash = deInt32Hash(parentNdx);
+
+	for (int ndx = 0; ndx < nameLen; ++ndx)
+		hash = (hash << 5) + hash + (deUint8)name[ndx];
+
+	return hash;
+}
+
+inline bool CaseTree::nodeMatches (int nodeNdx, int parentNdx, const char* name, int nameLen) const
+{
+	const Node& node = m_nodes[nodeNdx];
+
+	return node.parentNdx	== parentNdx	&&
+		   node.nameLen		== nameLen		&&
+		   deMemCmp(&m_names[0] + node.nameOffset, name, (size_t)nameLen) == 0;
 }
 
-int CaseTreeNode::findChildNdx (const std::string& name) const
+int CaseTree::findChild (int parentNdx, const char* name, int nameLen) const
 {
-	for (int ndx = 0; ndx < (int)m_children.size(); ++ndx)
+	if (!hasChildren(parentNdx))
+		return NOT_FOUND;
+
+	const size_t	mask	= m_hashTable.size() - 1;
+	size_t			slot	= hashKey(parentNdx, name, nameLen) & mask;
+
+	for (;;)
 	{
-		if (m_children[ndx]->getName() == name)
-			return ndx;
+		const int nodeNdx = m_hashTable[slot];
+
+		if (nodeNdx == NOT_FOUND || nodeMatches(nodeNdx, parentNdx, name, nameLen))
+			return nodeNdx;
+
+		slot = (slot + 1) & mask;
 	}
-	return NOT_FOUND;
 }
 
-inline bool CaseTreeNode::hasChild (const std::string& name) const
+void CaseTree::insertToHash (int nodeNdx)
+{
+	const Node&		node	= m_nodes[nodeNdx];
+	const size_t	mask	= m_hashTable.size() - 1;
+	size_t			slot	= hashKey(node.parentNdx, &m_names[0] + node.nameOffset, node.nameLen) & mask;
+
+	while (m_hashTable[slot] != NOT_FOUND)
+		slot = (slot + 1) & mask;
+
+	m_hashTable[slot] = nodeNdx;
+}
+
+void CaseTree::rehash (size_t tableSize)
 {
-	return findChildNdx(name) != NOT_FOUND;
+	m_hashTable.assign(tableSize, NOT_FOUND);
+
+	for (int nodeNdx = ROOT+1; nodeNdx < (int)m_nodes.size(); ++nodeNdx)
+		insertToHash(nodeNdx);
 }
 
-inline const CaseTreeNode* CaseTreeNode::getChild (const std::string& name) const
+int CaseTree::addChild (int parentNdx, const char* name, int nameLen)
 {
-	const int ndx = findChildNdx(name);
-	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
+	const Node	child		= { parentNdx, (deUint32)m_names.size(), nameLen, 0 };
+	const int	childNdx	= (int)m_nodes.size();
+
+	DE_ASSERT(findChild(parentNdx, name, nameLen) == NOT_FOUND);
+
+	// Keep load factor at most 1/2
+	if ((m_nodes.size() + 1) * 2 > m_hashTable.size())
+		rehash(m_hashTable.size() * 2);
+
+	m_names.insert(m_names.end(), name, name + nameLen);
+	m_nodes.push_back(child);
+	m_nodes[parentNdx].numChildren += 1;
+
+	insertToHash(childNdx);
+
+	return childNdx;
 }
 
-inline CaseTreeNode* CaseTreeNode::getChild (const std::string& name)
+bool CaseTree::isNamed (int nodeNdx, const string& name) const
 {
-	const int ndx = findChildNdx(name);
-	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
+	const Node& node = m_nodes[nodeNdx];
+
+	return node.nameLen == (int)name.size() && deMemCmp(&m_names[0] + node.nameOffset, name.c_str(), name.size()) == 0;
 }
 
 static int getCurrentComponentLen (const char* path)
@@ -329,17 +416,17 @@ static int getCurrentComponentLen (const char* path)
 	return ndx;
 }
 
-static const CaseTreeNode* findNode (const CaseTreeNode* root, const char* path)
+int CaseTree::findNode (const char* path) const
 {
-	const CaseTreeNode*	curNode		= root;
-	const char*			curPath		= path;
-	int					curLen		= getCurrentComponentLen(curPath);
+	int			curNode		= ROOT;
+	const char*	curPath		= path;
+	int			curLen		= getCurrentComponentLen(curPath);
 
 	for (;;)
 	{
-		curNode = curNode->getChild(std::string(curPath, curPath+curLen));
+		curNode = findChild(curNode, curPath, curLen);
 
-		if (!curNode)
+		if (curNode == NOT_FOUND)
 			break;
 
 		curPath	+= curLen;
@@ -357,20 +444,20 @@ static const CaseTreeNode* findNode (const CaseTreeNode* root, const char* path)
 	return curNode;
 }
 
-static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
+static void parseCaseTrie (CaseTree& tree, std::streambuf& buf)
 {
-	vector<CaseTreeNode*>	nodeStack;
-	string					curName;
-	bool					expectNode		= true;
+	vector<int>		nodeStack;
+	string			curName;
+	bool			expectNode		= true;
 
-	if (in.get() != '{')
+	if (buf.sbumpc() != '{')
 		throw std::invalid_argument("Malformed case trie");
 
-	nodeStack.push_back(root);
+	nodeStack.push_back(CaseTree::ROOT);
 
 	while (!nodeStack.empty())
 	{
-		const int	curChr	= in.get();
+		const int	curChr	= buf.sbumpc();
 
 		if (curChr == std::char_traits<char>::eof() || curChr == 0)
 			throw std::invalid_argument("Unterminated case tree");
@@ -379,17 +466,11 @@ static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
 		{
 			if (!curName.empty() && expectNode)
 			{
-				CaseTreeNode* const newChild = new CaseTreeNode(curName);
+				// Repeated group names are merged
+				int newChild = tree.findChild(nodeStack.back(), curName.c_str(), (int)curName.size());
 
-				try
-				{
-					nodeStack.back()->addChild(newChild);
-				}
-				catch (...)
-				{
-					delete newChild;
-					throw;
-				}
+				if (newChild == CaseTree::NOT_FOUND)
+					newChild = tree.addChild(nodeStack.back(), curName.c_str(), (int)curName.size());
 
 				if (curChr == '{')
 					nodeStack.push_back(newChild);
@@ -407,10 +488,10 @@ static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
 				// consume trailing new line
 				if (nodeStack.empty())
 				{
-					if (in.peek() == '\r')
-					  in.get();
-					if (in.peek() == '\n')
-					  in.get();
+					if (buf.sgetc() == '\r')
+					  buf.sbumpc();
+					if (buf.sgetc() == '\n')
+					  buf.sbumpc();
 				}
 			}
 			else
@@ -423,50 +504,40 @@ static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
 	}
 }
 
-static void parseCaseList (CaseTreeNode* root, std::istream& in)
+static void parseCaseList (CaseTree& tree, std::streambuf& buf)
 {
 	// \note Algorithm assumes that cases are sorted by groups, but will
 	//		 function fine, albeit more slowly, if that is not the case.
-	vector<CaseTreeNode*>	nodeStack;
-	int						stackPos	= 0;
-	string					curName;
+	vector<int>		nodeStack;
+	int				stackPos	= 0;
+	string			curName;
 
-	nodeStack.resize(8, DE_NULL);
+	nodeStack.resize(8, CaseTree::NOT_FOUND);
 
-	nodeStack[0] = root;
+	nodeStack[0] = CaseTree::ROOT;
 
 	for (;;)
 	{
-		const int	curChr	= in.get();
+		const int	curChr	= buf.sbumpc();
 
 		if (curChr == std::char_traits<char>::eof() || curChr == 0 || curChr == '\n' || curChr == '\r')
 		{
 			if (curName.empty())
 				throw std::invalid_argument("Empty test case name");
 
-			if (nodeStack[stackPos]->hasChild(curName))
+			if (tree.findChild(nodeStack[stackPos], curName.c_str(), (int)curName.size()) != CaseTree::NOT_FOUND)
 				throw std::invalid_argument("Duplicate test case");
 
-			CaseTreeNode* const newChild = new CaseTreeNode(curName);
-
-			try
-			{
-				nodeStack[stackPos]->addChild(newChild);
-			}
-			catch (...)
-			{
-				delete newChild;
-				throw;
-			}
+			tree.addChild(nodeStack[stackPos], curName.c_str(), (int)curName.size());
 
 			curName.clear();
 			stackPos = 0;
 
-			if (curChr == '\r' && in.peek() == '\n')
-				in.get();
+			if (curChr == '\r' && buf.sgetc() == '\n')
+				buf.sbumpc();
 
 			{
-				const int nextChr = in.peek();
+				const int nextChr = buf.sgetc();
 
 				if (nextChr == std::char_traits<char>::eof() || nextChr == 0)
 					break;
@@ -478,34 +549,22 @@ static void parseCaseList (CaseTreeNode* root, std::istream& in)
 				throw std::invalid_argument("Empty test group name");
 
 			if ((int)nodeStack.size() <= stackPos+1)
-				nodeStack.resize(nodeStack.size()*2, DE_NULL);
+				nodeStack.resize(nodeStack.size()*2, CaseTree::NOT_FOUND);
 
-			if (!nodeStack[stackPos+1] || nodeStack[stackPos+1]->getName() != curName)
+			if (nodeStack[stackPos+1] == CaseTree::NOT_FOUND || !tree.isNamed(nodeStack[stackPos+1], curName))
 			{
-				CaseTreeNode* curGroup = nodeStack[stackPos]->getChild(curName);
+				int curGroup = tree.findChild(nodeStack[stackPos], curName.c_str(), (int)curName.size());
 
-				if (!curGroup)
-				{
-					curGroup = new CaseTreeNode(curName);
-
-					try
-					{
-						nodeStack[stackPos]->addChild(curGroup);
-					}
-					catch (...)
-					{
-						delete curGroup;
-						throw;
-					}
-				}
+				if (curGroup == CaseTree::NOT_FOUND)
+					curGroup = tree.addChild(nodeStack[stackPos], curName.c_str(), (int)curName.size());
 
 				nodeStack[stackPos+1] = curGroup;
 
 				if ((int)nodeStack.size() > stackPos+2)
-					nodeStack[stackPos+2] = DE_NULL; // Invalidate rest of entries
+					nodeStack[stackPos+2] = CaseTree::NOT_FOUND; // Invalidate rest of entries
 			}
 
-			DE_ASSERT(nodeStack[stackPos+1]->getName() == curName);
+			DE_ASSERT(tree.isNamed(nodeStack[stackPos+1], curName));
 
 			curName.clear();
 			stackPos += 1;
@@ -517,27 +576,29 @@ static void parseCaseList (CaseTreeNode* root, std::istream& in)
 	}
 }
 
-static CaseTreeNode* parseCaseList (std::istream& in)
+static CaseTree* parseCaseList (std::istream& in)
 {
-	CaseTreeNode* const root = new CaseTreeNode("");
+	// \note Characters are read directly from the stream buffer to avoid per-character istream overhead.
+	std::streambuf&	buf		= *in.rdbuf();
+	CaseTree* const	tree	= new CaseTree();
 	try
 	{
-		if (in.peek() == '{')
-			parseCaseTrie(root, in);
+		if (buf.sgetc() == '{')
+			parseCaseTrie(*tree, buf);
 		else
-			parseCaseList(root, in);
+			parseCaseList(*tree, buf);
 
 		{
-			const int curChr = in.get();
+			const int curChr = buf.sbumpc();
 			if (curChr != std::char_traits<char>::eof() && curChr != 0)
 				throw std::invalid_argument("Trailing characters at end of case list");
 		}
 
-		return root;
+		return tree;
 	}
 	catch (...)
 	{
-		delete root;
+		delete tree;
 		throw;
 	}
 }
@@ -743,6 +804,12 @@ bool CommandLine::parse (int argc, const char* const* argv)
 	if (!m_cmdLine.getOption<opt::LogFlush>())
 		m_logFlags |= QP_TEST_LOG_NO_FLUSH;
 
+	if (m_cmdLine.getOption<opt::LogAsync>())
+		m_logFlags |= QP_TEST_LOG_ASYNC_WRITE;
+
+	if (m_cmdLine.getOption<opt::LogCaseIndex>())
+		m_logFlags |= QP_TEST_LOG_WRITE_CASE_INDEX;
+
 	if ((m_cmdLine.hasOption<opt::CasePath>()?1:0) +
 		(m_cmdLine.hasOption<opt::CaseList>()?1:0) +
 		(m_cmdLine.hasOption<opt::CaseListFile>()?1:0) +
@@ -809,6 +876,8 @@ bool					CommandLine::isShaderCacheTruncateEnabled	(void) const	{ return m_cmdLi
 int						CommandLine::getOptimizationRecipe			(void) const	{ return m_cmdLine.getOption<opt::Optimization>();					}
 bool					CommandLine::isSpirvOptimizationEnabled		(void) const	{ return m_cmdLine.getOption<opt::OptimizeSpirv>();					}
 bool					CommandLine::isRenderDocEnabled				(void) const	{ return m_cmdLine.getOption<opt::RenderDoc>();						}
+int						CommandLine::getNumWorkerThreads			(void) const	{ return m_cmdLine.getOption<opt::WorkerThreads>();					}
+int						CommandLine::getDecompressionCacheSize		(void) const	{ return m_cmdLine.getOption<opt::DecompressCacheSize>();			}
 
 const char* CommandLine::getGLContextType (void) const
 {
@@ -865,16 +934,16 @@ const char* CommandLine::getEGLPixmapType (void) const
 		return DE_NULL;
 }
 
-static bool checkTestGroupName (const CaseTreeNode* root, const char* groupPath)
+static bool checkTestGroupName (const CaseTree& tree, const char* groupPath)
 {
-	const CaseTreeNode* node = findNode(root, groupPath);
-	return node && node->hasChildren();
+	const int node = tree.findNode(groupPath);
+	return node != CaseTree::NOT_FOUND && tree.hasChildren(node);
 }
 
-static bool checkTestCaseName (const CaseTreeNode* root, const char* casePath)
+static bool checkTestCaseName (const CaseTree& tree, const char* casePath)
 {
-	const CaseTreeNode* node = findNode(root, casePath);
-	return node && !node->hasChildren();
+	const int node = tree.findNode(casePath);
+	return node != CaseTree::NOT_FOUND && !tree.hasChildren(node);
 }
 
 de::MovePtr<CaseListFilter> CommandLine::createCaseListFilter (const tcu::Archive& archive) const
@@ -887,7 +956,7 @@ bool CaseListFilter::checkTestGroupName (const char* groupName) const
 	if (m_casePaths)
 		return m_casePaths->matches(groupName, true);
 	else if (m_caseTree)
-		return groupName[0] == 0 || tcu::checkTestGroupName(m_caseTree, groupName);
+		return groupName[0] == 0 || tcu::checkTestGroupName(*m_caseTree, groupName);
 	else
 		return true;
 }
@@ -897,7 +966,7 @@ bool CaseListFilter::checkTestCaseName (const char* caseName) const
 	if (m_casePaths)
 		return m_casePaths->matches(caseName, false);
 	else if (m_caseTree)
-		return tcu::checkTestCaseName(m_caseTree, caseName);
+		return tcu::checkTestCaseName(*m_caseTree, caseName);
 	else
 		return true;
 }
@@ -87,7 +87,7 @@ enum ScreenRotation
 	SCREENROTATION_LAST
 };
 
-class CaseTreeNode;
+class CaseTree;
 class CasePaths;
 class Archive;
 
@@ -98,7 +98,7 @@ public:
 									CaseListFilter				(void);
 									~CaseListFilter				(void);
 
-	//! Check if test group is in supplied test case list.
+	//! Check if test group is in supplied test case list, i.e. whether any case under it can match.
 	bool							checkTestGroupName			(const char* groupName) const;
 
 	//! Check if test case is in supplied test case list.
@@ -108,7 +108,7 @@ private:
 	CaseListFilter												(const CaseListFilter&);	// not allowed!
 	CaseListFilter&					operator=					(const CaseListFilter&);	// not allowed!
 
-	CaseTreeNode*					m_caseTree;
+	CaseTree*						m_caseTree;
 	de::MovePtr<const CasePaths>	m_casePaths;
 };
 
@@ -229,6 +229,12 @@ public:
 	//! Enable RenderDoc frame markers (--deqp-renderdoc)
 	bool							isRenderDocEnabled			(void) const;
 
+	//! Get number of CPU worker threads (--deqp-worker-threads)
+	int								getNumWorkerThreads			(void) const;
+
+	//! Get size of decompressed texture cache in megabytes (--deqp-decompression-cache-size)
+	int								getDecompressionCacheSize	(void) const;
+
 	/*--------------------------------------------------------------------*//*!
 	 * \brief Creates case list filter
 	 * \param archive Resources
@@ -24,11 +24,17 @@
 #include "tcuCompressedTexture.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuAstcUtil.hpp"
+#include "tcuWorkerPool.hpp"
 
 #include "deStringUtil.hpp"
 #include "deFloat16.h"
+#include "deMutex.hpp"
+#include "deString.h"
+#include "deMemory.h"
+#include "deInt32.h"
 
 #include <algorithm>
+#include <list>
 
 namespace tcu
 {
@@ -2493,39 +2499,228 @@ int componentSum (const IVec3& vec)
 	return vec.x() + vec.y() + vec.z();
 }
 
-} // anonymous
+// Decodes one row of blocks per item. Rows write disjoint regions of the destination.
+class DecompressBlockRows : public ParallelWork
+{
+public:
+							DecompressBlockRows	(const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, const TexDecompressionParams& params);
+
+	int						getNumItems			(void) const { return m_blockCount.y() * m_blockCount.z(); }
+	void					execute				(int workerNdx, int itemNdx);
+
+private:
+	const PixelBufferAccess			m_dst;
+	const CompressedTexFormat		m_format;
+	const deUint8* const			m_src;
+	const TexDecompressionParams	m_params;
+	const IVec3						m_blockPixelSize;
+	const IVec3						m_blockCount;
+	const IVec3						m_blockPitches;
+	const int						m_uncompressedBlockSize;
+	std::vector<deUint8>			m_uncompressedBlocks;	//!< One block per worker thread
+};
 
-void decompress (const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, const TexDecompressionParams& params)
+DecompressBlockRows::DecompressBlockRows (const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, const TexDecompressionParams& params)
+	: m_dst						(dst)
+	, m_format					(fmt)
+	, m_src						(src)
+	, m_params					(params)
+	, m_blockPixelSize			(getBlockPixelSize(fmt))
+	, m_blockCount				(deDivRoundUp32(dst.getWidth(),		m_blockPixelSize.x()),
+								 deDivRoundUp32(dst.getHeight(),	m_blockPixelSize.y()),
+								 deDivRoundUp32(dst.getDepth(),		m_blockPixelSize.z()))
+	, m_blockPitches			(getBlockSize(fmt), getBlockSize(fmt) * m_blockCount.x(), getBlockSize(fmt) * m_blockCount.x() * m_blockCount.y())
+	, m_uncompressedBlockSize	(dst.getFormat().getPixelSize() * m_blockPixelSize.x() * m_blockPixelSize.y() * m_blockPixelSize.z())
+	, m_uncompressedBlocks		((size_t)(m_uncompressedBlockSize * getNumWorkerThreads()))
 {
-	const int				blockSize			= getBlockSize(fmt);
-	const IVec3				blockPixelSize		(getBlockPixelSize(fmt));
-	const IVec3				blockCount			(deDivRoundUp32(dst.getWidth(),		blockPixelSize.x()),
-												 deDivRoundUp32(dst.getHeight(),	blockPixelSize.y()),
-												 deDivRoundUp32(dst.getDepth(),		blockPixelSize.z()));
-	const IVec3				blockPitches		(blockSize, blockSize * blockCount.x(), blockSize * blockCount.x() * blockCount.y());
-
-	std::vector<deUint8>	uncompressedBlock	(dst.getFormat().getPixelSize() * blockPixelSize.x() * blockPixelSize.y() * blockPixelSize.z());
-	const PixelBufferAccess	blockAccess			(getUncompressedFormat(fmt), blockPixelSize.x(), blockPixelSize.y(), blockPixelSize.z(), &uncompressedBlock[0]);
-
 	DE_ASSERT(dst.getFormat() == getUncompressedFormat(fmt));
+}
+
+void DecompressBlockRows::execute (int workerNdx, int itemNdx)
+{
+	const PixelBufferAccess	blockAccess	(m_dst.getFormat(), m_blockPixelSize.x(), m_blockPixelSize.y(), m_blockPixelSize.z(), &m_uncompressedBlocks[workerNdx * m_uncompressedBlockSize]);
+	const int				blockY		= itemNdx % m_blockCount.y();
+	const int				blockZ		= itemNdx / m_blockCount.y();
 
-	for (int blockZ = 0; blockZ < blockCount.z(); blockZ++)
-	for (int blockY = 0; blockY < blockCount.y(); blockY++)
-	for (int blockX = 0; blockX < blockCount.x(); blockX++)
+	for (int blockX = 0; blockX < m_blockCount.x(); blockX++)
 	{
 		const IVec3				blockPos	(blockX, blockY, blockZ);
-		const deUint8* const	blockPtr	= src + componentSum(blockPos * blockPitches);
-		const IVec3				copySize	(de::min(blockPixelSize.x(), dst.getWidth()		- blockPos.x() * blockPixelSize.x()),
-											 de::min(blockPixelSize.y(), dst.getHeight()	- blockPos.y() * blockPixelSize.y()),
-											 de::min(blockPixelSize.z(), dst.getDepth()		- blockPos.z() * blockPixelSize.z()));
-		const IVec3				dstPixelPos	= blockPos * blockPixelSize;
+		const deUint8* const	blockPtr	= m_src + componentSum(blockPos * m_blockPitches);
+		const IVec3				copySize	(de::min(m_blockPixelSize.x(), m_dst.getWidth()		- blockPos.x() * m_blockPixelSize.x()),
+											 de::min(m_blockPixelSize.y(), m_dst.getHeight()	- blockPos.y() * m_blockPixelSize.y()),
+											 de::min(m_blockPixelSize.z(), m_dst.getDepth()		- blockPos.z() * m_blockPixelSize.z()));
+		const IVec3				dstPixelPos	= blockPos * m_blockPixelSize;
 
-		decompressBlock(fmt, blockAccess, blockPtr, params);
+		decompressBlock(m_format, blockAccess, blockPtr, m_params);
 
-		copy(getSubregion(dst, dstPixelPos.x(), dstPixelPos.y(), dstPixelPos.z(), copySize.x(), copySize.y(), copySize.z()), getSubregion(blockAccess, 0, 0, 0, copySize.x(), copySize.y(), copySize.z()));
+		copy(getSubregion(m_dst, dstPixelPos.x(), dstPixelPos.y(), dstPixelPos.z(), copySize.x(), copySize.y(), copySize.z()), getSubregion(blockAccess, 0, 0, 0, copySize.x(), copySize.y(), copySize.z()));
 	}
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Process-wide cache of decompressed levels
+ *
+ * Levels are identified by format, decompression parameters, size and
+ * compressed contents. Compressed data is stored alongside the decoded
+ * level and compared in full on lookup, so hash collisions are harmless.
+ * Least recently used levels are evicted once the size limit is exceeded.
+ *//*--------------------------------------------------------------------*/
+class DecompressionCache
+{
+public:
+							DecompressionCache	(void) : m_maxSize(0), m_size(0) {}
+
+	void					setMaxSize			(size_t maxSize);
+	bool					isEnabled			(void) const { return m_maxSize != 0; }
+
+	bool					lookup				(const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, size_t srcSize, const TexDecompressionParams& params);
+	void					insert				(const ConstPixelBufferAccess& level, CompressedTexFormat fmt, const deUint8* src, size_t srcSize, const TexDecompressionParams& params);
+
+private:
+	struct Entry
+	{
+		deUint32					hash;
+		CompressedTexFormat			format;
+		TexDecompressionParams		params;
+		IVec3						size;
+		std::vector<deUint8>		compressed;
+		std::vector<deUint8>		uncompressed;
+
+		Entry (void) : hash(0), format(COMPRESSEDTEXFORMAT_LAST) {}
+	};
+
+	typedef std::list<Entry> EntryList;
+
+	static deUint32			computeHash			(CompressedTexFormat fmt, const deUint8* src, size_t srcSize);
+	EntryList::iterator		find				(deUint32 hash, CompressedTexFormat fmt, const IVec3& size, const deUint8* src, size_t srcSize, const TexDecompressionParams& params);
+	void					evict				(void);
+
+	de::Mutex				m_lock;
+	size_t					m_maxSize;
+	size_t					m_size;
+	EntryList				m_entries;			//!< Most recently used first
+};
+
+deUint32 DecompressionCache::computeHash (CompressedTexFormat fmt, const deUint8* src, size_t srcSize)
+{
+	return deMemoryHash(src, srcSize) ^ deInt32Hash((deInt32)fmt);
+}
+
+DecompressionCache::EntryList::iterator DecompressionCache::find (deUint32 hash, CompressedTexFormat fmt, const IVec3& size, const deUint8* src, size_t srcSize, const TexDecompressionParams& params)
+{
+	for (EntryList::iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+	{
+		if (entry->hash					== hash				&&
+			entry->format				== fmt				&&
+			entry->size					== size				&&
+			entry->params.astcMode		== params.astcMode	&&
+			entry->compressed.size()	== srcSize			&&
+			deMemCmp(&entry->compressed[0], src, srcSize) == 0)
+			return entry;
+	}
+
+	return m_entries.end();
+}
+
+void DecompressionCache::evict (void)
+{
+	while (m_size > m_maxSize && !m_entries.empty())
+	{
+		m_size -= m_entries.back().compressed.size() + m_entries.back().uncompressed.size();
+		m_entries.pop_back();
+	}
+}
+
+void DecompressionCache::setMaxSize (size_t maxSize)
+{
+	de::ScopedLock lock (m_lock);
+
+	m_maxSize = maxSize;
+	evict();
+}
+
+bool DecompressionCache::lookup (const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, size_t srcSize, const TexDecompressionParams& params)
+{
+	const deUint32		hash	= computeHash(fmt, src, srcSize);
+	de::ScopedLock		lock	(m_lock);
+	EntryList::iterator	entry	= find(hash, fmt, dst.getSize(), src, srcSize, params);
+
+	if (entry == m_entries.end())
+		return false;
+
+	// Move to front
+	m_entries.splice(m_entries.begin(), m_entries, entry);
+
+	copy(dst, ConstPixelBufferAccess(dst.getFormat(), entry->size, &entry->uncompressed[0]));
+	return true;
+}
+
+void DecompressionCache::insert (const ConstPixelBufferAccess& level, CompressedTexFormat fmt, const deUint8* src, size_t srcSize, const TexDecompressionParams& params)
+{
+	const size_t	levelSize	= (size_t)level.getFormat().getPixelSize() * level.getWidth() * level.getHeight() * level.getDepth();
+	const deUint32	hash		= computeHash(fmt, src, srcSize);
+
+	{
+		de::ScopedLock lock (m_lock);
+
+		if (levelSize + srcSize > m_maxSize || find(hash, fmt, level.getSize(), src, srcSize, params) != m_entries.end())
+			return;
+	}
+
+	// Copy data outside the lock
+	EntryList	newEntry	(1);
+	Entry&		entry		= newEntry.front();
+
+	entry.hash		= hash;
+	entry.format	= fmt;
+	entry.params	= params;
+	entry.size		= level.getSize();
+	entry.compressed.assign(src, src + srcSize);
+	entry.uncompressed.resize(levelSize);
+
+	copy(PixelBufferAccess(level.getFormat(), entry.size, &entry.uncompressed[0]), level);
+
+	{
+		de::ScopedLock lock (m_lock);
+
+		if (find(hash, fmt, entry.size, src, srcSize, params) != m_entries.end())
+			return;
+
+		m_entries.splice(m_entries.begin(), newEntry);
+		m_size += srcSize + levelSize;
+		evict();
+	}
+}
+
+DecompressionCache	s_decompressionCache;
+
+} // anonymous
+
+void setDecompressionCacheSize (size_t maxBytes)
+{
+	s_decompressionCache.setMaxSize(maxBytes);
+}
+
+void decompress (const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, const TexDecompressionParams& params)
+{
+	const IVec3		blockPixelSize	(getBlockPixelSize(fmt));
+	const size_t	srcSize			= (size_t)getBlockSize(fmt) * deDivRoundUp32(dst.getWidth(),	blockPixelSize.x())
+																* deDivRoundUp32(dst.getHeight(),	blockPixelSize.y())
+																* deDivRoundUp32(dst.getDepth(),	blockPixelSize.z());
+	const bool		useCache		= s_decompressionCache.isEnabled();
+
+	if (useCache && s_decompressionCache.lookup(dst, fmt, src, srcSize, params))
+		return;
+
+	{
+		DecompressBlockRows	work	(dst, fmt, src, params);
+		executeParallel(work, work.getNumItems());
+	}
+
+	if (useCache)
+		s_decompressionCache.insert(dst, fmt, src, srcSize, params);
+}
+
 CompressedTexture::CompressedTexture (void)
 	: m_format	(COMPRESSEDTEXFORMAT_LAST)
 	, m_width	(0)
@@ -157,6 +157,9 @@ private:
 
 void decompress (const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, const TexDecompressionParams& params = TexDecompressionParams());
 
+//! Set maximum size of the process-wide cache of decompressed levels in bytes. 0 disables caching.
+void setDecompressionCacheSize (size_t maxBytes);
+
 } // tcu
 
 #endif // _TCUCOMPRESSEDTEXTURE_HPP
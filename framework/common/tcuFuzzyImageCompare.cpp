@@ -24,6 +24,7 @@
 #include "tcuFuzzyImageCompare.hpp"
 #include "tcuTexture.hpp"
 #include "tcuTextureUtil.hpp"
+#include "tcuWorkerPool.hpp"
 #include "deMath.h"
 #include "deRandom.hpp"
 
@@ -158,55 +159,108 @@ inline deUint32 bilinearSample (const ConstPixelBufferAccess& src, float u, floa
 	return dst;
 }
 
-template<int DstChannels, int SrcChannels>
-static void separableConvolve (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, int shiftX, int shiftY, const std::vector<float>& kernelX, const std::vector<float>& kernelY)
+namespace
 {
-	DE_ASSERT(dst.getWidth() == src.getWidth() && dst.getHeight() == src.getHeight());
 
-	TextureLevel		tmp			(dst.getFormat(), dst.getHeight(), dst.getWidth());
-	PixelBufferAccess	tmpAccess	= tmp.getAccess();
-
-	int kw = (int)kernelX.size();
-	int kh = (int)kernelY.size();
+// \note Temporary surface is written in column-wise order
+template<int DstChannels, int SrcChannels>
+class HorizontalConvolveWork : public ParallelWork
+{
+public:
+	HorizontalConvolveWork (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, int shift, const std::vector<float>& kernel)
+		: m_dst		(dst)
+		, m_src		(src)
+		, m_shift	(shift)
+		, m_kernel	(kernel)
+	{
+	}
 
-	// Horizontal pass
-	// \note Temporary surface is written in column-wise order
-	for (int j = 0; j < src.getHeight(); j++)
+	void execute (int, int j)
 	{
-		for (int i = 0; i < src.getWidth(); i++)
+		const int kw = (int)m_kernel.size();
+
+		for (int i = 0; i < m_src.getWidth(); i++)
 		{
 			Vec4 sum(0);
 
 			for (int kx = 0; kx < kw; kx++)
 			{
-				float		f = kernelX[kw-kx-1];
-				deUint32	p = readUnorm8<SrcChannels>(src, de::clamp(i+kx-shiftX, 0, src.getWidth()-1), j);
+				float		f = m_kernel[kw-kx-1];
+				deUint32	p = readUnorm8<SrcChannels>(m_src, de::clamp(i+kx-m_shift, 0, m_src.getWidth()-1), j);
 
 				sum += toFloatVec(p)*f;
 			}
 
-			writeUnorm8<DstChannels>(tmpAccess, j, i, toColor(sum));
+			writeUnorm8<DstChannels>(m_dst, j, i, toColor(sum));
 		}
 	}
 
-	// Vertical pass
-	for (int j = 0; j < src.getHeight(); j++)
+private:
+	const PixelBufferAccess			m_dst;
+	const ConstPixelBufferAccess	m_src;
+	const int						m_shift;
+	const std::vector<float>&		m_kernel;
+};
+
+template<int NumChannels>
+class VerticalConvolveWork : public ParallelWork
+{
+public:
+	VerticalConvolveWork (const PixelBufferAccess& dst, const ConstPixelBufferAccess& tmp, int shift, const std::vector<float>& kernel)
+		: m_dst		(dst)
+		, m_tmp		(tmp)
+		, m_shift	(shift)
+		, m_kernel	(kernel)
+	{
+	}
+
+	void execute (int, int j)
 	{
-		for (int i = 0; i < src.getWidth(); i++)
+		const int kh = (int)m_kernel.size();
+
+		for (int i = 0; i < m_dst.getWidth(); i++)
 		{
 			Vec4 sum(0.0f);
 
 			for (int ky = 0; ky < kh; ky++)
 			{
-				float		f = kernelY[kh-ky-1];
-				deUint32	p = readUnorm8<DstChannels>(tmpAccess, de::clamp(j+ky-shiftY, 0, tmp.getWidth()-1), i);
+				float		f = m_kernel[kh-ky-1];
+				deUint32	p = readUnorm8<NumChannels>(m_tmp, de::clamp(j+ky-m_shift, 0, m_tmp.getWidth()-1), i);
 
 				sum += toFloatVec(p)*f;
 			}
 
-			writeUnorm8<DstChannels>(dst, i, j, toColor(sum));
+			writeUnorm8<NumChannels>(m_dst, i, j, toColor(sum));
 		}
 	}
+
+private:
+	const PixelBufferAccess			m_dst;
+	const ConstPixelBufferAccess	m_tmp;
+	const int						m_shift;
+	const std::vector<float>&		m_kernel;
+};
+
+} // anonymous
+
+template<int DstChannels, int SrcChannels>
+static void separableConvolve (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, int shiftX, int shiftY, const std::vector<float>& kernelX, const std::vector<float>& kernelY)
+{
+	DE_ASSERT(dst.getWidth() == src.getWidth() && dst.getHeight() == src.getHeight());
+
+	TextureLevel		tmp			(dst.getFormat(), dst.getHeight(), dst.getWidth());
+	PixelBufferAccess	tmpAccess	= tmp.getAccess();
+
+	// Rows are independent in both passes
+	{
+		HorizontalConvolveWork<DstChannels, SrcChannels> work (tmpAccess, src, shiftX, kernelX);
+		executeParallel(work, src.getHeight());
+	}
+
+	{
+		VerticalConvolveWork<DstChannels> work (dst, tmpAccess, shiftY, kernelY);
+		executeParallel(work, src.getHeight());
+	}
 }
 
 template<int NumChannels>
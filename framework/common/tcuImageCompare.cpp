@@ -32,8 +32,10 @@
 #include "tcuTexture.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuWorkerPool.hpp"
 
 #include <string.h>
+#include <vector>
 
 namespace tcu
 {
@@ -88,14 +90,158 @@ void computeScaleAndBias (const ConstPixelBufferAccess& reference, const ConstPi
 	}
 }
 
+class ReadPixelsIntWork : public ParallelWork
+{
+public:
+								ReadPixelsIntWork	(const ConstPixelBufferAccess& src, IVec4* dst) : m_rows(src), m_dst(dst) {}
+
+	int							getNumItems			(void) const { return m_rows.getAccess().getHeight()*m_rows.getAccess().getDepth(); }
+
+	void						execute				(int, int itemNdx)
+	{
+		const int width = m_rows.getAccess().getWidth();
+		m_rows.readRow(0, itemNdx % m_rows.getAccess().getHeight(), itemNdx / m_rows.getAccess().getHeight(), width, m_dst + itemNdx*width);
+	}
+
+private:
+	const ConstPixelRowAccess	m_rows;
+	IVec4* const				m_dst;
+};
+
+static inline bool isWithinThreshold (const IVec4& a, const IVec4& b, const UVec4& threshold)
+{
+	return boolAll(lessThanEqual(abs(a - b).cast<deUint32>(), threshold));
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Row-parallel position deviation search
+ *
+ * Operates on unpacked reference and result pixels. Each work item processes
+ * one row of the compared region and stores its number of failing pixels.
+ *//*--------------------------------------------------------------------*/
+class PositionDeviationWork : public ParallelWork
+{
+public:
+							PositionDeviationWork	(const PixelBufferAccess& errorMask, const IVec4* reference, const IVec4* result, const UVec4& threshold, const IVec3& maxPositionDeviation, const IVec3& begin, const IVec3& end);
+
+	int						getNumItems				(void) const { return (int)m_rowNumFailed.size(); }
+	int						getNumFailed			(void) const;
+
+	void					execute					(int workerNdx, int itemNdx);
+
+private:
+	const IVec4&			getReference			(int x, int y, int z) const { return m_reference[(z*m_height + y)*m_width + x];	}
+	const IVec4&			getResult				(int x, int y, int z) const { return m_result[(z*m_height + y)*m_width + x];	}
+
+	const PixelBufferAccess	m_errorMask;
+	const IVec4* const		m_reference;
+	const IVec4* const		m_result;
+	const int				m_width;
+	const int				m_height;
+	const int				m_depth;
+	const UVec4				m_threshold;
+	const IVec3				m_maxPositionDeviation;
+	const IVec3				m_begin;
+	const IVec3				m_end;
+
+	std::vector<int>		m_rowNumFailed;
+};
+
+PositionDeviationWork::PositionDeviationWork (const PixelBufferAccess& errorMask, const IVec4* reference, const IVec4* result, const UVec4& threshold, const IVec3& maxPositionDeviation, const IVec3& begin, const IVec3& end)
+	: m_errorMask				(errorMask)
+	, m_reference				(reference)
+	, m_result					(result)
+	, m_width					(errorMask.getWidth())
+	, m_height					(errorMask.getHeight())
+	, m_depth					(errorMask.getDepth())
+	, m_threshold				(threshold)
+	, m_maxPositionDeviation	(maxPositionDeviation)
+	, m_begin					(begin)
+	, m_end						(end)
+	, m_rowNumFailed			((end.y() > begin.y() && end.z() > begin.z()) ? (end.y() - begin.y())*(end.z() - begin.z()) : 0, 0)
+{
+}
+
+int PositionDeviationWork::getNumFailed (void) const
+{
+	int numFailed = 0;
+
+	for (size_t ndx = 0; ndx < m_rowNumFailed.size(); ndx++)
+		numFailed += m_rowNumFailed[ndx];
+
+	return numFailed;
+}
+
+void PositionDeviationWork::execute (int, int itemNdx)
+{
+	const tcu::IVec4	errorColor		(255, 0, 0, 255);
+	const int			numRows			= m_end.y() - m_begin.y();
+	const int			y				= m_begin.y() + itemNdx % numRows;
+	const int			z				= m_begin.z() + itemNdx / numRows;
+	const int			minZ			= de::max(0, z - m_maxPositionDeviation.z());
+	const int			maxZ			= de::min(m_depth  - 1, z + m_maxPositionDeviation.z());
+	const int			minY			= de::max(0, y - m_maxPositionDeviation.y());
+	const int			maxY			= de::min(m_height - 1, y + m_maxPositionDeviation.y());
+	int					numFailed		= 0;
+
+	for (int x = m_begin.x(); x < m_end.x(); x++)
+	{
+		const IVec4&	refPix	= getReference(x, y, z);
+		const IVec4&	cmpPix	= getResult(x, y, z);
+		const int		minX	= de::max(0, x - m_maxPositionDeviation.x());
+		const int		maxX	= de::min(m_width  - 1, x + m_maxPositionDeviation.x());
+
+		// Exact match
+		if (isWithinThreshold(refPix, cmpPix, m_threshold))
+			continue;
+
+		// Find matching pixels for both result and reference pixel
+
+		{
+			bool pixelFoundForReference = false;
+
+			// Find deviated result pixel for reference
+
+			for (int sz = minZ; sz <= maxZ && !pixelFoundForReference; ++sz)
+			for (int sy = minY; sy <= maxY && !pixelFoundForReference; ++sy)
+			for (int sx = minX; sx <= maxX && !pixelFoundForReference; ++sx)
+				pixelFoundForReference = isWithinThreshold(refPix, getResult(sx, sy, sz), m_threshold);
+
+			if (!pixelFoundForReference)
+			{
+				m_errorMask.setPixel(errorColor, x, y, z);
+				++numFailed;
+				continue;
+			}
+		}
+		{
+			bool pixelFoundForResult = false;
+
+			// Find deviated reference pixel for result
+
+			for (int sz = minZ; sz <= maxZ && !pixelFoundForResult; ++sz)
+			for (int sy = minY; sy <= maxY && !pixelFoundForResult; ++sy)
+			for (int sx = minX; sx <= maxX && !pixelFoundForResult; ++sx)
+				pixelFoundForResult = isWithinThreshold(cmpPix, getReference(sx, sy, sz), m_threshold);
+
+			if (!pixelFoundForResult)
+			{
+				m_errorMask.setPixel(errorColor, x, y, z);
+				++numFailed;
+				continue;
+			}
+		}
+	}
+
+	m_rowNumFailed[itemNdx] = numFailed;
+}
+
 static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const tcu::IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue)
 {
 	const tcu::IVec4	okColor				(0, 255, 0, 255);
-	const tcu::IVec4	errorColor			(255, 0, 0, 255);
 	const int			width				= reference.getWidth();
 	const int			height				= reference.getHeight();
 	const int			depth				= reference.getDepth();
-	int					numFailingPixels	= 0;
 
 	// Accept pixels "sampling" over the image bounds pixels since "taps" could be anything
 	const int			beginX				= (acceptOutOfBoundsAsAnyValue) ? (maxPositionDeviation.x()) : (0);
@@ -110,77 +256,27 @@ static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& error
 
 	tcu::clear(errorMask, okColor);
 
-	for (int z = beginZ; z < endZ; z++)
+	if (width*height*depth == 0)
+		return 0;
+
 	{
-		for (int y = beginY; y < endY; y++)
+		// Unpack both images once, search reads each pixel up to (2*maxPositionDeviation+1)^3 times
+		std::vector<IVec4>		referencePixels	(width*height*depth);
+		std::vector<IVec4>		resultPixels	(width*height*depth);
+		ReadPixelsIntWork		readReference	(reference, &referencePixels[0]);
+		ReadPixelsIntWork		readResult		(result, &resultPixels[0]);
+
+		executeParallel(readReference, readReference.getNumItems());
+		executeParallel(readResult, readResult.getNumItems());
+
 		{
-			for (int x = beginX; x < endX; x++)
-			{
-				const IVec4	refPix = reference.getPixelInt(x, y, z);
-				const IVec4	cmpPix = result.getPixelInt(x, y, z);
-
-				// Exact match
-				{
-					const UVec4	diff = abs(refPix - cmpPix).cast<deUint32>();
-					const bool	isOk = boolAll(lessThanEqual(diff, threshold));
-
-					if (isOk)
-						continue;
-				}
-
-				// Find matching pixels for both result and reference pixel
-
-				{
-					bool pixelFoundForReference = false;
-
-					// Find deviated result pixel for reference
-
-					for (int sz = de::max(0, z - maxPositionDeviation.z()); sz <= de::min(depth  - 1, z + maxPositionDeviation.z()) && !pixelFoundForReference; ++sz)
-					for (int sy = de::max(0, y - maxPositionDeviation.y()); sy <= de::min(height - 1, y + maxPositionDeviation.y()) && !pixelFoundForReference; ++sy)
-					for (int sx = de::max(0, x - maxPositionDeviation.x()); sx <= de::min(width  - 1, x + maxPositionDeviation.x()) && !pixelFoundForReference; ++sx)
-					{
-						const IVec4	deviatedCmpPix	= result.getPixelInt(sx, sy, sz);
-						const UVec4	diff			= abs(refPix - deviatedCmpPix).cast<deUint32>();
-						const bool	isOk			= boolAll(lessThanEqual(diff, threshold));
-
-						pixelFoundForReference		= isOk;
-					}
-
-					if (!pixelFoundForReference)
-					{
-						errorMask.setPixel(errorColor, x, y, z);
-						++numFailingPixels;
-						continue;
-					}
-				}
-				{
-					bool pixelFoundForResult = false;
-
-					// Find deviated reference pixel for result
-
-					for (int sz = de::max(0, z - maxPositionDeviation.z()); sz <= de::min(depth  - 1, z + maxPositionDeviation.z()) && !pixelFoundForResult; ++sz)
-					for (int sy = de::max(0, y - maxPositionDeviation.y()); sy <= de::min(height - 1, y + maxPositionDeviation.y()) && !pixelFoundForResult; ++sy)
-					for (int sx = de::max(0, x - maxPositionDeviation.x()); sx <= de::min(width  - 1, x + maxPositionDeviation.x()) && !pixelFoundForResult; ++sx)
-					{
-						const IVec4	deviatedRefPix	= reference.getPixelInt(sx, sy, sz);
-						const UVec4	diff			= abs(cmpPix - deviatedRefPix).cast<deUint32>();
-						const bool	isOk			= boolAll(lessThanEqual(diff, threshold));
-
-						pixelFoundForResult			= isOk;
-					}
-
-					if (!pixelFoundForResult)
-					{
-						errorMask.setPixel(errorColor, x, y, z);
-						++numFailingPixels;
-						continue;
-					}
-				}
-			}
+			PositionDeviationWork	work	(errorMask, &referencePixels[0], &resultPixels[0], threshold, maxPositionDeviation, IVec3(beginX, beginY, beginZ), IVec3(endX, endY, endZ));
+
+			executeParallel(work, work.getNumItems());
+
+			return work.getNumFailed();
 		}
 	}
-
-	return numFailingPixels;
 }
 
 } // anonymous
@@ -462,6 +558,234 @@ static tcu::UVec4 computeFlushRelaxedULPDiff (const tcu::Vec4& a, const tcu::Vec
 					  computeFloatFlushRelaxedULPDiff(a.w(), b.w()));
 }
 
+namespace
+{
+
+struct FloatDiff
+{
+	typedef Vec4	PixelType;
+	typedef Vec4	DiffType;
+
+	static DiffType compute (const Vec4& a, const Vec4& b) { return abs(a - b); }
+};
+
+struct FloatUlpDiff
+{
+	typedef Vec4	PixelType;
+	typedef UVec4	DiffType;
+
+	static DiffType compute (const Vec4& a, const Vec4& b) { return computeFlushRelaxedULPDiff(a, b); }
+};
+
+struct IntDiff
+{
+	typedef IVec4	PixelType;
+	typedef UVec4	DiffType;
+
+	static DiffType compute (const IVec4& a, const IVec4& b) { return abs(a - b).cast<deUint32>(); }
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Row-parallel threshold compare
+ *
+ * Each work item compares one row and writes the corresponding error mask
+ * row. Maximum difference is tracked per row and combined afterwards so
+ * that the result does not depend on execution order.
+ *//*--------------------------------------------------------------------*/
+template<typename Diff>
+class ThresholdCompareWork : public ParallelWork
+{
+public:
+	typedef typename Diff::PixelType	PixelType;
+	typedef typename Diff::DiffType		DiffType;
+
+								ThresholdCompareWork	(const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const PixelBufferAccess& errorMask, const DiffType& threshold);
+								ThresholdCompareWork	(const PixelType& reference, const ConstPixelBufferAccess& result, const PixelBufferAccess& errorMask, const DiffType& threshold);
+
+	int							getNumItems				(void) const { return m_height*m_depth; }
+	DiffType					getMaxDiff				(void) const;
+
+	void						execute					(int workerNdx, int itemNdx);
+
+private:
+	const int					m_width;
+	const int					m_height;
+	const int					m_depth;
+	const bool					m_constReference;
+	const ConstPixelRowAccess	m_referenceRows;
+	const ConstPixelRowAccess	m_resultRows;
+	const PixelRowAccess		m_errorMaskRows;
+	const DiffType				m_threshold;
+
+	std::vector<PixelType>		m_refRows;
+	std::vector<PixelType>		m_cmpRows;
+	std::vector<IVec4>			m_errorRows;
+	std::vector<DiffType>		m_rowMaxDiff;
+};
+
+template<typename Diff>
+ThresholdCompareWork<Diff>::ThresholdCompareWork (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const PixelBufferAccess& errorMask, const DiffType& threshold)
+	: m_width			(result.getWidth())
+	, m_height			(result.getHeight())
+	, m_depth			(result.getDepth())
+	, m_constReference	(false)
+	, m_referenceRows	(reference)
+	, m_resultRows		(result)
+	, m_errorMaskRows	(errorMask)
+	, m_threshold		(threshold)
+	, m_refRows			(getNumWorkerThreads()*m_width)
+	, m_cmpRows			(getNumWorkerThreads()*m_width)
+	, m_errorRows		(getNumWorkerThreads()*m_width)
+	, m_rowMaxDiff		(m_height*m_depth, DiffType(0))
+{
+}
+
+template<typename Diff>
+ThresholdCompareWork<Diff>::ThresholdCompareWork (const PixelType& reference, const ConstPixelBufferAccess& result, const PixelBufferAccess& errorMask, const DiffType& threshold)
+	: m_width			(result.getWidth())
+	, m_height			(result.getHeight())
+	, m_depth			(result.getDepth())
+	, m_constReference	(true)
+	, m_referenceRows	(result)
+	, m_resultRows		(result)
+	, m_errorMaskRows	(errorMask)
+	, m_threshold		(threshold)
+	, m_refRows			(getNumWorkerThreads()*m_width, reference)
+	, m_cmpRows			(getNumWorkerThreads()*m_width)
+	, m_errorRows		(getNumWorkerThreads()*m_width)
+	, m_rowMaxDiff		(m_height*m_depth, DiffType(0))
+{
+}
+
+template<typename Diff>
+typename ThresholdCompareWork<Diff>::DiffType ThresholdCompareWork<Diff>::getMaxDiff (void) const
+{
+	DiffType maxDiff (0);
+
+	for (size_t ndx = 0; ndx < m_rowMaxDiff.size(); ndx++)
+		maxDiff = max(maxDiff, m_rowMaxDiff[ndx]);
+
+	return maxDiff;
+}
+
+template<typename Diff>
+void ThresholdCompareWork<Diff>::execute (int workerNdx, int itemNdx)
+{
+	const int			y			= itemNdx % m_height;
+	const int			z			= itemNdx / m_height;
+	PixelType* const	refRow		= &m_refRows[workerNdx*m_width];
+	PixelType* const	cmpRow		= &m_cmpRows[workerNdx*m_width];
+	IVec4* const		errorRow	= &m_errorRows[workerNdx*m_width];
+	DiffType			maxDiff		(0);
+
+	if (!m_constReference)
+		m_referenceRows.readRow(0, y, z, m_width, refRow);
+
+	m_resultRows.readRow(0, y, z, m_width, cmpRow);
+
+	for (int x = 0; x < m_width; x++)
+	{
+		const DiffType	diff	= Diff::compute(refRow[x], cmpRow[x]);
+		const bool		isOk	= boolAll(lessThanEqual(diff, m_threshold));
+
+		maxDiff = max(maxDiff, diff);
+
+		errorRow[x] = isOk ? IVec4(0, 0xff, 0, 0xff) : IVec4(0xff, 0, 0, 0xff);
+	}
+
+	m_errorMaskRows.writeRow(0, y, z, m_width, errorRow);
+	m_rowMaxDiff[itemNdx] = maxDiff;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Row-parallel integer threshold compare for RGBA8 images
+ *
+ * Same as ThresholdCompareWork<IntDiff> but operates directly on packed
+ * channel bytes. Error mask must be in RGB8 format.
+ *//*--------------------------------------------------------------------*/
+class RGBA8ThresholdCompareWork : public ParallelWork
+{
+public:
+									RGBA8ThresholdCompareWork	(const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const PixelBufferAccess& errorMask, const UVec4& threshold);
+
+	int								getNumItems					(void) const { return m_height*m_depth; }
+	UVec4							getMaxDiff					(void) const;
+
+	void							execute						(int workerNdx, int itemNdx);
+
+private:
+	const int						m_width;
+	const int						m_height;
+	const int						m_depth;
+	const ConstPixelBufferAccess	m_reference;
+	const ConstPixelBufferAccess	m_result;
+	const PixelBufferAccess			m_errorMask;
+	const UVec4						m_threshold;
+
+	std::vector<UVec4>				m_rowMaxDiff;
+};
+
+RGBA8ThresholdCompareWork::RGBA8ThresholdCompareWork (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const PixelBufferAccess& errorMask, const UVec4& threshold)
+	: m_width		(result.getWidth())
+	, m_height		(result.getHeight())
+	, m_depth		(result.getDepth())
+	, m_reference	(reference)
+	, m_result		(result)
+	, m_errorMask	(errorMask)
+	, m_threshold	(threshold)
+	, m_rowMaxDiff	(m_height*m_depth, UVec4(0))
+{
+	DE_ASSERT(errorMask.getFormat() == TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8));
+}
+
+UVec4 RGBA8ThresholdCompareWork::getMaxDiff (void) const
+{
+	UVec4 maxDiff (0);
+
+	for (size_t ndx = 0; ndx < m_rowMaxDiff.size(); ndx++)
+		maxDiff = max(maxDiff, m_rowMaxDiff[ndx]);
+
+	return maxDiff;
+}
+
+void RGBA8ThresholdCompareWork::execute (int, int itemNdx)
+{
+	const int			y				= itemNdx % m_height;
+	const int			z				= itemNdx / m_height;
+	const deUint8*		refPtr			= (const deUint8*)m_reference.getPixelPtr(0, y, z);
+	const deUint8*		cmpPtr			= (const deUint8*)m_result.getPixelPtr(0, y, z);
+	deUint8*			maskPtr			= (deUint8*)m_errorMask.getPixelPtr(0, y, z);
+	const int			refPixelPitch	= m_reference.getPixelPitch();
+	const int			cmpPixelPitch	= m_result.getPixelPitch();
+	const int			maskPixelPitch	= m_errorMask.getPixelPitch();
+	deUint32			maxDiff[4]		= { 0u, 0u, 0u, 0u };
+
+	for (int x = 0; x < m_width; x++)
+	{
+		bool isOk = true;
+
+		for (int c = 0; c < 4; c++)
+		{
+			const deUint32 diff = (deUint32)de::abs((int)refPtr[c] - (int)cmpPtr[c]);
+
+			maxDiff[c]	= de::max(maxDiff[c], diff);
+			isOk		= isOk && diff <= m_threshold[c];
+		}
+
+		maskPtr[0] = isOk ? 0x00 : 0xff;
+		maskPtr[1] = isOk ? 0xff : 0x00;
+		maskPtr[2] = 0x00;
+
+		refPtr	+= refPixelPitch;
+		cmpPtr	+= cmpPixelPitch;
+		maskPtr	+= maskPixelPitch;
+	}
+
+	m_rowMaxDiff[itemNdx] = UVec4(maxDiff[0], maxDiff[1], maxDiff[2], maxDiff[3]);
+}
+
+} // anonymous
+
 /*--------------------------------------------------------------------*//*!
  * \brief Per-pixel threshold-based comparison
  *
@@ -498,22 +822,12 @@ bool floatUlpThresholdCompare (TestLog& log, const char* imageSetName, const cha
 
 	TCU_CHECK(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
+	if (width > 0)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				const Vec4	refPix	= reference.getPixel(x, y, z);
-				const Vec4	cmpPix	= result.getPixel(x, y, z);
-				const UVec4	diff	= computeFlushRelaxedULPDiff(refPix, cmpPix);
-				const bool	isOk	= boolAll(lessThanEqual(diff, threshold));
+		ThresholdCompareWork<FloatUlpDiff> work (reference, result, errorMask, threshold);
 
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		executeParallel(work, work.getNumItems());
+		maxDiff = work.getMaxDiff();
 	}
 
 	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
@@ -584,23 +898,12 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 
 	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
+	if (width > 0)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				Vec4	refPix		= reference.getPixel(x, y, z);
-				Vec4	cmpPix		= result.getPixel(x, y, z);
-
-				Vec4	diff		= abs(refPix - cmpPix);
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
-
-				maxDiff = max(maxDiff, diff);
+		ThresholdCompareWork<FloatDiff> work (reference, result, errorMask, threshold);
 
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		executeParallel(work, work.getNumItems());
+		maxDiff = work.getMaxDiff();
 	}
 
 	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
@@ -670,21 +973,12 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
 
-	for (int z = 0; z < depth; z++)
+	if (width > 0)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				const Vec4	cmpPix		= result.getPixel(x, y, z);
-				const Vec4	diff		= abs(reference - cmpPix);
-				const bool	isOk		= boolAll(lessThanEqual(diff, threshold));
+		ThresholdCompareWork<FloatDiff> work (reference, result, errorMask, threshold);
 
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		executeParallel(work, work.getNumItems());
+		maxDiff = work.getMaxDiff();
 	}
 
 	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
@@ -753,22 +1047,23 @@ bool intThresholdCompare (TestLog& log, const char* imageSetName, const char* im
 
 	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
+	if (width > 0)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				IVec4	refPix		= reference.getPixelInt(x, y, z);
-				IVec4	cmpPix		= result.getPixelInt(x, y, z);
+		const TextureFormat rgba8Format (TextureFormat::RGBA, TextureFormat::UNORM_INT8);
 
-				UVec4	diff		= abs(refPix - cmpPix).cast<deUint32>();
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
+		if (reference.getFormat() == rgba8Format && result.getFormat() == rgba8Format)
+		{
+			RGBA8ThresholdCompareWork work (reference, result, errorMask, threshold);
 
-				maxDiff = max(maxDiff, diff);
+			executeParallel(work, work.getNumItems());
+			maxDiff = work.getMaxDiff();
+		}
+		else
+		{
+			ThresholdCompareWork<IntDiff> work (reference, result, errorMask, threshold);
 
-				errorMask.setPixel(isOk ? IVec4(0, 0xff, 0, 0xff) : IVec4(0xff, 0, 0, 0xff), x, y, z);
-			}
+			executeParallel(work, work.getNumItems());
+			maxDiff = work.getMaxDiff();
 		}
 	}
 
@@ -28,11 +28,13 @@
 #include "tcuTextureUtil.hpp"
 #include "tcuVectorUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuWorkerPool.hpp"
 #include "deMath.h"
 
 #include "rrRasterizer.hpp"
 
 #include <limits>
+#include <algorithm>
 
 namespace tcu
 {
@@ -202,6 +204,123 @@ tcu::IVec4 getTriangleAABB (const TriangleSceneSpec::SceneTriangle& triangle, co
 	return aabb;
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Get screen space bounds (minX, minY, maxX, maxY) of triangle
+ *
+ * Matches screen space positions used in calculateTriangleCoverage. If any
+ * position is not finite, bounds are infinite.
+ *//*--------------------------------------------------------------------*/
+tcu::Vec4 getTriangleScreenBounds (const TriangleSceneSpec::SceneTriangle& triangle, const tcu::IVec2& viewportSize)
+{
+	const float	infinity	= std::numeric_limits<float>::infinity();
+	tcu::Vec4	bounds;
+
+	for (int vtxNdx = 0; vtxNdx < 3; ++vtxNdx)
+	{
+		const tcu::Vec2 normalizedDeviceSpace	= tcu::Vec2(triangle.positions[vtxNdx].x() / triangle.positions[vtxNdx].w(), triangle.positions[vtxNdx].y() / triangle.positions[vtxNdx].w());
+		const tcu::Vec2 screenSpace				= (normalizedDeviceSpace + tcu::Vec2(1.0f, 1.0f)) * 0.5f * tcu::Vec2((float)viewportSize.x(), (float)viewportSize.y());
+
+		for (int compNdx = 0; compNdx < 2; ++compNdx)
+		{
+			const tcu::Float32 value (screenSpace[compNdx]);
+
+			// \note NaN would be dropped by min and max depending on vertex order
+			if (value.isInf() || value.isNaN())
+				return tcu::Vec4(-infinity, -infinity, infinity, infinity);
+		}
+
+		if (vtxNdx == 0)
+			bounds = tcu::Vec4(screenSpace.x(), screenSpace.y(), screenSpace.x(), screenSpace.y());
+		else
+			bounds = tcu::Vec4(de::min(bounds.x(), screenSpace.x()), de::min(bounds.y(), screenSpace.y()), de::max(bounds.z(), screenSpace.x()), de::max(bounds.w(), screenSpace.y()));
+	}
+
+	return bounds;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get pixels within distance of screen space bounds
+ *
+ * Returns inclusive pixel range (x0, y0, x1, y1) containing every pixel p
+ * for which bounds.min - margin <= p <= bounds.max + margin. Range is
+ * clamped to one pixel outside the viewport.
+ *//*--------------------------------------------------------------------*/
+tcu::IVec4 getPixelBounds (const tcu::Vec4& bounds, float margin, const tcu::IVec2& viewportSize)
+{
+	return tcu::IVec4((int)de::clamp(deFloatCeil (bounds.x() - margin), -1.0f, (float)viewportSize.x()),
+					  (int)de::clamp(deFloatCeil (bounds.y() - margin), -1.0f, (float)viewportSize.y()),
+					  (int)de::clamp(deFloatFloor(bounds.z() + margin), -1.0f, (float)viewportSize.x()),
+					  (int)de::clamp(deFloatFloor(bounds.w() + margin), -1.0f, (float)viewportSize.y()));
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Primitive lists of screen tiles
+ *
+ * Primitives are binned once to the tiles their pixel bounds overlap so
+ * that per-pixel verification only needs to consider primitives in the
+ * pixel's tile. Tile lists are in the order the primitives were added.
+ *//*--------------------------------------------------------------------*/
+class PrimitiveTileBins
+{
+public:
+	enum
+	{
+		TILE_SIZE = 16
+	};
+
+								PrimitiveTileBins	(const tcu::IVec2& viewportSize);
+
+	int							getNumTiles			(void) const				{ return m_numTiles.x() * m_numTiles.y();	}
+	tcu::IVec4					getTileRect			(int tileNdx) const;		//!< Inclusive pixel range of tile.
+	const std::vector<int>&		getPrimitives		(int tileNdx) const			{ return m_bins[tileNdx];					}
+
+	//! Add primitive to all tiles overlapping inclusive pixel range (x0, y0, x1, y1).
+	void						addPrimitive		(int primitiveNdx, const tcu::IVec4& pixelBounds);
+
+private:
+	const tcu::IVec2			m_viewportSize;
+	const tcu::IVec2			m_numTiles;
+	std::vector<std::vector<int> >	m_bins;
+};
+
+PrimitiveTileBins::PrimitiveTileBins (const tcu::IVec2& viewportSize)
+	: m_viewportSize	(viewportSize)
+	, m_numTiles		(deDivRoundUp32(viewportSize.x(), TILE_SIZE), deDivRoundUp32(viewportSize.y(), TILE_SIZE))
+	, m_bins			(m_numTiles.x() * m_numTiles.y())
+{
+}
+
+tcu::IVec4 PrimitiveTileBins::getTileRect (int tileNdx) const
+{
+	const int x0 = (tileNdx % m_numTiles.x()) * TILE_SIZE;
+	const int y0 = (tileNdx / m_numTiles.x()) * TILE_SIZE;
+
+	return tcu::IVec4(x0, y0, de::min(x0 + TILE_SIZE, m_viewportSize.x()) - 1, de::min(y0 + TILE_SIZE, m_viewportSize.y()) - 1);
+}
+
+void PrimitiveTileBins::addPrimitive (int primitiveNdx, const tcu::IVec4& pixelBounds)
+{
+	const int x0 = de::max(pixelBounds.x(), 0);
+	const int y0 = de::max(pixelBounds.y(), 0);
+	const int x1 = de::min(pixelBounds.z(), m_viewportSize.x() - 1);
+	const int y1 = de::min(pixelBounds.w(), m_viewportSize.y() - 1);
+
+	if (x0 > x1 || y0 > y1)
+		return;
+
+	for (int tileY = y0 / TILE_SIZE; tileY <= y1 / TILE_SIZE; ++tileY)
+	for (int tileX = x0 / TILE_SIZE; tileX <= x1 / TILE_SIZE; ++tileX)
+		m_bins[tileY * m_numTiles.x() + tileX].push_back(primitiveNdx);
+}
+
+//! Bin triangles by pixels for which calculateTriangleCoverage() may return other than COVERAGE_NONE.
+void binTrianglesByCoverage (PrimitiveTileBins& bins, const TriangleSceneSpec& scene, const tcu::IVec2& viewportSize)
+{
+	// calculateTriangleCoverage rejects pixels more than one pixel outside the screen space bounds
+	for (int triNdx = 0; triNdx < (int)scene.triangles.size(); ++triNdx)
+		bins.addPrimitive(triNdx, getPixelBounds(getTriangleScreenBounds(scene.triangles[triNdx], viewportSize), 1.0f, viewportSize));
+}
+
 float getExponentEpsilonFromULP (int valueExponent, deUint32 ulp)
 {
 	DE_ASSERT(ulp < (1u<<10));
@@ -650,12 +769,224 @@ struct MultisampleLineInterpolator
 	}
 };
 
+//! Invalid pixel found in triangle interpolation verification.
+struct InterpolationPixelError
+{
+	tcu::IVec2	pixel;
+	tcu::RGBA	color;
+	int			stackSize;			//!< Number of potentially contributing fragments. 0 if only background is allowed.
+	tcu::IVec3	pixelNativeColor;
+	tcu::IVec3	colorMin;
+	tcu::IVec3	colorMax;
+	tcu::Vec3	colorMinF;
+	tcu::Vec3	colorMaxF;
+	tcu::Vec3	valueRangeMin;
+	tcu::Vec3	valueRangeMax;
+};
+
+bool isErrorBeforeInRasterOrder (const InterpolationPixelError& a, const InterpolationPixelError& b)
+{
+	return (a.pixel.y() != b.pixel.y()) ? (a.pixel.y() < b.pixel.y()) : (a.pixel.x() < b.pixel.x());
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Tile-parallel triangle interpolation verification
+ *
+ * Each work item verifies one screen tile against the triangles binned to
+ * it and records invalid pixels. Errors are logged afterwards in raster
+ * order so that the log does not depend on execution order.
+ *//*--------------------------------------------------------------------*/
+template <typename Interpolator>
+class TriangleInterpolationWork : public tcu::ParallelWork
+{
+public:
+													TriangleInterpolationWork	(const tcu::Surface& surface, const TriangleSceneSpec& scene, const RasterizationArguments& args, int subPixelBits, const Interpolator& interpolator);
+
+	int												getNumItems					(void) const				{ return m_bins.getNumTiles();	}
+	const std::vector<InterpolationPixelError>&		getErrors					(int tileNdx) const			{ return m_errors[tileNdx];		}
+
+	void											execute						(int workerNdx, int tileNdx);
+
+private:
+	bool											verifyPixel					(const std::vector<int>& triangles, const tcu::IVec2& pixel, InterpolationPixelError& error) const;
+
+	const tcu::Surface&								m_surface;
+	const TriangleSceneSpec&						m_scene;
+	const RasterizationArguments&					m_args;
+	const Interpolator&								m_interpolator;
+	const bool										m_multisampled;
+	const int										m_subPixelBits;
+	const tcu::IVec2								m_viewportSize;
+	PrimitiveTileBins								m_bins;
+	std::vector<std::vector<InterpolationPixelError> >	m_errors;
+};
+
+template <typename Interpolator>
+TriangleInterpolationWork<Interpolator>::TriangleInterpolationWork (const tcu::Surface& surface, const TriangleSceneSpec& scene, const RasterizationArguments& args, int subPixelBits, const Interpolator& interpolator)
+	: m_surface			(surface)
+	, m_scene			(scene)
+	, m_args			(args)
+	, m_interpolator	(interpolator)
+	, m_multisampled	(args.numSamples != 0)
+	, m_subPixelBits	(subPixelBits)
+	, m_viewportSize	(surface.getWidth(), surface.getHeight())
+	, m_bins			(m_viewportSize)
+{
+	binTrianglesByCoverage(m_bins, scene, m_viewportSize);
+	m_errors.resize(m_bins.getNumTiles());
+}
+
+template <typename Interpolator>
+void TriangleInterpolationWork<Interpolator>::execute (int workerNdx, int tileNdx)
+{
+	const tcu::IVec4			rect		= m_bins.getTileRect(tileNdx);
+	const std::vector<int>&		triangles	= m_bins.getPrimitives(tileNdx);
+	InterpolationPixelError		error;
+
+	DE_UNREF(workerNdx);
+
+	for (int y = rect.y(); y <= rect.w(); ++y)
+	for (int x = rect.x(); x <= rect.z(); ++x)
+	{
+		if (!verifyPixel(triangles, tcu::IVec2(x, y), error))
+			m_errors[tileNdx].push_back(error);
+	}
+}
+
+template <typename Interpolator>
+bool TriangleInterpolationWork<Interpolator>::verifyPixel (const std::vector<int>& triangles, const tcu::IVec2& pixel, InterpolationPixelError& error) const
+{
+	const RasterizationArguments&	args				= m_args;
+	const tcu::RGBA					color				= m_surface.getPixel(pixel.x(), pixel.y());
+	bool							stackBottomFound	= false;
+	int								stackSize			= 0;
+	tcu::Vec4						colorStackMin;
+	tcu::Vec4						colorStackMax;
+
+	// Iterate triangle coverage front to back, find the stack of pontentially contributing fragments
+	for (int binNdx = (int)triangles.size() - 1; binNdx >= 0; --binNdx)
+	{
+		const int			triNdx		= triangles[binNdx];
+		const CoverageType	coverage	= calculateTriangleCoverage(m_scene.triangles[triNdx].positions[0],
+																	m_scene.triangles[triNdx].positions[1],
+																	m_scene.triangles[triNdx].positions[2],
+																	pixel,
+																	m_viewportSize,
+																	m_subPixelBits,
+																	m_multisampled);
+
+		if (coverage == COVERAGE_FULL || coverage == COVERAGE_PARTIAL)
+		{
+			// potentially contributes to the result fragment's value
+			const InterpolationRange weights = m_interpolator.interpolate(triNdx, pixel, m_viewportSize, m_multisampled, m_subPixelBits);
+
+			const tcu::Vec4 fragmentColorMax =	de::clamp(weights.max.x(), 0.0f, 1.0f) * m_scene.triangles[triNdx].colors[0] +
+												de::clamp(weights.max.y(), 0.0f, 1.0f) * m_scene.triangles[triNdx].colors[1] +
+												de::clamp(weights.max.z(), 0.0f, 1.0f) * m_scene.triangles[triNdx].colors[2];
+			const tcu::Vec4 fragmentColorMin =	de::clamp(weights.min.x(), 0.0f, 1.0f) * m_scene.triangles[triNdx].colors[0] +
+												de::clamp(weights.min.y(), 0.0f, 1.0f) * m_scene.triangles[triNdx].colors[1] +
+												de::clamp(weights.min.z(), 0.0f, 1.0f) * m_scene.triangles[triNdx].colors[2];
+
+			if (stackSize++ == 0)
+			{
+				// first triangle, set the values properly
+				colorStackMin = fragmentColorMin;
+				colorStackMax = fragmentColorMax;
+			}
+			else
+			{
+				// contributing triangle
+				colorStackMin = tcu::min(colorStackMin, fragmentColorMin);
+				colorStackMax = tcu::max(colorStackMax, fragmentColorMax);
+			}
+
+			if (coverage == COVERAGE_FULL)
+			{
+				// loop terminates, this is the bottommost fragment
+				stackBottomFound = true;
+				break;
+			}
+		}
+	}
+
+	// Partial coverage == background may be visible
+	if (stackSize != 0 && !stackBottomFound)
+	{
+		stackSize++;
+		colorStackMin = tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	error.pixel		= pixel;
+	error.color		= color;
+	error.stackSize	= stackSize;
+
+	// Is the result image color in the valid range.
+	if (stackSize == 0)
+	{
+		// No coverage, allow only background (black, value=0)
+		const tcu::IVec3	pixelNativeColor	= convertRGB8ToNativeFormat(color, args);
+		const int			threshold			= 1;
+
+		return pixelNativeColor.x() <= threshold &&
+			   pixelNativeColor.y() <= threshold &&
+			   pixelNativeColor.z() <= threshold;
+	}
+	else
+	{
+		DE_ASSERT(stackSize);
+
+		// Each additional step in the stack may cause conversion error of 1 bit due to undefined rounding direction
+		const int			thresholdRed	= stackSize - 1;
+		const int			thresholdGreen	= stackSize - 1;
+		const int			thresholdBlue	= stackSize - 1;
+
+		const tcu::Vec3		valueRangeMin	= tcu::Vec3(colorStackMin.xyz());
+		const tcu::Vec3		valueRangeMax	= tcu::Vec3(colorStackMax.xyz());
+
+		const tcu::IVec3	formatLimit		((1 << args.redBits) - 1, (1 << args.greenBits) - 1, (1 << args.blueBits) - 1);
+		const tcu::Vec3		colorMinF		(de::clamp(valueRangeMin.x() * (float)formatLimit.x(), 0.0f, (float)formatLimit.x()),
+											 de::clamp(valueRangeMin.y() * (float)formatLimit.y(), 0.0f, (float)formatLimit.y()),
+											 de::clamp(valueRangeMin.z() * (float)formatLimit.z(), 0.0f, (float)formatLimit.z()));
+		const tcu::Vec3		colorMaxF		(de::clamp(valueRangeMax.x() * (float)formatLimit.x(), 0.0f, (float)formatLimit.x()),
+											 de::clamp(valueRangeMax.y() * (float)formatLimit.y(), 0.0f, (float)formatLimit.y()),
+											 de::clamp(valueRangeMax.z() * (float)formatLimit.z(), 0.0f, (float)formatLimit.z()));
+		const tcu::IVec3	colorMin		((int)deFloatFloor(colorMinF.x()),
+											 (int)deFloatFloor(colorMinF.y()),
+											 (int)deFloatFloor(colorMinF.z()));
+		const tcu::IVec3	colorMax		((int)deFloatCeil (colorMaxF.x()),
+											 (int)deFloatCeil (colorMaxF.y()),
+											 (int)deFloatCeil (colorMaxF.z()));
+
+		// Convert pixel color from rgba8 to the real pixel format. Usually rgba8 or 565
+		const tcu::IVec3 pixelNativeColor = convertRGB8ToNativeFormat(color, args);
+
+		// Validity check
+		if (pixelNativeColor.x() < colorMin.x() - thresholdRed   ||
+			pixelNativeColor.y() < colorMin.y() - thresholdGreen ||
+			pixelNativeColor.z() < colorMin.z() - thresholdBlue  ||
+			pixelNativeColor.x() > colorMax.x() + thresholdRed   ||
+			pixelNativeColor.y() > colorMax.y() + thresholdGreen ||
+			pixelNativeColor.z() > colorMax.z() + thresholdBlue)
+		{
+			error.pixelNativeColor	= pixelNativeColor;
+			error.colorMin			= colorMin;
+			error.colorMax			= colorMax;
+			error.colorMinF			= colorMinF;
+			error.colorMaxF			= colorMaxF;
+			error.valueRangeMin		= valueRangeMin;
+			error.valueRangeMax		= valueRangeMax;
+
+			return false;
+		}
+
+		return true;
+	}
+}
+
 template <typename Interpolator>
 bool verifyTriangleGroupInterpolationWithInterpolator (const tcu::Surface& surface, const TriangleSceneSpec& scene, const RasterizationArguments& args, tcu::TestLog& log, const Interpolator& interpolator)
 {
 	const tcu::RGBA		invalidPixelColor	= tcu::RGBA(255, 0, 0, 255);
-	const bool			multisampled		= (args.numSamples != 0);
-	const tcu::IVec2	viewportSize		= tcu::IVec2(surface.getWidth(), surface.getHeight());
 	const int			errorFloodThreshold	= 4;
 	int					errorCount			= 0;
 	int					invalidPixels		= 0;
@@ -686,80 +1017,28 @@ bool verifyTriangleGroupInterpolationWithInterpolator (const tcu::Surface& surfa
 
 	// check pixels
 
-	for (int y = 0; y < surface.getHeight(); ++y)
-	for (int x = 0; x < surface.getWidth();  ++x)
 	{
-		const tcu::RGBA		color				= surface.getPixel(x, y);
-		bool				stackBottomFound	= false;
-		int					stackSize			= 0;
-		tcu::Vec4			colorStackMin;
-		tcu::Vec4			colorStackMax;
+		TriangleInterpolationWork<Interpolator>	work		(surface, scene, args, subPixelBits, interpolator);
+		std::vector<InterpolationPixelError>	errors;
 
-		// Iterate triangle coverage front to back, find the stack of pontentially contributing fragments
-		for (int triNdx = (int)scene.triangles.size() - 1; triNdx >= 0; --triNdx)
-		{
-			const CoverageType coverage = calculateTriangleCoverage(scene.triangles[triNdx].positions[0],
-																	scene.triangles[triNdx].positions[1],
-																	scene.triangles[triNdx].positions[2],
-																	tcu::IVec2(x, y),
-																	viewportSize,
-																	subPixelBits,
-																	multisampled);
+		tcu::executeParallel(work, work.getNumItems());
 
-			if (coverage == COVERAGE_FULL || coverage == COVERAGE_PARTIAL)
-			{
-				// potentially contributes to the result fragment's value
-				const InterpolationRange weights = interpolator.interpolate(triNdx, tcu::IVec2(x, y), viewportSize, multisampled, subPixelBits);
+		for (int tileNdx = 0; tileNdx < work.getNumItems(); ++tileNdx)
+			errors.insert(errors.end(), work.getErrors(tileNdx).begin(), work.getErrors(tileNdx).end());
 
-				const tcu::Vec4 fragmentColorMax =	de::clamp(weights.max.x(), 0.0f, 1.0f) * scene.triangles[triNdx].colors[0] +
-													de::clamp(weights.max.y(), 0.0f, 1.0f) * scene.triangles[triNdx].colors[1] +
-													de::clamp(weights.max.z(), 0.0f, 1.0f) * scene.triangles[triNdx].colors[2];
-				const tcu::Vec4 fragmentColorMin =	de::clamp(weights.min.x(), 0.0f, 1.0f) * scene.triangles[triNdx].colors[0] +
-													de::clamp(weights.min.y(), 0.0f, 1.0f) * scene.triangles[triNdx].colors[1] +
-													de::clamp(weights.min.z(), 0.0f, 1.0f) * scene.triangles[triNdx].colors[2];
+		std::sort(errors.begin(), errors.end(), isErrorBeforeInRasterOrder);
 
-				if (stackSize++ == 0)
-				{
-					// first triangle, set the values properly
-					colorStackMin = fragmentColorMin;
-					colorStackMax = fragmentColorMax;
-				}
-				else
-				{
-					// contributing triangle
-					colorStackMin = tcu::min(colorStackMin, fragmentColorMin);
-					colorStackMax = tcu::max(colorStackMax, fragmentColorMax);
-				}
-
-				if (coverage == COVERAGE_FULL)
-				{
-					// loop terminates, this is the bottommost fragment
-					stackBottomFound = true;
-					break;
-				}
-			}
-		}
-
-		// Partial coverage == background may be visible
-		if (stackSize != 0 && !stackBottomFound)
+		for (int errorNdx = 0; errorNdx < (int)errors.size(); ++errorNdx)
 		{
-			stackSize++;
-			colorStackMin = tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f);
-		}
+			const InterpolationPixelError&	error	= errors[errorNdx];
+			const int						x		= error.pixel.x();
+			const int						y		= error.pixel.y();
+			const tcu::RGBA					color	= error.color;
 
-		// Is the result image color in the valid range.
-		if (stackSize == 0)
-		{
-			// No coverage, allow only background (black, value=0)
-			const tcu::IVec3	pixelNativeColor	= convertRGB8ToNativeFormat(color, args);
-			const int			threshold			= 1;
+			++errorCount;
 
-			if (pixelNativeColor.x() > threshold ||
-				pixelNativeColor.y() > threshold ||
-				pixelNativeColor.z() > threshold)
+			if (error.stackSize == 0)
 			{
-				++errorCount;
-
 				// don't fill the logs with too much data
 				if (errorCount < errorFloodThreshold)
 				{
@@ -769,49 +1048,13 @@ bool verifyTriangleGroupInterpolationWithInterpolator (const tcu::Surface& surfa
 						<< "\tExpected background color.\n"
 						<< tcu::TestLog::EndMessage;
 				}
-
-				++invalidPixels;
-				errorMask.setPixel(x, y, invalidPixelColor);
 			}
-		}
-		else
-		{
-			DE_ASSERT(stackSize);
-
-			// Each additional step in the stack may cause conversion error of 1 bit due to undefined rounding direction
-			const int			thresholdRed	= stackSize - 1;
-			const int			thresholdGreen	= stackSize - 1;
-			const int			thresholdBlue	= stackSize - 1;
-
-			const tcu::Vec3		valueRangeMin	= tcu::Vec3(colorStackMin.xyz());
-			const tcu::Vec3		valueRangeMax	= tcu::Vec3(colorStackMax.xyz());
-
-			const tcu::IVec3	formatLimit		((1 << args.redBits) - 1, (1 << args.greenBits) - 1, (1 << args.blueBits) - 1);
-			const tcu::Vec3		colorMinF		(de::clamp(valueRangeMin.x() * (float)formatLimit.x(), 0.0f, (float)formatLimit.x()),
-												 de::clamp(valueRangeMin.y() * (float)formatLimit.y(), 0.0f, (float)formatLimit.y()),
-												 de::clamp(valueRangeMin.z() * (float)formatLimit.z(), 0.0f, (float)formatLimit.z()));
-			const tcu::Vec3		colorMaxF		(de::clamp(valueRangeMax.x() * (float)formatLimit.x(), 0.0f, (float)formatLimit.x()),
-												 de::clamp(valueRangeMax.y() * (float)formatLimit.y(), 0.0f, (float)formatLimit.y()),
-												 de::clamp(valueRangeMax.z() * (float)formatLimit.z(), 0.0f, (float)formatLimit.z()));
-			const tcu::IVec3	colorMin		((int)deFloatFloor(colorMinF.x()),
-												 (int)deFloatFloor(colorMinF.y()),
-												 (int)deFloatFloor(colorMinF.z()));
-			const tcu::IVec3	colorMax		((int)deFloatCeil (colorMaxF.x()),
-												 (int)deFloatCeil (colorMaxF.y()),
-												 (int)deFloatCeil (colorMaxF.z()));
-
-			// Convert pixel color from rgba8 to the real pixel format. Usually rgba8 or 565
-			const tcu::IVec3 pixelNativeColor = convertRGB8ToNativeFormat(color, args);
-
-			// Validity check
-			if (pixelNativeColor.x() < colorMin.x() - thresholdRed   ||
-				pixelNativeColor.y() < colorMin.y() - thresholdGreen ||
-				pixelNativeColor.z() < colorMin.z() - thresholdBlue  ||
-				pixelNativeColor.x() > colorMax.x() + thresholdRed   ||
-				pixelNativeColor.y() > colorMax.y() + thresholdGreen ||
-				pixelNativeColor.z() > colorMax.z() + thresholdBlue)
+			else
 			{
-				++errorCount;
+				const int			thresholdRed	= error.stackSize - 1;
+				const int			thresholdGreen	= error.stackSize - 1;
+				const int			thresholdBlue	= error.stackSize - 1;
+				const tcu::IVec3	formatLimit		((1 << args.redBits) - 1, (1 << args.greenBits) - 1, (1 << args.blueBits) - 1);
 
 				// don't fill the logs with too much data
 				if (errorCount <= errorFloodThreshold)
@@ -819,20 +1062,20 @@ bool verifyTriangleGroupInterpolationWithInterpolator (const tcu::Surface& surfa
 					log << tcu::TestLog::Message
 						<< "Found an invalid pixel at (" << x << "," << y << ")\n"
 						<< "\tPixel color:\t\t" << color << "\n"
-						<< "\tNative color:\t\t" << pixelNativeColor << "\n"
+						<< "\tNative color:\t\t" << error.pixelNativeColor << "\n"
 						<< "\tAllowed error:\t\t" << tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue) << "\n"
-						<< "\tReference native color min: " << tcu::clamp(colorMin - tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue), tcu::IVec3(0,0,0), formatLimit) << "\n"
-						<< "\tReference native color max: " << tcu::clamp(colorMax + tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue), tcu::IVec3(0,0,0), formatLimit) << "\n"
-						<< "\tReference native float min: " << tcu::clamp(colorMinF - tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue).cast<float>(), tcu::Vec3(0.0f, 0.0f, 0.0f), formatLimit.cast<float>()) << "\n"
-						<< "\tReference native float max: " << tcu::clamp(colorMaxF + tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue).cast<float>(), tcu::Vec3(0.0f, 0.0f, 0.0f), formatLimit.cast<float>()) << "\n"
-						<< "\tFmin:\t" << tcu::clamp(valueRangeMin, tcu::Vec3(0.0f, 0.0f, 0.0f), tcu::Vec3(1.0f, 1.0f, 1.0f)) << "\n"
-						<< "\tFmax:\t" << tcu::clamp(valueRangeMax, tcu::Vec3(0.0f, 0.0f, 0.0f), tcu::Vec3(1.0f, 1.0f, 1.0f)) << "\n"
+						<< "\tReference native color min: " << tcu::clamp(error.colorMin - tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue), tcu::IVec3(0,0,0), formatLimit) << "\n"
+						<< "\tReference native color max: " << tcu::clamp(error.colorMax + tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue), tcu::IVec3(0,0,0), formatLimit) << "\n"
+						<< "\tReference native float min: " << tcu::clamp(error.colorMinF - tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue).cast<float>(), tcu::Vec3(0.0f, 0.0f, 0.0f), formatLimit.cast<float>()) << "\n"
+						<< "\tReference native float max: " << tcu::clamp(error.colorMaxF + tcu::IVec3(thresholdRed, thresholdGreen, thresholdBlue).cast<float>(), tcu::Vec3(0.0f, 0.0f, 0.0f), formatLimit.cast<float>()) << "\n"
+						<< "\tFmin:\t" << tcu::clamp(error.valueRangeMin, tcu::Vec3(0.0f, 0.0f, 0.0f), tcu::Vec3(1.0f, 1.0f, 1.0f)) << "\n"
+						<< "\tFmax:\t" << tcu::clamp(error.valueRangeMax, tcu::Vec3(0.0f, 0.0f, 0.0f), tcu::Vec3(1.0f, 1.0f, 1.0f)) << "\n"
 						<< tcu::TestLog::EndMessage;
 				}
-
-				++invalidPixels;
-				errorMask.setPixel(x, y, invalidPixelColor);
 			}
+
+			++invalidPixels;
+			errorMask.setPixel(x, y, invalidPixelColor);
 		}
 	}
 
@@ -2096,6 +2339,201 @@ bool verifySinglesampleWideLineGroupInterpolation (const tcu::Surface& surface,
 	}
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Tile-parallel triangle rasterization verification
+ *
+ * Each work item generates the reference coverage of one screen tile from
+ * the triangles binned to it and compares the result image against it.
+ * Shared edge lookups only consider triangles with shared edges near the
+ * tile.
+ *//*--------------------------------------------------------------------*/
+class TriangleRasterizationWork : public tcu::ParallelWork
+{
+public:
+								TriangleRasterizationWork	(const tcu::Surface& surface, const TriangleSceneSpec& scene, const RasterizationArguments& args, int subPixelBits, tcu::Surface& errorMask);
+
+	int							getNumItems					(void) const	{ return m_bins.getNumTiles();	}
+	int							getMissingPixels			(void) const;
+	int							getUnexpectedPixels			(void) const;
+
+	void						execute						(int workerNdx, int tileNdx);
+
+private:
+	CoverageType				getPartialCoverage			(int triNdx, const std::vector<int>& sharedEdgeTriangles, const tcu::IVec2& pixel) const;
+
+	const tcu::Surface&			m_surface;
+	const TriangleSceneSpec&	m_scene;
+	const RasterizationArguments&	m_args;
+	const bool					m_multisampled;
+	const int					m_subPixelBits;
+	const tcu::IVec2			m_viewportSize;
+	tcu::Surface&				m_errorMask;
+	tcu::TextureLevel			m_coverageMap;
+	std::vector<tcu::IVec4>		m_aabbs;
+	PrimitiveTileBins			m_bins;
+	PrimitiveTileBins			m_sharedEdgeBins;
+	std::vector<int>			m_missingPixels;
+	std::vector<int>			m_unexpectedPixels;
+};
+
+TriangleRasterizationWork::TriangleRasterizationWork (const tcu::Surface& surface, const TriangleSceneSpec& scene, const RasterizationArguments& args, int subPixelBits, tcu::Surface& errorMask)
+	: m_surface				(surface)
+	, m_scene				(scene)
+	, m_args				(args)
+	, m_multisampled		(args.numSamples != 0)
+	, m_subPixelBits		(subPixelBits)
+	, m_viewportSize		(surface.getWidth(), surface.getHeight())
+	, m_errorMask			(errorMask)
+	, m_coverageMap			(tcu::TextureFormat(tcu::TextureFormat::R, tcu::TextureFormat::UNSIGNED_INT8), surface.getWidth(), surface.getHeight())
+	, m_aabbs				(scene.triangles.size())
+	, m_bins				(m_viewportSize)
+	, m_sharedEdgeBins		(m_viewportSize)
+	, m_missingPixels		(m_bins.getNumTiles(), 0)
+	, m_unexpectedPixels	(m_bins.getNumTiles(), 0)
+{
+	tcu::clear(m_coverageMap.getAccess(), tcu::IVec4(COVERAGE_NONE, 0, 0, 0));
+
+	for (int triNdx = 0; triNdx < (int)scene.triangles.size(); ++triNdx)
+	{
+		const TriangleSceneSpec::SceneTriangle& triangle = scene.triangles[triNdx];
+
+		m_aabbs[triNdx] = getTriangleAABB(triangle, m_viewportSize);
+		m_bins.addPrimitive(triNdx, m_aabbs[triNdx]);
+
+		// Pixels near an edge are within 2 pixels of the edge end points, see pixelNearLineSegment. Extra pixel is left for rounding.
+		if (triangle.sharedEdge[0] || triangle.sharedEdge[1] || triangle.sharedEdge[2])
+			m_sharedEdgeBins.addPrimitive(triNdx, getPixelBounds(getTriangleScreenBounds(triangle, m_viewportSize), 4.0f, m_viewportSize));
+	}
+}
+
+int TriangleRasterizationWork::getMissingPixels (void) const
+{
+	int numPixels = 0;
+
+	for (int tileNdx = 0; tileNdx < (int)m_missingPixels.size(); ++tileNdx)
+		numPixels += m_missingPixels[tileNdx];
+
+	return numPixels;
+}
+
+int TriangleRasterizationWork::getUnexpectedPixels (void) const
+{
+	int numPixels = 0;
+
+	for (int tileNdx = 0; tileNdx < (int)m_unexpectedPixels.size(); ++tileNdx)
+		numPixels += m_unexpectedPixels[tileNdx];
+
+	return numPixels;
+}
+
+CoverageType TriangleRasterizationWork::getPartialCoverage (int triNdx, const std::vector<int>& sharedEdgeTriangles, const tcu::IVec2& pixel) const
+{
+	// Sharing an edge with another triangle?
+	// There should always be such a triangle, but the pixel in the other triangle might be
+	// on multiple edges, some of which are not shared. In these cases the coverage cannot be determined.
+	// Assume full coverage if the pixel is only on a shared edge in shared triangle too.
+	if (pixelOnlyOnASharedEdge(pixel, m_scene.triangles[triNdx], m_viewportSize))
+	{
+		for (int binNdx = 0; binNdx < (int)sharedEdgeTriangles.size(); ++binNdx)
+		{
+			const int friendTriNdx = sharedEdgeTriangles[binNdx];
+
+			if (friendTriNdx != triNdx && pixelOnlyOnASharedEdge(pixel, m_scene.triangles[friendTriNdx], m_viewportSize))
+				return COVERAGE_FULL;
+		}
+	}
+
+	return COVERAGE_PARTIAL;
+}
+
+void TriangleRasterizationWork::execute (int workerNdx, int tileNdx)
+{
+	const tcu::RGBA				backGroundColor			= tcu::RGBA(0, 0, 0, 255);
+	const tcu::RGBA				triangleColor			= tcu::RGBA(255, 255, 255, 255);
+	const tcu::RGBA				missingPixelColor		= tcu::RGBA(255, 0, 255, 255);
+	const tcu::RGBA				unexpectedPixelColor	= tcu::RGBA(255, 0, 0, 255);
+	const tcu::RGBA				partialPixelColor		= tcu::RGBA(255, 255, 0, 255);
+	const tcu::RGBA				primitivePixelColor		= tcu::RGBA(30, 30, 30, 255);
+	const tcu::IVec4			rect					= m_bins.getTileRect(tileNdx);
+	const std::vector<int>&		triangles				= m_bins.getPrimitives(tileNdx);
+	const std::vector<int>&		sharedEdgeTriangles		= m_sharedEdgeBins.getPrimitives(tileNdx);
+	const tcu::PixelBufferAccess	coverageMap			= m_coverageMap.getAccess();
+
+	DE_UNREF(workerNdx);
+
+	// generate coverage map
+
+	for (int binNdx = 0; binNdx < (int)triangles.size(); ++binNdx)
+	{
+		const int			triNdx	= triangles[binNdx];
+		const tcu::IVec4&	aabb	= m_aabbs[triNdx];
+
+		for (int y = de::max(rect.y(), aabb.y()); y <= de::min(rect.w(), aabb.w()); ++y)
+		for (int x = de::max(rect.x(), aabb.x()); x <= de::min(rect.z(), aabb.z()); ++x)
+		{
+			if (coverageMap.getPixelUint(x, y).x() == COVERAGE_FULL)
+				continue;
+
+			const CoverageType coverage = calculateTriangleCoverage(m_scene.triangles[triNdx].positions[0],
+																	m_scene.triangles[triNdx].positions[1],
+																	m_scene.triangles[triNdx].positions[2],
+																	tcu::IVec2(x, y),
+																	m_viewportSize,
+																	m_subPixelBits,
+																	m_multisampled);
+
+			if (coverage == COVERAGE_FULL)
+				coverageMap.setPixel(tcu::IVec4(COVERAGE_FULL, 0, 0, 0), x, y);
+			else if (coverage == COVERAGE_PARTIAL)
+				coverageMap.setPixel(tcu::IVec4(getPartialCoverage(triNdx, sharedEdgeTriangles, tcu::IVec2(x, y)), 0, 0, 0), x, y);
+		}
+	}
+
+	// check pixels
+
+	for (int y = rect.y(); y <= rect.w(); ++y)
+	for (int x = rect.x(); x <= rect.z(); ++x)
+	{
+		const tcu::RGBA		color				= m_surface.getPixel(x, y);
+		const bool			imageNoCoverage		= compareColors(color, backGroundColor, m_args.redBits, m_args.greenBits, m_args.blueBits);
+		const bool			imageFullCoverage	= compareColors(color, triangleColor, m_args.redBits, m_args.greenBits, m_args.blueBits);
+		CoverageType		referenceCoverage	= (CoverageType)coverageMap.getPixelUint(x, y).x();
+
+		switch (referenceCoverage)
+		{
+			case COVERAGE_NONE:
+				if (!imageNoCoverage)
+				{
+					// coverage where there should not be
+					++m_unexpectedPixels[tileNdx];
+					m_errorMask.setPixel(x, y, unexpectedPixelColor);
+				}
+				break;
+
+			case COVERAGE_PARTIAL:
+				// anything goes
+				m_errorMask.setPixel(x, y, partialPixelColor);
+				break;
+
+			case COVERAGE_FULL:
+				if (!imageFullCoverage)
+				{
+					// no coverage where there should be
+					++m_missingPixels[tileNdx];
+					m_errorMask.setPixel(x, y, missingPixelColor);
+				}
+				else
+				{
+					m_errorMask.setPixel(x, y, primitivePixelColor);
+				}
+				break;
+
+			default:
+				DE_ASSERT(false);
+		};
+	}
+}
+
 } // anonymous
 
 CoverageType calculateTriangleCoverage (const tcu::Vec4& p0, const tcu::Vec4& p1, const tcu::Vec4& p2, const tcu::IVec2& pixel, const tcu::IVec2& viewportSize, int subpixelBits, bool multisample)
@@ -2272,19 +2710,10 @@ bool verifyTriangleGroupRasterization (const tcu::Surface& surface, const Triang
 {
 	DE_ASSERT(mode < VERIFICATIONMODE_LAST);
 
-	const tcu::RGBA		backGroundColor				= tcu::RGBA(0, 0, 0, 255);
-	const tcu::RGBA		triangleColor				= tcu::RGBA(255, 255, 255, 255);
-	const tcu::RGBA		missingPixelColor			= tcu::RGBA(255, 0, 255, 255);
-	const tcu::RGBA		unexpectedPixelColor		= tcu::RGBA(255, 0, 0, 255);
-	const tcu::RGBA		partialPixelColor			= tcu::RGBA(255, 255, 0, 255);
-	const tcu::RGBA		primitivePixelColor			= tcu::RGBA(30, 30, 30, 255);
 	const int			weakVerificationThreshold	= 10;
-	const bool			multisampled				= (args.numSamples != 0);
-	const tcu::IVec2	viewportSize				= tcu::IVec2(surface.getWidth(), surface.getHeight());
 	int					missingPixels				= 0;
 	int					unexpectedPixels			= 0;
 	int					subPixelBits				= args.subpixelBits;
-	tcu::TextureLevel	coverageMap					(tcu::TextureFormat(tcu::TextureFormat::R, tcu::TextureFormat::UNSIGNED_INT8), surface.getWidth(), surface.getHeight());
 	tcu::Surface		errorMask					(surface.getWidth(), surface.getHeight());
 	bool				result						= false;
 
@@ -2302,105 +2731,17 @@ bool verifyTriangleGroupRasterization (const tcu::Surface& surface, const Triang
 		subPixelBits = 16;
 	}
 
-	// generate coverage map
-
-	tcu::clear(coverageMap.getAccess(), tcu::IVec4(COVERAGE_NONE, 0, 0, 0));
-
-	for (int triNdx = 0; triNdx < (int)scene.triangles.size(); ++triNdx)
-	{
-		const tcu::IVec4 aabb = getTriangleAABB(scene.triangles[triNdx], viewportSize);
-
-		for (int y = de::max(0, aabb.y()); y <= de::min(aabb.w(), coverageMap.getHeight() - 1); ++y)
-		for (int x = de::max(0, aabb.x()); x <= de::min(aabb.z(), coverageMap.getWidth() - 1); ++x)
-		{
-			if (coverageMap.getAccess().getPixelUint(x, y).x() == COVERAGE_FULL)
-				continue;
-
-			const CoverageType coverage = calculateTriangleCoverage(scene.triangles[triNdx].positions[0],
-																	scene.triangles[triNdx].positions[1],
-																	scene.triangles[triNdx].positions[2],
-																	tcu::IVec2(x, y),
-																	viewportSize,
-																	subPixelBits,
-																	multisampled);
-
-			if (coverage == COVERAGE_FULL)
-			{
-				coverageMap.getAccess().setPixel(tcu::IVec4(COVERAGE_FULL, 0, 0, 0), x, y);
-			}
-			else if (coverage == COVERAGE_PARTIAL)
-			{
-				CoverageType resultCoverage = COVERAGE_PARTIAL;
-
-				// Sharing an edge with another triangle?
-				// There should always be such a triangle, but the pixel in the other triangle might be
-				// on multiple edges, some of which are not shared. In these cases the coverage cannot be determined.
-				// Assume full coverage if the pixel is only on a shared edge in shared triangle too.
-				if (pixelOnlyOnASharedEdge(tcu::IVec2(x, y), scene.triangles[triNdx], viewportSize))
-				{
-					bool friendFound = false;
-					for (int friendTriNdx = 0; friendTriNdx < (int)scene.triangles.size(); ++friendTriNdx)
-					{
-						if (friendTriNdx != triNdx && pixelOnlyOnASharedEdge(tcu::IVec2(x, y), scene.triangles[friendTriNdx], viewportSize))
-						{
-							friendFound = true;
-							break;
-						}
-					}
-
-					if (friendFound)
-						resultCoverage = COVERAGE_FULL;
-				}
-
-				coverageMap.getAccess().setPixel(tcu::IVec4(resultCoverage, 0, 0, 0), x, y);
-			}
-		}
-	}
-
-	// check pixels
+	// generate coverage map and check pixels
 
 	tcu::clear(errorMask.getAccess(), tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
 
-	for (int y = 0; y < surface.getHeight(); ++y)
-	for (int x = 0; x < surface.getWidth(); ++x)
 	{
-		const tcu::RGBA		color				= surface.getPixel(x, y);
-		const bool			imageNoCoverage		= compareColors(color, backGroundColor, args.redBits, args.greenBits, args.blueBits);
-		const bool			imageFullCoverage	= compareColors(color, triangleColor, args.redBits, args.greenBits, args.blueBits);
-		CoverageType		referenceCoverage	= (CoverageType)coverageMap.getAccess().getPixelUint(x, y).x();
+		TriangleRasterizationWork work (surface, scene, args, subPixelBits, errorMask);
 
-		switch (referenceCoverage)
-		{
-			case COVERAGE_NONE:
-				if (!imageNoCoverage)
-				{
-					// coverage where there should not be
-					++unexpectedPixels;
-					errorMask.setPixel(x, y, unexpectedPixelColor);
-				}
-				break;
+		tcu::executeParallel(work, work.getNumItems());
 
-			case COVERAGE_PARTIAL:
-				// anything goes
-				errorMask.setPixel(x, y, partialPixelColor);
-				break;
-
-			case COVERAGE_FULL:
-				if (!imageFullCoverage)
-				{
-					// no coverage where there should be
-					++missingPixels;
-					errorMask.setPixel(x, y, missingPixelColor);
-				}
-				else
-				{
-					errorMask.setPixel(x, y, primitivePixelColor);
-				}
-				break;
-
-			default:
-				DE_ASSERT(false);
-		};
+		missingPixels		= work.getMissingPixels();
+		unexpectedPixels	= work.getUnexpectedPixels();
 	}
 
 	if (((mode == VERIFICATIONMODE_STRICT) && (missingPixels + unexpectedPixels > 0)) ||
@@ -101,6 +101,12 @@ void TestNode::init (void)
 {
 }
 
+void TestNode::releaseChildren (vector<TestNode*>& res)
+{
+	res.clear();
+	res.swap(m_children);
+}
+
 void TestNode::deinit (void)
 {
 	for (int i = 0; i < (int)m_children.size(); i++)
@@ -1568,6 +1568,239 @@ void PixelBufferAccess::setPixStencil (int stencil, int x, int y, int z) const
 	}
 }
 
+namespace
+{
+
+// Row access routines. Specialized formats provide static read/write functions for
+// a single pixel; missing ones are substituted with generic per-pixel access.
+
+struct RGBA8RowFormat
+{
+	static Vec4		read		(const deUint8* ptr)					{ return readRGBA8888Float(ptr);	}
+	static IVec4	readInt		(const deUint8* ptr)					{ return readRGBA8888Int(ptr);		}
+	static void		write		(deUint8* ptr, const Vec4& value)		{ writeRGBA8888Float(ptr, value);	}
+	static void		writeInt	(deUint8* ptr, const IVec4& value)		{ writeRGBA8888Int(ptr, value);		}
+};
+
+struct RGB8RowFormat
+{
+	static Vec4		read		(const deUint8* ptr)					{ return readRGB888Float(ptr);		}
+	static IVec4	readInt		(const deUint8* ptr)					{ return readRGB888Int(ptr);		}
+	static void		write		(deUint8* ptr, const Vec4& value)		{ writeRGB888Float(ptr, value);		}
+	static void		writeInt	(deUint8* ptr, const IVec4& value)		{ writeRGB888Int(ptr, value);		}
+};
+
+//! R32F and D32F
+struct R32FRowFormat
+{
+	static Vec4		read		(const deUint8* ptr)					{ return Vec4(*(const float*)ptr, 0.0f, 0.0f, 1.0f);	}
+	static void		write		(deUint8* ptr, const Vec4& value)		{ *(float*)ptr = value.x();								}
+};
+
+struct RGBA32FRowFormat
+{
+	static Vec4		read		(const deUint8* ptr)					{ const float* v = (const float*)ptr; return Vec4(v[0], v[1], v[2], v[3]);	}
+	static void		write		(deUint8* ptr, const Vec4& value)		{ float* v = (float*)ptr; v[0] = value[0]; v[1] = value[1]; v[2] = value[2]; v[3] = value[3]; }
+};
+
+struct RGBA16FRowFormat
+{
+	static Vec4 read (const deUint8* ptr)
+	{
+		const deFloat16* v = (const deFloat16*)ptr;
+		return Vec4(deFloat16To32(v[0]), deFloat16To32(v[1]), deFloat16To32(v[2]), deFloat16To32(v[3]));
+	}
+
+	static void write (deUint8* ptr, const Vec4& value)
+	{
+		deFloat16* v = (deFloat16*)ptr;
+		v[0] = deFloat32To16(value[0]);
+		v[1] = deFloat32To16(value[1]);
+		v[2] = deFloat32To16(value[2]);
+		v[3] = deFloat32To16(value[3]);
+	}
+};
+
+//! 24-bit unorm depth, as returned by getEffectiveDepthStencilAccess() for D24S8
+struct D24RowFormat
+{
+	static Vec4		read		(const deUint8* ptr)					{ return Vec4((float)readUint24(ptr) / 16777215.0f, 0.0f, 0.0f, 1.0f);	}
+	static void		write		(deUint8* ptr, const Vec4& value)		{ writeUint24(ptr, convertSatRteUint24(value.x() * 16777215.0f));		}
+};
+
+template <typename Format>
+void readRowFloat (const ConstPixelBufferAccess& access, int x, int y, int z, int numPixels, Vec4* dst)
+{
+	DE_ASSERT(de::inBounds(x, 0, access.getWidth()) && x + numPixels <= access.getWidth());
+	DE_ASSERT(de::inBounds(y, 0, access.getHeight()));
+	DE_ASSERT(de::inBounds(z, 0, access.getDepth()));
+
+	const deUint8*	srcPtr		= (const deUint8*)access.getPixelPtr(x, y, z);
+	const int		pixelPitch	= access.getPixelPitch();
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dst[ndx] = Format::read(srcPtr + ndx*pixelPitch);
+}
+
+template <typename Format>
+void readRowInt (const ConstPixelBufferAccess& access, int x, int y, int z, int numPixels, IVec4* dst)
+{
+	DE_ASSERT(de::inBounds(x, 0, access.getWidth()) && x + numPixels <= access.getWidth());
+	DE_ASSERT(de::inBounds(y, 0, access.getHeight()));
+	DE_ASSERT(de::inBounds(z, 0, access.getDepth()));
+
+	const deUint8*	srcPtr		= (const deUint8*)access.getPixelPtr(x, y, z);
+	const int		pixelPitch	= access.getPixelPitch();
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dst[ndx] = Format::readInt(srcPtr + ndx*pixelPitch);
+}
+
+template <typename Format>
+void writeRowFloat (const PixelBufferAccess& access, int x, int y, int z, int numPixels, const Vec4* src)
+{
+	DE_ASSERT(de::inBounds(x, 0, access.getWidth()) && x + numPixels <= access.getWidth());
+	DE_ASSERT(de::inBounds(y, 0, access.getHeight()));
+	DE_ASSERT(de::inBounds(z, 0, access.getDepth()));
+
+	deUint8*		dstPtr		= (deUint8*)access.getPixelPtr(x, y, z);
+	const int		pixelPitch	= access.getPixelPitch();
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		Format::write(dstPtr + ndx*pixelPitch, src[ndx]);
+}
+
+template <typename Format>
+void writeRowInt (const PixelBufferAccess& access, int x, int y, int z, int numPixels, const IVec4* src)
+{
+	DE_ASSERT(de::inBounds(x, 0, access.getWidth()) && x + numPixels <= access.getWidth());
+	DE_ASSERT(de::inBounds(y, 0, access.getHeight()));
+	DE_ASSERT(de::inBounds(z, 0, access.getDepth()));
+
+	deUint8*		dstPtr		= (deUint8*)access.getPixelPtr(x, y, z);
+	const int		pixelPitch	= access.getPixelPitch();
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		Format::writeInt(dstPtr + ndx*pixelPitch, src[ndx]);
+}
+
+void readRowGeneric (const ConstPixelBufferAccess& access, int x, int y, int z, int numPixels, Vec4* dst)
+{
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dst[ndx] = access.getPixel(x + ndx, y, z);
+}
+
+void readRowIntGeneric (const ConstPixelBufferAccess& access, int x, int y, int z, int numPixels, IVec4* dst)
+{
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dst[ndx] = access.getPixelInt(x + ndx, y, z);
+}
+
+void writeRowGeneric (const PixelBufferAccess& access, int x, int y, int z, int numPixels, const Vec4* src)
+{
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		access.setPixel(src[ndx], x + ndx, y, z);
+}
+
+void writeRowIntGeneric (const PixelBufferAccess& access, int x, int y, int z, int numPixels, const IVec4* src)
+{
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		access.setPixel(src[ndx], x + ndx, y, z);
+}
+
+enum RowFormat
+{
+	ROWFORMAT_RGBA8 = 0,
+	ROWFORMAT_RGB8,
+	ROWFORMAT_R32F,
+	ROWFORMAT_RGBA32F,
+	ROWFORMAT_RGBA16F,
+	ROWFORMAT_D24,
+
+	ROWFORMAT_GENERIC
+};
+
+RowFormat getRowFormat (const TextureFormat& format)
+{
+	if (format.type == TextureFormat::UNORM_INT8)
+	{
+		if (format.order == TextureFormat::RGBA || format.order == TextureFormat::sRGBA)
+			return ROWFORMAT_RGBA8;
+		else if (format.order == TextureFormat::RGB || format.order == TextureFormat::sRGB)
+			return ROWFORMAT_RGB8;
+	}
+	else if (format.type == TextureFormat::FLOAT)
+	{
+		if (format.order == TextureFormat::R || format.order == TextureFormat::D)
+			return ROWFORMAT_R32F;
+		else if (format.order == TextureFormat::RGBA)
+			return ROWFORMAT_RGBA32F;
+	}
+	else if (format.type == TextureFormat::HALF_FLOAT && format.order == TextureFormat::RGBA)
+		return ROWFORMAT_RGBA16F;
+	else if (format.type == TextureFormat::UNORM_INT24 && format.order == TextureFormat::D)
+		return ROWFORMAT_D24;
+
+	return ROWFORMAT_GENERIC;
+}
+
+} // anonymous
+
+ConstPixelRowAccess::ConstPixelRowAccess (const ConstPixelBufferAccess& access)
+	: m_access		(access)
+	, m_readRow		(readRowGeneric)
+	, m_readRowInt	(readRowIntGeneric)
+{
+	switch (getRowFormat(access.getFormat()))
+	{
+		case ROWFORMAT_RGBA8:
+			m_readRow		= readRowFloat<RGBA8RowFormat>;
+			m_readRowInt	= readRowInt<RGBA8RowFormat>;
+			break;
+
+		case ROWFORMAT_RGB8:
+			m_readRow		= readRowFloat<RGB8RowFormat>;
+			m_readRowInt	= readRowInt<RGB8RowFormat>;
+			break;
+
+		case ROWFORMAT_R32F:	m_readRow = readRowFloat<R32FRowFormat>;	break;
+		case ROWFORMAT_RGBA32F:	m_readRow = readRowFloat<RGBA32FRowFormat>;	break;
+		case ROWFORMAT_RGBA16F:	m_readRow = readRowFloat<RGBA16FRowFormat>;	break;
+		case ROWFORMAT_D24:		m_readRow = readRowFloat<D24RowFormat>;		break;
+
+		default:
+			break;
+	}
+}
+
+PixelRowAccess::PixelRowAccess (const PixelBufferAccess& access)
+	: ConstPixelRowAccess	(access)
+	, m_writeAccess			(access)
+	, m_writeRow			(writeRowGeneric)
+	, m_writeRowInt			(writeRowIntGeneric)
+{
+	switch (getRowFormat(access.getFormat()))
+	{
+		case ROWFORMAT_RGBA8:
+			m_writeRow		= writeRowFloat<RGBA8RowFormat>;
+			m_writeRowInt	= writeRowInt<RGBA8RowFormat>;
+			break;
+
+		case ROWFORMAT_RGB8:
+			m_writeRow		= writeRowFloat<RGB8RowFormat>;
+			m_writeRowInt	= writeRowInt<RGB8RowFormat>;
+			break;
+
+		case ROWFORMAT_R32F:	m_writeRow = writeRowFloat<R32FRowFormat>;		break;
+		case ROWFORMAT_RGBA32F:	m_writeRow = writeRowFloat<RGBA32FRowFormat>;	break;
+		case ROWFORMAT_RGBA16F:	m_writeRow = writeRowFloat<RGBA16FRowFormat>;	break;
+		case ROWFORMAT_D24:		m_writeRow = writeRowFloat<D24RowFormat>;		break;
+
+		default:
+			break;
+	}
+}
+
 static inline int imod (int a, int b)
 {
 	int m = a % b;
@@ -2254,6 +2487,166 @@ Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLeve
 	}
 }
 
+namespace
+{
+
+//! Texture level decoded once per sampleLevelArray2DBatch() call.
+struct BatchLevel2D
+{
+	const deUint8*	data;
+	int				width;
+	int				height;
+	int				pixelPitch;
+	int				rowPitch;
+};
+
+template <typename Format>
+inline Vec4 lookupBatch (const BatchLevel2D& level, int i, int j)
+{
+	return Format::read(level.data + j*level.rowPitch + i*level.pixelPitch);
+}
+
+// \note Must match sampleNearest2D() and sampleLinear2D() exactly for wrap modes other than CLAMP_TO_BORDER.
+template <typename Format>
+Vec4 sampleBatchLevel2D (const BatchLevel2D& level, const Sampler& sampler, Sampler::FilterMode filter, float s, float t)
+{
+	const float u = sampler.normalizedCoords ? unnormalize(sampler.wrapS, s, level.width)	: s;
+	const float v = sampler.normalizedCoords ? unnormalize(sampler.wrapT, t, level.height)	: t;
+
+	if (filter == Sampler::NEAREST)
+	{
+		const int i = wrap(sampler.wrapS, deFloorFloatToInt32(u), level.width);
+		const int j = wrap(sampler.wrapT, deFloorFloatToInt32(v), level.height);
+
+		return lookupBatch<Format>(level, i, j);
+	}
+	else
+	{
+		DE_ASSERT(filter == Sampler::LINEAR);
+
+		const int	x0	= deFloorFloatToInt32(u-0.5f);
+		const int	y0	= deFloorFloatToInt32(v-0.5f);
+
+		const int	i0	= wrap(sampler.wrapS, x0, level.width);
+		const int	i1	= wrap(sampler.wrapS, x0+1, level.width);
+		const int	j0	= wrap(sampler.wrapT, y0, level.height);
+		const int	j1	= wrap(sampler.wrapT, y0+1, level.height);
+
+		const float	a	= deFloatFrac(u-0.5f);
+		const float	b	= deFloatFrac(v-0.5f);
+
+		const Vec4	p00	= lookupBatch<Format>(level, i0, j0);
+		const Vec4	p10	= lookupBatch<Format>(level, i1, j0);
+		const Vec4	p01	= lookupBatch<Format>(level, i0, j1);
+		const Vec4	p11	= lookupBatch<Format>(level, i1, j1);
+
+		return (p00*(1.0f-a)*(1.0f-b)) +
+			   (p10*(     a)*(1.0f-b)) +
+			   (p01*(1.0f-a)*(     b)) +
+			   (p11*(     a)*(     b));
+	}
+}
+
+template <typename Format>
+void sampleLevelArray2DBatchSpecialized (const BatchLevel2D* levels, int numLevels, const Sampler& sampler, int numCoords, const float* s, const float* t, const float* lod, Vec4* dst)
+{
+	const int maxLevel = numLevels-1;
+
+	for (int ndx = 0; ndx < numCoords; ndx++)
+	{
+		const bool					magnified	= lod[ndx] <= sampler.lodThreshold;
+		const Sampler::FilterMode	filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+
+		switch (filterMode)
+		{
+			case Sampler::NEAREST:
+			case Sampler::LINEAR:
+				dst[ndx] = sampleBatchLevel2D<Format>(levels[0], sampler, filterMode, s[ndx], t[ndx]);
+				break;
+
+			case Sampler::NEAREST_MIPMAP_NEAREST:
+			case Sampler::LINEAR_MIPMAP_NEAREST:
+			{
+				const int					level		= deClamp32((int)deFloatCeil(lod[ndx] + 0.5f) - 1, 0, maxLevel);
+				const Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
+
+				dst[ndx] = sampleBatchLevel2D<Format>(levels[level], sampler, levelFilter, s[ndx], t[ndx]);
+				break;
+			}
+
+			case Sampler::NEAREST_MIPMAP_LINEAR:
+			case Sampler::LINEAR_MIPMAP_LINEAR:
+			{
+				const int					level0		= deClamp32((int)deFloatFloor(lod[ndx]), 0, maxLevel);
+				const int					level1		= de::min(maxLevel, level0 + 1);
+				const Sampler::FilterMode	levelFilter	= (filterMode == Sampler::LINEAR_MIPMAP_LINEAR) ? Sampler::LINEAR : Sampler::NEAREST;
+				const float					f			= deFloatFrac(lod[ndx]);
+				const Vec4					t0			= sampleBatchLevel2D<Format>(levels[level0], sampler, levelFilter, s[ndx], t[ndx]);
+				const Vec4					t1			= sampleBatchLevel2D<Format>(levels[level1], sampler, levelFilter, s[ndx], t[ndx]);
+
+				dst[ndx] = t0*(1.0f - f) + t1*f;
+				break;
+			}
+
+			default:
+				DE_ASSERT(DE_FALSE);
+				dst[ndx] = Vec4(0.0f);
+		}
+	}
+}
+
+bool isBatchSamplingSpecialized (const ConstPixelBufferAccess& level0, const Sampler& sampler)
+{
+	// Border color lookups and sRGB conversion are left to the generic path.
+	return sampler.wrapS != Sampler::CLAMP_TO_BORDER	&&
+		   sampler.wrapT != Sampler::CLAMP_TO_BORDER	&&
+		   !isSRGB(level0.getFormat())					&&
+		   getRowFormat(level0.getFormat()) != ROWFORMAT_GENERIC;
+}
+
+} // anonymous
+
+void sampleLevelArray2DBatch (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, int depth, int numCoords, const float* s, const float* t, const float* lod, Vec4* dst)
+{
+	if (numCoords <= 0)
+		return;
+
+	if (numLevels > 0 && isBatchSamplingSpecialized(levels[0], sampler))
+	{
+		std::vector<BatchLevel2D> batchLevels	(numLevels);
+
+		for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
+		{
+			const ConstPixelBufferAccess&	level	= levels[levelNdx];
+			BatchLevel2D&					dstDesc	= batchLevels[levelNdx];
+
+			DE_ASSERT(level.getFormat() == levels[0].getFormat());
+			DE_ASSERT(de::inBounds(depth, 0, level.getDepth()));
+
+			dstDesc.data		= (const deUint8*)level.getPixelPtr(0, 0, depth);
+			dstDesc.width		= level.getWidth();
+			dstDesc.height		= level.getHeight();
+			dstDesc.pixelPitch	= level.getPixelPitch();
+			dstDesc.rowPitch	= level.getRowPitch();
+		}
+
+		switch (getRowFormat(levels[0].getFormat()))
+		{
+			case ROWFORMAT_RGBA8:	sampleLevelArray2DBatchSpecialized<RGBA8RowFormat>		(&batchLevels[0], numLevels, sampler, numCoords, s, t, lod, dst);	return;
+			case ROWFORMAT_RGB8:	sampleLevelArray2DBatchSpecialized<RGB8RowFormat>		(&batchLevels[0], numLevels, sampler, numCoords, s, t, lod, dst);	return;
+			case ROWFORMAT_R32F:	sampleLevelArray2DBatchSpecialized<R32FRowFormat>		(&batchLevels[0], numLevels, sampler, numCoords, s, t, lod, dst);	return;
+			case ROWFORMAT_RGBA32F:	sampleLevelArray2DBatchSpecialized<RGBA32FRowFormat>	(&batchLevels[0], numLevels, sampler, numCoords, s, t, lod, dst);	return;
+			case ROWFORMAT_RGBA16F:	sampleLevelArray2DBatchSpecialized<RGBA16FRowFormat>	(&batchLevels[0], numLevels, sampler, numCoords, s, t, lod, dst);	return;
+			case ROWFORMAT_D24:		sampleLevelArray2DBatchSpecialized<D24RowFormat>		(&batchLevels[0], numLevels, sampler, numCoords, s, t, lod, dst);	return;
+			default:
+				DE_ASSERT(DE_FALSE);
+		}
+	}
+
+	for (int ndx = 0; ndx < numCoords; ndx++)
+		dst[ndx] = sampleLevelArray2D(levels, numLevels, sampler, s[ndx], t[ndx], depth, lod[ndx]);
+}
+
 Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset)
 {
 	bool					magnified	= lod <= sampler.lodThreshold;
@@ -414,6 +414,62 @@ public:
 	void				setPixStencil		(int stencil, int x, int y, int z = 0) const;
 } DE_WARN_UNUSED_TYPE;
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Row-wise read-only pixel access
+ *
+ * Conversion routines are selected once based on the access format,
+ * which avoids per-pixel format dispatch in image-wide loops. Common
+ * formats (RGBA8, RGB8, R32F, RGBA32F, RGBA16F, D32F and 24-bit unorm
+ * depth, e.g. depth view of D24S8) have specialized routines; other
+ * formats fall back to getPixel() and getPixelInt(). Results are
+ * identical to the per-pixel accessors.
+ *//*--------------------------------------------------------------------*/
+class ConstPixelRowAccess
+{
+public:
+	typedef void					(*ReadRowFunc)			(const ConstPixelBufferAccess& access, int x, int y, int z, int numPixels, Vec4* dst);
+	typedef void					(*ReadRowIntFunc)		(const ConstPixelBufferAccess& access, int x, int y, int z, int numPixels, IVec4* dst);
+
+	explicit						ConstPixelRowAccess		(const ConstPixelBufferAccess& access);
+
+	const ConstPixelBufferAccess&	getAccess				(void) const { return m_access; }
+
+	//! Read numPixels pixels starting from (x, y, z). Same as calling getPixel() for each pixel.
+	void							readRow					(int x, int y, int z, int numPixels, Vec4* dst) const	{ m_readRow(m_access, x, y, z, numPixels, dst);		}
+	//! Read numPixels pixels starting from (x, y, z). Same as calling getPixelInt() for each pixel.
+	void							readRow					(int x, int y, int z, int numPixels, IVec4* dst) const	{ m_readRowInt(m_access, x, y, z, numPixels, dst);	}
+
+protected:
+	ConstPixelBufferAccess			m_access;
+	ReadRowFunc						m_readRow;
+	ReadRowIntFunc					m_readRowInt;
+} DE_WARN_UNUSED_TYPE;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Row-wise read-write pixel access
+ *
+ * \see ConstPixelRowAccess
+ *//*--------------------------------------------------------------------*/
+class PixelRowAccess : public ConstPixelRowAccess
+{
+public:
+	typedef void					(*WriteRowFunc)			(const PixelBufferAccess& access, int x, int y, int z, int numPixels, const Vec4* src);
+	typedef void					(*WriteRowIntFunc)		(const PixelBufferAccess& access, int x, int y, int z, int numPixels, const IVec4* src);
+
+	explicit						PixelRowAccess			(const PixelBufferAccess& access);
+
+	const PixelBufferAccess&		getAccess				(void) const { return m_writeAccess; }
+
+	//! Write numPixels pixels starting from (x, y, z). Same as calling setPixel() for each pixel.
+	void							writeRow				(int x, int y, int z, int numPixels, const Vec4* src) const		{ m_writeRow(m_writeAccess, x, y, z, numPixels, src);		}
+	void							writeRow				(int x, int y, int z, int numPixels, const IVec4* src) const	{ m_writeRowInt(m_writeAccess, x, y, z, numPixels, src);	}
+
+private:
+	PixelBufferAccess				m_writeAccess;
+	WriteRowFunc					m_writeRow;
+	WriteRowIntFunc					m_writeRowInt;
+} DE_WARN_UNUSED_TYPE;
+
 /*--------------------------------------------------------------------*//*!
  * \brief Generic pixel data container
  *
@@ -461,6 +517,9 @@ Vec4	sampleLevelArray1DOffset		(const ConstPixelBufferAccess* levels, int numLev
 Vec4	sampleLevelArray2DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float lod, const IVec3& offset);
 Vec4	sampleLevelArray3DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset);
 
+// Batched variant of sampleLevelArray2D(): samples numCoords coordinates (s[i], t[i], lod[i]) into dst[i].
+void	sampleLevelArray2DBatch			(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, int depth, int numCoords, const float* s, const float* t, const float* lod, Vec4* dst);
+
 float	sampleLevelArray1DCompare		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float lod, const IVec2& offset);
 float	sampleLevelArray2DCompare		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float t, float lod, const IVec3& offset);
 
@@ -569,6 +628,7 @@ public:
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const;
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const;
+	void							sampleBatch			(const Sampler& sampler, int numCoords, const float* s, const float* t, const float* lod, Vec4* dst) const;
 
 	Vec4							gatherOffsets		(const Sampler& sampler, float s, float t, int componentNdx, const IVec2 (&offsets)[4]) const;
 	Vec4							gatherOffsetsCompare(const Sampler& sampler, float ref, float s, float t, const IVec2 (&offsets)[4]) const;
@@ -605,6 +665,11 @@ inline float Texture2DView::sampleCompareOffset (const Sampler& sampler, float r
 	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(offset.x(), offset.y(), 0));
 }
 
+inline void Texture2DView::sampleBatch (const Sampler& sampler, int numCoords, const float* s, const float* t, const float* lod, Vec4* dst) const
+{
+	sampleLevelArray2DBatch(m_levels, m_numLevels, sampler, 0 /* depth */, numCoords, s, t, lod, dst);
+}
+
 inline Vec4 Texture2DView::gatherOffsets (const Sampler& sampler, float s, float t, int componentNdx, const IVec2 (&offsets)[4]) const
 {
 	return gatherArray2DOffsets(m_levels[0], sampler, s, t, 0, componentNdx, offsets);
@@ -726,6 +791,7 @@ public:
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const;
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const;
+	void							sampleBatch			(const Sampler& sampler, int numCoords, const float* s, const float* t, const float* lod, Vec4* dst) const;
 
 	Vec4							gatherOffsets		(const Sampler& sampler, float s, float t, int componentNdx, const IVec2 (&offsets)[4]) const;
 	Vec4							gatherOffsetsCompare(const Sampler& sampler, float ref, float s, float t, const IVec2 (&offsets)[4]) const;
@@ -766,6 +832,11 @@ inline float Texture2D::sampleCompareOffset	(const Sampler& sampler, float ref,
 	return m_view.sampleCompareOffset(sampler, ref, s, t, lod, offset);
 }
 
+inline void Texture2D::sampleBatch (const Sampler& sampler, int numCoords, const float* s, const float* t, const float* lod, Vec4* dst) const
+{
+	m_view.sampleBatch(sampler, numCoords, s, t, lod, dst);
+}
+
 inline Vec4 Texture2D::gatherOffsets (const Sampler& sampler, float s, float t, int componentNdx, const IVec2 (&offsets)[4]) const
 {
 	return m_view.gatherOffsets(sampler, s, t, componentNdx, offsets);
@@ -733,12 +733,14 @@ void clear (const PixelBufferAccess& access, const Vec4& color)
 			for (int y = 0; y < access.getHeight(); y++)
 				fillRow(access, y, z, pixelSize, &pixel.u8[0]);
 	}
-	else
+	else if (access.getWidth() > 0)
 	{
+		const PixelRowAccess	rowAccess	(access);
+		const std::vector<Vec4>	row			(access.getWidth(), color);
+
 		for (int z = 0; z < access.getDepth(); z++)
 			for (int y = 0; y < access.getHeight(); y++)
-				for (int x = 0; x < access.getWidth(); x++)
-					access.setPixel(color, x, y, z);
+				rowAccess.writeRow(0, y, z, access.getWidth(), &row[0]);
 	}
 }
 
@@ -764,12 +766,14 @@ void clear (const PixelBufferAccess& access, const IVec4& color)
 			for (int y = 0; y < access.getHeight(); y++)
 				fillRow(access, y, z, pixelSize, &pixel.u8[0]);
 	}
-	else
+	else if (access.getWidth() > 0)
 	{
+		const PixelRowAccess		rowAccess	(access);
+		const std::vector<IVec4>	row			(access.getWidth(), color);
+
 		for (int z = 0; z < access.getDepth(); z++)
 			for (int y = 0; y < access.getHeight(); y++)
-				for (int x = 0; x < access.getWidth(); x++)
-					access.setPixel(color, x, y, z);
+				rowAccess.writeRow(0, y, z, access.getWidth(), &row[0]);
 	}
 }
 
@@ -795,6 +799,10 @@ void clearStencil (const PixelBufferAccess& access, int stencil)
 static void fillWithComponentGradients1D (const PixelBufferAccess& access, const Vec4& minVal, const Vec4& maxVal)
 {
 	DE_ASSERT(access.getHeight() == 1);
+
+	const PixelRowAccess	rowAccess	(access);
+	std::vector<Vec4>		row			(access.getWidth());
+
 	for (int x = 0; x < access.getWidth(); x++)
 	{
 		float s = ((float)x + 0.5f) / (float)access.getWidth();
@@ -804,12 +812,21 @@ static void fillWithComponentGradients1D (const PixelBufferAccess& access, const
 		float b = linearInterpolate(s, minVal.z(), maxVal.z());
 		float a = linearInterpolate(s, minVal.w(), maxVal.w());
 
-		access.setPixel(tcu::Vec4(r, g, b, a), x, 0);
+		row[x] = tcu::Vec4(r, g, b, a);
 	}
+
+	if (!row.empty())
+		rowAccess.writeRow(0, 0, 0, access.getWidth(), &row[0]);
 }
 
 static void fillWithComponentGradients2D (const PixelBufferAccess& access, const Vec4& minVal, const Vec4& maxVal)
 {
+	const PixelRowAccess	rowAccess	(access);
+	std::vector<Vec4>		row			(access.getWidth());
+
+	if (row.empty())
+		return;
+
 	for (int y = 0; y < access.getHeight(); y++)
 	{
 		for (int x = 0; x < access.getWidth(); x++)
@@ -822,13 +839,21 @@ static void fillWithComponentGradients2D (const PixelBufferAccess& access, const
 			float b = linearInterpolate(((1.0f-s) +       t) *0.5f, minVal.z(), maxVal.z());
 			float a = linearInterpolate(((1.0f-s) + (1.0f-t))*0.5f, minVal.w(), maxVal.w());
 
-			access.setPixel(tcu::Vec4(r, g, b, a), x, y);
+			row[x] = tcu::Vec4(r, g, b, a);
 		}
+
+		rowAccess.writeRow(0, y, 0, access.getWidth(), &row[0]);
 	}
 }
 
 static void fillWithComponentGradients3D (const PixelBufferAccess& dst, const Vec4& minVal, const Vec4& maxVal)
 {
+	const PixelRowAccess	rowAccess	(dst);
+	std::vector<Vec4>		row			(dst.getWidth());
+
+	if (row.empty())
+		return;
+
 	for (int z = 0; z < dst.getDepth(); z++)
 	{
 		for (int y = 0; y < dst.getHeight(); y++)
@@ -844,8 +869,10 @@ static void fillWithComponentGradients3D (const PixelBufferAccess& dst, const Ve
 				float b = linearInterpolate(p,						minVal.z(), maxVal.z());
 				float a = linearInterpolate(1.0f - (s+t+p)/3.0f,	minVal.w(), maxVal.w());
 
-				dst.setPixel(tcu::Vec4(r, g, b, a), x, y, z);
+				row[x] = tcu::Vec4(r, g, b, a);
 			}
+
+			rowAccess.writeRow(0, y, z, dst.getWidth(), &row[0]);
 		}
 	}
 }
@@ -1037,6 +1064,9 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 	const bool	dstHasDepth			= (dst.getFormat().order == tcu::TextureFormat::DS || dst.getFormat().order == tcu::TextureFormat::D);
 	const bool	dstHasStencil		= (dst.getFormat().order == tcu::TextureFormat::DS || dst.getFormat().order == tcu::TextureFormat::S);
 
+	if (width == 0)
+		return;
+
 	if (src.getFormat() == dst.getFormat() && srcTightlyPacked && dstTightlyPacked)
 	{
 		// Fast-path for matching formats.
@@ -1058,10 +1088,17 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 
 		if (dstHasDepth && srcHasDepth)
 		{
+			// \note Effective depth accesses have plain D formats which can be converted row at a time.
+			const ConstPixelRowAccess	srcRows		(getEffectiveDepthStencilAccess(src, Sampler::MODE_DEPTH));
+			const PixelRowAccess		dstRows		(getEffectiveDepthStencilAccess(dst, Sampler::MODE_DEPTH));
+			std::vector<Vec4>			row			(width);
+
 			for (int z = 0; z < depth; z++)
 			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixDepth(src.getPixDepth(x, y, z), x, y, z);
+			{
+				srcRows.readRow(0, y, z, width, &row[0]);
+				dstRows.writeRow(0, y, z, width, &row[0]);
+			}
 		}
 		else if (dstHasDepth && !srcHasDepth)
 		{
@@ -1089,19 +1126,30 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 		bool					srcIsInt	= srcClass == TEXTURECHANNELCLASS_SIGNED_INTEGER || srcClass == TEXTURECHANNELCLASS_UNSIGNED_INTEGER;
 		bool					dstIsInt	= dstClass == TEXTURECHANNELCLASS_SIGNED_INTEGER || dstClass == TEXTURECHANNELCLASS_UNSIGNED_INTEGER;
 
+		const ConstPixelRowAccess	srcRows		(src);
+		const PixelRowAccess		dstRows		(dst);
+
 		if (srcIsInt && dstIsInt)
 		{
+			std::vector<IVec4> row (width);
+
 			for (int z = 0; z < depth; z++)
 			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixel(src.getPixelInt(x, y, z), x, y, z);
+			{
+				srcRows.readRow(0, y, z, width, &row[0]);
+				dstRows.writeRow(0, y, z, width, &row[0]);
+			}
 		}
 		else
 		{
+			std::vector<Vec4> row (width);
+
 			for (int z = 0; z < depth; z++)
 			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixel(src.getPixel(x, y, z), x, y, z);
+			{
+				srcRows.readRow(0, y, z, width, &row[0]);
+				dstRows.writeRow(0, y, z, width, &row[0]);
+			}
 		}
 	}
 }
@@ -0,0 +1,312 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Process-wide worker pool for CPU-side reference computations.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuWorkerPool.hpp"
+#include "deThread.hpp"
+#include "deMutex.hpp"
+#include "deSemaphore.hpp"
+#include "deAtomic.h"
+#include "deThread.h"
+
+#include <vector>
+#include <string>
+#include <new>
+
+namespace tcu
+{
+namespace
+{
+
+enum ErrorType
+{
+	ERRORTYPE_NONE = 0,
+	ERRORTYPE_TEST_ERROR,
+	ERRORTYPE_INTERNAL_ERROR,
+	ERRORTYPE_RESOURCE_ERROR,
+	ERRORTYPE_NOT_SUPPORTED,
+	ERRORTYPE_TEST_EXCEPTION,
+	ERRORTYPE_OUT_OF_MEMORY,
+	ERRORTYPE_OTHER,
+
+	ERRORTYPE_LAST
+};
+
+class WorkerPool;
+
+class WorkerThread : public de::Thread
+{
+public:
+						WorkerThread	(WorkerPool& pool, int workerNdx) : m_pool(pool), m_workerNdx(workerNdx), m_wakeUp(0) {}
+
+	void				run				(void);
+	void				wakeUp			(void) { m_wakeUp.increment(); }
+
+private:
+	WorkerPool&			m_pool;
+	const int			m_workerNdx;
+	de::Semaphore		m_wakeUp;
+};
+
+class WorkerPool
+{
+public:
+								WorkerPool		(int numThreads);
+								~WorkerPool		(void);
+
+	bool						tryExecute		(ParallelWork& work, int numItems);
+
+	void						executeItems	(int workerNdx);
+	void						workerFinished	(void) { m_finished.increment(); }
+	bool						isQuitting		(void) const { return m_quit; }
+
+private:
+								WorkerPool		(const WorkerPool&);
+	WorkerPool&					operator=		(const WorkerPool&);
+
+	void						setError		(ErrorType type, const std::string& message, qpTestResult result);
+	void						throwError		(void);
+
+	std::vector<WorkerThread*>	m_threads;
+	volatile deUint32			m_busy;			//!< Set for the duration of one executeParallel()
+	de::Semaphore				m_finished;
+
+	// Current work, valid while m_busy is set.
+	ParallelWork*				m_work;
+	int							m_numItems;
+	volatile deInt32			m_nextItem;
+	volatile deUint32			m_aborted;
+	bool						m_quit;
+
+	// First error, protected by m_errorLock.
+	de::Mutex					m_errorLock;
+	ErrorType					m_errorType;
+	std::string					m_errorMessage;
+	qpTestResult				m_errorResult;
+};
+
+void WorkerThread::run (void)
+{
+	for (;;)
+	{
+		m_wakeUp.decrement();
+
+		if (m_pool.isQuitting())
+			break;
+
+		m_pool.executeItems(m_workerNdx);
+		m_pool.workerFinished();
+	}
+}
+
+WorkerPool::WorkerPool (int numThreads)
+	: m_busy		(0)
+	, m_finished	(0)
+	, m_work		(DE_NULL)
+	, m_numItems	(0)
+	, m_nextItem	(0)
+	, m_aborted		(0)
+	, m_quit		(false)
+	, m_errorType	(ERRORTYPE_NONE)
+	, m_errorResult	(QP_TEST_RESULT_INTERNAL_ERROR)
+{
+	DE_ASSERT(numThreads > 1);
+
+	try
+	{
+		for (int workerNdx = 1; workerNdx < numThreads; ++workerNdx)
+		{
+			m_threads.push_back(new WorkerThread(*this, workerNdx));
+			m_threads.back()->start();
+		}
+	}
+	catch (...)
+	{
+		m_quit = true;
+
+		for (size_t ndx = 0; ndx < m_threads.size(); ++ndx)
+		{
+			if (m_threads[ndx]->isStarted())
+			{
+				m_threads[ndx]->wakeUp();
+				m_threads[ndx]->join();
+			}
+			delete m_threads[ndx];
+		}
+
+		throw;
+	}
+}
+
+WorkerPool::~WorkerPool (void)
+{
+	m_quit = true;
+
+	for (size_t ndx = 0; ndx < m_threads.size(); ++ndx)
+		m_threads[ndx]->wakeUp();
+
+	for (size_t ndx = 0; ndx < m_threads.size(); ++ndx)
+	{
+		m_threads[ndx]->join();
+		delete m_threads[ndx];
+	}
+}
+
+void WorkerPool::setError (ErrorType type, const std::string& message, qpTestResult result)
+{
+	de::ScopedLock lock(m_errorLock);
+
+	if (m_errorType == ERRORTYPE_NONE)
+	{
+		m_errorType		= type;
+		m_errorMessage	= message;
+		m_errorResult	= result;
+	}
+
+	// Skip remaining items
+	deAtomicCompareExchange32(&m_aborted, 0u, 1u);
+}
+
+void WorkerPool::throwError (void)
+{
+	const ErrorType		type	= m_errorType;
+	const std::string	message	= m_errorMessage;
+
+	m_errorType = ERRORTYPE_NONE;
+	m_errorMessage.clear();
+
+	switch (type)
+	{
+		case ERRORTYPE_NONE:			return;
+		case ERRORTYPE_TEST_ERROR:		throw TestError(message);
+		case ERRORTYPE_INTERNAL_ERROR:	throw InternalError(message);
+		case ERRORTYPE_RESOURCE_ERROR:	throw ResourceError(message);
+		case ERRORTYPE_NOT_SUPPORTED:	throw NotSupportedError(message);
+		case ERRORTYPE_TEST_EXCEPTION:	throw TestException(message, m_errorResult);
+		case ERRORTYPE_OUT_OF_MEMORY:	throw std::bad_alloc();
+		default:						throw InternalError(message);
+	}
+}
+
+void WorkerPool::executeItems (int workerNdx)
+{
+	while (!m_aborted)
+	{
+		const int itemNdx = (int)deAtomicIncrement32(&m_nextItem) - 1;
+
+		if (itemNdx >= m_numItems)
+			break;
+
+		try
+		{
+			m_work->execute(workerNdx, itemNdx);
+		}
+		catch (const TestError& e)			{ setError(ERRORTYPE_TEST_ERROR,		e.getMessage(),	e.getTestResult());				}
+		catch (const InternalError& e)		{ setError(ERRORTYPE_INTERNAL_ERROR,	e.getMessage(),	e.getTestResult());				}
+		catch (const ResourceError& e)		{ setError(ERRORTYPE_RESOURCE_ERROR,	e.getMessage(),	e.getTestResult());				}
+		catch (const NotSupportedError& e)	{ setError(ERRORTYPE_NOT_SUPPORTED,		e.getMessage(),	e.getTestResult());				}
+		catch (const TestException& e)		{ setError(ERRORTYPE_TEST_EXCEPTION,	e.getMessage(),	e.getTestResult());				}
+		catch (const std::bad_alloc&)		{ setError(ERRORTYPE_OUT_OF_MEMORY,		"",				QP_TEST_RESULT_RESOURCE_ERROR);	}
+		catch (const std::exception& e)		{ setError(ERRORTYPE_OTHER,				e.what(),		QP_TEST_RESULT_INTERNAL_ERROR);	}
+		catch (...)							{ setError(ERRORTYPE_OTHER,				"Unknown exception in worker thread", QP_TEST_RESULT_INTERNAL_ERROR); }
+	}
+}
+
+bool WorkerPool::tryExecute (ParallelWork& work, int numItems)
+{
+	// \note Not a mutex: recursive mutexes (Win32) would let nested calls from the executing thread re-enter the pool.
+	if (deAtomicCompareExchange32(&m_busy, 0u, 1u) != 0u)
+		return false;
+
+	m_work		= &work;
+	m_numItems	= numItems;
+	m_nextItem	= 0;
+	m_aborted	= 0;
+
+	// \note Semaphore operations act as memory barriers for the work state
+	for (size_t ndx = 0; ndx < m_threads.size(); ++ndx)
+		m_threads[ndx]->wakeUp();
+
+	executeItems(0);
+
+	for (size_t ndx = 0; ndx < m_threads.size(); ++ndx)
+		m_finished.decrement();
+
+	m_work = DE_NULL;
+
+	try
+	{
+		throwError();
+	}
+	catch (...)
+	{
+		deAtomicCompareExchange32(&m_busy, 1u, 0u);
+		throw;
+	}
+
+	deAtomicCompareExchange32(&m_busy, 1u, 0u);
+	return true;
+}
+
+de::Mutex		s_poolLock;
+WorkerPool*		s_pool			= DE_NULL;
+int				s_numThreads	= 1;
+
+} // anonymous
+
+void setNumWorkerThreads (int numThreads)
+{
+	de::ScopedLock	lock		(s_poolLock);
+	const int		newCount	= (numThreads <= 0) ? de::max(1, (int)deGetNumAvailableLogicalCores()) : numThreads;
+
+	if (newCount == s_numThreads)
+		return;
+
+	delete s_pool;
+	s_pool			= DE_NULL;
+	s_numThreads	= 1;
+
+	if (newCount > 1)
+	{
+		s_pool			= new WorkerPool(newCount);
+		s_numThreads	= newCount;
+	}
+}
+
+int getNumWorkerThreads (void)
+{
+	return s_numThreads;
+}
+
+void executeParallel (ParallelWork& work, int numItems)
+{
+	if (numItems <= 0)
+		return;
+
+	if (numItems > 1 && s_pool && s_pool->tryExecute(work, numItems))
+		return;
+
+	for (int itemNdx = 0; itemNdx < numItems; ++itemNdx)
+		work.execute(0, itemNdx);
+}
+
+} // tcu
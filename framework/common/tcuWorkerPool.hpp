@@ -0,0 +1,69 @@
+#ifndef _TCUWORKERPOOL_HPP
+#define _TCUWORKERPOOL_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Process-wide worker pool for CPU-side reference computations.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+
+namespace tcu
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Work executed by executeParallel()
+ *
+ * execute() is called once for each item in range [0, numItems). Calls
+ * may happen concurrently from different threads and in any order.
+ * workerNdx is in range [0, getNumWorkerThreads()) and no two concurrent
+ * calls share the same workerNdx, so it can be used to index per-thread
+ * scratch buffers.
+ *//*--------------------------------------------------------------------*/
+class ParallelWork
+{
+public:
+	virtual			~ParallelWork	(void) {}
+	virtual void	execute			(int workerNdx, int itemNdx) = 0;
+};
+
+//! Set number of worker threads used by executeParallel(). 0 selects number of available cores, 1 disables threading.
+void	setNumWorkerThreads		(int numThreads);
+
+//! Get number of worker threads, including the calling thread. Always at least 1.
+int		getNumWorkerThreads		(void);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Execute items in parallel
+ *
+ * Executes work items [0, numItems) using the worker pool and the calling
+ * thread. Blocks until all items have been executed. If the pool is
+ * already busy (nested or concurrent use), items are executed serially
+ * on the calling thread with workerNdx 0.
+ *
+ * If an item throws, remaining unstarted items are skipped and the
+ * exception is re-thrown on the calling thread. Exceptions derived from
+ * tcu::TestException retain their type and message.
+ *//*--------------------------------------------------------------------*/
+void	executeParallel			(ParallelWork& work, int numItems);
+
+} // tcu
+
+#endif // _TCUWORKERPOOL_HPP
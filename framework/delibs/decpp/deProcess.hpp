@@ -52,6 +52,7 @@ public:
 
 	bool				isRunning			(void)			{ return deProcess_isRunning(m_process) == DE_TRUE;	}
 	int					getExitCode			(void) const	{ return deProcess_getExitCode(m_process);			}
+	deUintptr			getHandle			(void) const	{ return deProcess_getHandle(m_process);			}
 
 	deFile*				getStdIn			(void)			{ return deProcess_getStdIn(m_process);				}
 	deFile*				getStdOut			(void)			{ return deProcess_getStdOut(m_process);			}
@@ -73,6 +73,8 @@ deFile*			deFile_create			(const char* filename, deUint32 mode);
 deFile*			deFile_createFromHandle	(deUintptr handle);
 void			deFile_destroy			(deFile* file);
 
+deUintptr		deFile_getHandle		(const deFile* file);
+
 deBool			deFile_setFlags			(deFile* file, deUint32 flags);
 
 deInt64			deFile_getPosition		(const deFile* file);
@@ -185,6 +185,11 @@ int deProcess_getExitCode (const deProcess* process)
 	return process->exitCode;
 }
 
+deUintptr deProcess_getHandle (const deProcess* process)
+{
+	return (deUintptr)process->pid;
+}
+
 static deBool deProcess_setError (deProcess* process, const char* error)
 {
 	if (process->lastError)
@@ -625,6 +630,11 @@ int deProcess_getExitCode (const deProcess* process)
 	return process->exitCode;
 }
 
+deUintptr deProcess_getHandle (const deProcess* process)
+{
+	return (deUintptr)process->procInfo.hProcess;
+}
+
 deBool deProcess_start (deProcess* process, const char* commandLine, const char* workingDirectory)
 {
 	SECURITY_ATTRIBUTES	securityAttr;
@@ -40,6 +40,7 @@ deBool			deProcess_waitForFinish		(deProcess* process);
 
 const char*		deProcess_getLastError		(const deProcess* process);
 int				deProcess_getExitCode		(const deProcess* process);
+deUintptr		deProcess_getHandle			(const deProcess* process);	/*!< Process id on POSIX, process handle on Win32. */
 
 /* Non-blocking operations. */
 deBool			deProcess_terminate			(deProcess* process);
@@ -29,6 +29,7 @@
 #include "tcuImageCompare.hpp"
 #include "tcuTestLog.hpp"
 #include "tcuVectorUtil.hpp"
+#include "tcuWorkerPool.hpp"
 
 #include "deMath.h"
 #include "deStringUtil.hpp"
@@ -357,6 +358,17 @@ static inline tcu::Vec4 execSample (const tcu::Texture2DView& src, const Referen
 		return src.sample(params.sampler, s, t, lod);
 }
 
+static void execSampleBatch (const tcu::Texture2DView& src, const ReferenceParams& params, int numCoords, const float* s, const float* t, const float* lod, tcu::Vec4* dst)
+{
+	if (params.samplerType == SAMPLERTYPE_SHADOW)
+	{
+		for (int ndx = 0; ndx < numCoords; ndx++)
+			dst[ndx] = execSample(src, params, s[ndx], t[ndx], lod[ndx]);
+	}
+	else
+		src.sampleBatch(params.sampler, numCoords, s, t, lod, dst);
+}
+
 static inline tcu::Vec4 execSample (const tcu::TextureCubeView& src, const ReferenceParams& params, float s, float t, float r, float lod)
 {
 	if (params.samplerType == SAMPLERTYPE_SHADOW)
@@ -441,6 +453,12 @@ static void sampleTextureNonProjected (const tcu::SurfaceAccess& dst, const tcu:
 	float										triLod[2]			= { de::clamp(computeNonProjectedTriLod(params.lodMode, dstSize, srcSize, triS[0], triT[0]) + lodBias, params.minLod, params.maxLod),
 																		de::clamp(computeNonProjectedTriLod(params.lodMode, dstSize, srcSize, triS[1], triT[1]) + lodBias, params.minLod, params.maxLod) };
 
+	// Coordinates are computed and sampled one row at a time.
+	std::vector<float>							rowS				(dst.getWidth());
+	std::vector<float>							rowT				(dst.getWidth());
+	std::vector<float>							rowLod				(dst.getWidth());
+	std::vector<tcu::Vec4>						rowColor			(dst.getWidth());
+
 	for (int y = 0; y < dst.getHeight(); y++)
 	{
 		for (int x = 0; x < dst.getWidth(); x++)
@@ -452,12 +470,16 @@ static void sampleTextureNonProjected (const tcu::SurfaceAccess& dst, const tcu:
 			float	triX	= triNdx ? 1.0f-xf : xf;
 			float	triY	= triNdx ? 1.0f-yf : yf;
 
-			float	s		= triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY);
-			float	t		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
-			float	lod		= triLod[triNdx];
-
-			dst.setPixel(execSample(src, params, s, t, lod) * params.colorScale + params.colorBias, x, y);
+			rowS[x]		= triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY);
+			rowT[x]		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
+			rowLod[x]	= triLod[triNdx];
 		}
+
+		if (dst.getWidth() > 0)
+			execSampleBatch(src, params, dst.getWidth(), &rowS[0], &rowT[0], &rowLod[0], &rowColor[0]);
+
+		for (int x = 0; x < dst.getWidth(); x++)
+			dst.setPixel(rowColor[x] * params.colorScale + params.colorBias, x, y);
 	}
 }
 
@@ -520,6 +542,12 @@ static void sampleTextureProjected (const tcu::SurfaceAccess& dst, const tcu::Te
 	tcu::Vec3									triV[2]				= { vq.swizzle(0, 1, 2), vq.swizzle(3, 2, 1) };
 	tcu::Vec3									triW[2]				= { params.w.swizzle(0, 1, 2), params.w.swizzle(3, 2, 1) };
 
+	// Coordinates are computed and sampled one row at a time.
+	std::vector<float>							rowS				(dst.getWidth());
+	std::vector<float>							rowT				(dst.getWidth());
+	std::vector<float>							rowLod				(dst.getWidth());
+	std::vector<tcu::Vec4>						rowColor			(dst.getWidth());
+
 	for (int py = 0; py < dst.getHeight(); py++)
 	{
 		for (int px = 0; px < dst.getWidth(); px++)
@@ -535,13 +563,17 @@ static void sampleTextureProjected (const tcu::SurfaceAccess& dst, const tcu::Te
 			float	triNx	= triNdx ? 1.0f - nx : nx;
 			float	triNy	= triNdx ? 1.0f - ny : ny;
 
-			float	s		= projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy);
-			float	t		= projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy);
-			float	lod		= computeProjectedTriLod(params.lodMode, triU[triNdx], triV[triNdx], triW[triNdx], triWx, triWy, (float)dst.getWidth(), (float)dst.getHeight())
-							+ lodBias;
-
-			dst.setPixel(execSample(src, params, s, t, lod) * params.colorScale + params.colorBias, px, py);
+			rowS[px]	= projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy);
+			rowT[px]	= projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy);
+			rowLod[px]	= computeProjectedTriLod(params.lodMode, triU[triNdx], triV[triNdx], triW[triNdx], triWx, triWy, (float)dst.getWidth(), (float)dst.getHeight())
+						+ lodBias;
 		}
+
+		if (dst.getWidth() > 0)
+			execSampleBatch(src, params, dst.getWidth(), &rowS[0], &rowT[0], &rowLod[0], &rowColor[0]);
+
+		for (int px = 0; px < dst.getWidth(); px++)
+			dst.setPixel(rowColor[px] * params.colorScale + params.colorBias, px, py);
 	}
 }
 
@@ -1221,455 +1253,909 @@ void computeQuadTexCoordCubeArray (std::vector<float>& dst, tcu::CubeFace face,
 
 // Texture result verification
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture1DView&				baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+namespace
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
-
-	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
-	const tcu::Texture1DView					src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
 
-	const tcu::Vec4								sq					= tcu::Vec4(texCoord[0], texCoord[1], texCoord[2], texCoord[3]);
-
-	const tcu::IVec2							dstSize				= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float									dstW				= float(dstSize.x());
-	const float									dstH				= float(dstSize.y());
-	const int									srcSize				= src.getWidth();
+const tcu::Vec2 s_lodOffsets[] =
+{
+	tcu::Vec2(-1,  0),
+	tcu::Vec2(+1,  0),
+	tcu::Vec2( 0, -1),
+	tcu::Vec2( 0, +1),
 
-	// Coordinates and lod per triangle.
-	const tcu::Vec3								triS[2]				= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triW[2]				= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
+	// \note Not strictly allowed by spec, but implementations do this in practice.
+	tcu::Vec2(-1, -1),
+	tcu::Vec2(-1, +1),
+	tcu::Vec2(+1, -1),
+	tcu::Vec2(+1, +1),
+};
 
-	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
+//! Number of s_lodOffsets that are allowed by spec
+const int s_numAxisLodOffsets = 4;
 
-	int											numFailed			= 0;
+//! Set by setLookupColorBoundsEnabled(), only changed while no verification is running.
+bool s_lookupColorBoundsEnabled = true;
 
-	const tcu::Vec2 lodOffsets[] =
-	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
+/*--------------------------------------------------------------------*//*!
+ * \brief Conservative color bounds for filtered lookup results
+ *
+ * Filtered results are convex combinations of texel values and the border
+ * color. Results outside the value range of all levels (plus threshold)
+ * can be rejected without the full lookup search.
+ *//*--------------------------------------------------------------------*/
+class LookupColorBounds
+{
+public:
+						LookupColorBounds	(void);
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	void				addBorderColor		(const tcu::Sampler& sampler, const tcu::TextureFormat& format);
+	void				addLevel			(const tcu::ConstPixelBufferAccess& level);
+	bool				isOutOfBounds		(const tcu::LookupPrecision& prec, const tcu::Vec4& result) const;
 
-	for (int py = 0; py < result.getHeight(); py++)
-	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
+private:
+	void				addColor			(const tcu::Vec4& color);
 
-		for (int px = 0; px < result.getWidth(); px++)
-		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
+	tcu::Vec4			m_min;
+	tcu::Vec4			m_max;
+	bool				m_isEmpty;
+	bool				m_isFinite;
+};
 
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
+LookupColorBounds::LookupColorBounds (void)
+	: m_isEmpty		(true)
+	, m_isFinite	(true)
+{
+}
 
-				const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
-				const float		triWx	= triNdx ? dstW - wx : wx;
-				const float		triWy	= triNdx ? dstH - wy : wy;
-				const float		triNx	= triNdx ? 1.0f - nx : nx;
-				const float		triNy	= triNdx ? 1.0f - ny : ny;
+void LookupColorBounds::addBorderColor (const tcu::Sampler& sampler, const tcu::TextureFormat& format)
+{
+	if (sampler.wrapS == tcu::Sampler::CLAMP_TO_BORDER ||
+		sampler.wrapT == tcu::Sampler::CLAMP_TO_BORDER ||
+		sampler.wrapR == tcu::Sampler::CLAMP_TO_BORDER)
+		addColor(tcu::sampleTextureBorder<float>(format, sampler));
+}
 
-				const float		coord		= projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy);
-				const float		coordDx		= triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy) * float(srcSize);
-				const float		coordDy		= triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx) * float(srcSize);
+void LookupColorBounds::addColor (const tcu::Vec4& color)
+{
+	for (int compNdx = 0; compNdx < 4; compNdx++)
+	{
+		if (deFloatIsNaN(color[compNdx]) || deFloatIsInf(color[compNdx]))
+			m_isFinite = false;
+	}
 
-				tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx, coordDy, lodPrec);
+	m_min		= m_isEmpty ? color : tcu::min(m_min, color);
+	m_max		= m_isEmpty ? color : tcu::max(m_max, color);
+	m_isEmpty	= false;
+}
 
-				// Compute lod bounds across lodOffsets range.
-				for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-				{
-					const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-					const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-					const float		nxo		= wxo/dstW;
-					const float		nyo		= wyo/dstH;
+void LookupColorBounds::addLevel (const tcu::ConstPixelBufferAccess& level)
+{
+	// \note Must match lookup conversion done by tcuTexLookupVerifier.
+	const bool				isSRGB	= tcu::isSRGB(level.getFormat());
+	std::vector<tcu::Vec4>	row		(level.getWidth());
 
-					const float	coordDxo	= triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo) * float(srcSize);
-					const float	coordDyo	= triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo) * float(srcSize);
-					const tcu::Vec2	lodO	= tcu::computeLodBoundsFromDerivates(coordDxo, coordDyo, lodPrec);
+	if (level.getWidth() == 0)
+		return;
 
-					lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-					lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-				}
+	const tcu::ConstPixelRowAccess rowAccess (level);
 
-				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
+	for (int z = 0; z < level.getDepth(); z++)
+	for (int y = 0; y < level.getHeight(); y++)
+	{
+		rowAccess.readRow(0, y, z, level.getWidth(), &row[0]);
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red().toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
+		for (int x = 0; x < level.getWidth(); x++)
+			addColor(isSRGB ? tcu::sRGBToLinear(row[x]) : row[x]);
 	}
-
-	return numFailed;
 }
 
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture2DView&				baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+bool LookupColorBounds::isOutOfBounds (const tcu::LookupPrecision& prec, const tcu::Vec4& result) const
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
+	if (m_isEmpty || !m_isFinite)
+		return false;
 
-	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
-	const tcu::Texture2DView					src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
-
-	const tcu::Vec4								sq					= tcu::Vec4(texCoord[0+0], texCoord[2+0], texCoord[4+0], texCoord[6+0]);
-	const tcu::Vec4								tq					= tcu::Vec4(texCoord[0+1], texCoord[2+1], texCoord[4+1], texCoord[6+1]);
-
-	const tcu::IVec2							dstSize				= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float									dstW				= float(dstSize.x());
-	const float									dstH				= float(dstSize.y());
-	const tcu::IVec2							srcSize				= tcu::IVec2(src.getWidth(), src.getHeight());
+	for (int compNdx = 0; compNdx < 4; compNdx++)
+	{
+		if (!prec.colorMask[compNdx])
+			continue;
 
-	// Coordinates and lod per triangle.
-	const tcu::Vec3								triS[2]				= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triT[2]				= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triW[2]				= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
+		// Generous slack covers rounding in the verifier's interpolation and threshold arithmetic.
+		const float	minVal	= m_min[compNdx] - prec.colorThreshold[compNdx];
+		const float	maxVal	= m_max[compNdx] + prec.colorThreshold[compNdx];
+		const float	slack	= (de::abs(minVal) + de::abs(maxVal)) / 4096.0f;
 
-	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
+		if (result[compNdx] < minVal - slack || result[compNdx] > maxVal + slack)
+			return true;
+	}
 
-	const float									posEps				= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
+	return false;
+}
 
-	int											numFailed			= 0;
+//! Full verification of a single result pixel that was not accepted by comparison to ideal reference.
+class LookupPixelVerifier
+{
+public:
+	virtual			~LookupPixelVerifier	(void) {}
+	virtual bool	isPixelValid			(int px, int py, const tcu::Vec4& resPix) const = 0;
+};
 
-	const tcu::Vec2 lodOffsets[] =
-	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
+//! Verifies result rows in parallel, one row per work item.
+class LookupDiffRowWork : public tcu::ParallelWork
+{
+public:
+								LookupDiffRowWork	(const tcu::ConstPixelBufferAccess&	result,
+													 const tcu::ConstPixelBufferAccess&	reference,
+													 const tcu::PixelBufferAccess&		errorMask,
+													 const ReferenceParams&				sampleParams,
+													 const tcu::LookupPrecision&		lookupPrec,
+													 const LookupColorBounds&			colorBounds,
+													 const LookupPixelVerifier&			verifier,
+													 qpWatchDog*						watchDog)
+									: m_result			(result)
+									, m_reference		(reference)
+									, m_errorMask		(errorMask)
+									, m_sampleParams	(sampleParams)
+									, m_lookupPrec		(lookupPrec)
+									, m_colorBounds		(colorBounds)
+									, m_verifier		(verifier)
+									, m_watchDog		(watchDog)
+									, m_rowNumFailed	(result.getHeight(), 0)
+								{
+								}
+
+	void						execute				(int workerNdx, int py);
+	int							getNumFailed		(void) const;
+
+private:
+	const tcu::ConstPixelBufferAccess&	m_result;
+	const tcu::ConstPixelBufferAccess&	m_reference;
+	const tcu::PixelBufferAccess&		m_errorMask;
+	const ReferenceParams&				m_sampleParams;
+	const tcu::LookupPrecision&			m_lookupPrec;
+	const LookupColorBounds&			m_colorBounds;
+	const LookupPixelVerifier&			m_verifier;
+	qpWatchDog* const					m_watchDog;
+	std::vector<int>					m_rowNumFailed;
+};
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+void LookupDiffRowWork::execute (int workerNdx, int py)
+{
+	// Ugly hack, validation can take way too long at the moment.
+	// \note Only touched from calling thread.
+	if (m_watchDog && workerNdx == 0)
+		qpWatchDog_touch(m_watchDog);
 
-	for (int py = 0; py < result.getHeight(); py++)
+	for (int px = 0; px < m_result.getWidth(); px++)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
+		const tcu::Vec4	resPix	= (m_result.getPixel(px, py)	- m_sampleParams.colorBias) / m_sampleParams.colorScale;
+		const tcu::Vec4	refPix	= (m_reference.getPixel(px, py)	- m_sampleParams.colorBias) / m_sampleParams.colorScale;
 
-		for (int px = 0; px < result.getWidth(); px++)
+		// Try comparison to ideal reference first, and if that fails use slower verificator.
+		if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), m_lookupPrec.colorThreshold)))
 		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
+			const bool isOk = !m_colorBounds.isOutOfBounds(m_lookupPrec, resPix) && m_verifier.isPixelValid(px, py, resPix);
 
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
+			if (!isOk)
 			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
-
-				const bool		tri0	= (wx-posEps)/dstW + (wy-posEps)/dstH <= 1.0f;
-				const bool		tri1	= (wx+posEps)/dstW + (wy+posEps)/dstH >= 1.0f;
-
-				bool			isOk	= false;
-
-				DE_ASSERT(tri0 || tri1);
-
-				// Pixel can belong to either of the triangles if it lies close enough to the edge.
-				for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
-				{
-					const float		triWx	= triNdx ? dstW - wx : wx;
-					const float		triWy	= triNdx ? dstH - wy : wy;
-					const float		triNx	= triNdx ? 1.0f - nx : nx;
-					const float		triNy	= triNdx ? 1.0f - ny : ny;
-
-					const tcu::Vec2	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy));
-					const tcu::Vec2	coordDx		= tcu::Vec2(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-															triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy)) * srcSize.asFloat();
-					const tcu::Vec2	coordDy		= tcu::Vec2(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-															triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx)) * srcSize.asFloat();
-
-					tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDy.x(), coordDy.y(), lodPrec);
-
-					// Compute lod bounds across lodOffsets range.
-					for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-					{
-						const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-						const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-						const float		nxo		= wxo/dstW;
-						const float		nyo		= wyo/dstH;
-
-						const tcu::Vec2	coordDxo	= tcu::Vec2(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-																triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo)) * srcSize.asFloat();
-						const tcu::Vec2	coordDyo	= tcu::Vec2(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-																triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo)) * srcSize.asFloat();
-						const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDyo.x(), coordDyo.y(), lodPrec);
-
-						lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-						lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-					}
-
-					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
-
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red().toVec(), px, py);
-					numFailed += 1;
-				}
+				m_errorMask.setPixel(tcu::RGBA::red().toVec(), px, py);
+				m_rowNumFailed[py] += 1;
 			}
 		}
 	}
-
-	return numFailed;
 }
 
-bool verifyTextureResult (tcu::TestContext&						testCtx,
-						  const tcu::ConstPixelBufferAccess&	result,
-						  const tcu::Texture1DView&				src,
-						  const float*							texCoord,
-						  const ReferenceParams&				sampleParams,
-						  const tcu::LookupPrecision&			lookupPrec,
-						  const tcu::LodPrecision&				lodPrec,
-						  const tcu::PixelFormat&				pixelFormat)
+int LookupDiffRowWork::getNumFailed (void) const
 {
-	tcu::TestLog&	log				= testCtx.getLog();
-	tcu::Surface	reference		(result.getWidth(), result.getHeight());
-	tcu::Surface	errorMask		(result.getWidth(), result.getHeight());
-	int				numFailedPixels;
-
-	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
-
-	sampleTexture(tcu::SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
-
-	if (numFailedPixels > 0)
-		log << tcu::TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << tcu::TestLog::EndMessage;
+	int numFailed = 0;
 
-	log << tcu::TestLog::ImageSet("VerifyResult", "Verification result")
-		<< tcu::TestLog::Image("Rendered", "Rendered image", result);
-
-	if (numFailedPixels > 0)
-	{
-		log << tcu::TestLog::Image("Reference", "Ideal reference image", reference)
-			<< tcu::TestLog::Image("ErrorMask", "Error mask", errorMask);
-	}
+	for (size_t rowNdx = 0; rowNdx < m_rowNumFailed.size(); rowNdx++)
+		numFailed += m_rowNumFailed[rowNdx];
 
-	log << tcu::TestLog::EndImageSet;
-
-	return numFailedPixels == 0;
+	return numFailed;
 }
 
-bool verifyTextureResult (tcu::TestContext&						testCtx,
-						  const tcu::ConstPixelBufferAccess&	result,
-						  const tcu::Texture2DView&				src,
-						  const float*							texCoord,
-						  const ReferenceParams&				sampleParams,
-						  const tcu::LookupPrecision&			lookupPrec,
-						  const tcu::LodPrecision&				lodPrec,
-						  const tcu::PixelFormat&				pixelFormat)
+template<typename TextureViewType>
+LookupColorBounds computeLookupColorBounds (const TextureViewType& src, const tcu::Sampler& sampler)
 {
-	tcu::TestLog&	log				= testCtx.getLog();
-	tcu::Surface	reference		(result.getWidth(), result.getHeight());
-	tcu::Surface	errorMask		(result.getWidth(), result.getHeight());
-	int				numFailedPixels;
+	LookupColorBounds bounds;
 
-	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
+	for (int levelNdx = 0; levelNdx < src.getNumLevels(); levelNdx++)
+		bounds.addLevel(src.getLevel(levelNdx));
 
-	sampleTexture(tcu::SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
+	if (src.getNumLevels() > 0)
+		bounds.addBorderColor(sampler, src.getLevel(0).getFormat());
 
-	if (numFailedPixels > 0)
-		log << tcu::TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << tcu::TestLog::EndMessage;
+	return bounds;
+}
 
-	log << tcu::TestLog::ImageSet("VerifyResult", "Verification result")
-		<< tcu::TestLog::Image("Rendered", "Rendered image", result);
+template<>
+LookupColorBounds computeLookupColorBounds (const tcu::TextureCubeView& src, const tcu::Sampler& sampler)
+{
+	LookupColorBounds bounds;
 
-	if (numFailedPixels > 0)
+	for (int levelNdx = 0; levelNdx < src.getNumLevels(); levelNdx++)
 	{
-		log << tcu::TestLog::Image("Reference", "Ideal reference image", reference)
-			<< tcu::TestLog::Image("ErrorMask", "Error mask", errorMask);
+		for (int face = 0; face < tcu::CUBEFACE_LAST; face++)
+			bounds.addLevel(src.getLevelFace(levelNdx, (tcu::CubeFace)face));
 	}
 
-	log << tcu::TestLog::EndImageSet;
+	if (src.getNumLevels() > 0)
+		bounds.addBorderColor(sampler, src.getLevelFace(0, tcu::CUBEFACE_NEGATIVE_X).getFormat());
 
-	return numFailedPixels == 0;
+	return bounds;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+template<typename TextureViewType>
+int computeLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::ConstPixelBufferAccess&	reference,
 							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::TextureCubeView&			baseView,
-							  const float*							texCoord,
+							  const TextureViewType&				src,
 							  const ReferenceParams&				sampleParams,
 							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
+							  const LookupPixelVerifier&			verifier,
 							  qpWatchDog*							watchDog)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
 
-	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
-	const tcu::TextureCubeView					src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
+	const LookupColorBounds	colorBounds	= s_lookupColorBoundsEnabled ? computeLookupColorBounds(src, sampleParams.sampler) : LookupColorBounds();
+	LookupDiffRowWork		work		(result, reference, errorMask, sampleParams, lookupPrec, colorBounds, verifier, watchDog);
 
-	const tcu::Vec4								sq					= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
-	const tcu::Vec4								tq					= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
-	const tcu::Vec4								rq					= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
+	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	tcu::executeParallel(work, result.getHeight());
 
-	const tcu::IVec2							dstSize				= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float									dstW				= float(dstSize.x());
-	const float									dstH				= float(dstSize.y());
-	const int									srcSize				= src.getSize();
+	return work.getNumFailed();
+}
 
-	// Coordinates per triangle.
-	const tcu::Vec3								triS[2]				= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triT[2]				= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triR[2]				= { rq.swizzle(0, 1, 2), rq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triW[2]				= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
+//! Common state for verifying lookups on a quad rendered as two triangles
+class TriangleLookupVerifier : public LookupPixelVerifier
+{
+protected:
+								TriangleLookupVerifier	(const float* texCoord, int numComps, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize);
+
+	const ReferenceParams&		m_sampleParams;
+	const tcu::LookupPrecision&	m_lookupPrec;
+	const tcu::LodPrecision&	m_lodPrec;
+	const float					m_dstW;
+	const float					m_dstH;
+	const tcu::Vec2				m_lodBias;
 
-	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
+	// Coordinates per triangle.
+	tcu::Vec3					m_triS[2];
+	tcu::Vec3					m_triT[2];
+	tcu::Vec3					m_triR[2];
+	tcu::Vec3					m_triQ[2];
+	tcu::Vec3					m_triW[2];
+};
 
-	const float									posEps				= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
+TriangleLookupVerifier::TriangleLookupVerifier (const float* texCoord, int numComps, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize)
+	: m_sampleParams	(sampleParams)
+	, m_lookupPrec		(lookupPrec)
+	, m_lodPrec			(lodPrec)
+	, m_dstW			(float(dstSize.x()))
+	, m_dstH			(float(dstSize.y()))
+	, m_lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f)
+{
+	tcu::Vec3* const triCoords[] = { m_triS, m_triT, m_triR, m_triQ };
 
-	int											numFailed			= 0;
+	DE_ASSERT(de::inRange(numComps, 1, DE_LENGTH_OF_ARRAY(triCoords)));
 
-	const tcu::Vec2 lodOffsets[] =
+	for (int compNdx = 0; compNdx < numComps; compNdx++)
 	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
+		const tcu::Vec4 cq = tcu::Vec4(texCoord[0*numComps + compNdx], texCoord[1*numComps + compNdx], texCoord[2*numComps + compNdx], texCoord[3*numComps + compNdx]);
 
-		// \note Not strictly allowed by spec, but implementations do this in practice.
-		tcu::Vec2(-1, -1),
-		tcu::Vec2(-1, +1),
-		tcu::Vec2(+1, -1),
-		tcu::Vec2(+1, +1),
-	};
+		triCoords[compNdx][0] = cq.swizzle(0, 1, 2);
+		triCoords[compNdx][1] = cq.swizzle(3, 2, 1);
+	}
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	m_triW[0] = sampleParams.w.swizzle(0, 1, 2);
+	m_triW[1] = sampleParams.w.swizzle(3, 2, 1);
+}
 
-	for (int py = 0; py < result.getHeight(); py++)
-	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
+class Texture1DLookupVerifier : public TriangleLookupVerifier
+{
+public:
+						Texture1DLookupVerifier	(const tcu::Texture1DView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize)
+							: TriangleLookupVerifier	(texCoord, 1, sampleParams, lookupPrec, lodPrec, dstSize)
+							, m_src						(src)
+							, m_srcSize					(src.getWidth())
+						{
+						}
 
-		for (int px = 0; px < result.getWidth(); px++)
-		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
+	bool				isPixelValid			(int px, int py, const tcu::Vec4& resPix) const;
 
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
+private:
+	const tcu::Texture1DView&	m_src;
+	const int					m_srcSize;
+};
 
-				const bool		tri0	= (wx-posEps)/dstW + (wy-posEps)/dstH <= 1.0f;
-				const bool		tri1	= (wx+posEps)/dstW + (wy+posEps)/dstH >= 1.0f;
+bool Texture1DLookupVerifier::isPixelValid (int px, int py, const tcu::Vec4& resPix) const
+{
+	const float		wx		= (float)px + 0.5f;
+	const float		wy		= (float)py + 0.5f;
+	const float		nx		= wx / m_dstW;
+	const float		ny		= wy / m_dstH;
 
-				bool			isOk	= false;
+	const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
+	const float		triWx	= triNdx ? m_dstW - wx : wx;
+	const float		triWy	= triNdx ? m_dstH - wy : wy;
+	const float		triNx	= triNdx ? 1.0f - nx : nx;
+	const float		triNy	= triNdx ? 1.0f - ny : ny;
 
-				DE_ASSERT(tri0 || tri1);
+	const float		coord		= projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy);
+	const float		coordDx		= triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy) * float(m_srcSize);
+	const float		coordDy		= triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx) * float(m_srcSize);
 
-				// Pixel can belong to either of the triangles if it lies close enough to the edge.
-				for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
-				{
-					const float		triWx	= triNdx ? dstW - wx : wx;
-					const float		triWy	= triNdx ? dstH - wy : wy;
-					const float		triNx	= triNdx ? 1.0f - nx : nx;
-					const float		triNy	= triNdx ? 1.0f - ny : ny;
-
-					const tcu::Vec3	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triR[triNdx], triW[triNdx], triNx, triNy));
-					const tcu::Vec3	coordDx		(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-												 triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy),
-												 triDerivateX(triR[triNdx], triW[triNdx], wx, dstW, triNy));
-					const tcu::Vec3	coordDy		(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-												 triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx),
-												 triDerivateY(triR[triNdx], triW[triNdx], wy, dstH, triNx));
-
-					tcu::Vec2		lodBounds	= tcu::computeCubeLodBoundsFromDerivates(coord, coordDx, coordDy, srcSize, lodPrec);
-
-					// Compute lod bounds across lodOffsets range.
-					for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-					{
-						const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-						const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-						const float		nxo		= wxo/dstW;
-						const float		nyo		= wyo/dstH;
-
-						const tcu::Vec3	coordO		(projectedTriInterpolate(triS[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triT[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triR[triNdx], triW[triNdx], nxo, nyo));
-						const tcu::Vec3	coordDxo	(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-													 triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo),
-													 triDerivateX(triR[triNdx], triW[triNdx], wxo, dstW, nyo));
-						const tcu::Vec3	coordDyo	(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-													 triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo),
-													 triDerivateY(triR[triNdx], triW[triNdx], wyo, dstH, nxo));
-						const tcu::Vec2	lodO		= tcu::computeCubeLodBoundsFromDerivates(coordO, coordDxo, coordDyo, srcSize, lodPrec);
-
-						lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-						lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-					}
-
-					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
+	tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx, coordDy, m_lodPrec);
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red().toVec(), px, py);
-					numFailed += 1;
-				}
-			}
+	// Compute lod bounds across lodOffsets range.
+	for (int lodOffsNdx = 0; lodOffsNdx < s_numAxisLodOffsets; lodOffsNdx++)
+	{
+		const float		wxo		= triWx + s_lodOffsets[lodOffsNdx].x();
+		const float		wyo		= triWy + s_lodOffsets[lodOffsNdx].y();
+		const float		nxo		= wxo/m_dstW;
+		const float		nyo		= wyo/m_dstH;
+
+		const float	coordDxo	= triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo) * float(m_srcSize);
+		const float	coordDyo	= triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo) * float(m_srcSize);
+		const tcu::Vec2	lodO	= tcu::computeLodBoundsFromDerivates(coordDxo, coordDyo, m_lodPrec);
+
+		lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+		lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+	}
+
+	const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+	const bool		isOk		= tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix);
+
+	return isOk;
+}
+
+class Texture2DLookupVerifier : public TriangleLookupVerifier
+{
+public:
+						Texture2DLookupVerifier	(const tcu::Texture2DView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize)
+							: TriangleLookupVerifier	(texCoord, 2, sampleParams, lookupPrec, lodPrec, dstSize)
+							, m_src						(src)
+							, m_srcSize					(src.getWidth(), src.getHeight())
+						{
+						}
+
+	bool				isPixelValid			(int px, int py, const tcu::Vec4& resPix) const;
+
+private:
+	const tcu::Texture2DView&	m_src;
+	const tcu::IVec2			m_srcSize;
+};
+
+bool Texture2DLookupVerifier::isPixelValid (int px, int py, const tcu::Vec4& resPix) const
+{
+	const float	posEps	= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
+
+	const float		wx		= (float)px + 0.5f;
+	const float		wy		= (float)py + 0.5f;
+	const float		nx		= wx / m_dstW;
+	const float		ny		= wy / m_dstH;
+
+	const bool		tri0	= (wx-posEps)/m_dstW + (wy-posEps)/m_dstH <= 1.0f;
+	const bool		tri1	= (wx+posEps)/m_dstW + (wy+posEps)/m_dstH >= 1.0f;
+
+	bool			isOk	= false;
+
+	DE_ASSERT(tri0 || tri1);
+
+	// Pixel can belong to either of the triangles if it lies close enough to the edge.
+	for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
+	{
+		const float		triWx	= triNdx ? m_dstW - wx : wx;
+		const float		triWy	= triNdx ? m_dstH - wy : wy;
+		const float		triNx	= triNdx ? 1.0f - nx : nx;
+		const float		triNy	= triNdx ? 1.0f - ny : ny;
+
+		const tcu::Vec2	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy));
+		const tcu::Vec2	coordDx		= tcu::Vec2(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+												triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy)) * m_srcSize.asFloat();
+		const tcu::Vec2	coordDy		= tcu::Vec2(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+												triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx)) * m_srcSize.asFloat();
+
+		tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDy.x(), coordDy.y(), m_lodPrec);
+
+		// Compute lod bounds across lodOffsets range.
+		for (int lodOffsNdx = 0; lodOffsNdx < s_numAxisLodOffsets; lodOffsNdx++)
+		{
+			const float		wxo		= triWx + s_lodOffsets[lodOffsNdx].x();
+			const float		wyo		= triWy + s_lodOffsets[lodOffsNdx].y();
+			const float		nxo		= wxo/m_dstW;
+			const float		nyo		= wyo/m_dstH;
+
+			const tcu::Vec2	coordDxo	= tcu::Vec2(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+													triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo)) * m_srcSize.asFloat();
+			const tcu::Vec2	coordDyo	= tcu::Vec2(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+													triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo)) * m_srcSize.asFloat();
+			const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDyo.x(), coordDyo.y(), m_lodPrec);
+
+			lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+			lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+		}
+
+		const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+		if (tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix))
+		{
+			isOk = true;
+			break;
 		}
 	}
 
-	return numFailed;
+	return isOk;
+}
+
+class TextureCubeLookupVerifier : public TriangleLookupVerifier
+{
+public:
+						TextureCubeLookupVerifier	(const tcu::TextureCubeView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize)
+							: TriangleLookupVerifier	(texCoord, 3, sampleParams, lookupPrec, lodPrec, dstSize)
+							, m_src						(src)
+							, m_srcSize					(src.getSize())
+						{
+						}
+
+	bool				isPixelValid			(int px, int py, const tcu::Vec4& resPix) const;
+
+private:
+	const tcu::TextureCubeView&	m_src;
+	const int					m_srcSize;
+};
+
+bool TextureCubeLookupVerifier::isPixelValid (int px, int py, const tcu::Vec4& resPix) const
+{
+	const float	posEps	= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
+
+	const float		wx		= (float)px + 0.5f;
+	const float		wy		= (float)py + 0.5f;
+	const float		nx		= wx / m_dstW;
+	const float		ny		= wy / m_dstH;
+
+	const bool		tri0	= (wx-posEps)/m_dstW + (wy-posEps)/m_dstH <= 1.0f;
+	const bool		tri1	= (wx+posEps)/m_dstW + (wy+posEps)/m_dstH >= 1.0f;
+
+	bool			isOk	= false;
+
+	DE_ASSERT(tri0 || tri1);
+
+	// Pixel can belong to either of the triangles if it lies close enough to the edge.
+	for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
+	{
+		const float		triWx	= triNdx ? m_dstW - wx : wx;
+		const float		triWy	= triNdx ? m_dstH - wy : wy;
+		const float		triNx	= triNdx ? 1.0f - nx : nx;
+		const float		triNy	= triNdx ? 1.0f - ny : ny;
+
+		const tcu::Vec3	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], triNx, triNy));
+		const tcu::Vec3	coordDx		(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+									 triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+									 triDerivateX(m_triR[triNdx], m_triW[triNdx], wx, m_dstW, triNy));
+		const tcu::Vec3	coordDy		(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+									 triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+									 triDerivateY(m_triR[triNdx], m_triW[triNdx], wy, m_dstH, triNx));
+
+		tcu::Vec2		lodBounds	= tcu::computeCubeLodBoundsFromDerivates(coord, coordDx, coordDy, m_srcSize, m_lodPrec);
+
+		// Compute lod bounds across lodOffsets range.
+		for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(s_lodOffsets); lodOffsNdx++)
+		{
+			const float		wxo		= triWx + s_lodOffsets[lodOffsNdx].x();
+			const float		wyo		= triWy + s_lodOffsets[lodOffsNdx].y();
+			const float		nxo		= wxo/m_dstW;
+			const float		nyo		= wyo/m_dstH;
+
+			const tcu::Vec3	coordO		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], nxo, nyo),
+										 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], nxo, nyo),
+										 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], nxo, nyo));
+			const tcu::Vec3	coordDxo	(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+										 triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+										 triDerivateX(m_triR[triNdx], m_triW[triNdx], wxo, m_dstW, nyo));
+			const tcu::Vec3	coordDyo	(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+										 triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+										 triDerivateY(m_triR[triNdx], m_triW[triNdx], wyo, m_dstH, nxo));
+			const tcu::Vec2	lodO		= tcu::computeCubeLodBoundsFromDerivates(coordO, coordDxo, coordDyo, m_srcSize, m_lodPrec);
+
+			lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+			lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+		}
+
+		const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+
+		if (tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix))
+		{
+			isOk = true;
+			break;
+		}
+	}
+
+	return isOk;
+}
+
+class Texture3DLookupVerifier : public TriangleLookupVerifier
+{
+public:
+						Texture3DLookupVerifier	(const tcu::Texture3DView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize)
+							: TriangleLookupVerifier	(texCoord, 3, sampleParams, lookupPrec, lodPrec, dstSize)
+							, m_src						(src)
+							, m_srcSize					(src.getWidth(), src.getHeight(), src.getDepth())
+						{
+						}
+
+	bool				isPixelValid			(int px, int py, const tcu::Vec4& resPix) const;
+
+private:
+	const tcu::Texture3DView&	m_src;
+	const tcu::IVec3			m_srcSize;
+};
+
+bool Texture3DLookupVerifier::isPixelValid (int px, int py, const tcu::Vec4& resPix) const
+{
+	const float	posEps	= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
+
+	const float		wx		= (float)px + 0.5f;
+	const float		wy		= (float)py + 0.5f;
+	const float		nx		= wx / m_dstW;
+	const float		ny		= wy / m_dstH;
+
+	const bool		tri0	= (wx-posEps)/m_dstW + (wy-posEps)/m_dstH <= 1.0f;
+	const bool		tri1	= (wx+posEps)/m_dstW + (wy+posEps)/m_dstH >= 1.0f;
+
+	bool			isOk	= false;
+
+	DE_ASSERT(tri0 || tri1);
+
+	// Pixel can belong to either of the triangles if it lies close enough to the edge.
+	for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
+	{
+		const float		triWx	= triNdx ? m_dstW - wx : wx;
+		const float		triWy	= triNdx ? m_dstH - wy : wy;
+		const float		triNx	= triNdx ? 1.0f - nx : nx;
+		const float		triNy	= triNdx ? 1.0f - ny : ny;
+
+		const tcu::Vec3	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], triNx, triNy));
+		const tcu::Vec3	coordDx		= tcu::Vec3(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+												triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+												triDerivateX(m_triR[triNdx], m_triW[triNdx], wx, m_dstW, triNy)) * m_srcSize.asFloat();
+		const tcu::Vec3	coordDy		= tcu::Vec3(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+												triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+												triDerivateY(m_triR[triNdx], m_triW[triNdx], wy, m_dstH, triNx)) * m_srcSize.asFloat();
+
+		tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDx.z(), coordDy.x(), coordDy.y(), coordDy.z(), m_lodPrec);
+
+		// Compute lod bounds across lodOffsets range.
+		for (int lodOffsNdx = 0; lodOffsNdx < s_numAxisLodOffsets; lodOffsNdx++)
+		{
+			const float		wxo		= triWx + s_lodOffsets[lodOffsNdx].x();
+			const float		wyo		= triWy + s_lodOffsets[lodOffsNdx].y();
+			const float		nxo		= wxo/m_dstW;
+			const float		nyo		= wyo/m_dstH;
+
+			const tcu::Vec3	coordDxo	= tcu::Vec3(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+													triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+													triDerivateX(m_triR[triNdx], m_triW[triNdx], wxo, m_dstW, nyo)) * m_srcSize.asFloat();
+			const tcu::Vec3	coordDyo	= tcu::Vec3(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+													triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+													triDerivateY(m_triR[triNdx], m_triW[triNdx], wyo, m_dstH, nxo)) * m_srcSize.asFloat();
+			const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDxo.z(), coordDyo.x(), coordDyo.y(), coordDyo.z(), m_lodPrec);
+
+			lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+			lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+		}
+
+		const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+
+		if (tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix))
+		{
+			isOk = true;
+			break;
+		}
+	}
+
+	return isOk;
+}
+
+class Texture1DArrayLookupVerifier : public TriangleLookupVerifier
+{
+public:
+						Texture1DArrayLookupVerifier	(const tcu::Texture1DArrayView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize)
+							: TriangleLookupVerifier	(texCoord, 2, sampleParams, lookupPrec, lodPrec, dstSize)
+							, m_src						(src)
+							, m_srcSize					(float(src.getWidth()))
+						{
+						}
+
+	bool				isPixelValid			(int px, int py, const tcu::Vec4& resPix) const;
+
+private:
+	const tcu::Texture1DArrayView&	m_src;
+	const float						m_srcSize;
+};
+
+bool Texture1DArrayLookupVerifier::isPixelValid (int px, int py, const tcu::Vec4& resPix) const
+{
+	const float		wx		= (float)px + 0.5f;
+	const float		wy		= (float)py + 0.5f;
+	const float		nx		= wx / m_dstW;
+	const float		ny		= wy / m_dstH;
+
+	const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
+	const float		triWx	= triNdx ? m_dstW - wx : wx;
+	const float		triWy	= triNdx ? m_dstH - wy : wy;
+	const float		triNx	= triNdx ? 1.0f - nx : nx;
+	const float		triNy	= triNdx ? 1.0f - ny : ny;
+
+	const tcu::Vec2	coord	(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+							 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy));
+	const float	coordDx		= triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy) * m_srcSize;
+	const float	coordDy		= triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx) * m_srcSize;
+
+	tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx, coordDy, m_lodPrec);
+
+	// Compute lod bounds across lodOffsets range.
+	for (int lodOffsNdx = 0; lodOffsNdx < s_numAxisLodOffsets; lodOffsNdx++)
+	{
+		const float		wxo		= triWx + s_lodOffsets[lodOffsNdx].x();
+		const float		wyo		= triWy + s_lodOffsets[lodOffsNdx].y();
+		const float		nxo		= wxo/m_dstW;
+		const float		nyo		= wyo/m_dstH;
+
+		const float	coordDxo		= triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo) * m_srcSize;
+		const float	coordDyo		= triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo) * m_srcSize;
+		const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo, coordDyo, m_lodPrec);
+
+		lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+		lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+	}
+
+	const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+	const bool		isOk		= tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix);
+
+	return isOk;
+}
+
+class Texture2DArrayLookupVerifier : public TriangleLookupVerifier
+{
+public:
+						Texture2DArrayLookupVerifier	(const tcu::Texture2DArrayView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize)
+							: TriangleLookupVerifier	(texCoord, 3, sampleParams, lookupPrec, lodPrec, dstSize)
+							, m_src						(src)
+							, m_srcSize					(tcu::IVec2(src.getWidth(), src.getHeight()).asFloat())
+						{
+						}
+
+	bool				isPixelValid			(int px, int py, const tcu::Vec4& resPix) const;
+
+private:
+	const tcu::Texture2DArrayView&	m_src;
+	const tcu::Vec2					m_srcSize;
+};
+
+bool Texture2DArrayLookupVerifier::isPixelValid (int px, int py, const tcu::Vec4& resPix) const
+{
+	const float		wx		= (float)px + 0.5f;
+	const float		wy		= (float)py + 0.5f;
+	const float		nx		= wx / m_dstW;
+	const float		ny		= wy / m_dstH;
+
+	const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
+	const float		triWx	= triNdx ? m_dstW - wx : wx;
+	const float		triWy	= triNdx ? m_dstH - wy : wy;
+	const float		triNx	= triNdx ? 1.0f - nx : nx;
+	const float		triNy	= triNdx ? 1.0f - ny : ny;
+
+	const tcu::Vec3	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+								 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy),
+								 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], triNx, triNy));
+	const tcu::Vec2	coordDx		= tcu::Vec2(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+											triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy)) * m_srcSize;
+	const tcu::Vec2	coordDy		= tcu::Vec2(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+											triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx)) * m_srcSize;
+
+	tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDy.x(), coordDy.y(), m_lodPrec);
+
+	// Compute lod bounds across lodOffsets range.
+	for (int lodOffsNdx = 0; lodOffsNdx < s_numAxisLodOffsets; lodOffsNdx++)
+	{
+		const float		wxo		= triWx + s_lodOffsets[lodOffsNdx].x();
+		const float		wyo		= triWy + s_lodOffsets[lodOffsNdx].y();
+		const float		nxo		= wxo/m_dstW;
+		const float		nyo		= wyo/m_dstH;
+
+		const tcu::Vec2	coordDxo	= tcu::Vec2(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+												triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo)) * m_srcSize;
+		const tcu::Vec2	coordDyo	= tcu::Vec2(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+												triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo)) * m_srcSize;
+		const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDyo.x(), coordDyo.y(), m_lodPrec);
+
+		lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+		lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+	}
+
+	const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+	const bool		isOk		= tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix);
+
+	return isOk;
+}
+
+class TextureCubeArrayLookupVerifier : public TriangleLookupVerifier
+{
+public:
+						TextureCubeArrayLookupVerifier	(const tcu::TextureCubeArrayView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::IVec4& coordBits, const tcu::LodPrecision& lodPrec, const tcu::IVec2& dstSize)
+							: TriangleLookupVerifier	(texCoord, 4, sampleParams, lookupPrec, lodPrec, dstSize)
+							, m_src						(src)
+							, m_srcSize					(src.getSize())
+							, m_coordBits				(coordBits)
+						{
+						}
+
+	bool				isPixelValid			(int px, int py, const tcu::Vec4& resPix) const;
+
+private:
+	const tcu::TextureCubeArrayView&	m_src;
+	const int							m_srcSize;
+	const tcu::IVec4					m_coordBits;
+};
+
+bool TextureCubeArrayLookupVerifier::isPixelValid (int px, int py, const tcu::Vec4& resPix) const
+{
+	const float	posEps	= 1.0f / float((1<<4) + 1); // ES3 requires at least 4 subpixel bits.
+
+	const float		wx		= (float)px + 0.5f;
+	const float		wy		= (float)py + 0.5f;
+	const float		nx		= wx / m_dstW;
+	const float		ny		= wy / m_dstH;
+
+	const bool		tri0	= nx + ny - posEps <= 1.0f;
+	const bool		tri1	= nx + ny + posEps >= 1.0f;
+
+	bool			isOk	= false;
+
+	DE_ASSERT(tri0 || tri1);
+
+	// Pixel can belong to either of the triangles if it lies close enough to the edge.
+	for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
+	{
+		const float		triWx		= triNdx ? m_dstW - wx : wx;
+		const float		triWy		= triNdx ? m_dstH - wy : wy;
+		const float		triNx		= triNdx ? 1.0f - nx : nx;
+		const float		triNy		= triNdx ? 1.0f - ny : ny;
+
+		const tcu::Vec4	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triQ[triNdx], m_triW[triNdx], triNx, triNy));
+		const tcu::Vec3	coordDx		(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+									 triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+									 triDerivateX(m_triR[triNdx], m_triW[triNdx], wx, m_dstW, triNy));
+		const tcu::Vec3	coordDy		(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+									 triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+									 triDerivateY(m_triR[triNdx], m_triW[triNdx], wy, m_dstH, triNx));
+
+		tcu::Vec2		lodBounds	= tcu::computeCubeLodBoundsFromDerivates(coord.toWidth<3>(), coordDx, coordDy, m_srcSize, m_lodPrec);
+
+		// Compute lod bounds across lodOffsets range.
+		for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(s_lodOffsets); lodOffsNdx++)
+		{
+			const float		wxo			= triWx + s_lodOffsets[lodOffsNdx].x();
+			const float		wyo			= triWy + s_lodOffsets[lodOffsNdx].y();
+			const float		nxo			= wxo/m_dstW;
+			const float		nyo			= wyo/m_dstH;
+
+			const tcu::Vec3	coordO		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], nxo, nyo),
+										 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], nxo, nyo),
+										 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], nxo, nyo));
+			const tcu::Vec3	coordDxo	(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+										 triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+										 triDerivateX(m_triR[triNdx], m_triW[triNdx], wxo, m_dstW, nyo));
+			const tcu::Vec3	coordDyo	(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+										 triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+										 triDerivateY(m_triR[triNdx], m_triW[triNdx], wyo, m_dstH, nxo));
+			const tcu::Vec2	lodO		= tcu::computeCubeLodBoundsFromDerivates(coordO, coordDxo, coordDyo, m_srcSize, m_lodPrec);
+
+			lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+			lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+		}
+
+		const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+
+		if (tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, m_coordBits, coord, clampedLod, resPix))
+		{
+			isOk = true;
+			break;
+		}
+	}
+
+	return isOk;
+}
+} // anonymous
+
+void setLookupColorBoundsEnabled (bool enabled)
+{
+	s_lookupColorBoundsEnabled = enabled;
+}
+
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture1DView&				baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
+	const tcu::Texture1DView					src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
+	const Texture1DLookupVerifier				verifier			(src, texCoord, sampleParams, lookupPrec, lodPrec, tcu::IVec2(result.getWidth(), result.getHeight()));
+
+	return computeLookupDiff(result, reference, errorMask, src, sampleParams, lookupPrec, verifier, watchDog);
+}
+
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture2DView&				baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
+	const tcu::Texture2DView					src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
+	const Texture2DLookupVerifier				verifier			(src, texCoord, sampleParams, lookupPrec, lodPrec, tcu::IVec2(result.getWidth(), result.getHeight()));
+
+	return computeLookupDiff(result, reference, errorMask, src, sampleParams, lookupPrec, verifier, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
 						  const tcu::ConstPixelBufferAccess&	result,
-						  const tcu::TextureCubeView&			src,
+						  const tcu::Texture1DView&				src,
+						  const float*							texCoord,
+						  const ReferenceParams&				sampleParams,
+						  const tcu::LookupPrecision&			lookupPrec,
+						  const tcu::LodPrecision&				lodPrec,
+						  const tcu::PixelFormat&				pixelFormat)
+{
+	tcu::TestLog&	log				= testCtx.getLog();
+	tcu::Surface	reference		(result.getWidth(), result.getHeight());
+	tcu::Surface	errorMask		(result.getWidth(), result.getHeight());
+	int				numFailedPixels;
+
+	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
+
+	sampleTexture(tcu::SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
+
+	if (numFailedPixels > 0)
+		log << tcu::TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << tcu::TestLog::EndMessage;
+
+	log << tcu::TestLog::ImageSet("VerifyResult", "Verification result")
+		<< tcu::TestLog::Image("Rendered", "Rendered image", result);
+
+	if (numFailedPixels > 0)
+	{
+		log << tcu::TestLog::Image("Reference", "Ideal reference image", reference)
+			<< tcu::TestLog::Image("ErrorMask", "Error mask", errorMask);
+	}
+
+	log << tcu::TestLog::EndImageSet;
+
+	return numFailedPixels == 0;
+}
+
+bool verifyTextureResult (tcu::TestContext&						testCtx,
+						  const tcu::ConstPixelBufferAccess&	result,
+						  const tcu::Texture2DView&				src,
 						  const float*							texCoord,
 						  const ReferenceParams&				sampleParams,
 						  const tcu::LookupPrecision&			lookupPrec,
@@ -1707,135 +2193,72 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::ConstPixelBufferAccess&	reference,
 							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture3DView&				baseView,
+							  const tcu::TextureCubeView&			baseView,
 							  const float*							texCoord,
 							  const ReferenceParams&				sampleParams,
 							  const tcu::LookupPrecision&			lookupPrec,
 							  const tcu::LodPrecision&				lodPrec,
 							  qpWatchDog*							watchDog)
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
-
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
-	const tcu::Texture3DView					src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
-
-	const tcu::Vec4								sq					= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
-	const tcu::Vec4								tq					= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
-	const tcu::Vec4								rq					= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
-
-	const tcu::IVec2							dstSize				= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float									dstW				= float(dstSize.x());
-	const float									dstH				= float(dstSize.y());
-	const tcu::IVec3							srcSize				= tcu::IVec3(src.getWidth(), src.getHeight(), src.getDepth());
+	const tcu::TextureCubeView					src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
+	const TextureCubeLookupVerifier				verifier			(src, texCoord, sampleParams, lookupPrec, lodPrec, tcu::IVec2(result.getWidth(), result.getHeight()));
 
-	// Coordinates and lod per triangle.
-	const tcu::Vec3								triS[2]				= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triT[2]				= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triR[2]				= { rq.swizzle(0, 1, 2), rq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triW[2]				= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
+	return computeLookupDiff(result, reference, errorMask, src, sampleParams, lookupPrec, verifier, watchDog);
+}
 
-	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
+bool verifyTextureResult (tcu::TestContext&						testCtx,
+						  const tcu::ConstPixelBufferAccess&	result,
+						  const tcu::TextureCubeView&			src,
+						  const float*							texCoord,
+						  const ReferenceParams&				sampleParams,
+						  const tcu::LookupPrecision&			lookupPrec,
+						  const tcu::LodPrecision&				lodPrec,
+						  const tcu::PixelFormat&				pixelFormat)
+{
+	tcu::TestLog&	log				= testCtx.getLog();
+	tcu::Surface	reference		(result.getWidth(), result.getHeight());
+	tcu::Surface	errorMask		(result.getWidth(), result.getHeight());
+	int				numFailedPixels;
 
-	const float									posEps				= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
+	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
 
-	int											numFailed			= 0;
+	sampleTexture(tcu::SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
 
-	const tcu::Vec2 lodOffsets[] =
-	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
+	if (numFailedPixels > 0)
+		log << tcu::TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << tcu::TestLog::EndMessage;
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	log << tcu::TestLog::ImageSet("VerifyResult", "Verification result")
+		<< tcu::TestLog::Image("Rendered", "Rendered image", result);
 
-	for (int py = 0; py < result.getHeight(); py++)
+	if (numFailedPixels > 0)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
-		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
-
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
-
-				const bool		tri0	= (wx-posEps)/dstW + (wy-posEps)/dstH <= 1.0f;
-				const bool		tri1	= (wx+posEps)/dstW + (wy+posEps)/dstH >= 1.0f;
-
-				bool			isOk	= false;
+		log << tcu::TestLog::Image("Reference", "Ideal reference image", reference)
+			<< tcu::TestLog::Image("ErrorMask", "Error mask", errorMask);
+	}
 
-				DE_ASSERT(tri0 || tri1);
+	log << tcu::TestLog::EndImageSet;
 
-				// Pixel can belong to either of the triangles if it lies close enough to the edge.
-				for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
-				{
-					const float		triWx	= triNdx ? dstW - wx : wx;
-					const float		triWy	= triNdx ? dstH - wy : wy;
-					const float		triNx	= triNdx ? 1.0f - nx : nx;
-					const float		triNy	= triNdx ? 1.0f - ny : ny;
-
-					const tcu::Vec3	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triR[triNdx], triW[triNdx], triNx, triNy));
-					const tcu::Vec3	coordDx		= tcu::Vec3(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-															triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy),
-															triDerivateX(triR[triNdx], triW[triNdx], wx, dstW, triNy)) * srcSize.asFloat();
-					const tcu::Vec3	coordDy		= tcu::Vec3(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-															triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx),
-															triDerivateY(triR[triNdx], triW[triNdx], wy, dstH, triNx)) * srcSize.asFloat();
-
-					tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDx.z(), coordDy.x(), coordDy.y(), coordDy.z(), lodPrec);
-
-					// Compute lod bounds across lodOffsets range.
-					for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-					{
-						const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-						const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-						const float		nxo		= wxo/dstW;
-						const float		nyo		= wyo/dstH;
-
-						const tcu::Vec3	coordDxo	= tcu::Vec3(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-																triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo),
-																triDerivateX(triR[triNdx], triW[triNdx], wxo, dstW, nyo)) * srcSize.asFloat();
-						const tcu::Vec3	coordDyo	= tcu::Vec3(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-																triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo),
-																triDerivateY(triR[triNdx], triW[triNdx], wyo, dstH, nxo)) * srcSize.asFloat();
-						const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDxo.z(), coordDyo.x(), coordDyo.y(), coordDyo.z(), lodPrec);
-
-						lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-						lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-					}
-
-					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
+	return numFailedPixels == 0;
+}
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red().toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
-	}
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture3DView&				baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
+	const tcu::Texture3DView					src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
+	const Texture3DLookupVerifier				verifier			(src, texCoord, sampleParams, lookupPrec, lodPrec, tcu::IVec2(result.getWidth(), result.getHeight()));
 
-	return numFailed;
+	return computeLookupDiff(result, reference, errorMask, src, sampleParams, lookupPrec, verifier, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -1885,100 +2308,11 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::LodPrecision&				lodPrec,
 							  qpWatchDog*							watchDog)
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
-
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture1DArrayView				src					= getEffectiveTextureView(baseView, srcLevelStorage, sampleParams.sampler);
+	const Texture1DArrayLookupVerifier			verifier			(src, texCoord, sampleParams, lookupPrec, lodPrec, tcu::IVec2(result.getWidth(), result.getHeight()));
 
-	const tcu::Vec4								sq					= tcu::Vec4(texCoord[0+0], texCoord[2+0], texCoord[4+0], texCoord[6+0]);
-	const tcu::Vec4								tq					= tcu::Vec4(texCoord[0+1], texCoord[2+1], texCoord[4+1], texCoord[6+1]);
-
-	const tcu::IVec2							dstSize				= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float									dstW				= float(dstSize.x());
-	const float									dstH				= float(dstSize.y());
-	const float									srcSize				= float(src.getWidth()); // For lod computation, thus #layers is ignored.
-
-	// Coordinates and lod per triangle.
-	const tcu::Vec3								triS[2]				= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triT[2]				= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triW[2]				= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
-
-	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
-
-	int											numFailed			= 0;
-
-	const tcu::Vec2 lodOffsets[] =
-	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
-
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
-	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
-		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
-
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
-
-				const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
-				const float		triWx	= triNdx ? dstW - wx : wx;
-				const float		triWy	= triNdx ? dstH - wy : wy;
-				const float		triNx	= triNdx ? 1.0f - nx : nx;
-				const float		triNy	= triNdx ? 1.0f - ny : ny;
-
-				const tcu::Vec2	coord	(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-										 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy));
-				const float	coordDx		= triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy) * srcSize;
-				const float	coordDy		= triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx) * srcSize;
-
-				tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx, coordDy, lodPrec);
-
-				// Compute lod bounds across lodOffsets range.
-				for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-				{
-					const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-					const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-					const float		nxo		= wxo/dstW;
-					const float		nyo		= wyo/dstH;
-
-					const float	coordDxo		= triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo) * srcSize;
-					const float	coordDyo		= triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo) * srcSize;
-					const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo, coordDyo, lodPrec);
-
-					lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-					lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-				}
-
-				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
-
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red().toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
-	}
-
-	return numFailed;
+	return computeLookupDiff(result, reference, errorMask, src, sampleParams, lookupPrec, verifier, watchDog);
 }
 
 //! Verifies texture lookup results and returns number of failed pixels.
@@ -1992,107 +2326,11 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::LodPrecision&				lodPrec,
 							  qpWatchDog*							watchDog)
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
-
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::Texture2DArrayView				src					= getEffectiveTextureView(baseView, srcLevelStorage, sampleParams.sampler);
+	const Texture2DArrayLookupVerifier			verifier			(src, texCoord, sampleParams, lookupPrec, lodPrec, tcu::IVec2(result.getWidth(), result.getHeight()));
 
-	const tcu::Vec4								sq					= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
-	const tcu::Vec4								tq					= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
-	const tcu::Vec4								rq					= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
-
-	const tcu::IVec2							dstSize				= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float									dstW				= float(dstSize.x());
-	const float									dstH				= float(dstSize.y());
-	const tcu::Vec2								srcSize				= tcu::IVec2(src.getWidth(), src.getHeight()).asFloat(); // For lod computation, thus #layers is ignored.
-
-	// Coordinates and lod per triangle.
-	const tcu::Vec3								triS[2]				= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triT[2]				= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triR[2]				= { rq.swizzle(0, 1, 2), rq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triW[2]				= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
-
-	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
-
-	int											numFailed			= 0;
-
-	const tcu::Vec2 lodOffsets[] =
-	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
-
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
-	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
-		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
-
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
-
-				const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
-				const float		triWx	= triNdx ? dstW - wx : wx;
-				const float		triWy	= triNdx ? dstH - wy : wy;
-				const float		triNx	= triNdx ? 1.0f - nx : nx;
-				const float		triNy	= triNdx ? 1.0f - ny : ny;
-
-				const tcu::Vec3	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-											 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy),
-											 projectedTriInterpolate(triR[triNdx], triW[triNdx], triNx, triNy));
-				const tcu::Vec2	coordDx		= tcu::Vec2(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-														triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy)) * srcSize;
-				const tcu::Vec2	coordDy		= tcu::Vec2(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-														triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx)) * srcSize;
-
-				tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDy.x(), coordDy.y(), lodPrec);
-
-				// Compute lod bounds across lodOffsets range.
-				for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-				{
-					const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-					const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-					const float		nxo		= wxo/dstW;
-					const float		nyo		= wyo/dstH;
-
-					const tcu::Vec2	coordDxo	= tcu::Vec2(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-															triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo)) * srcSize;
-					const tcu::Vec2	coordDyo	= tcu::Vec2(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-															triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo)) * srcSize;
-					const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDyo.x(), coordDyo.y(), lodPrec);
-
-					lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-					lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-				}
-
-				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
-
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red().toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
-	}
-
-	return numFailed;
+	return computeLookupDiff(result, reference, errorMask, src, sampleParams, lookupPrec, verifier, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -2179,140 +2417,11 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::LodPrecision&				lodPrec,
 							  qpWatchDog*							watchDog)
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
-
 	std::vector<tcu::ConstPixelBufferAccess>	srcLevelStorage;
 	const tcu::TextureCubeArrayView				src					= getEffectiveTextureView(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel), srcLevelStorage, sampleParams.sampler);
+	const TextureCubeArrayLookupVerifier		verifier			(src, texCoord, sampleParams, lookupPrec, coordBits, lodPrec, tcu::IVec2(result.getWidth(), result.getHeight()));
 
-	const tcu::Vec4								sq					= tcu::Vec4(texCoord[0+0], texCoord[4+0], texCoord[8+0], texCoord[12+0]);
-	const tcu::Vec4								tq					= tcu::Vec4(texCoord[0+1], texCoord[4+1], texCoord[8+1], texCoord[12+1]);
-	const tcu::Vec4								rq					= tcu::Vec4(texCoord[0+2], texCoord[4+2], texCoord[8+2], texCoord[12+2]);
-	const tcu::Vec4								qq					= tcu::Vec4(texCoord[0+3], texCoord[4+3], texCoord[8+3], texCoord[12+3]);
-
-	const tcu::IVec2							dstSize				= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float									dstW				= float(dstSize.x());
-	const float									dstH				= float(dstSize.y());
-	const int									srcSize				= src.getSize();
-
-	// Coordinates per triangle.
-	const tcu::Vec3								triS[2]				= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triT[2]				= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triR[2]				= { rq.swizzle(0, 1, 2), rq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triQ[2]				= { qq.swizzle(0, 1, 2), qq.swizzle(3, 2, 1) };
-	const tcu::Vec3								triW[2]				= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
-
-	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
-
-	const float									posEps				= 1.0f / float((1<<4) + 1); // ES3 requires at least 4 subpixel bits.
-
-	int											numFailed			= 0;
-
-	const tcu::Vec2 lodOffsets[] =
-	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-
-		// \note Not strictly allowed by spec, but implementations do this in practice.
-		tcu::Vec2(-1, -1),
-		tcu::Vec2(-1, +1),
-		tcu::Vec2(+1, -1),
-		tcu::Vec2(+1, +1),
-	};
-
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
-	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
-		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
-
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
-
-				const bool		tri0	= nx + ny - posEps <= 1.0f;
-				const bool		tri1	= nx + ny + posEps >= 1.0f;
-
-				bool			isOk	= false;
-
-				DE_ASSERT(tri0 || tri1);
-
-				// Pixel can belong to either of the triangles if it lies close enough to the edge.
-				for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
-				{
-					const float		triWx		= triNdx ? dstW - wx : wx;
-					const float		triWy		= triNdx ? dstH - wy : wy;
-					const float		triNx		= triNdx ? 1.0f - nx : nx;
-					const float		triNy		= triNdx ? 1.0f - ny : ny;
-
-					const tcu::Vec4	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triR[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triQ[triNdx], triW[triNdx], triNx, triNy));
-					const tcu::Vec3	coordDx		(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-												 triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy),
-												 triDerivateX(triR[triNdx], triW[triNdx], wx, dstW, triNy));
-					const tcu::Vec3	coordDy		(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-												 triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx),
-												 triDerivateY(triR[triNdx], triW[triNdx], wy, dstH, triNx));
-
-					tcu::Vec2		lodBounds	= tcu::computeCubeLodBoundsFromDerivates(coord.toWidth<3>(), coordDx, coordDy, srcSize, lodPrec);
-
-					// Compute lod bounds across lodOffsets range.
-					for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-					{
-						const float		wxo			= triWx + lodOffsets[lodOffsNdx].x();
-						const float		wyo			= triWy + lodOffsets[lodOffsNdx].y();
-						const float		nxo			= wxo/dstW;
-						const float		nyo			= wyo/dstH;
-
-						const tcu::Vec3	coordO		(projectedTriInterpolate(triS[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triT[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triR[triNdx], triW[triNdx], nxo, nyo));
-						const tcu::Vec3	coordDxo	(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-													 triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo),
-													 triDerivateX(triR[triNdx], triW[triNdx], wxo, dstW, nyo));
-						const tcu::Vec3	coordDyo	(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-													 triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo),
-													 triDerivateY(triR[triNdx], triW[triNdx], wyo, dstH, nxo));
-						const tcu::Vec2	lodO		= tcu::computeCubeLodBoundsFromDerivates(coordO, coordDxo, coordDyo, srcSize, lodPrec);
-
-						lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-						lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-					}
-
-					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coordBits, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
-
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red().toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
-	}
-
-	return numFailed;
+	return computeLookupDiff(result, reference, errorMask, src, sampleParams, lookupPrec, verifier, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
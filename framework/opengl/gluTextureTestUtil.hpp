@@ -183,6 +183,9 @@ bool			compareImages				(tcu::TestLog& log, const char* name, const char* desc,
 bool			compareImages				(tcu::TestLog& log, const tcu::Surface& reference, const tcu::Surface& rendered, tcu::RGBA threshold);
 int				measureAccuracy				(tcu::TestLog& log, const tcu::Surface& reference, const tcu::Surface& rendered, int bestScoreDiff, int worstScoreDiff);
 
+//! Enable or disable rejecting result pixels outside the texture's color range before the full lookup search in computeTextureLookupDiff().
+void			setLookupColorBoundsEnabled	(bool enabled);
+
 int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const tcu::ConstPixelBufferAccess&	reference,
 											 const tcu::PixelBufferAccess&		errorMask,
@@ -235,6 +235,30 @@ static inline tcu::IVec4 getBufferRect (const rr::MultisampleConstPixelBufferAcc
 	return tcu::IVec4(0, 0, access.raw().getHeight(), access.raw().getDepth());
 }
 
+//! Copy (resolved) pixels from src rectangle to dst starting at (dstX, dstY). Pixels outside src are left untouched.
+static void copyFromColorbuffer (const tcu::PixelBufferAccess& dst, int dstX, int dstY, const rr::MultisampleConstPixelBufferAccess& src, int srcX, int srcY, int width, int height)
+{
+	const tcu::IVec4	srcRect		= intersect(tcu::IVec4(srcX, srcY, width, height), getBufferRect(src));
+	const int			dstOffsetX	= dstX + srcRect.x() - srcX;
+	const int			dstOffsetY	= dstY + srcRect.y() - srcY;
+
+	if (isEmpty(srcRect))
+		return;
+
+	if (src.getNumSamples() == 1)
+	{
+		// Row-wise copy, plain memcpy if formats match.
+		tcu::copy(tcu::getSubregion(dst, dstOffsetX, dstOffsetY, srcRect.z(), srcRect.w()),
+				  tcu::getSubregion(src.toSinglesampleAccess(), srcRect.x(), srcRect.y(), srcRect.z(), srcRect.w()));
+	}
+	else
+	{
+		for (int yo = 0; yo < srcRect.w(); yo++)
+		for (int xo = 0; xo < srcRect.z(); xo++)
+			dst.setPixel(rr::resolveMultisamplePixel(src, srcRect.x()+xo, srcRect.y()+yo), dstOffsetX+xo, dstOffsetY+yo);
+	}
+}
+
 ReferenceContextLimits::ReferenceContextLimits (const glu::RenderContext& renderCtx)
 	: contextType				(renderCtx.getType())
 	, maxTextureImageUnits		(0)
@@ -1455,15 +1479,8 @@ void ReferenceContext::copyTexImage1D (deUint32 target, int level, deUint32 inte
 		else
 			texture->allocLevel(level, storageFmt, width);
 
-		// Copy from current framebuffer.
-		PixelBufferAccess dst = texture->getLevel(level);
-		for (int xo = 0; xo < width; xo++)
-		{
-			if (!de::inBounds(x+xo, 0, src.raw().getHeight()))
-				continue; // Undefined pixel.
-
-			dst.setPixel(rr::resolveMultisamplePixel(src, x+xo, y), xo, 0);
-		}
+		// Copy from current framebuffer. Pixels outside framebuffer are undefined.
+		copyFromColorbuffer(texture->getLevel(level), 0, 0, src, x, y, width, 1);
 	}
 	else
 		RC_ERROR_RET(GL_INVALID_ENUM, RC_RET_VOID);
@@ -1504,16 +1521,8 @@ void ReferenceContext::copyTexImage2D (deUint32 target, int level, deUint32 inte
 		else
 			texture->allocLevel(level, storageFmt, width, height);
 
-		// Copy from current framebuffer.
-		PixelBufferAccess dst = texture->getLevel(level);
-		for (int yo = 0; yo < height; yo++)
-		for (int xo = 0; xo < width; xo++)
-		{
-			if (!de::inBounds(x+xo, 0, src.raw().getHeight()) || !de::inBounds(y+yo, 0, src.raw().getDepth()))
-				continue; // Undefined pixel.
-
-			dst.setPixel(rr::resolveMultisamplePixel(src, x+xo, y+yo), xo, yo);
-		}
+		// Copy from current framebuffer. Pixels outside framebuffer are undefined.
+		copyFromColorbuffer(texture->getLevel(level), 0, 0, src, x, y, width, height);
 	}
 	else if (target == GL_TEXTURE_CUBE_MAP_NEGATIVE_X ||
 			 target == GL_TEXTURE_CUBE_MAP_POSITIVE_X ||
@@ -1541,16 +1550,8 @@ void ReferenceContext::copyTexImage2D (deUint32 target, int level, deUint32 inte
 		else
 			texture->allocFace(level, face, storageFmt, width, height);
 
-		// Copy from current framebuffer.
-		PixelBufferAccess dst = texture->getFace(level, face);
-		for (int yo = 0; yo < height; yo++)
-		for (int xo = 0; xo < width; xo++)
-		{
-			if (!de::inBounds(x+xo, 0, src.raw().getHeight()) || !de::inBounds(y+yo, 0, src.raw().getDepth()))
-				continue; // Undefined pixel.
-
-			dst.setPixel(rr::resolveMultisamplePixel(src, x+xo, y+yo), xo, yo);
-		}
+		// Copy from current framebuffer. Pixels outside framebuffer are undefined.
+		copyFromColorbuffer(texture->getFace(level, face), 0, 0, src, x, y, width, height);
 	}
 	else
 		RC_ERROR_RET(GL_INVALID_ENUM, RC_RET_VOID);
@@ -1575,13 +1576,7 @@ void ReferenceContext::copyTexSubImage1D (deUint32 target, int level, int xoffse
 
 		RC_IF_ERROR(xoffset + width > dst.getWidth(), GL_INVALID_VALUE, RC_RET_VOID);
 
-		for (int xo = 0; xo < width; xo++)
-		{
-			if (!de::inBounds(x+xo, 0, src.raw().getHeight()))
-				continue;
-
-			dst.setPixel(rr::resolveMultisamplePixel(src, x+xo, y), xo+xoffset, 0);
-		}
+		copyFromColorbuffer(dst, xoffset, 0, src, x, y, width, 1);
 	}
 	else
 		RC_ERROR_RET(GL_INVALID_ENUM, RC_RET_VOID);
@@ -1608,14 +1603,7 @@ void ReferenceContext::copyTexSubImage2D (deUint32 target, int level, int xoffse
 					yoffset + height	> dst.getHeight(),
 					GL_INVALID_VALUE, RC_RET_VOID);
 
-		for (int yo = 0; yo < height; yo++)
-		for (int xo = 0; xo < width; xo++)
-		{
-			if (!de::inBounds(x+xo, 0, src.raw().getHeight()) || !de::inBounds(y+yo, 0, src.raw().getDepth()))
-				continue;
-
-			dst.setPixel(rr::resolveMultisamplePixel(src, x+xo, y+yo), xo+xoffset, yo+yoffset);
-		}
+		copyFromColorbuffer(dst, xoffset, yoffset, src, x, y, width, height);
 	}
 	else if (target == GL_TEXTURE_CUBE_MAP_NEGATIVE_X ||
 			 target == GL_TEXTURE_CUBE_MAP_POSITIVE_X ||
@@ -1635,14 +1623,7 @@ void ReferenceContext::copyTexSubImage2D (deUint32 target, int level, int xoffse
 					yoffset + height	> dst.getHeight(),
 					GL_INVALID_VALUE, RC_RET_VOID);
 
-		for (int yo = 0; yo < height; yo++)
-		for (int xo = 0; xo < width; xo++)
-		{
-			if (!de::inBounds(x+xo, 0, src.raw().getHeight()) || !de::inBounds(y+yo, 0, src.raw().getDepth()))
-				continue;
-
-			dst.setPixel(rr::resolveMultisamplePixel(src, x+xo, y+yo), xo+xoffset, yo+yoffset);
-		}
+		copyFromColorbuffer(dst, xoffset, yoffset, src, x, y, width, height);
 	}
 	else
 		RC_ERROR_RET(GL_INVALID_ENUM, RC_RET_VOID);
@@ -3206,29 +3187,43 @@ void ReferenceContext::blitFramebuffer (int srcX0, int srcY0, int srcX1, int src
 
 		// \note We don't check for unsupported conversions, unlike spec requires.
 
-		for (int yo = 0; yo < dstRect.w(); yo++)
+		if (!scale && swapSrcX == swapDstX && swapSrcY == swapDstY && src.getFormat() == dst.getFormat() && !tcu::isSRGB(src.getFormat()))
 		{
-			for (int xo = 0; xo < dstRect.z(); xo++)
+			// Unscaled, unflipped blit between matching formats is a plain copy of the overlapping rows.
+			const int		offsetX		= (srcX0 - srcRect.x()) + (dstRect.x() - dstX0);
+			const int		offsetY		= (srcY0 - srcRect.y()) + (dstRect.y() - dstY0);
+			const IVec4		copyRect	= intersect(IVec4(0, 0, dstRect.z(), dstRect.w()), IVec4(-offsetX, -offsetY, srcRect.z(), srcRect.w()));
+
+			if (!isEmpty(copyRect))
+				tcu::copy(tcu::getSubregion(dst, copyRect.x(), copyRect.y(), copyRect.z(), copyRect.w()),
+						  tcu::getSubregion(src, copyRect.x() + offsetX, copyRect.y() + offsetY, copyRect.z(), copyRect.w()));
+		}
+		else
+		{
+			for (int yo = 0; yo < dstRect.w(); yo++)
 			{
-				float	dX	= (float)xo + 0.5f;
-				float	dY	= (float)yo + 0.5f;
-
-				// \note Only affine part is used.
-				float	sX	= transform(0, 0)*dX + transform(0, 1)*dY + transform(0, 2);
-				float	sY	= transform(1, 0)*dX + transform(1, 1)*dY + transform(1, 2);
-
-				// do not copy pixels outside the modified source region (modified by buffer intersection)
-				if (sX < 0.0f || sX >= (float)srcRect.z() ||
-					sY < 0.0f || sY >= (float)srcRect.w())
-					continue;
-
-				if (dstIsFloat || srcIsSRGB || filter == tcu::Sampler::LINEAR)
+				for (int xo = 0; xo < dstRect.z(); xo++)
 				{
-					Vec4 p = src.sample2D(sampler, sampler.minFilter, sX, sY, 0);
-					dst.setPixel((dstIsSRGB && convertSRGB) ? tcu::linearToSRGB(p) : p, xo, yo);
+					float	dX	= (float)xo + 0.5f;
+					float	dY	= (float)yo + 0.5f;
+
+					// \note Only affine part is used.
+					float	sX	= transform(0, 0)*dX + transform(0, 1)*dY + transform(0, 2);
+					float	sY	= transform(1, 0)*dX + transform(1, 1)*dY + transform(1, 2);
+
+					// do not copy pixels outside the modified source region (modified by buffer intersection)
+					if (sX < 0.0f || sX >= (float)srcRect.z() ||
+						sY < 0.0f || sY >= (float)srcRect.w())
+						continue;
+
+					if (dstIsFloat || srcIsSRGB || filter == tcu::Sampler::LINEAR)
+					{
+						Vec4 p = src.sample2D(sampler, sampler.minFilter, sX, sY, 0);
+						dst.setPixel((dstIsSRGB && convertSRGB) ? tcu::linearToSRGB(p) : p, xo, yo);
+					}
+					else
+						dst.setPixel(src.getPixelInt(deFloorFloatToInt32(sX), deFloorFloatToInt32(sY)), xo, yo);
 				}
-				else
-					dst.setPixel(src.getPixelInt(deFloorFloatToInt32(sX), deFloorFloatToInt32(sY)), xo, yo);
 			}
 		}
 	}
@@ -4684,10 +4679,15 @@ void TextureLevelArray::allocLevel (int level, const tcu::TextureFormat& format,
 
 	DE_ASSERT(deInBounds32(level, 0, DE_LENGTH_OF_ARRAY(m_data)));
 
-	if (hasLevel(level))
-		clearLevel(level);
+	// Respecifying a level with the same size reuses the existing storage.
+	if (!hasLevel(level) || m_data[level].size() != (size_t)dataSize)
+	{
+		if (hasLevel(level))
+			clearLevel(level);
+
+		m_data[level].setStorage(dataSize);
+	}
 
-	m_data[level].setStorage(dataSize);
 	m_access[level] = PixelBufferAccess(format, width, height, depth, m_data[level].getPtr());
 }
 
@@ -4912,6 +4912,10 @@ void Texture2D::sample4 (tcu::Vec4 output[4], const tcu::Vec2 packetTexcoords[4]
 	const tcu::Vec2 dFdy0 = packetTexcoords[2] - packetTexcoords[0];
 	const tcu::Vec2 dFdy1 = packetTexcoords[3] - packetTexcoords[1];
 
+	float s[4];
+	float t[4];
+	float lod[4];
+
 	for (int fragNdx = 0; fragNdx < 4; ++fragNdx)
 	{
 		const tcu::Vec2& dFdx = (fragNdx & 2) ? dFdx1 : dFdx0;
@@ -4921,10 +4925,12 @@ void Texture2D::sample4 (tcu::Vec4 output[4], const tcu::Vec2 packetTexcoords[4]
 		const float mv = de::max(de::abs(dFdx.y()), de::abs(dFdy.y()));
 		const float p = de::max(mu * texWidth, mv * texHeight);
 
-		const float	lod = deFloatLog2(p) + lodBias;
-
-		output[fragNdx] = sample(packetTexcoords[fragNdx].x(), packetTexcoords[fragNdx].y(), lod);
+		s[fragNdx]		= packetTexcoords[fragNdx].x();
+		t[fragNdx]		= packetTexcoords[fragNdx].y();
+		lod[fragNdx]	= deFloatLog2(p) + lodBias;
 	}
+
+	m_view.sampleBatch(getSampler(), 4, s, t, lod, output);
 }
 
 TextureCube::TextureCube (deUint32 name)
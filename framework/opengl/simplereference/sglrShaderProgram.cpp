@@ -148,6 +148,9 @@ ShaderProgram::ShaderProgram (const pdec::ShaderProgramDeclaration& decl)
 {
 	DE_ASSERT(decl.valid());
 
+	// Programs only read uniforms and samplers while shading, so fragments may be shaded in parallel tiles
+	this->rr::FragmentShader::m_threadSafe = true;
+
 	// Set up shader IO
 
 	for (size_t ndx = 0; ndx < decl.m_vertexAttributes.size(); ++ndx)
@@ -235,6 +235,9 @@ public:
 	inline const rr::FragmentShader*		getFragmentShader	(void) const { return static_cast<const rr::FragmentShader*>(this); }
 	inline const rr::GeometryShader*		getGeometryShader	(void) const { return static_cast<const rr::GeometryShader*>(this); }
 
+protected:
+	void									setFragmentShaderThreadSafe	(bool threadSafe) { this->rr::FragmentShader::m_threadSafe = threadSafe; } //!< Programs with mutable shading state must clear this.
+
 private:
 	virtual void							shadeVertices		(const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const = 0;
 	virtual void							shadeFragments		(rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const = 0;
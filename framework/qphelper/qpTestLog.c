@@ -29,8 +29,11 @@
 #include "deMemory.h"
 #include "deInt32.h"
 #include "deString.h"
+#include "deClock.h"
 
 #include "deMutex.h"
+#include "deSemaphore.h"
+#include "deThread.h"
 
 #if defined(QP_SUPPORT_PNG)
 #	include <png.h>
@@ -119,6 +122,95 @@ DE_INLINE ContainerType ContainerStack_getTop (const ContainerStack* stack)
 
 #endif
 
+typedef struct Buffer_s
+{
+	size_t		capacity;
+	size_t		size;
+	deUint8*	data;
+} Buffer;
+
+void Buffer_init (Buffer* buffer)
+{
+	buffer->capacity	= 0;
+	buffer->size		= 0;
+	buffer->data		= DE_NULL;
+}
+
+void Buffer_deinit (Buffer* buffer)
+{
+	deFree(buffer->data);
+	Buffer_init(buffer);
+}
+
+deBool Buffer_resize (Buffer* buffer, size_t newSize)
+{
+	/* Grow buffer if necessary. */
+	if (newSize > buffer->capacity)
+	{
+		size_t		newCapacity	= (size_t)deAlign32(deMax32(2*(int)buffer->capacity, (int)newSize), 512);
+		deUint8*	newData		= (deUint8*)deMalloc(newCapacity);
+		if (!newData)
+			return DE_FALSE;
+
+		memcpy(newData, buffer->data, buffer->size);
+		deFree(buffer->data);
+		buffer->data		= newData;
+		buffer->capacity	= newCapacity;
+	}
+
+	buffer->size = newSize;
+	return DE_TRUE;
+}
+
+deBool Buffer_append (Buffer* buffer, const deUint8* data, size_t numBytes)
+{
+	size_t offset = buffer->size;
+
+	if (!Buffer_resize(buffer, buffer->size + numBytes))
+		return DE_FALSE;
+
+	/* Append bytes. */
+	memcpy(&buffer->data[offset], data, numBytes);
+	return DE_TRUE;
+}
+
+/* Asynchronous writing. */
+
+enum
+{
+	ASYNC_DATA_CHUNK_SIZE	= 64*1024,			/*!< Buffered log data is passed to writer thread in chunks of this size.	*/
+	ASYNC_MAX_QUEUED_SIZE	= 32*1024*1024		/*!< Submitting blocks while more data than this is queued.					*/
+};
+
+typedef enum LogJobType_e
+{
+	LOGJOB_DATA = 0,	/*!< Write data.										*/
+	LOGJOB_IMAGE,		/*!< Compress image and write it as <Image> element.	*/
+	LOGJOB_FENCE,		/*!< Flush output file and signal fence semaphore.		*/
+	LOGJOB_CASE_BEGIN,	/*!< Record output file offset of case for case index.	*/
+	LOGJOB_CASE_END,	/*!< Write case index record.							*/
+	LOGJOB_QUIT,		/*!< Terminate writer thread.							*/
+
+	LOGJOB_LAST
+} LogJobType;
+
+typedef struct LogJob_s
+{
+	LogJobType				type;
+	struct LogJob_s*		next;
+
+	Buffer					data;				/*!< Log data, packed image pixels or case index record.	*/
+
+	/* Image parameters. */
+	char*					name;
+	char*					description;
+	qpImageCompressionMode	compressionMode;
+	qpImageFormat			imageFormat;
+	int						width;
+	int						height;
+	int						elementDepth;
+} LogJob;
+
 /* qpTestLog instance */
 struct qpTestLog_s
 {
@@ -131,10 +223,28 @@ struct qpTestLog_s
 	qpXmlWriter*			writer;
 	deBool					isSessionOpen;
 	deBool					isCaseOpen;
+	Buffer					pendingData;		/*!< Log data not yet passed to writer thread.	*/
 
 #if defined(DE_DEBUG)
 	ContainerStack			containerStack;		/*!< For container usage verification.	*/
 #endif
+
+	/* Writer thread state, only used with QP_TEST_LOG_ASYNC_WRITE. */
+	deThread				writerThread;
+	deMutex					queueLock;
+	deSemaphore				queueSem;			/*!< Number of jobs in queue.			*/
+	deSemaphore				fenceSem;			/*!< Signaled when fence is reached.	*/
+	deSemaphore				queueSpaceSem;		/*!< Signaled when queued data drops to ASYNC_MAX_QUEUED_SIZE.	*/
+	LogJob*					queueHead;
+	LogJob*					queueTail;
+	size_t					queuedSize;			/*!< Bytes of job data queued or being written, protected by queueLock.	*/
+	deBool					isSubmitBlocked;	/*!< Submitter is waiting for queueSpaceSem, protected by queueLock.	*/
+
+	/* Case index state, only used with QP_TEST_LOG_WRITE_CASE_INDEX. */
+	FILE*					indexFile;
+	deInt64					caseOffset;			/*!< Output file offset of current case. Owned by writer thread in async mode.	*/
+	deUint64				caseStartTime;
+	char*					casePath;
 };
 
 /* Maps integer to string. */
@@ -248,16 +358,40 @@ static const qpKeyStringMap s_qpShaderTypeMap[] =
 
 DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(s_qpShaderTypeMap) == QP_SHADER_TYPE_LAST + 1);
 
-static void qpTestLog_flushFile (qpTestLog* log)
+static deBool	startWriterThread	(qpTestLog* log);
+static void		stopWriterThread	(qpTestLog* log);
+static void		waitWriterThread	(qpTestLog* log);
+static void		appendPendingData	(void* userPtr, const void* data, size_t numBytes);
+
+static deBool	openCaseIndex			(qpTestLog* log, const char* logFileName);
+static void		beginCaseIndexRecord	(qpTestLog* log, const char* casePath);
+static void		endCaseIndexRecord		(qpTestLog* log, const char* statusStr);
+static void		endCaseIndex			(qpTestLog* log);
+static void		recordCaseOffset		(qpTestLog* log);
+static void		writeCaseIndexRecord	(qpTestLog* log, const Buffer* caseInfo);
+
+static void flushOutputFile (FILE* file)
 {
-	DE_ASSERT(log && log->outputFile);
-	fflush(log->outputFile);
+	fflush(file);
 #if (DE_OS == DE_OS_WIN32) && (DE_COMPILER == DE_COMPILER_MSC)
 	/* \todo [petri] Is this really necessary? */
-	FlushFileBuffers((HANDLE)_get_osfhandle(_fileno(log->outputFile)));
+	FlushFileBuffers((HANDLE)_get_osfhandle(_fileno(file)));
 #endif
 }
 
+static void qpTestLog_flushFile (qpTestLog* log)
+{
+	DE_ASSERT(log && log->outputFile);
+
+	qpXmlWriter_flush(log->writer);
+
+	/* In async mode file is flushed by writer thread once it has written everything submitted so far. */
+	if (log->flags & QP_TEST_LOG_ASYNC_WRITE)
+		waitWriterThread(log);
+	else
+		flushOutputFile(log->outputFile);
+}
+
 #define QP_LOOKUP_STRING(KEYMAP, KEY)	qpLookupString(KEYMAP, DE_LENGTH_OF_ARRAY(KEYMAP), (int)(KEY))
 
 static const char* qpLookupString (const qpKeyStringMap* keyMap, int keyMapSize, int key)
@@ -294,12 +428,21 @@ static deBool beginSession (qpTestLog* log)
 	DE_ASSERT(log && !log->isSessionOpen);
 
 	/* Write session info. */
-	fprintf(log->outputFile, "#sessionInfo releaseName %s\n", qpGetReleaseName());
-	fprintf(log->outputFile, "#sessionInfo releaseId 0x%08x\n", qpGetReleaseId());
-	fprintf(log->outputFile, "#sessionInfo targetName \"%s\"\n", qpGetTargetName());
+	{
+		char releaseIdStr[32];
+		deSprintf(&releaseIdStr[0], sizeof(releaseIdStr), "0x%08x", qpGetReleaseId());
+
+		qpXmlWriter_writeRaw(log->writer, "#sessionInfo releaseName ");
+		qpXmlWriter_writeRaw(log->writer, qpGetReleaseName());
+		qpXmlWriter_writeRaw(log->writer, "\n#sessionInfo releaseId ");
+		qpXmlWriter_writeRaw(log->writer, releaseIdStr);
+		qpXmlWriter_writeRaw(log->writer, "\n#sessionInfo targetName \"");
+		qpXmlWriter_writeRaw(log->writer, qpGetTargetName());
+		qpXmlWriter_writeRaw(log->writer, "\"\n");
+	}
 
     /* Write out #beginSession. */
-	fprintf(log->outputFile, "#beginSession\n");
+	qpXmlWriter_writeRaw(log->writer, "#beginSession\n");
 	qpTestLog_flushFile(log);
 
 	log->isSessionOpen = DE_TRUE;
@@ -315,9 +458,12 @@ static deBool endSession (qpTestLog* log)
     qpXmlWriter_flush(log->writer);
 
     /* Write out #endSession. */
-	fprintf(log->outputFile, "\n#endSession\n");
+	qpXmlWriter_writeRaw(log->writer, "\n#endSession\n");
 	qpTestLog_flushFile(log);
 
+	if (log->indexFile)
+		endCaseIndex(log);
+
 	log->isSessionOpen = DE_FALSE;
 
 	return DE_TRUE;
@@ -352,11 +498,18 @@ qpTestLog* qpTestLog_createFileLog (const char* fileName, deUint32 flags)
 	}
 
 	log->flags			= flags;
-	log->writer			= qpXmlWriter_createFileWriter(log->outputFile, 0, !(flags & QP_TEST_LOG_NO_FLUSH));
 	log->lock			= deMutex_create(DE_NULL);
 	log->isSessionOpen	= DE_FALSE;
 	log->isCaseOpen		= DE_FALSE;
 
+	Buffer_init(&log->pendingData);
+
+	/* In async mode all output goes through writer thread. */
+	if (flags & QP_TEST_LOG_ASYNC_WRITE)
+		log->writer = qpXmlWriter_createStreamWriter(appendPendingData, log, 0);
+	else
+		log->writer = qpXmlWriter_createFileWriter(log->outputFile, 0, !(flags & QP_TEST_LOG_NO_FLUSH));
+
 	if (!log->writer)
 	{
 		qpPrintf("ERROR: Unable to create output XML writer to file '%s'.\n", fileName);
@@ -371,6 +524,19 @@ qpTestLog* qpTestLog_createFileLog (const char* fileName, deUint32 flags)
 		return DE_NULL;
 	}
 
+	if ((flags & QP_TEST_LOG_ASYNC_WRITE) && !startWriterThread(log))
+	{
+		qpPrintf("ERROR: Unable to create log writer thread.\n");
+		qpTestLog_destroy(log);
+		return DE_NULL;
+	}
+
+	if ((flags & QP_TEST_LOG_WRITE_CASE_INDEX) && !openCaseIndex(log, fileName))
+	{
+		qpTestLog_destroy(log);
+		return DE_NULL;
+	}
+
 	beginSession(log);
 
 	return log;
@@ -387,15 +553,37 @@ void qpTestLog_destroy (qpTestLog* log)
 	if (log->isSessionOpen)
 		endSession(log);
 
+	if (log->writerThread)
+		stopWriterThread(log);
+
 	if (log->writer)
 		qpXmlWriter_destroy(log->writer);
 
+	Buffer_deinit(&log->pendingData);
+
 	if (log->outputFile)
 		fclose(log->outputFile);
 
+	if (log->indexFile)
+		fclose(log->indexFile);
+
+	deFree(log->casePath);
+
 	if (log->lock)
 		deMutex_destroy(log->lock);
 
+	if (log->queueLock)
+		deMutex_destroy(log->queueLock);
+
+	if (log->queueSem)
+		deSemaphore_destroy(log->queueSem);
+
+	if (log->fenceSem)
+		deSemaphore_destroy(log->fenceSem);
+
+	if (log->queueSpaceSem)
+		deSemaphore_destroy(log->queueSpaceSem);
+
 	deFree(log);
 }
 
@@ -420,7 +608,15 @@ deBool qpTestLog_startCase (qpTestLog* log, const char* testCasePath, qpTestCase
 
 	/* Flush XML and write out #beginTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#beginTestCaseResult %s\n", testCasePath);
+
+	if (log->indexFile)
+		beginCaseIndexRecord(log, testCasePath);
+
+	qpXmlWriter_writeRaw(log->writer, "\n#beginTestCaseResult ");
+	qpXmlWriter_writeRaw(log->writer, testCasePath);
+	qpXmlWriter_writeRaw(log->writer, "\n");
+
+	/* \note In async mode this fences the writer thread, so that #beginTestCaseResult is on disk if the case crashes. */
 	if (!(log->flags & QP_TEST_LOG_NO_FLUSH))
 		qpTestLog_flushFile(log);
 
@@ -476,7 +672,11 @@ deBool qpTestLog_endCase (qpTestLog* log, qpTestResult result, const char* resul
 
 	/* Flush XML and write #endTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#endTestCaseResult\n");
+	qpXmlWriter_writeRaw(log->writer, "\n#endTestCaseResult\n");
+
+	if (log->indexFile)
+		endCaseIndexRecord(log, statusStr);
+
 	if (!(log->flags & QP_TEST_LOG_NO_FLUSH))
 		qpTestLog_flushFile(log);
 
@@ -493,7 +693,7 @@ deBool qpTestLog_startTestsCasesTime (qpTestLog* log)
 
 	/* Flush XML and write out #beginTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#beginTestsCasesTime\n");
+	qpXmlWriter_writeRaw(log->writer, "\n#beginTestsCasesTime\n");
 
 	log->isCaseOpen = DE_TRUE;
 
@@ -526,7 +726,10 @@ deBool qpTestLog_endTestsCasesTime (qpTestLog* log)
 
 	qpXmlWriter_flush(log->writer);
 
-	fprintf(log->outputFile, "\n#endTestsCasesTime\n");
+	qpXmlWriter_writeRaw(log->writer, "\n#endTestsCasesTime\n");
+
+	if (!(log->flags & QP_TEST_LOG_NO_FLUSH))
+		qpTestLog_flushFile(log);
 
 	log->isCaseOpen = DE_FALSE;
 
@@ -558,7 +761,13 @@ deBool qpTestLog_terminateCase (qpTestLog* log, qpTestResult result)
 
 	/* Flush XML and write #terminateTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#terminateTestCaseResult %s\n", resultStr);
+	qpXmlWriter_writeRaw(log->writer, "\n#terminateTestCaseResult ");
+	qpXmlWriter_writeRaw(log->writer, resultStr);
+	qpXmlWriter_writeRaw(log->writer, "\n");
+
+	if (log->indexFile)
+		endCaseIndexRecord(log, resultStr);
+
 	qpTestLog_flushFile(log);
 
 	log->isCaseOpen = DE_FALSE;
@@ -650,58 +859,6 @@ deBool qpTestLog_writeFloat (qpTestLog* log, const char* name, const char* descr
 	return qpTestLog_writeKeyValuePair(log, "Number", name, description, unit, tag, tmpString);
 }
 
-typedef struct Buffer_s
-{
-	size_t		capacity;
-	size_t		size;
-	deUint8*	data;
-} Buffer;
-
-void Buffer_init (Buffer* buffer)
-{
-	buffer->capacity	= 0;
-	buffer->size		= 0;
-	buffer->data		= DE_NULL;
-}
-
-void Buffer_deinit (Buffer* buffer)
-{
-	deFree(buffer->data);
-	Buffer_init(buffer);
-}
-
-deBool Buffer_resize (Buffer* buffer, size_t newSize)
-{
-	/* Grow buffer if necessary. */
-	if (newSize > buffer->capacity)
-	{
-		size_t		newCapacity	= (size_t)deAlign32(deMax32(2*(int)buffer->capacity, (int)newSize), 512);
-		deUint8*	newData		= (deUint8*)deMalloc(newCapacity);
-		if (!newData)
-			return DE_FALSE;
-
-		memcpy(newData, buffer->data, buffer->size);
-		deFree(buffer->data);
-		buffer->data		= newData;
-		buffer->capacity	= newCapacity;
-	}
-
-	buffer->size = newSize;
-	return DE_TRUE;
-}
-
-deBool Buffer_append (Buffer* buffer, const deUint8* data, size_t numBytes)
-{
-	size_t offset = buffer->size;
-
-	if (!Buffer_resize(buffer, buffer->size + numBytes))
-		return DE_FALSE;
-
-	/* Append bytes. */
-	memcpy(&buffer->data[offset], data, numBytes);
-	return DE_TRUE;
-}
-
 #if defined(QP_SUPPORT_PNG)
 void pngWriteData (png_structp png, png_bytep dataPtr, png_size_t numBytes)
 {
@@ -783,6 +940,506 @@ static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int w
 }
 #endif /* QP_SUPPORT_PNG */
 
+static deBool encodeImage (Buffer* buffer, qpImageCompressionMode* compressionMode, qpImageFormat imageFormat, int width, int height, int stride, const void* data, const void** writeDataPtr, size_t* writeDataBytes)
+{
+	/* BEST compression mode defaults to PNG. */
+	if (*compressionMode == QP_IMAGE_COMPRESSION_MODE_BEST)
+	{
+#if defined(QP_SUPPORT_PNG)
+		*compressionMode = QP_IMAGE_COMPRESSION_MODE_PNG;
+#else
+		*compressionMode = QP_IMAGE_COMPRESSION_MODE_NONE;
+#endif
+	}
+
+#if defined(QP_SUPPORT_PNG)
+	/* Try storing with PNG compression. */
+	if (*compressionMode == QP_IMAGE_COMPRESSION_MODE_PNG)
+	{
+		deBool compressOk = compressImagePNG(buffer, imageFormat, width, height, stride, data);
+		if (compressOk)
+		{
+			*writeDataPtr	= buffer->data;
+			*writeDataBytes	= buffer->size;
+		}
+		else
+		{
+			/* Fall-back to default compression. */
+			qpPrintf("WARNING: PNG compression failed -- storing image uncompressed.\n");
+			*compressionMode	= QP_IMAGE_COMPRESSION_MODE_NONE;
+		}
+	}
+#endif
+
+	/* Handle image compression. */
+	switch (*compressionMode)
+	{
+		case QP_IMAGE_COMPRESSION_MODE_NONE:
+		{
+			int pixelSize		= imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4;
+			int packedStride	= pixelSize*width;
+
+			if (packedStride == stride)
+				*writeDataPtr = data;
+			else
+			{
+				/* Need to re-pack pixels. */
+				if (Buffer_resize(buffer, (size_t)(packedStride*height)))
+				{
+					int row;
+					for (row = 0; row < height; row++)
+						memcpy(&buffer->data[packedStride*row], &((const deUint8*)data)[row*stride], (size_t)(pixelSize*width));
+				}
+				else
+				{
+					qpPrintf("ERROR: Failed to pack pixels for writing.\n");
+					return DE_FALSE;
+				}
+
+				*writeDataPtr = buffer->data;
+			}
+
+			*writeDataBytes = (size_t)(packedStride*height);
+			break;
+		}
+
+#if defined(QP_SUPPORT_PNG)
+		case QP_IMAGE_COMPRESSION_MODE_PNG:
+			DE_ASSERT(*writeDataPtr); /* Already handled. */
+			break;
+#endif
+
+		default:
+			qpPrintf("qpTestLog_writeImage(): Unknown compression mode: %s\n", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, *compressionMode));
+			return DE_FALSE;
+	}
+
+	return DE_TRUE;
+}
+
+static deBool writeImageElement (qpXmlWriter* writer, const char* name, const char* description, qpImageCompressionMode compressionMode, qpImageFormat imageFormat, int width, int height, const void* writeDataPtr, size_t writeDataBytes)
+{
+	char			widthStr[32];
+	char			heightStr[32];
+	qpXmlAttribute	attribs[8];
+	int				numAttribs			= 0;
+
+	/* Fill in attributes. */
+	int32ToString(width, widthStr);
+	int32ToString(height, heightStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
+	attribs[numAttribs++] = qpSetStringAttrib("Width", widthStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Height", heightStr);
+	attribs[numAttribs++] = qpSetStringAttrib("Format", QP_LOOKUP_STRING(s_qpImageFormatMap, imageFormat));
+	attribs[numAttribs++] = qpSetStringAttrib("CompressionMode", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, compressionMode));
+	if (description) attribs[numAttribs++] = qpSetStringAttrib("Description", description);
+
+	/* <Image ID="result" Name="Foobar" Width="640" Height="480" Format="RGB888" CompressionMode="None">base64 data</Image> */
+	return qpXmlWriter_startElement(writer, "Image", numAttribs, attribs) &&
+		   qpXmlWriter_writeBase64(writer, (const deUint8*)writeDataPtr, writeDataBytes) &&
+		   qpXmlWriter_endElement(writer, "Image");
+}
+
+static LogJob* LogJob_create (LogJobType type)
+{
+	LogJob* job = (LogJob*)deCalloc(sizeof(LogJob));
+
+	if (job)
+	{
+		job->type = type;
+		Buffer_init(&job->data);
+	}
+
+	return job;
+}
+
+static void LogJob_destroy (LogJob* job)
+{
+	Buffer_deinit(&job->data);
+	deFree(job->name);
+	deFree(job->description);
+	deFree(job);
+}
+
+static void writeOutputFile (void* userPtr, const void* data, size_t numBytes)
+{
+	fwrite(data, 1, numBytes, (FILE*)userPtr);
+}
+
+static void writeImageJob (qpTestLog* log, const LogJob* job)
+{
+	qpImageCompressionMode	compressionMode		= job->compressionMode;
+	qpXmlWriter*			writer				= qpXmlWriter_createStreamWriter(writeOutputFile, log->outputFile, job->elementDepth);
+	Buffer					compressedBuffer;
+	const void*				writeDataPtr		= DE_NULL;
+	size_t					writeDataBytes		= ~(size_t)0;
+	const int				pixelSize			= job->imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4;
+
+	Buffer_init(&compressedBuffer);
+
+	if (!writer)
+		qpPrintf("ERROR: Failed to create writer for image.\n");
+	else if (encodeImage(&compressedBuffer, &compressionMode, job->imageFormat, job->width, job->height, pixelSize*job->width, job->data.data, &writeDataPtr, &writeDataBytes))
+	{
+		if (!writeImageElement(writer, job->name, job->description, compressionMode, job->imageFormat, job->width, job->height, writeDataPtr, writeDataBytes))
+			qpPrintf("qpTestLog_writeImage(): Writing XML failed\n");
+	}
+
+	if (writer)
+		qpXmlWriter_destroy(writer);
+
+	Buffer_deinit(&compressedBuffer);
+}
+
+static void writerThreadMain (void* arg)
+{
+	qpTestLog*	log		= (qpTestLog*)arg;
+	deBool		quit	= DE_FALSE;
+
+	while (!quit)
+	{
+		LogJob* job;
+
+		deSemaphore_decrement(log->queueSem);
+
+		deMutex_lock(log->queueLock);
+		job				= log->queueHead;
+		log->queueHead	= job->next;
+		if (!log->queueHead)
+			log->queueTail = DE_NULL;
+		deMutex_unlock(log->queueLock);
+
+		switch (job->type)
+		{
+			case LOGJOB_DATA:
+				fwrite(job->data.data, 1, job->data.size, log->outputFile);
+				break;
+
+			case LOGJOB_IMAGE:
+				writeImageJob(log, job);
+				break;
+
+			case LOGJOB_FENCE:
+				flushOutputFile(log->outputFile);
+				deSemaphore_increment(log->fenceSem);
+				break;
+
+			case LOGJOB_CASE_BEGIN:
+				recordCaseOffset(log);
+				break;
+
+			case LOGJOB_CASE_END:
+				writeCaseIndexRecord(log, &job->data);
+				break;
+
+			case LOGJOB_QUIT:
+				flushOutputFile(log->outputFile);
+				quit = DE_TRUE;
+				break;
+
+			default:
+				DE_ASSERT(DE_FALSE);
+		}
+
+		deMutex_lock(log->queueLock);
+		DE_ASSERT(log->queuedSize >= job->data.size);
+		log->queuedSize -= job->data.size;
+		if (log->isSubmitBlocked && log->queuedSize <= ASYNC_MAX_QUEUED_SIZE)
+		{
+			log->isSubmitBlocked = DE_FALSE;
+			deSemaphore_increment(log->queueSpaceSem);
+		}
+		deMutex_unlock(log->queueLock);
+
+		LogJob_destroy(job);
+	}
+}
+
+/* Jobs are submitted with log lock held, so there is at most one blocked submitter. */
+static void submitJob (qpTestLog* log, LogJob* job)
+{
+	deBool isBlocked;
+
+	deMutex_lock(log->queueLock);
+	if (log->queueTail)
+		log->queueTail->next = job;
+	else
+		log->queueHead = job;
+	log->queueTail = job;
+
+	/* Bound memory use if writer thread can't keep up, e.g. with many large images. */
+	log->queuedSize			+= job->data.size;
+	isBlocked				= log->queuedSize > ASYNC_MAX_QUEUED_SIZE;
+	log->isSubmitBlocked	= isBlocked;
+	deMutex_unlock(log->queueLock);
+
+	deSemaphore_increment(log->queueSem);
+
+	if (isBlocked)
+		deSemaphore_decrement(log->queueSpaceSem);
+}
+
+static void submitPendingData (qpTestLog* log)
+{
+	LogJob* job;
+
+	if (log->pendingData.size == 0)
+		return;
+
+	job = LogJob_create(LOGJOB_DATA);
+	if (!job)
+	{
+		qpPrintf("ERROR: Failed to allocate log write job, %d bytes of log data lost.\n", (int)log->pendingData.size);
+		log->pendingData.size = 0;
+		return;
+	}
+
+	/* Hand over pending data. */
+	job->data = log->pendingData;
+	Buffer_init(&log->pendingData);
+
+	submitJob(log, job);
+}
+
+/* Write function for XML writer in async mode. Called with log lock held. */
+static void appendPendingData (void* userPtr, const void* data, size_t numBytes)
+{
+	qpTestLog* log = (qpTestLog*)userPtr;
+
+	if (!Buffer_append(&log->pendingData, (const deUint8*)data, numBytes))
+	{
+		qpPrintf("ERROR: Failed to buffer log data.\n");
+		return;
+	}
+
+	if (log->pendingData.size >= ASYNC_DATA_CHUNK_SIZE)
+		submitPendingData(log);
+}
+
+static deBool startWriterThread (qpTestLog* log)
+{
+	log->queueLock		= deMutex_create(DE_NULL);
+	log->queueSem		= deSemaphore_create(0, DE_NULL);
+	log->fenceSem		= deSemaphore_create(0, DE_NULL);
+	log->queueSpaceSem	= deSemaphore_create(0, DE_NULL);
+
+	if (!log->queueLock || !log->queueSem || !log->fenceSem || !log->queueSpaceSem)
+		return DE_FALSE;
+
+	log->writerThread = deThread_create(writerThreadMain, log, DE_NULL);
+
+	return log->writerThread != 0;
+}
+
+/* Submit all pending data and wait until writer thread has written and flushed it. */
+static void waitWriterThread (qpTestLog* log)
+{
+	LogJob* fence;
+
+	submitPendingData(log);
+
+	fence = LogJob_create(LOGJOB_FENCE);
+	if (!fence)
+	{
+		qpPrintf("ERROR: Failed to allocate log write job.\n");
+		return;
+	}
+
+	submitJob(log, fence);
+	deSemaphore_decrement(log->fenceSem);
+}
+
+static void stopWriterThread (qpTestLog* log)
+{
+	LogJob* quit = LogJob_create(LOGJOB_QUIT);
+
+	DE_ASSERT(log->writerThread);
+
+	qpXmlWriter_flush(log->writer);
+	submitPendingData(log);
+
+	if (quit)
+	{
+		submitJob(log, quit);
+		deThread_join(log->writerThread);
+	}
+	else
+		qpPrintf("ERROR: Failed to allocate log write job, writer thread not stopped.\n");
+
+	deThread_destroy(log->writerThread);
+	log->writerThread = 0;
+}
+
+/* Case index.
+ *
+ * Index file lets tools find test case results in the log without parsing
+ * it. It starts with CASE_INDEX_MAGIC followed by a sequence of records.
+ * All integers are little-endian.
+ *
+ *  CASE_INDEX_RECORD_CASE:	u8 type, u64 offset, u64 size, u64 duration (us),
+ *							u8 status length, status, u16 path length, path
+ *  CASE_INDEX_RECORD_END:	u8 type, u64 log size
+ *
+ * Offset and size cover the case from #beginTestCaseResult to
+ * #endTestCaseResult or #terminateTestCaseResult, including the preceding
+ * newline. Status is the StatusCode string. End record is written when the
+ * session ends; an index without it is incomplete and must not be used.
+ */
+
+static const char CASE_INDEX_MAGIC[] = "qpaIdx01";
+
+enum
+{
+	CASE_INDEX_RECORD_CASE	= 1,
+	CASE_INDEX_RECORD_END	= 2
+};
+
+static deInt64 getOutputFileOffset (FILE* file)
+{
+	/* \note ftell() returns 32-bit long on Win32 and 32-bit platforms. */
+#if (DE_OS == DE_OS_WIN32)
+	return (deInt64)_ftelli64(file);
+#else
+	return (deInt64)ftello(file);
+#endif
+}
+
+static void encodeUint (deUint8* dst, deUint64 value, int numBytes)
+{
+	int ndx;
+	for (ndx = 0; ndx < numBytes; ndx++)
+		dst[ndx] = (deUint8)(value >> (8*ndx));
+}
+
+static deBool openCaseIndex (qpTestLog* log, const char* logFileName)
+{
+	const size_t	nameLen			= strlen(logFileName);
+	char*			indexFileName	= (char*)deMalloc(nameLen + 5);
+
+	if (!indexFileName)
+		return DE_FALSE;
+
+	deMemcpy(indexFileName, logFileName, nameLen);
+	deMemcpy(indexFileName + nameLen, ".idx", 5);
+
+	log->indexFile = fopen(indexFileName, "wb");
+	if (!log->indexFile)
+		qpPrintf("ERROR: Unable to open case index file '%s'.\n", indexFileName);
+
+	deFree(indexFileName);
+
+	return log->indexFile && fwrite(CASE_INDEX_MAGIC, 1, sizeof(CASE_INDEX_MAGIC)-1, log->indexFile) == sizeof(CASE_INDEX_MAGIC)-1;
+}
+
+/* Called with log lock held, after XML writer has been flushed. */
+static void beginCaseIndexRecord (qpTestLog* log, const char* casePath)
+{
+	deFree(log->casePath);
+	log->casePath		= deStrdup(casePath);
+	log->caseStartTime	= deGetMicroseconds();
+
+	if (log->flags & QP_TEST_LOG_ASYNC_WRITE)
+	{
+		LogJob* job = LogJob_create(LOGJOB_CASE_BEGIN);
+
+		submitPendingData(log);
+
+		if (job)
+			submitJob(log, job);
+		else
+			qpPrintf("ERROR: Failed to allocate log write job.\n");
+	}
+	else
+		recordCaseOffset(log);
+}
+
+/* Called with log lock held, after end of case has been written. */
+static void endCaseIndexRecord (qpTestLog* log, const char* statusStr)
+{
+	const deUint64	duration	= deGetMicroseconds() - log->caseStartTime;
+	const size_t	statusLen	= strlen(statusStr);
+	const size_t	pathLen		= log->casePath ? strlen(log->casePath) : 0;
+	const size_t	infoSize	= 8 + 1 + statusLen + 2 + pathLen;
+	Buffer			caseInfo;
+
+	if (!log->casePath || statusLen > 0xffu || pathLen > 0xffffu)
+	{
+		qpPrintf("ERROR: Failed to write case index record.\n");
+		return;
+	}
+
+	Buffer_init(&caseInfo);
+
+	if (!Buffer_resize(&caseInfo, infoSize))
+	{
+		qpPrintf("ERROR: Failed to write case index record.\n");
+		return;
+	}
+
+	encodeUint(&caseInfo.data[0], duration, 8);
+	encodeUint(&caseInfo.data[8], (deUint64)statusLen, 1);
+	deMemcpy(&caseInfo.data[9], statusStr, statusLen);
+	encodeUint(&caseInfo.data[9 + statusLen], (deUint64)pathLen, 2);
+	deMemcpy(&caseInfo.data[11 + statusLen], log->casePath, pathLen);
+
+	deFree(log->casePath);
+	log->casePath = DE_NULL;
+
+	qpXmlWriter_flush(log->writer);
+
+	if (log->flags & QP_TEST_LOG_ASYNC_WRITE)
+	{
+		LogJob* job = LogJob_create(LOGJOB_CASE_END);
+
+		submitPendingData(log);
+
+		if (job)
+		{
+			job->data = caseInfo;
+			submitJob(log, job);
+			return;
+		}
+		else
+			qpPrintf("ERROR: Failed to allocate log write job.\n");
+	}
+	else
+		writeCaseIndexRecord(log, &caseInfo);
+
+	Buffer_deinit(&caseInfo);
+}
+
+/* Called after all log data has been written out. */
+static void endCaseIndex (qpTestLog* log)
+{
+	deUint8 record[1 + 8];
+
+	encodeUint(&record[0], CASE_INDEX_RECORD_END, 1);
+	encodeUint(&record[1], (deUint64)getOutputFileOffset(log->outputFile), 8);
+
+	fwrite(&record[0], 1, sizeof(record), log->indexFile);
+	fflush(log->indexFile);
+}
+
+/* Called by writer thread in async mode. */
+static void recordCaseOffset (qpTestLog* log)
+{
+	log->caseOffset = getOutputFileOffset(log->outputFile);
+}
+
+/* Called by writer thread in async mode. */
+static void writeCaseIndexRecord (qpTestLog* log, const Buffer* caseInfo)
+{
+	const deInt64	endOffset	= getOutputFileOffset(log->outputFile);
+	deUint8			record[1 + 8 + 8];
+
+	encodeUint(&record[0], CASE_INDEX_RECORD_CASE, 1);
+	encodeUint(&record[1], (deUint64)log->caseOffset, 8);
+	encodeUint(&record[9], (deUint64)(endOffset - log->caseOffset), 8);
+
+	fwrite(&record[0], 1, sizeof(record), log->indexFile);
+	fwrite(caseInfo->data, 1, caseInfo->size, log->indexFile);
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Start image set
  * \param log			qpTestLog instance
@@ -864,10 +1521,6 @@ deBool qpTestLog_writeImage	(
 	int						stride,
 	const void*				data)
 {
-	char			widthStr[32];
-	char			heightStr[32];
-	qpXmlAttribute	attribs[8];
-	int				numAttribs			= 0;
 	Buffer			compressedBuffer;
 	const void*		writeDataPtr		= DE_NULL;
 	size_t			writeDataBytes		= ~(size_t)0;
@@ -880,97 +1533,56 @@ deBool qpTestLog_writeImage	(
 	if (log->flags & QP_TEST_LOG_EXCLUDE_IMAGES)
 		return DE_TRUE; /* Image not logged. */
 
-	Buffer_init(&compressedBuffer);
-
-	/* BEST compression mode defaults to PNG. */
-	if (compressionMode == QP_IMAGE_COMPRESSION_MODE_BEST)
+	if (log->flags & QP_TEST_LOG_ASYNC_WRITE)
 	{
-#if defined(QP_SUPPORT_PNG)
-		compressionMode = QP_IMAGE_COMPRESSION_MODE_PNG;
-#else
-		compressionMode = QP_IMAGE_COMPRESSION_MODE_NONE;
-#endif
-	}
-
-#if defined(QP_SUPPORT_PNG)
-	/* Try storing with PNG compression. */
-	if (compressionMode == QP_IMAGE_COMPRESSION_MODE_PNG)
-	{
-		deBool compressOk = compressImagePNG(&compressedBuffer, imageFormat, width, height, stride, data);
-		if (compressOk)
+		/* Copy pixels and let writer thread compress and write image. */
+		const int	pixelSize		= imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4;
+		const int	packedStride	= pixelSize*width;
+		LogJob*		job				= LogJob_create(LOGJOB_IMAGE);
+		int			row;
+
+		if (!job || !Buffer_resize(&job->data, (size_t)(packedStride*height)) ||
+			!(job->name = deStrdup(name)) || (description && !(job->description = deStrdup(description))))
 		{
-			writeDataPtr	= compressedBuffer.data;
-			writeDataBytes	= compressedBuffer.size;
-		}
-		else
-		{
-			/* Fall-back to default compression. */
-			qpPrintf("WARNING: PNG compression failed -- storing image uncompressed.\n");
-			compressionMode	= QP_IMAGE_COMPRESSION_MODE_NONE;
+			qpPrintf("ERROR: Failed to copy image for writing.\n");
+			if (job)
+				LogJob_destroy(job);
+			return DE_FALSE;
 		}
-	}
-#endif
 
-	/* Handle image compression. */
-	switch (compressionMode)
-	{
-		case QP_IMAGE_COMPRESSION_MODE_NONE:
-		{
-			int pixelSize		= imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4;
-			int packedStride	= pixelSize*width;
+		for (row = 0; row < height; row++)
+			memcpy(&job->data.data[packedStride*row], &((const deUint8*)data)[row*stride], (size_t)packedStride);
 
-			if (packedStride == stride)
-				writeDataPtr = data;
-			else
-			{
-				/* Need to re-pack pixels. */
-				if (Buffer_resize(&compressedBuffer, (size_t)(packedStride*height)))
-				{
-					int row;
-					for (row = 0; row < height; row++)
-						memcpy(&compressedBuffer.data[packedStride*row], &((const deUint8*)data)[row*stride], (size_t)(pixelSize*width));
-				}
-				else
-				{
-					qpPrintf("ERROR: Failed to pack pixels for writing.\n");
-					Buffer_deinit(&compressedBuffer);
-					return DE_FALSE;
-				}
-			}
+		job->compressionMode	= compressionMode;
+		job->imageFormat		= imageFormat;
+		job->width				= width;
+		job->height				= height;
 
-			writeDataBytes = (size_t)(packedStride*height);
-			break;
-		}
+		deMutex_lock(log->lock);
 
-#if defined(QP_SUPPORT_PNG)
-		case QP_IMAGE_COMPRESSION_MODE_PNG:
-			DE_ASSERT(writeDataPtr); /* Already handled. */
-			break;
-#endif
+		/* Image is written after all preceding data. */
+		qpXmlWriter_flush(log->writer);
+		submitPendingData(log);
 
-		default:
-			qpPrintf("qpTestLog_writeImage(): Unknown compression mode: %s\n", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, compressionMode));
-			Buffer_deinit(&compressedBuffer);
-			return DE_FALSE;
+		job->elementDepth = qpXmlWriter_getElementDepth(log->writer);
+		submitJob(log, job);
+
+		deMutex_unlock(log->lock);
+		return DE_TRUE;
 	}
 
-	/* Fill in attributes. */
-	int32ToString(width, widthStr);
-	int32ToString(height, heightStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
-	attribs[numAttribs++] = qpSetStringAttrib("Width", widthStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Height", heightStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Format", QP_LOOKUP_STRING(s_qpImageFormatMap, imageFormat));
-	attribs[numAttribs++] = qpSetStringAttrib("CompressionMode", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, compressionMode));
-	if (description) attribs[numAttribs++] = qpSetStringAttrib("Description", description);
+	Buffer_init(&compressedBuffer);
+
+	if (!encodeImage(&compressedBuffer, &compressionMode, imageFormat, width, height, stride, data, &writeDataPtr, &writeDataBytes))
+	{
+		Buffer_deinit(&compressedBuffer);
+		return DE_FALSE;
+	}
 
 	/* \note Log lock is acquired after compression! */
 	deMutex_lock(log->lock);
 
-	/* <Image ID="result" Name="Foobar" Width="640" Height="480" Format="RGB888" CompressionMode="None">base64 data</Image> */
-	if (!qpXmlWriter_startElement(log->writer, "Image", numAttribs, attribs) ||
-		!qpXmlWriter_writeBase64(log->writer, (const deUint8*)writeDataPtr, writeDataBytes) ||
-		!qpXmlWriter_endElement(log->writer, "Image"))
+	if (!writeImageElement(log->writer, name, description, compressionMode, imageFormat, width, height, writeDataPtr, writeDataBytes))
 	{
 		qpPrintf("qpTestLog_writeImage(): Writing XML failed\n");
 		deMutex_unlock(log->lock);
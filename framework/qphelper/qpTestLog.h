@@ -134,7 +134,9 @@ typedef enum qpTestLogFlag_e
 {
 	QP_TEST_LOG_EXCLUDE_IMAGES			= (1<<0),		/*!< Do not log images. This reduces log size considerably.			*/
 	QP_TEST_LOG_EXCLUDE_SHADER_SOURCES	= (1<<1),		/*!< Do not log shader sources. Helps to reduce log size further.	*/
-	QP_TEST_LOG_NO_FLUSH				= (1<<2)		/*!< Do not do a fflush after writing the log.						*/
+	QP_TEST_LOG_NO_FLUSH				= (1<<2),		/*!< Do not do a fflush after writing the log.						*/
+	QP_TEST_LOG_ASYNC_WRITE				= (1<<3),		/*!< Compress images and write the log in a background thread.		*/
+	QP_TEST_LOG_WRITE_CASE_INDEX		= (1<<4)		/*!< Write case index into <log file name>.idx.						*/
 } qpTestLogFlag;
 
 /* Shader type. */
@@ -33,30 +33,86 @@
 #include "deMemPool.h"
 #include "dePoolArray.h"
 
+enum
+{
+	QP_XML_WRITER_BUFFER_SIZE	= 16*1024	/*!< Output is collected into blocks of this size before writing. */
+};
+
 struct qpXmlWriter_s
 {
-	FILE*				outputFile;
+	qpXmlWriteFunc		writeFunc;
+	void*				writeFuncPtr;
+	FILE*				outputFile;			/*!< Output file, DE_NULL for stream writers. */
 	deBool				flushAfterWrite;
 
+	char				buffer[QP_XML_WRITER_BUFFER_SIZE];
+	size_t				bufferSize;
+
 	deBool				xmlPrevIsStartElement;
 	deBool				xmlIsWriting;
 	int					xmlElementDepth;
 };
 
+static void writeToFile (void* userPtr, const void* data, size_t numBytes)
+{
+	fwrite(data, 1, numBytes, (FILE*)userPtr);
+}
+
+static void flushBuffer (qpXmlWriter* writer)
+{
+	if (writer->bufferSize > 0)
+	{
+		writer->writeFunc(writer->writeFuncPtr, &writer->buffer[0], writer->bufferSize);
+		writer->bufferSize = 0;
+	}
+}
+
+static void writeBytes (qpXmlWriter* writer, const char* data, size_t numBytes)
+{
+	while (numBytes > 0)
+	{
+		const size_t	space		= (size_t)QP_XML_WRITER_BUFFER_SIZE - writer->bufferSize;
+		const size_t	numToCopy	= (numBytes < space) ? numBytes : space;
+
+		memcpy(&writer->buffer[writer->bufferSize], data, numToCopy);
+		writer->bufferSize	+= numToCopy;
+		data				+= numToCopy;
+		numBytes			-= numToCopy;
+
+		if (writer->bufferSize == QP_XML_WRITER_BUFFER_SIZE)
+			flushBuffer(writer);
+	}
+}
+
+static void writeStr (qpXmlWriter* writer, const char* str)
+{
+	writeBytes(writer, str, strlen(str));
+}
+
+/* Called after each completed element. Flushing per token would fflush several times per element. */
+static void endElementWrite (qpXmlWriter* writer)
+{
+	if (writer->flushAfterWrite)
+	{
+		flushBuffer(writer);
+
+		if (writer->outputFile)
+			fflush(writer->outputFile);
+	}
+}
+
 static deBool writeEscaped (qpXmlWriter* writer, const char* str)
 {
-	char		buf[256 + 10];
-	char*		d		= &buf[0];
-	const char*	s		= str;
-	deBool		isEOS	= DE_FALSE;
+	const char*	s			= str;
+	const char*	runStart	= str;
 
-	do
+	for (;;)
 	{
 		/* Check for characters that need to be escaped. */
 		const char* repl = DE_NULL;
 		switch (*s)
 		{
-			case 0:		isEOS = DE_TRUE;		break;
+			case 0:		break;
 			case '<':	repl = "&lt;";			break;
 			case '>':	repl = "&gt;";			break;
 			case '&':	repl = "&amp;";			break;
@@ -96,49 +152,58 @@ static deBool writeEscaped (qpXmlWriter* writer, const char* str)
 			default:	/* nada */				break;
 		}
 
-		/* Write out char or escape sequence. */
-		if (repl)
+		/* Write out run of plain characters preceding escape sequence or EOS. */
+		if (repl || *s == 0)
 		{
-			s++;
-			strcpy(d, repl);
-			d += strlen(repl);
-		}
-		else
-			*d++ = *s++;
+			writeBytes(writer, runStart, (size_t)(s - runStart));
 
-		/* Write buffer if EOS or buffer full. */
-		if (isEOS || ((d - &buf[0]) >= 4))
-		{
-			*d = 0;
-			fprintf(writer->outputFile, "%s", buf);
-			d = &buf[0];
+			if (!repl)
+				break;
+
+			writeStr(writer, repl);
+			runStart = s+1;
 		}
-	} while (!isEOS);
 
-	if (writer->flushAfterWrite)
-		fflush(writer->outputFile);
-	DE_ASSERT(d == &buf[0]); /* buffer must be empty */
+		s++;
+	}
+
 	return DE_TRUE;
 }
 
-qpXmlWriter* qpXmlWriter_createFileWriter (FILE* outputFile, deBool useCompression, deBool flushAfterWrite)
+static qpXmlWriter* createWriter (qpXmlWriteFunc writeFunc, void* writeFuncPtr, FILE* outputFile, deBool flushAfterWrite, int elementDepth)
 {
 	qpXmlWriter* writer = (qpXmlWriter*)deCalloc(sizeof(qpXmlWriter));
 	if (!writer)
 		return DE_NULL;
 
+	writer->writeFunc		= writeFunc;
+	writer->writeFuncPtr	= writeFuncPtr;
+	writer->outputFile		= outputFile;
+	writer->flushAfterWrite	= flushAfterWrite;
+	writer->xmlElementDepth	= elementDepth;
+
+	return writer;
+}
+
+qpXmlWriter* qpXmlWriter_createFileWriter (FILE* outputFile, deBool useCompression, deBool flushAfterWrite)
+{
 	DE_UNREF(useCompression); /* no compression supported. */
 
-	writer->outputFile = outputFile;
-	writer->flushAfterWrite = flushAfterWrite;
+	return createWriter(writeToFile, outputFile, outputFile, flushAfterWrite, 0);
+}
 
-	return writer;
+qpXmlWriter* qpXmlWriter_createStreamWriter (qpXmlWriteFunc writeFunc, void* userPtr, int elementDepth)
+{
+	DE_ASSERT(writeFunc && elementDepth >= 0);
+
+	return createWriter(writeFunc, userPtr, DE_NULL, DE_FALSE, elementDepth);
 }
 
 void qpXmlWriter_destroy (qpXmlWriter* writer)
 {
 	DE_ASSERT(writer);
 
+	flushBuffer(writer);
 	deFree(writer);
 }
 
@@ -146,7 +211,7 @@ static deBool closePending (qpXmlWriter* writer)
 {
 	if (writer->xmlPrevIsStartElement)
 	{
-		fprintf(writer->outputFile, ">\n");
+		writeStr(writer, ">\n");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 
@@ -156,6 +221,19 @@ static deBool closePending (qpXmlWriter* writer)
 void qpXmlWriter_flush (qpXmlWriter* writer)
 {
 	closePending(writer);
+	flushBuffer(writer);
+}
+
+int qpXmlWriter_getElementDepth (const qpXmlWriter* writer)
+{
+	return writer->xmlElementDepth;
+}
+
+deBool qpXmlWriter_writeRaw (qpXmlWriter* writer, const char* str)
+{
+	DE_ASSERT(writer && !writer->xmlPrevIsStartElement);
+	writeStr(writer, str);
+	return DE_TRUE;
 }
 
 deBool qpXmlWriter_startDocument (qpXmlWriter* writer)
@@ -164,7 +242,7 @@ deBool qpXmlWriter_startDocument (qpXmlWriter* writer)
 	writer->xmlIsWriting			= DE_TRUE;
 	writer->xmlElementDepth			= 0;
 	writer->xmlPrevIsStartElement	= DE_FALSE;
-	fprintf(writer->outputFile, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+	writeStr(writer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
 	return DE_TRUE;
 }
 
@@ -189,11 +267,12 @@ deBool qpXmlWriter_writeString (qpXmlWriter* writer, const char* str)
 {
 	if (writer->xmlPrevIsStartElement)
 	{
-		fprintf(writer->outputFile, ">");
+		writeStr(writer, ">");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 
-	return writeEscaped(writer, str);
+	writeEscaped(writer, str);
+	return DE_TRUE;
 }
 
 deBool qpXmlWriter_startElement(qpXmlWriter* writer, const char* elementName, int numAttribs, const qpXmlAttribute* attribs)
@@ -202,12 +281,16 @@ deBool qpXmlWriter_startElement(qpXmlWriter* writer, const char* elementName, in
 
 	closePending(writer);
 
-	fprintf(writer->outputFile, "%s<%s", getIndentStr(writer->xmlElementDepth), elementName);
+	writeStr(writer, getIndentStr(writer->xmlElementDepth));
+	writeStr(writer, "<");
+	writeStr(writer, elementName);
 
 	for (ndx = 0; ndx < numAttribs; ndx++)
 	{
 		const qpXmlAttribute* attrib = &attribs[ndx];
-		fprintf(writer->outputFile, " %s=\"", attrib->name);
+		writeStr(writer, " ");
+		writeStr(writer, attrib->name);
+		writeStr(writer, "=\"");
 		switch (attrib->type)
 		{
 			case QP_XML_ATTRIBUTE_STRING:
@@ -229,7 +312,7 @@ deBool qpXmlWriter_startElement(qpXmlWriter* writer, const char* elementName, in
 			default:
 				DE_ASSERT(DE_FALSE);
 		}
-		fprintf(writer->outputFile, "\"");
+		writeStr(writer, "\"");
 	}
 
 	writer->xmlElementDepth++;
@@ -244,12 +327,17 @@ deBool qpXmlWriter_endElement (qpXmlWriter* writer, const char* elementName)
 
 	if (writer->xmlPrevIsStartElement) /* leave flag as-is */
 	{
-		fprintf(writer->outputFile, " />\n");
+		writeStr(writer, " />\n");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 	else
-		fprintf(writer->outputFile, "</%s>\n", /*getIndentStr(writer->xmlElementDepth),*/ elementName);
+	{
+		writeStr(writer, "</");
+		writeStr(writer, /*getIndentStr(writer->xmlElementDepth),*/ elementName);
+		writeStr(writer, ">\n");
+	}
 
+	endElementWrite(writer);
 	return DE_TRUE;
 }
 
@@ -297,18 +385,18 @@ deBool qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, size_t
 		/* Write indent (if needed). */
 		if (writeIndent)
 		{
-			fprintf(writer->outputFile, "%s", indentStr);
+			writeStr(writer, indentStr);
 			writeIndent = DE_FALSE;
 		}
 
 		/* Write data. */
-		fprintf(writer->outputFile, "%s", &d[0]);
+		writeBytes(writer, &d[0], 4);
 
 		/* EOL every now and then. */
 		numWritten += 4;
 		if (numWritten >= 64)
 		{
-			fprintf(writer->outputFile, "\n");
+			writeStr(writer, "\n");
 			numWritten = 0;
 			writeIndent = DE_TRUE;
 		}
@@ -316,7 +404,7 @@ deBool qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, size_t
 
 	/* Last EOL. */
 	if (numWritten > 0)
-		fprintf(writer->outputFile, "\n");
+		writeStr(writer, "\n");
 
 	DE_ASSERT(srcNdx == numBytes);
 	return DE_TRUE;
@@ -31,6 +31,8 @@ DE_BEGIN_EXTERN_C
 
 typedef struct qpXmlWriter_s	qpXmlWriter;
 
+typedef void (*qpXmlWriteFunc) (void* userPtr, const void* data, size_t numBytes);
+
 typedef enum qpXmlAttributeType_e
 {
 	QP_XML_ATTRIBUTE_STRING = 0,
@@ -85,11 +87,26 @@ DE_INLINE qpXmlAttribute qpSetBoolAttrib (const char* name, deBool value)
  * \brief Create a file based XML Writer instance
  * \param fileName Name of the file
  * \param useCompression Set to DE_TRUE to use compression, if supported by implementation
- * \param flushAfterWrite Set to DE_TRUE to call fflush after writing each XML token
+ * \param flushAfterWrite Set to DE_TRUE to call fflush after writing each XML element
  * \return qpXmlWriter instance, or DE_NULL if cannot create file
  *//*--------------------------------------------------------------------*/
 qpXmlWriter*	qpXmlWriter_createFileWriter (FILE* outFile, deBool useCompression, deBool flushAfterWrite);
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Create a XML Writer instance that passes output to a function
+ *
+ * Output is buffered and passed to writeFunc in blocks when the buffer
+ * fills up and in qpXmlWriter_flush(). Stream writers can also be used
+ * for producing fragments of a document, elementDepth gives the initial
+ * element depth used for indentation.
+ *
+ * \param writeFunc Function receiving the output
+ * \param userPtr Pointer passed to writeFunc
+ * \param elementDepth Initial element depth
+ * \return qpXmlWriter instance, or DE_NULL on allocation failure
+ *//*--------------------------------------------------------------------*/
+qpXmlWriter*	qpXmlWriter_createStreamWriter (qpXmlWriteFunc writeFunc, void* userPtr, int elementDepth);
+
 /*--------------------------------------------------------------------*//*!
  * \brief XML Writer instance
  * \param a	qpXmlWriter instance
@@ -97,11 +114,30 @@ qpXmlWriter*	qpXmlWriter_createFileWriter (FILE* outFile, deBool useCompression,
 void			qpXmlWriter_destroy (qpXmlWriter* writer);
 
 /*--------------------------------------------------------------------*//*!
- * \brief XML Writer instance
+ * \brief Close pending start element and write out buffered output
  * \param a	qpXmlWriter instance
  *//*--------------------------------------------------------------------*/
 void			qpXmlWriter_flush (qpXmlWriter* writer);
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Get current element depth
+ * \param writer qpXmlWriter instance
+ * \return Number of currently open elements
+ *//*--------------------------------------------------------------------*/
+int				qpXmlWriter_getElementDepth (const qpXmlWriter* writer);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Write unescaped text into output
+ *
+ * Used for writing non-XML content between documents. Pending start
+ * element must have been closed with qpXmlWriter_flush().
+ *
+ * \param writer qpXmlWriter instance
+ * \param str Text to be written
+ * \return true on success, false on error
+ *//*--------------------------------------------------------------------*/
+deBool			qpXmlWriter_writeRaw (qpXmlWriter* writer, const char* str);
+
 /*--------------------------------------------------------------------*//*!
  * \brief Start XML document
  * \param writer qpXmlWriter instance
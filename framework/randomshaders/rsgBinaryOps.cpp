@@ -46,12 +46,11 @@ public:
 	void						tokenize				(GeneratorState& state, TokenStream& str) const;
 
 	void						evaluate				(ExecutionContext& execCtx);
-	ExecConstValueAccess		getValue				(void) const { return m_value.getValue(m_type); }
+	ExecConstValueAccess		getValue				(const ExecutionContext& ctx) const { return ctx.getTempValue(this, m_type); }
 
 private:
 	std::string					m_function;
 	VariableType				m_type;
-	ExecValueStorage			m_value;
 	Expression*					m_child;
 };
 
@@ -60,7 +59,6 @@ CustomAbsOp::CustomAbsOp (void)
 	, m_type			(VariableType::TYPE_FLOAT, 1)
 	, m_child			(DE_NULL)
 {
-	m_value.setStorage(m_type);
 }
 
 CustomAbsOp::~CustomAbsOp (void)
@@ -90,8 +88,8 @@ void CustomAbsOp::evaluate (ExecutionContext& execCtx)
 {
 	m_child->evaluate(execCtx);
 
-	ExecConstValueAccess	srcValue	= m_child->getValue();
-	ExecValueAccess			dstValue	= m_value.getValue(m_type);
+	ExecConstValueAccess	srcValue	= m_child->getValue(execCtx);
+	ExecValueAccess			dstValue	= execCtx.getTempValue(this, m_type);
 
 	for (int elemNdx = 0; elemNdx < m_type.getNumElements(); elemNdx++)
 	{
@@ -128,7 +126,6 @@ CustomBinaryOp<ComputeValue>::CustomBinaryOp ()
 	// By default add operation is assumed, for every other operation
 	// separate constructor specialization should be implemented
 	m_type = VariableType(VariableType::TYPE_FLOAT, 1);
-	m_value.setStorage(m_type);
 }
 
 template <>
@@ -139,7 +136,6 @@ CustomBinaryOp<EvaluateSub>::CustomBinaryOp ()
 	m_type = VariableType(VariableType::TYPE_FLOAT, 1);
 	m_leftValueRange =	ValueRange(m_type);
 	m_rightValueRange = ValueRange(m_type);
-	m_value.setStorage(m_type);
 }
 
 template <>
@@ -151,7 +147,6 @@ CustomBinaryOp<EvaluateLessThan>::CustomBinaryOp ()
 	VariableType floatType = VariableType(VariableType::TYPE_FLOAT, 1);
 	m_leftValueRange =	ValueRange(floatType);
 	m_rightValueRange = ValueRange(floatType);
-	m_value.setStorage(m_type);
 }
 
 template <typename ComputeValue>
@@ -175,8 +170,12 @@ void CustomBinaryOp<ComputeValue>::evaluate(ExecValueAccess dst, ExecConstValueA
 
 	for (int elemNdx = 0; elemNdx < dst.getType().getNumElements(); elemNdx++)
 	{
+		ExecConstValueAccess	aComp	= a.component(elemNdx);
+		ExecConstValueAccess	bComp	= b.component(elemNdx);
+		ExecValueAccess			dstComp	= dst.component(elemNdx);
+
 		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			dst.component(elemNdx).asFloat(compNdx) = ComputeValue()(a.component(elemNdx).asFloat(compNdx),b.component(elemNdx).asFloat(compNdx));
+			dstComp.asFloat(compNdx) = ComputeValue()(aComp.asFloat(compNdx), bComp.asFloat(compNdx));
 	}
 }
 
@@ -188,8 +187,12 @@ void CustomBinaryOp<EvaluateLessThan>::evaluate(ExecValueAccess dst, ExecConstVa
 
 	for (int elemNdx = 0; elemNdx < dst.getType().getNumElements(); elemNdx++)
 	{
+		ExecConstValueAccess	aComp	= a.component(elemNdx);
+		ExecConstValueAccess	bComp	= b.component(elemNdx);
+		ExecValueAccess			dstComp	= dst.component(elemNdx);
+
 		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			dst.component(elemNdx).asBool(compNdx) = EvaluateLessThan()(a.component(elemNdx).asFloat(compNdx),b.component(elemNdx).asFloat(compNdx));
+			dstComp.asBool(compNdx) = EvaluateLessThan()(aComp.asFloat(compNdx), bComp.asFloat(compNdx));
 	}
 }
 
@@ -353,9 +356,9 @@ void BinaryOp<Precedence, Assoc>::evaluate (ExecutionContext& execCtx)
 	m_leftValueExpr->evaluate(execCtx);
 	m_rightValueExpr->evaluate(execCtx);
 
-	ExecConstValueAccess	leftVal		= m_leftValueExpr->getValue();
-	ExecConstValueAccess	rightVal	= m_rightValueExpr->getValue();
-	ExecValueAccess			dst			= m_value.getValue(m_type);
+	ExecConstValueAccess	leftVal		= m_leftValueExpr->getValue(execCtx);
+	ExecConstValueAccess	rightVal	= m_rightValueExpr->getValue(execCtx);
+	ExecValueAccess			dst			= execCtx.getTempValue(this, m_type);
 
 	evaluate(dst, leftVal, rightVal);
 }
@@ -382,9 +385,8 @@ BinaryVecOp<Precedence, Float, Int, Bool, ComputeValueRange, EvaluateComp>::Bina
 		computeRandomValueRange(state, valueRange.asAccess());
 	}
 
-	// Choose type, allocate storage for execution
+	// Choose type
 	this->m_type = valueRange.getType();
-	this->m_value.setStorage(this->m_type);
 
 	// Initialize storage for value ranges
 	this->m_rightValueRange	= ValueRange(this->m_type);
@@ -442,16 +444,24 @@ void BinaryVecOp<Precedence, Float, Int, Bool, ComputeValueRange, EvaluateComp>:
 		case VariableType::TYPE_FLOAT:
 			for (int elemNdx = 0; elemNdx < dst.getType().getNumElements(); elemNdx++)
 			{
+				ExecConstValueAccess	aComp	= a.component(elemNdx);
+				ExecConstValueAccess	bComp	= b.component(elemNdx);
+				ExecValueAccess			dstComp	= dst.component(elemNdx);
+
 				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-					dst.component(elemNdx).asFloat(compNdx) = EvaluateComp()(a.component(elemNdx).asFloat(compNdx), b.component(elemNdx).asFloat(compNdx));
+					dstComp.asFloat(compNdx) = EvaluateComp()(aComp.asFloat(compNdx), bComp.asFloat(compNdx));
 			}
 			break;
 
 		case VariableType::TYPE_INT:
 			for (int elemNdx = 0; elemNdx < dst.getType().getNumElements(); elemNdx++)
 			{
+				ExecConstValueAccess	aComp	= a.component(elemNdx);
+				ExecConstValueAccess	bComp	= b.component(elemNdx);
+				ExecValueAccess			dstComp	= dst.component(elemNdx);
+
 				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-					dst.component(elemNdx).asInt(compNdx) = EvaluateComp()(a.component(elemNdx).asInt(compNdx), b.component(elemNdx).asInt(compNdx));
+					dstComp.asInt(compNdx) = EvaluateComp()(aComp.asInt(compNdx), bComp.asInt(compNdx));
 			}
 			break;
 
@@ -655,9 +665,8 @@ RelationalOp<ComputeValueRange, EvaluateComp>::RelationalOp (GeneratorState& sta
 		computeRandomValueRange(state, valueRange.asAccess());
 	}
 
-	// Choose type, allocate storage for execution
+	// Choose type
 	this->m_type = valueRange.getType();
-	this->m_value.setStorage(this->m_type);
 
 	// Choose random input type
 	VariableType::Type inBaseTypes[]	= { VariableType::TYPE_FLOAT, VariableType::TYPE_INT };
@@ -950,9 +959,8 @@ EqualityComparisonOp<IsEqual>::EqualityComparisonOp (GeneratorState& state, Cons
 		computeRandomValueRange(state, valueRange.asAccess());
 	}
 
-	// Choose type, allocate storage for execution
+	// Choose type
 	this->m_type = valueRange.getType();
-	this->m_value.setStorage(this->m_type);
 
 	// Choose random input type
 	VariableType::Type inBaseTypes[]	= { VariableType::TYPE_FLOAT, VariableType::TYPE_INT };
@@ -1022,14 +1030,14 @@ template <typename T>
 inline bool EqualityCompare<true>::compare	(T a, T b)			{ return a == b; }
 
 template <>
-inline bool EqualityCompare<true>::combine	(bool a, bool b)	{ return a && b; }
+inline bool EqualityCompare<true>::combine	(bool a, bool b)	{ return a & b; }
 
 template <>
 template <typename T>
 inline bool EqualityCompare<false>::compare	(T a, T b)			{ return a != b; }
 
 template <>
-inline bool EqualityCompare<false>::combine	(bool a, bool b)	{ return a || b; }
+inline bool EqualityCompare<false>::combine	(bool a, bool b)	{ return a | b; }
 
 } // anonymous
 
@@ -1038,42 +1046,42 @@ void EqualityComparisonOp<IsEqual>::evaluate (ExecValueAccess dst, ExecConstValu
 {
 	DE_ASSERT(a.getType() == b.getType());
 
+	// Element results are accumulated lane-wise into dst
+	for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+		dst.asBool(compNdx) = IsEqual ? true : false;
 
 	switch (a.getType().getBaseType())
 	{
 		case VariableType::TYPE_FLOAT:
-			for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+			for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
 			{
-				bool result = IsEqual ? true : false;
-
-				for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
-					result = EqualityCompare<IsEqual>::combine(result, EqualityCompare<IsEqual>::compare(a.component(elemNdx).asFloat(compNdx), b.component(elemNdx).asFloat(compNdx)));
+				ExecConstValueAccess	aComp	= a.component(elemNdx);
+				ExecConstValueAccess	bComp	= b.component(elemNdx);
 
-				dst.asBool(compNdx) = result;
+				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+					dst.asBool(compNdx) = EqualityCompare<IsEqual>::combine(dst.asBool(compNdx), EqualityCompare<IsEqual>::compare(aComp.asFloat(compNdx), bComp.asFloat(compNdx)));
 			}
 			break;
 
 		case VariableType::TYPE_INT:
-			for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+			for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
 			{
-				bool result = IsEqual ? true : false;
-
-				for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
-					result = EqualityCompare<IsEqual>::combine(result, EqualityCompare<IsEqual>::compare(a.component(elemNdx).asInt(compNdx), b.component(elemNdx).asInt(compNdx)));
+				ExecConstValueAccess	aComp	= a.component(elemNdx);
+				ExecConstValueAccess	bComp	= b.component(elemNdx);
 
-				dst.asBool(compNdx) = result;
+				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+					dst.asBool(compNdx) = EqualityCompare<IsEqual>::combine(dst.asBool(compNdx), EqualityCompare<IsEqual>::compare(aComp.asInt(compNdx), bComp.asInt(compNdx)));
 			}
 			break;
 
 		case VariableType::TYPE_BOOL:
-			for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+			for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
 			{
-				bool result = IsEqual ? true : false;
-
-				for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
-					result = EqualityCompare<IsEqual>::combine(result, EqualityCompare<IsEqual>::compare(a.component(elemNdx).asBool(compNdx), b.component(elemNdx).asBool(compNdx)));
+				ExecConstValueAccess	aComp	= a.component(elemNdx);
+				ExecConstValueAccess	bComp	= b.component(elemNdx);
 
-				dst.asBool(compNdx) = result;
+				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
+					dst.asBool(compNdx) = EqualityCompare<IsEqual>::combine(dst.asBool(compNdx), EqualityCompare<IsEqual>::compare(aComp.asBool(compNdx), bComp.asBool(compNdx)));
 			}
 			break;
 
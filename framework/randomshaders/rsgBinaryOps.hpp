@@ -47,7 +47,7 @@ public:
 	Expression*					createNextChild		(GeneratorState& state);
 	void						tokenize			(GeneratorState& state, TokenStream& str) const;
 	void						evaluate			(ExecutionContext& execCtx);
-	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(m_type); }
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const { return ctx.getTempValue(this, m_type); }
 
 	virtual void				evaluate			(ExecValueAccess dst, ExecConstValueAccess a, ExecConstValueAccess b) = DE_NULL;
 
@@ -56,7 +56,6 @@ protected:
 
 	Token::Type					m_operator;
 	VariableType				m_type;
-	ExecValueStorage			m_value;
 
 	ValueRange					m_leftValueRange;
 	ValueRange					m_rightValueRange;
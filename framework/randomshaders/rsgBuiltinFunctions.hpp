@@ -43,14 +43,13 @@ public:
 	void						tokenize				(GeneratorState& state, TokenStream& str) const;
 
 	void						evaluate				(ExecutionContext& execCtx);
-	ExecConstValueAccess		getValue				(void) const { return m_value.getValue(m_inValueRange.getType()); }
+	ExecConstValueAccess		getValue				(const ExecutionContext& ctx) const { return ctx.getTempValue(this, m_inValueRange.getType()); }
 
 	static float				getWeight				(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 private:
 	std::string					m_function;
 	ValueRange					m_inValueRange;
-	ExecValueStorage			m_value;
 	Expression*					m_child;
 };
 
@@ -63,8 +62,6 @@ UnaryBuiltinVecFunc<GetValueRangeWeight, ComputeValueRange, Evaluate>::UnaryBuil
 	DE_UNREF(state);
 	DE_ASSERT(valueRange.getType().isFloatOrVec());
 
-	m_value.setStorage(valueRange.getType());
-
 	// Compute input value range
 	for (int ndx = 0; ndx < m_inValueRange.getType().getNumElements(); ndx++)
 	{
@@ -104,8 +101,8 @@ void UnaryBuiltinVecFunc<GetValueRangeWeight, ComputeValueRange, Evaluate>::eval
 {
 	m_child->evaluate(execCtx);
 
-	ExecConstValueAccess	srcValue	= m_child->getValue();
-	ExecValueAccess			dstValue	= m_value.getValue(m_inValueRange.getType());
+	ExecConstValueAccess	srcValue	= m_child->getValue(execCtx);
+	ExecValueAccess			dstValue	= execCtx.getTempValue(this, m_inValueRange.getType());
 
 	for (int elemNdx = 0; elemNdx < m_inValueRange.getType().getNumElements(); elemNdx++)
 	{
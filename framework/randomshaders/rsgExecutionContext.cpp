@@ -56,6 +56,10 @@ ExecutionContext::~ExecutionContext (void)
 	for (VarValueMap::iterator i = m_varValues.begin(); i != m_varValues.end(); i++)
 		delete i->second;
 	m_varValues.clear();
+
+	for (ExprValueMap::iterator i = m_tmpValues.begin(); i != m_tmpValues.end(); i++)
+		delete i->second;
+	m_tmpValues.clear();
 }
 
 ExecValueAccess ExecutionContext::getValue (const Variable* variable)
@@ -71,6 +75,33 @@ ExecValueAccess ExecutionContext::getValue (const Variable* variable)
 	return storage->getValue(variable->getType());
 }
 
+ExecConstValueAccess ExecutionContext::getValue (const Variable* variable) const
+{
+	VarValueMap::const_iterator pos = m_varValues.find(variable);
+	DE_ASSERT(pos != m_varValues.end());
+	return pos->second->getValue(variable->getType());
+}
+
+ExecValueAccess ExecutionContext::getTempValue (const Expression* expr, const VariableType& type)
+{
+	ExecValueStorage* storage = m_tmpValues[expr];
+
+	if (!storage)
+	{
+		storage = new ExecValueStorage(type);
+		m_tmpValues[expr] = storage;
+	}
+
+	return storage->getValue(type);
+}
+
+ExecConstValueAccess ExecutionContext::getTempValue (const Expression* expr, const VariableType& type) const
+{
+	ExprValueMap::const_iterator pos = m_tmpValues.find(expr);
+	DE_ASSERT(pos != m_tmpValues.end());
+	return pos->second->getValue(type);
+}
+
 const Sampler2D& ExecutionContext::getSampler2D (const Variable* sampler) const
 {
 	const ExecValueStorage* samplerVal = m_varValues.find(sampler)->second;
@@ -96,7 +127,7 @@ void ExecutionContext::andExecutionMask (ExecConstValueAccess value)
 	ExecConstValueAccess	oldValue	= getExecutionMask();
 
 	for (int i = 0; i < EXEC_VEC_WIDTH; i++)
-		newValue.asBool(i) = oldValue.asBool(i) && value.asBool(i);
+		newValue.asBool(i) = oldValue.asBool(i) & value.asBool(i);
 
 	pushExecutionMask(newValue);
 }
@@ -153,10 +184,11 @@ void assignMasked (ExecValueAccess dst, ExecConstValueAccess src, ExecConstValue
 				ExecValueAccess			dstElem		= dst.component(elemNdx);
 				ExecConstValueAccess	srcElem		= src.component(elemNdx);
 
+				// Select with bit mask instead of branching per lane
 				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
 				{
-					if (mask.asBool(compNdx))
-						dstElem.asScalar(compNdx) = srcElem.asScalar(compNdx);
+					const int laneMask = -(int)mask.asBool(compNdx);
+					dstElem.asInt(compNdx) = (srcElem.asInt(compNdx) & laneMask) | (dstElem.asInt(compNdx) & ~laneMask);
 				}
 			}
 
@@ -43,7 +43,10 @@ typedef ConstStridedValueAccess<EXEC_VEC_WIDTH>			ExecConstValueAccess;
 typedef StridedValueAccess<EXEC_VEC_WIDTH>				ExecValueAccess;
 typedef ValueStorage<EXEC_VEC_WIDTH>					ExecValueStorage;
 
+class Expression;
+
 typedef std::map<const Variable*, ExecValueStorage*>	VarValueMap;
+typedef std::map<const Expression*, ExecValueStorage*>	ExprValueMap;
 
 class ExecMaskStorage
 {
@@ -64,6 +67,7 @@ public:
 									~ExecutionContext		(void);
 
 	ExecValueAccess					getValue				(const Variable* variable);
+	ExecConstValueAccess			getValue				(const Variable* variable) const;
 	const Sampler2D&				getSampler2D			(const Variable* variable) const;
 	const SamplerCube&				getSamplerCube			(const Variable* variable) const;
 
@@ -74,11 +78,16 @@ public:
 
 	void							popExecutionMask		(void);
 
+	// Expression results are stored in context so that same shader can be executed concurrently in separate contexts.
+	ExecValueAccess					getTempValue			(const Expression* expr, const VariableType& type);
+	ExecConstValueAccess			getTempValue			(const Expression* expr, const VariableType& type) const;
+
 protected:
 									ExecutionContext		(const ExecutionContext& other);
 	ExecutionContext&				operator=				(const ExecutionContext& other);
 
 	VarValueMap						m_varValues;
+	ExprValueMap					m_tmpValues;
 	const Sampler2DMap&				m_samplers2D;
 	const SamplerCubeMap&			m_samplersCube;
 	std::vector<ExecMaskStorage>	m_execMaskStack;
@@ -823,14 +823,13 @@ void ConstructorOp::evaluate (ExecutionContext& evalCtx)
 
 	// Compute value
 	const VariableType& type = m_valueRange.getType();
-	m_value.setStorage(type);
 
-	ExecValueAccess	dst				= m_value.getValue(type);
+	ExecValueAccess	dst				= evalCtx.getTempValue(this, type);
 	int				curScalarNdx	= 0;
 
 	for (vector<Expression*>::reverse_iterator i = m_inputExpressions.rbegin(); i != m_inputExpressions.rend(); i++)
 	{
-		ExecConstValueAccess src = (*i)->getValue();
+		ExecConstValueAccess src = (*i)->getValue(evalCtx);
 
 		for (int elemNdx = 0; elemNdx < src.getType().getNumElements(); elemNdx++)
 			convertExecValue(src.component(elemNdx), dst.component(curScalarNdx++));
@@ -965,11 +964,12 @@ void AssignOp::evaluate (ExecutionContext& evalCtx)
 
 	// Evaluate value
 	m_rvalueExpr->evaluate(evalCtx);
-	m_value.setStorage(m_valueRange.getType());
-	m_value.getValue(m_valueRange.getType()) = m_rvalueExpr->getValue().value();
+
+	ExecValueAccess value = evalCtx.getTempValue(this, m_valueRange.getType());
+	value = m_rvalueExpr->getValue(evalCtx).value();
 
 	// Assign
-	assignMasked(m_lvalueExpr->getLValue(), m_value.getValue(m_valueRange.getType()), evalCtx.getExecutionMask());
+	assignMasked(m_lvalueExpr->getLValue(evalCtx), value, evalCtx.getExecutionMask());
 }
 
 namespace
@@ -1242,7 +1242,8 @@ float VariableWrite::getWeight (const GeneratorState& state, ConstValueRangeAcce
 
 void VariableAccess::evaluate (ExecutionContext& evalCtx)
 {
-	m_valueAccess = evalCtx.getValue(m_variable);
+	// Allocates storage for variable if it doesn't exist yet
+	evalCtx.getValue(m_variable);
 }
 
 ParenOp::ParenOp (GeneratorState& state, ConstValueRangeAccess valueRange)
@@ -1303,8 +1304,6 @@ SwizzleOp::SwizzleOp (GeneratorState& state, ConstValueRangeAccess valueRange)
 			  m_outValueRange.getType().isIntOrVec()	||
 			  m_outValueRange.getType().isBoolOrVec());
 
-	m_value.setStorage(m_outValueRange.getType());
-
 	int numOutputElements	= m_outValueRange.getType().getNumElements();
 
 	// \note Swizzle works for vector types only.
@@ -1411,8 +1410,8 @@ void SwizzleOp::evaluate (ExecutionContext& execCtx)
 {
 	m_child->evaluate(execCtx);
 
-	ExecConstValueAccess	inValue		= m_child->getValue();
-	ExecValueAccess			outValue	= m_value.getValue(m_outValueRange.getType());
+	ExecConstValueAccess	inValue		= m_child->getValue(execCtx);
+	ExecValueAccess			outValue	= execCtx.getTempValue(this, m_outValueRange.getType());
 
 	for (int outElemNdx = 0; outElemNdx < outValue.getType().getNumElements(); outElemNdx++)
 	{
@@ -1439,7 +1438,6 @@ TexLookup::TexLookup (GeneratorState& state, ConstValueRangeAccess valueRange)
 	, m_coordExpr		(DE_NULL)
 	, m_lodBiasExpr		(DE_NULL)
 	, m_valueType		(VariableType::TYPE_FLOAT, 4)
-	, m_value			(m_valueType)
 {
 	DE_ASSERT(valueRange.getType() == VariableType(VariableType::TYPE_FLOAT, 4));
 	DE_UNREF(valueRange); // Texture output value range is constant.
@@ -1656,8 +1654,8 @@ void TexLookup::evaluate (ExecutionContext& execCtx)
 	if (m_lodBiasExpr)
 		m_lodBiasExpr->evaluate(execCtx);
 
-	ExecConstValueAccess	coords	= m_coordExpr->getValue();
-	ExecValueAccess			dst		= m_value.getValue(m_valueType);
+	ExecConstValueAccess	coords	= m_coordExpr->getValue(execCtx);
+	ExecValueAccess			dst		= execCtx.getTempValue(this, m_valueType);
 
 	switch (m_type)
 	{
@@ -1678,7 +1676,7 @@ void TexLookup::evaluate (ExecutionContext& execCtx)
 
 		case TYPE_TEXTURE2D_LOD:
 		{
-			ExecConstValueAccess	lod		= m_lodBiasExpr->getValue();
+			ExecConstValueAccess	lod		= m_lodBiasExpr->getValue(execCtx);
 			const Sampler2D&		tex		= execCtx.getSampler2D(m_sampler);
 			for (int i = 0; i < EXEC_VEC_WIDTH; i++)
 			{
@@ -1711,7 +1709,7 @@ void TexLookup::evaluate (ExecutionContext& execCtx)
 
 		case TYPE_TEXTURE2D_PROJ_LOD:
 		{
-			ExecConstValueAccess	lod		= m_lodBiasExpr->getValue();
+			ExecConstValueAccess	lod		= m_lodBiasExpr->getValue(execCtx);
 			const Sampler2D&		tex		= execCtx.getSampler2D(m_sampler);
 			for (int i = 0; i < EXEC_VEC_WIDTH; i++)
 			{
@@ -1745,7 +1743,7 @@ void TexLookup::evaluate (ExecutionContext& execCtx)
 
 		case TYPE_TEXTURECUBE_LOD:
 		{
-			ExecConstValueAccess	lod		= m_lodBiasExpr->getValue();
+			ExecConstValueAccess	lod		= m_lodBiasExpr->getValue(execCtx);
 			const SamplerCube&		tex		= execCtx.getSamplerCube(m_sampler);
 			for (int i = 0; i < EXEC_VEC_WIDTH; i++)
 			{
@@ -32,6 +32,9 @@
  *    must be valid after evaluate().
  *  + L-values: Valid writable value access proxy must be returned after
  *    evaluate().
+ *  + Nodes must not store execution state. Intermediate values are kept
+ *    in ExecutionContext (getTempValue()) so that the same expression tree
+ *    can be evaluated concurrently in separate contexts.
  *//*--------------------------------------------------------------------*/
 
 #include "rsgDefs.hpp"
@@ -58,8 +61,8 @@ public:
 
 	// Execution API
 	virtual void					evaluate			(ExecutionContext& ctx)	= DE_NULL;
-	virtual ExecConstValueAccess	getValue			(void) const			= DE_NULL;
-	virtual ExecValueAccess			getLValue			(void) const { DE_ASSERT(DE_FALSE); throw Exception("Expression::getLValue(): not L-value node"); }
+	virtual ExecConstValueAccess	getValue			(const ExecutionContext& ctx) const	= DE_NULL;
+	virtual ExecValueAccess			getLValue			(ExecutionContext& ctx) const { DE_UNREF(ctx); DE_ASSERT(DE_FALSE); throw Exception("Expression::getLValue(): not L-value node"); }
 
 	static Expression*				createRandom		(GeneratorState& state, ConstValueRangeAccess valueRange);
 	static Expression*				createRandomLValue	(GeneratorState& state, ConstValueRangeAccess valueRange);
@@ -74,14 +77,13 @@ public:
 	void						tokenize			(GeneratorState& state, TokenStream& str) const	{ DE_UNREF(state); str << Token(m_variable->getName());	}
 
 	void						evaluate			(ExecutionContext& ctx);
-	ExecConstValueAccess		getValue			(void) const									{ return m_valueAccess;									}
-	ExecValueAccess				getLValue			(void) const									{ return m_valueAccess;									}
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const				{ return ctx.getValue(m_variable);						}
+	ExecValueAccess				getLValue			(ExecutionContext& ctx) const					{ return ctx.getValue(m_variable);						}
 
 protected:
 								VariableAccess		(void) : m_variable(DE_NULL) {}
 
 	const Variable*				m_variable;
-	ExecValueAccess				m_valueAccess;
 };
 
 class VariableRead : public VariableAccess
@@ -116,7 +118,7 @@ public:
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 	void						evaluate			(ExecutionContext& ctx) { DE_UNREF(ctx); }
-	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_FLOAT)); }
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const { DE_UNREF(ctx); return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_FLOAT)); }
 
 private:
 	ExecValueStorage			m_value;
@@ -134,7 +136,7 @@ public:
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 	void						evaluate			(ExecutionContext& ctx) { DE_UNREF(ctx); }
-	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_INT)); }
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const { DE_UNREF(ctx); return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_INT)); }
 
 private:
 	ExecValueStorage			m_value;
@@ -153,7 +155,7 @@ public:
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 	void						evaluate			(ExecutionContext& ctx) { DE_UNREF(ctx); }
-	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_BOOL)); }
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const { DE_UNREF(ctx); return m_value.getValue(VariableType::getScalarType(VariableType::TYPE_BOOL)); }
 
 private:
 	ExecValueStorage			m_value;
@@ -171,11 +173,10 @@ public:
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 	void						evaluate			(ExecutionContext& ctx);
-	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(m_valueRange.getType()); }
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const { return ctx.getTempValue(this, m_valueRange.getType()); }
 
 private:
 	ValueRange					m_valueRange;
-	ExecValueStorage			m_value;
 
 	std::vector<ValueRange>		m_inputValueRanges;
 	std::vector<Expression*>	m_inputExpressions;
@@ -196,11 +197,10 @@ public:
 //	static float				getLValueWeight		(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 	void						evaluate			(ExecutionContext& ctx);
-	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(m_valueRange.getType()); }
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const { return ctx.getTempValue(this, m_valueRange.getType()); }
 
 private:
 	ValueRange					m_valueRange;
-	ExecValueStorage			m_value;
 
 	Expression*					m_lvalueExpr;
 	Expression*					m_rvalueExpr;
@@ -219,7 +219,7 @@ public:
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 	void						evaluate			(ExecutionContext& execCtx)		{ m_child->evaluate(execCtx);	}
-	ExecConstValueAccess		getValue			(void) const					{ return m_child->getValue();	}
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const	{ return m_child->getValue(ctx);	}
 
 private:
 	ValueRange					m_valueRange;
@@ -238,14 +238,13 @@ public:
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 	void						evaluate			(ExecutionContext& execCtx);
-	ExecConstValueAccess		getValue			(void) const					{ return m_value.getValue(m_outValueRange.getType()); }
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const	{ return ctx.getTempValue(this, m_outValueRange.getType()); }
 
 private:
 	ValueRange					m_outValueRange;
 	int							m_numInputElements;
 	deUint8						m_swizzle[4];
 	Expression*					m_child;
-	ExecValueStorage			m_value;
 };
 
 class TexLookup : public Expression
@@ -260,7 +259,7 @@ public:
 	static float				getWeight			(const GeneratorState& state, ConstValueRangeAccess valueRange);
 
 	void						evaluate			(ExecutionContext& execCtx);
-	ExecConstValueAccess		getValue			(void) const { return m_value.getValue(m_valueType); }
+	ExecConstValueAccess		getValue			(const ExecutionContext& ctx) const { return ctx.getTempValue(this, m_valueType); }
 
 private:
 	enum Type
@@ -281,7 +280,6 @@ private:
 	Expression*					m_coordExpr;
 	Expression*					m_lodBiasExpr;
 	VariableType				m_valueType;
-	ExecValueStorage			m_value;
 };
 
 } // rsg
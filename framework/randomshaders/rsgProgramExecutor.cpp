@@ -26,7 +26,10 @@
 #include "rsgVariableValue.hpp"
 #include "rsgUtils.hpp"
 #include "tcuSurface.hpp"
+#include "tcuWorkerPool.hpp"
+#include "deSharedPtr.hpp"
 #include "deMath.h"
+#include "deInt32.h"
 #include "deString.h"
 
 #include <set>
@@ -208,153 +211,246 @@ inline tcu::RGBA toColor (tcu::Vec4 rgba)
 					 deClamp32(deRoundFloatToInt32(rgba.w()*255), 0, 255));
 }
 
-void ProgramExecutor::execute (const Shader& vertexShader, const Shader& fragmentShader, const vector<VariableValue>& uniformValues)
+namespace
 {
-	int	gridVtxWidth	= m_gridWidth+1;
-	int gridVtxHeight	= m_gridHeight+1;
-	int numVertices		= gridVtxWidth*gridVtxHeight;
 
-	VaryingStore varyingStore(numVertices);
+typedef de::SharedPtr<ExecutionContext> ExecutionContextSp;
 
-	// Execute vertex shader
-	{
-		ExecutionContext	execCtx(m_samplers2D, m_samplersCube);
-		int					numPackets	= numVertices + ((numVertices%EXEC_VEC_WIDTH) ? 1 : 0);
+void createExecutionContexts (vector<ExecutionContextSp>& contexts, const Sampler2DMap& samplers2D, const SamplerCubeMap& samplersCube, const vector<VariableValue>& uniformValues)
+{
+	// One context per worker thread, since contexts hold all intermediate execution state
+	contexts.resize(tcu::getNumWorkerThreads());
 
-		const vector<ShaderInput*>& inputs	= vertexShader.getInputs();
-		vector<const Variable*>		outputs;
-		vertexShader.getOutputs(outputs);
+	for (size_t ctxNdx = 0; ctxNdx < contexts.size(); ctxNdx++)
+	{
+		contexts[ctxNdx] = ExecutionContextSp(new ExecutionContext(samplers2D, samplersCube));
 
 		// Set uniform values
 		for (vector<VariableValue>::const_iterator uniformIter = uniformValues.begin(); uniformIter != uniformValues.end(); uniformIter++)
-			execCtx.getValue(uniformIter->getVariable()) = uniformIter->getValue().value();
+			contexts[ctxNdx]->getValue(uniformIter->getVariable()) = uniformIter->getValue().value();
+	}
+}
+
+class VertexPacketExecutor : public tcu::ParallelWork
+{
+public:
+									VertexPacketExecutor	(const Shader& shader, const vector<ExecutionContextSp>& contexts, VaryingStore& varyingStore, int gridVtxWidth, int gridVtxHeight);
+
+	int								getNumPackets			(void) const { return deDivRoundUp32(m_numVertices, EXEC_VEC_WIDTH); }
+	void							execute					(int workerNdx, int packetNdx);
+
+private:
+	const Shader&					m_shader;
+	const vector<ExecutionContextSp>&	m_contexts;
+	const int						m_gridVtxWidth;
+	const int						m_gridVtxHeight;
+	const int						m_numVertices;
+
+	vector<const Variable*>			m_outputs;
+	vector<VaryingStorage*>			m_outputStorage;
+};
+
+VertexPacketExecutor::VertexPacketExecutor (const Shader& shader, const vector<ExecutionContextSp>& contexts, VaryingStore& varyingStore, int gridVtxWidth, int gridVtxHeight)
+	: m_shader			(shader)
+	, m_contexts		(contexts)
+	, m_gridVtxWidth	(gridVtxWidth)
+	, m_gridVtxHeight	(gridVtxHeight)
+	, m_numVertices		(gridVtxWidth*gridVtxHeight)
+{
+	vector<const Variable*> outputs;
+	shader.getOutputs(outputs);
 
-		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+	// Allocate varying storage up front, VaryingStore is not thread-safe
+	for (vector<const Variable*>::const_iterator i = outputs.begin(); i != outputs.end(); i++)
+	{
+		const Variable* output = *i;
+
+		if (deStringEqual(output->getName(), "gl_Position"))
+			continue; // Do not store position
+
+		m_outputs.push_back(output);
+		m_outputStorage.push_back(varyingStore.getStorage(output->getType(), output->getName()));
+	}
+}
+
+void VertexPacketExecutor::execute (int workerNdx, int packetNdx)
+{
+	ExecutionContext&			execCtx		= *m_contexts[workerNdx];
+	const vector<ShaderInput*>&	inputs		= m_shader.getInputs();
+	int							packetStart	= packetNdx*EXEC_VEC_WIDTH;
+	int							packetEnd	= deMin32((packetNdx+1)*EXEC_VEC_WIDTH, m_numVertices);
+
+	// Compute values for vertex shader inputs
+	for (vector<ShaderInput*>::const_iterator i = inputs.begin(); i != inputs.end(); i++)
+	{
+		const ShaderInput*	input	= *i;
+		ExecValueAccess		access	= execCtx.getValue(input->getVariable());
+
+		for (int vtxNdx = packetStart; vtxNdx < packetEnd; vtxNdx++)
 		{
-			int packetStart	= packetNdx*EXEC_VEC_WIDTH;
-			int packetEnd	= deMin32((packetNdx+1)*EXEC_VEC_WIDTH, numVertices);
-
-			// Compute values for vertex shader inputs
-			for (vector<ShaderInput*>::const_iterator i = inputs.begin(); i != inputs.end(); i++)
-			{
-				const ShaderInput*	input	= *i;
-				ExecValueAccess		access	= execCtx.getValue(input->getVariable());
-
-				for (int vtxNdx = packetStart; vtxNdx < packetEnd; vtxNdx++)
-				{
-					int		y	= (vtxNdx/gridVtxWidth);
-					int		x	= vtxNdx - y*gridVtxWidth;
-					float	xf	= (float)x / (float)(gridVtxWidth-1);
-					float	yf	= (float)y / (float)(gridVtxHeight-1);
-
-					interpolateVertexInput(access, vtxNdx-packetStart, input->getValueRange(), xf, yf);
-				}
-			}
-
-			// Execute vertex shader for packet
-			vertexShader.execute(execCtx);
-
-			// Store output values
-			for (vector<const Variable*>::const_iterator i = outputs.begin(); i != outputs.end(); i++)
-			{
-				const Variable*			output	= *i;
-
-				if (deStringEqual(output->getName(), "gl_Position"))
-					continue; // Do not store position
-
-				ExecConstValueAccess	access	= execCtx.getValue(output);
-				VaryingStorage*			dst		= varyingStore.getStorage(output->getType(), output->getName());
-
-				for (int vtxNdx = packetStart; vtxNdx < packetEnd; vtxNdx++)
-				{
-					ValueAccess varyingAccess = dst->getValue(output->getType(), vtxNdx);
-					copyVarying(varyingAccess, access, vtxNdx-packetStart);
-				}
-			}
+			int		y	= (vtxNdx/m_gridVtxWidth);
+			int		x	= vtxNdx - y*m_gridVtxWidth;
+			float	xf	= (float)x / (float)(m_gridVtxWidth-1);
+			float	yf	= (float)y / (float)(m_gridVtxHeight-1);
+
+			interpolateVertexInput(access, vtxNdx-packetStart, input->getValueRange(), xf, yf);
 		}
 	}
 
-	// Execute fragment shader
+	// Execute vertex shader for packet
+	m_shader.execute(execCtx);
+
+	// Store output values
+	for (size_t outputNdx = 0; outputNdx < m_outputs.size(); outputNdx++)
 	{
-		ExecutionContext execCtx(m_samplers2D, m_samplersCube);
+		const Variable*			output	= m_outputs[outputNdx];
+		ExecConstValueAccess	access	= execCtx.getValue(output);
+		VaryingStorage*			dst		= m_outputStorage[outputNdx];
 
-		// Assign uniform values
-		for (vector<VariableValue>::const_iterator i = uniformValues.begin(); i != uniformValues.end(); i++)
-			execCtx.getValue(i->getVariable()) = i->getValue().value();
+		for (int vtxNdx = packetStart; vtxNdx < packetEnd; vtxNdx++)
+		{
+			ValueAccess varyingAccess = dst->getValue(output->getType(), vtxNdx);
+			copyVarying(varyingAccess, access, vtxNdx-packetStart);
+		}
+	}
+}
 
-		const vector<ShaderInput*>& inputs			= fragmentShader.getInputs();
-		const Variable*				fragColorVar	= DE_NULL;
-		vector<const Variable*>		outputs;
+class FragmentPacketExecutor : public tcu::ParallelWork
+{
+public:
+									FragmentPacketExecutor	(const Shader& shader, const vector<ExecutionContextSp>& contexts, VaryingStore& varyingStore, const tcu::PixelBufferAccess& dst, int gridWidth, int gridHeight);
 
-		// Find fragment shader output assigned to location 0. This is fragment color.
-		fragmentShader.getOutputs(outputs);
-		for (vector<const Variable*>::const_iterator i = outputs.begin(); i != outputs.end(); i++)
+	int								getNumPackets			(void) const { return deDivRoundUp32(m_width*m_height, EXEC_VEC_WIDTH); }
+	void							execute					(int workerNdx, int packetNdx);
+
+private:
+	const Shader&					m_shader;
+	const vector<ExecutionContextSp>&	m_contexts;
+	const tcu::PixelBufferAccess&	m_dst;
+	const int						m_width;
+	const int						m_height;
+	const int						m_gridVtxWidth;
+	const int						m_gridVtxHeight;
+	const float						m_cellWidth;
+	const float						m_cellHeight;
+
+	const Variable*					m_fragColorVar;
+	vector<const VaryingStorage*>	m_inputStorage;
+};
+
+FragmentPacketExecutor::FragmentPacketExecutor (const Shader& shader, const vector<ExecutionContextSp>& contexts, VaryingStore& varyingStore, const tcu::PixelBufferAccess& dst, int gridWidth, int gridHeight)
+	: m_shader			(shader)
+	, m_contexts		(contexts)
+	, m_dst				(dst)
+	, m_width			(dst.getWidth())
+	, m_height			(dst.getHeight())
+	, m_gridVtxWidth	(gridWidth+1)
+	, m_gridVtxHeight	(gridHeight+1)
+	, m_cellWidth		((float)m_width / (float)gridWidth)
+	, m_cellHeight		((float)m_height / (float)gridHeight)
+	, m_fragColorVar	(DE_NULL)
+{
+	const vector<ShaderInput*>&	inputs	= shader.getInputs();
+	vector<const Variable*>		outputs;
+
+	// Find fragment shader output assigned to location 0. This is fragment color.
+	shader.getOutputs(outputs);
+	for (vector<const Variable*>::const_iterator i = outputs.begin(); i != outputs.end(); i++)
+	{
+		if ((*i)->getLayoutLocation() == 0)
 		{
-			if ((*i)->getLayoutLocation() == 0)
-			{
-				fragColorVar = *i;
-				break;
-			}
+			m_fragColorVar = *i;
+			break;
 		}
-		TCU_CHECK(fragColorVar);
+	}
+	TCU_CHECK(m_fragColorVar);
 
-		int	width		= m_dst.getWidth();
-		int height		= m_dst.getHeight();
-		int numPackets	= (width*height)/EXEC_VEC_WIDTH + (((width*height)%EXEC_VEC_WIDTH) ? 1 : 0);
+	// Resolve varying storage up front, VaryingStore is not thread-safe
+	for (vector<ShaderInput*>::const_iterator i = inputs.begin(); i != inputs.end(); i++)
+		m_inputStorage.push_back(varyingStore.getStorage((*i)->getVariable()->getType(), (*i)->getVariable()->getName()));
+}
 
-		float cellWidth		= (float)width	/ (float)m_gridWidth;
-		float cellHeight	= (float)height	/ (float)m_gridHeight;
+void FragmentPacketExecutor::execute (int workerNdx, int packetNdx)
+{
+	ExecutionContext&			execCtx		= *m_contexts[workerNdx];
+	const vector<ShaderInput*>&	inputs		= m_shader.getInputs();
+	int							packetStart	= packetNdx*EXEC_VEC_WIDTH;
+	int							packetEnd	= deMin32((packetNdx+1)*EXEC_VEC_WIDTH, m_width*m_height);
 
-		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+	// Interpolate varyings
+	for (size_t inputNdx = 0; inputNdx < inputs.size(); inputNdx++)
+	{
+		const ShaderInput*		input	= inputs[inputNdx];
+		ExecValueAccess			access	= execCtx.getValue(input->getVariable());
+		const VariableType&		type	= input->getVariable()->getType();
+		const VaryingStorage*	src		= m_inputStorage[inputNdx];
+
+		// \todo [2011-03-08 pyry] Part of this could be pre-computed...
+		for (int fragNdx = packetStart; fragNdx < packetEnd; fragNdx++)
 		{
-			int packetStart	= packetNdx*EXEC_VEC_WIDTH;
-			int packetEnd	= deMin32((packetNdx+1)*EXEC_VEC_WIDTH, width*height);
-
-			// Interpolate varyings
-			for (vector<ShaderInput*>::const_iterator i = inputs.begin(); i != inputs.end(); i++)
-			{
-				const ShaderInput*		input	= *i;
-				ExecValueAccess			access	= execCtx.getValue(input->getVariable());
-				const VariableType&		type	= input->getVariable()->getType();
-				const VaryingStorage*	src		= varyingStore.getStorage(type, input->getVariable()->getName());
-
-				// \todo [2011-03-08 pyry] Part of this could be pre-computed...
-				for (int fragNdx = packetStart; fragNdx < packetEnd; fragNdx++)
-				{
-					int y = fragNdx/width;
-					int x = fragNdx - y*width;
-					tcu::IVec4	vtxIndices	= computeVertexIndices(cellWidth, cellHeight, gridVtxWidth, gridVtxHeight, x, y);
-					tcu::Vec2	weights		= computeGridCellWeights(cellWidth, cellHeight, x, y);
-
-					interpolateFragmentInput(access, fragNdx-packetStart,
-											 src->getValue(type, vtxIndices.x()),
-											 src->getValue(type, vtxIndices.y()),
-											 src->getValue(type, vtxIndices.z()),
-											 src->getValue(type, vtxIndices.w()),
-											 weights.x(), weights.y());
-				}
-			}
-
-			// Execute fragment shader
-			fragmentShader.execute(execCtx);
-
-			// Write resulting color
-			ExecConstValueAccess colorValue = execCtx.getValue(fragColorVar);
-			for (int fragNdx = packetStart; fragNdx < packetEnd; fragNdx++)
-			{
-				int			y		= fragNdx/width;
-				int			x		= fragNdx - y*width;
-				int			cNdx	= fragNdx-packetStart;
-				tcu::Vec4	c		= tcu::Vec4(colorValue.component(0).asFloat(cNdx),
-												colorValue.component(1).asFloat(cNdx),
-												colorValue.component(2).asFloat(cNdx),
-												colorValue.component(3).asFloat(cNdx));
-
-				// \todo [2012-11-13 pyry] Reverse order.
-				m_dst.setPixel(c, x, m_dst.getHeight()-y-1);
-			}
+			int y = fragNdx/m_width;
+			int x = fragNdx - y*m_width;
+			tcu::IVec4	vtxIndices	= computeVertexIndices(m_cellWidth, m_cellHeight, m_gridVtxWidth, m_gridVtxHeight, x, y);
+			tcu::Vec2	weights		= computeGridCellWeights(m_cellWidth, m_cellHeight, x, y);
+
+			interpolateFragmentInput(access, fragNdx-packetStart,
+									 src->getValue(type, vtxIndices.x()),
+									 src->getValue(type, vtxIndices.y()),
+									 src->getValue(type, vtxIndices.z()),
+									 src->getValue(type, vtxIndices.w()),
+									 weights.x(), weights.y());
 		}
 	}
+
+	// Execute fragment shader
+	m_shader.execute(execCtx);
+
+	// Write resulting color
+	ExecConstValueAccess colorValue = execCtx.getValue(m_fragColorVar);
+	for (int fragNdx = packetStart; fragNdx < packetEnd; fragNdx++)
+	{
+		int			y		= fragNdx/m_width;
+		int			x		= fragNdx - y*m_width;
+		int			cNdx	= fragNdx-packetStart;
+		tcu::Vec4	c		= tcu::Vec4(colorValue.component(0).asFloat(cNdx),
+										colorValue.component(1).asFloat(cNdx),
+										colorValue.component(2).asFloat(cNdx),
+										colorValue.component(3).asFloat(cNdx));
+
+		// \todo [2012-11-13 pyry] Reverse order.
+		m_dst.setPixel(c, x, m_height-y-1);
+	}
+}
+
+} // anonymous
+
+void ProgramExecutor::execute (const Shader& vertexShader, const Shader& fragmentShader, const vector<VariableValue>& uniformValues)
+{
+	int	gridVtxWidth	= m_gridWidth+1;
+	int gridVtxHeight	= m_gridHeight+1;
+	int numVertices		= gridVtxWidth*gridVtxHeight;
+
+	VaryingStore varyingStore(numVertices);
+
+	// Packets are independent and are executed in parallel, each worker thread using its own execution context.
+
+	// Execute vertex shader
+	{
+		vector<ExecutionContextSp> contexts;
+		createExecutionContexts(contexts, m_samplers2D, m_samplersCube, uniformValues);
+
+		VertexPacketExecutor executor(vertexShader, contexts, varyingStore, gridVtxWidth, gridVtxHeight);
+		tcu::executeParallel(executor, executor.getNumPackets());
+	}
+
+	// Execute fragment shader
+	{
+		vector<ExecutionContextSp> contexts;
+		createExecutionContexts(contexts, m_samplers2D, m_samplersCube, uniformValues);
+
+		FragmentPacketExecutor executor(fragmentShader, contexts, varyingStore, m_dst, m_gridWidth, m_gridHeight);
+		tcu::executeParallel(executor, executor.getNumPackets());
+	}
 }
 
 } // rsg
@@ -348,7 +348,7 @@ void DeclarationStatement::execute (ExecutionContext& execCtx) const
 	if (m_expression)
 	{
 		m_expression->evaluate(execCtx);
-		execCtx.getValue(m_variable) = m_expression->getValue().value();
+		execCtx.getValue(m_variable) = m_expression->getValue(execCtx).value();
 	}
 }
 
@@ -502,7 +502,7 @@ void ConditionalStatement::execute (ExecutionContext& execCtx) const
 	ExecMaskStorage	maskStorage; // Value might change when we are evaluating true block so we have to take a copy.
 	ExecValueAccess	trueMask	= maskStorage.getValue();
 
-	trueMask = m_condition->getValue().value();
+	trueMask = m_condition->getValue(execCtx).value();
 
 	// And mask, execute true statement and pop
 	execCtx.andExecutionMask(trueMask);
@@ -563,7 +563,7 @@ void AssignStatement::tokenize (GeneratorState& state, TokenStream& str) const
 void AssignStatement::execute (ExecutionContext& execCtx) const
 {
 	m_valueExpr->evaluate(execCtx);
-	assignMasked(execCtx.getValue(m_variable), m_valueExpr->getValue(), execCtx.getExecutionMask());
+	assignMasked(execCtx.getValue(m_variable), m_valueExpr->getValue(execCtx), execCtx.getExecutionMask());
 }
 
 } // rsg
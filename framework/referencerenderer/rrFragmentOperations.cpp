@@ -64,6 +64,87 @@ static inline Vec4 unpremultiply (const Vec4& v)
 	}
 }
 
+// Direct-access helpers for the most common buffer formats. These must match tcu::PixelBufferAccess
+// conversions bit-exactly, since the fast paths are selected based on buffer format only.
+
+static inline deUint32 readUnorm24 (const deUint8* ptr)
+{
+#if (DE_ENDIANNESS == DE_LITTLE_ENDIAN)
+	return ((deUint32)ptr[0]) | (((deUint32)ptr[1]) << 8u) | (((deUint32)ptr[2]) << 16u);
+#else
+	return (((deUint32)ptr[0]) << 16u) | (((deUint32)ptr[1]) << 8u) | ((deUint32)ptr[2]);
+#endif
+}
+
+static inline void writeUnorm24 (deUint8* ptr, deUint32 value)
+{
+#if (DE_ENDIANNESS == DE_LITTLE_ENDIAN)
+	ptr[0] = (deUint8)(value & 0xFFu);
+	ptr[1] = (deUint8)((value >> 8u) & 0xFFu);
+	ptr[2] = (deUint8)((value >> 16u) & 0xFFu);
+#else
+	ptr[0] = (deUint8)((value >> 16u) & 0xFFu);
+	ptr[1] = (deUint8)((value >> 8u) & 0xFFu);
+	ptr[2] = (deUint8)(value & 0xFFu);
+#endif
+}
+
+//! Float to 24-bit unorm with round-to-nearest-even and saturation, as done by PixelBufferAccess::setPixDepth().
+static inline deUint32 depthToUnorm24 (float depth)
+{
+	const float	scaled	= depth * 16777215.0f;
+	const float	frac	= deFloatFrac(scaled);
+	deInt64		intVal	= (deInt64)(scaled - frac);
+
+	if (frac == 0.5f)
+	{
+		if (intVal % 2 != 0)
+			intVal++;
+	}
+	else if (frac > 0.5f)
+		intVal++;
+
+	return (deUint32)de::clamp<deInt64>(intVal, 0, 0xFFFFFF);
+}
+
+static inline Vec4 readRGBA8Float (const deUint8* ptr)
+{
+	return Vec4(ptr[0]/255.0f, ptr[1]/255.0f, ptr[2]/255.0f, ptr[3]/255.0f);
+}
+
+// Compare whole sample register worth of depth values at once. Values of dead samples are
+// computed as well but ignored by the caller, which keeps the loops free of branches.
+template <typename T>
+static void compareDepthValues (TestFunc depthFunc, int numValues, const T* sampleDepths, const T* bufferDepths, bool* passed)
+{
+#define DEPTH_VALUES_COMPARE(COMPARE_EXPRESSION)						\
+	for (int ndx = 0; ndx < numValues; ndx++)							\
+	{																	\
+		const T sampleDepth			= sampleDepths[ndx];				\
+		const T depthBufferValue	= bufferDepths[ndx];				\
+		DE_UNREF(sampleDepth);											\
+		DE_UNREF(depthBufferValue);										\
+																		\
+		passed[ndx] = (COMPARE_EXPRESSION);								\
+	}
+
+	switch (depthFunc)
+	{
+		case TESTFUNC_NEVER:	DEPTH_VALUES_COMPARE(false)								break;
+		case TESTFUNC_ALWAYS:	DEPTH_VALUES_COMPARE(true)								break;
+		case TESTFUNC_LESS:		DEPTH_VALUES_COMPARE(sampleDepth <  depthBufferValue)	break;
+		case TESTFUNC_LEQUAL:	DEPTH_VALUES_COMPARE(sampleDepth <= depthBufferValue)	break;
+		case TESTFUNC_GREATER:	DEPTH_VALUES_COMPARE(sampleDepth >  depthBufferValue)	break;
+		case TESTFUNC_GEQUAL:	DEPTH_VALUES_COMPARE(sampleDepth >= depthBufferValue)	break;
+		case TESTFUNC_EQUAL:	DEPTH_VALUES_COMPARE(sampleDepth == depthBufferValue)	break;
+		case TESTFUNC_NOTEQUAL:	DEPTH_VALUES_COMPARE(sampleDepth != depthBufferValue)	break;
+		default:
+			DE_ASSERT(false);
+	}
+
+#undef DEPTH_VALUES_COMPARE
+}
+
 void clearMultisampleColorBuffer	(const tcu::PixelBufferAccess& dst, const Vec4& v,	const WindowRectangle& r)	{ tcu::clear(tcu::getSubregion(dst, 0, r.left, r.bottom, dst.getWidth(), r.width, r.height), v);				}
 void clearMultisampleColorBuffer	(const tcu::PixelBufferAccess& dst, const IVec4& v,	const WindowRectangle& r)	{ tcu::clear(tcu::getSubregion(dst, 0, r.left, r.bottom, dst.getWidth(), r.width, r.height), v);				}
 void clearMultisampleColorBuffer	(const tcu::PixelBufferAccess& dst, const UVec4& v,	const WindowRectangle& r)	{ tcu::clear(tcu::getSubregion(dst, 0, r.left, r.bottom, dst.getWidth(), r.width, r.height), v.cast<int>());	}
@@ -71,7 +152,8 @@ void clearMultisampleDepthBuffer	(const tcu::PixelBufferAccess& dst, float v,		c
 void clearMultisampleStencilBuffer	(const tcu::PixelBufferAccess& dst, int v,			const WindowRectangle& r)	{ tcu::clearStencil(tcu::getSubregion(dst, 0, r.left, r.bottom, dst.getWidth(), r.width, r.height), v);			}
 
 FragmentProcessor::FragmentProcessor (void)
-	: m_sampleRegister()
+	: m_sampleRegister			()
+	, m_formatKernelsEnabled	(true)
 {
 }
 
@@ -317,6 +399,108 @@ void FragmentProcessor::executeDepthWrite (int fragNdxOffset, int numSamplesPerF
 	}
 }
 
+void FragmentProcessor::executeD32FDepthCompare (int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, TestFunc depthFunc, const tcu::ConstPixelBufferAccess& depthBuffer)
+{
+	float	sampleDepths[SAMPLE_REGISTER_SIZE];
+	float	bufferDepths[SAMPLE_REGISTER_SIZE];
+	bool	passed[SAMPLE_REGISTER_SIZE];
+
+	DE_ASSERT(depthBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::FLOAT));
+
+	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+	{
+		if (m_sampleRegister[regSampleNdx].isAlive)
+		{
+			const int			fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
+			const Fragment&		frag			= inputFragments[fragNdxOffset + regSampleNdx/numSamplesPerFragment];
+
+			sampleDepths[regSampleNdx]	= de::clamp(frag.sampleDepths[fragSampleNdx], 0.0f, 1.0f);
+			bufferDepths[regSampleNdx]	= *(const float*)depthBuffer.getPixelPtr(fragSampleNdx, frag.pixelCoord.x(), frag.pixelCoord.y());
+		}
+		else
+		{
+			sampleDepths[regSampleNdx]	= 0.0f;
+			bufferDepths[regSampleNdx]	= 0.0f;
+		}
+	}
+
+	compareDepthValues(depthFunc, SAMPLE_REGISTER_SIZE, sampleDepths, bufferDepths, passed);
+
+	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+	{
+		if (m_sampleRegister[regSampleNdx].isAlive)
+			m_sampleRegister[regSampleNdx].depthPassed = passed[regSampleNdx];
+	}
+}
+
+void FragmentProcessor::executeD32FDepthWrite (int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::PixelBufferAccess& depthBuffer)
+{
+	DE_ASSERT(depthBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::FLOAT));
+
+	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+	{
+		if (m_sampleRegister[regSampleNdx].isAlive && m_sampleRegister[regSampleNdx].depthPassed)
+		{
+			const int			fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
+			const Fragment&		frag			= inputFragments[fragNdxOffset + regSampleNdx/numSamplesPerFragment];
+
+			*(float*)depthBuffer.getPixelPtr(fragSampleNdx, frag.pixelCoord.x(), frag.pixelCoord.y()) = de::clamp(frag.sampleDepths[fragSampleNdx], 0.0f, 1.0f);
+		}
+	}
+}
+
+void FragmentProcessor::executeD24DepthCompare (int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, TestFunc depthFunc, const tcu::ConstPixelBufferAccess& depthBuffer)
+{
+	deUint32	sampleDepths[SAMPLE_REGISTER_SIZE];
+	deUint32	bufferDepths[SAMPLE_REGISTER_SIZE];
+	bool		passed[SAMPLE_REGISTER_SIZE];
+
+	DE_ASSERT(depthBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::UNORM_INT24));
+
+	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+	{
+		if (m_sampleRegister[regSampleNdx].isAlive)
+		{
+			const int			fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
+			const Fragment&		frag			= inputFragments[fragNdxOffset + regSampleNdx/numSamplesPerFragment];
+
+			// \note Input depth is converted to buffer format for comparison, like in executeDepthCompare().
+			sampleDepths[regSampleNdx]	= depthToUnorm24(frag.sampleDepths[fragSampleNdx]);
+			bufferDepths[regSampleNdx]	= readUnorm24((const deUint8*)depthBuffer.getPixelPtr(fragSampleNdx, frag.pixelCoord.x(), frag.pixelCoord.y()));
+		}
+		else
+		{
+			sampleDepths[regSampleNdx]	= 0u;
+			bufferDepths[regSampleNdx]	= 0u;
+		}
+	}
+
+	compareDepthValues(depthFunc, SAMPLE_REGISTER_SIZE, sampleDepths, bufferDepths, passed);
+
+	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+	{
+		if (m_sampleRegister[regSampleNdx].isAlive)
+			m_sampleRegister[regSampleNdx].depthPassed = passed[regSampleNdx];
+	}
+}
+
+void FragmentProcessor::executeD24DepthWrite (int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::PixelBufferAccess& depthBuffer)
+{
+	DE_ASSERT(depthBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::UNORM_INT24));
+
+	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+	{
+		if (m_sampleRegister[regSampleNdx].isAlive && m_sampleRegister[regSampleNdx].depthPassed)
+		{
+			const int			fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
+			const Fragment&		frag			= inputFragments[fragNdxOffset + regSampleNdx/numSamplesPerFragment];
+			const float			clampedDepth	= de::clamp(frag.sampleDepths[fragSampleNdx], 0.0f, 1.0f);
+
+			writeUnorm24((deUint8*)depthBuffer.getPixelPtr(fragSampleNdx, frag.pixelCoord.x(), frag.pixelCoord.y()), depthToUnorm24(clampedDepth));
+		}
+	}
+}
+
 void FragmentProcessor::executeStencilDpFailAndPass (int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const StencilState& stencilState, int numStencilBits, const tcu::PixelBufferAccess& stencilBuffer)
 {
 #define SAMPLE_REGISTER_DPFAIL_OR_DPPASS(CONDITION, EXPRESSION)																													\
@@ -759,6 +943,27 @@ void FragmentProcessor::executeMaskedColorWrite (int fragNdxOffset, int numSampl
 	}
 }
 
+void FragmentProcessor::executeRGBA8MaskedColorWrite (int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::BVec4& colorMask, const tcu::PixelBufferAccess& colorBuffer)
+{
+	DE_ASSERT(colorBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8));
+
+	// \note Masked channels are left untouched instead of being written back through float conversion.
+	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
+	{
+		if (m_sampleRegister[regSampleNdx].isAlive)
+		{
+			const int			fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
+			const Fragment&		frag			= inputFragments[fragNdxOffset + regSampleNdx/numSamplesPerFragment];
+			deUint8* const		dstPtr			= (deUint8*)colorBuffer.getPixelPtr(fragSampleNdx, frag.pixelCoord.x(), frag.pixelCoord.y());
+
+			if (colorMask[0]) dstPtr[0] = tcu::floatToU8(m_sampleRegister[regSampleNdx].blendedRGB.x());
+			if (colorMask[1]) dstPtr[1] = tcu::floatToU8(m_sampleRegister[regSampleNdx].blendedRGB.y());
+			if (colorMask[2]) dstPtr[2] = tcu::floatToU8(m_sampleRegister[regSampleNdx].blendedRGB.z());
+			if (colorMask[3]) dstPtr[3] = tcu::floatToU8(m_sampleRegister[regSampleNdx].blendedA);
+		}
+	}
+}
+
 void FragmentProcessor::executeSignedValueWrite (int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::BVec4& colorMask, const tcu::PixelBufferAccess& colorBuffer)
 {
 	for (int regSampleNdx = 0; regSampleNdx < SAMPLE_REGISTER_SIZE; regSampleNdx++)
@@ -829,6 +1034,12 @@ void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColor
 	Vec4					colorMaskNegationFactor		(state.colorMask[0] ? 0.0f : 1.0f, state.colorMask[1] ? 0.0f : 1.0f, state.colorMask[2] ? 0.0f : 1.0f, state.colorMask[3] ? 0.0f : 1.0f);
 	bool					sRGBTarget					= state.sRGBEnabled && tcu::isSRGB(colorBuffer.getFormat());
 
+	// Formats with specialized implementations of the per-sample operations.
+	const bool				isD32FDepthBuffer			= m_formatKernelsEnabled && hasDepth && depthBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::FLOAT);
+	const bool				isD24DepthBuffer			= m_formatKernelsEnabled && hasDepth && depthBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::UNORM_INT24);
+	const bool				isRGBA8ColorBuffer			= m_formatKernelsEnabled && colorBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8);
+	const bool				isRGBA8OrSRGBA8ColorBuffer	= isRGBA8ColorBuffer || (m_formatKernelsEnabled && colorBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::sRGBA, tcu::TextureFormat::UNORM_INT8));
+
 	DE_ASSERT(SAMPLE_REGISTER_SIZE % numSamplesPerFragment == 0);
 
 	// Divide the fragments' samples into groups of size SAMPLE_REGISTER_SIZE, and perform
@@ -878,10 +1089,27 @@ void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColor
 
 		if (doDepthTest)
 		{
-			executeDepthCompare(groupFirstFragNdx, numSamplesPerFragment, inputFragments, state.depthFunc, depthBuffer);
+			if (isD32FDepthBuffer)
+			{
+				executeD32FDepthCompare(groupFirstFragNdx, numSamplesPerFragment, inputFragments, state.depthFunc, depthBuffer);
 
-			if (state.depthMask)
-				executeDepthWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, depthBuffer);
+				if (state.depthMask)
+					executeD32FDepthWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, depthBuffer);
+			}
+			else if (isD24DepthBuffer)
+			{
+				executeD24DepthCompare(groupFirstFragNdx, numSamplesPerFragment, inputFragments, state.depthFunc, depthBuffer);
+
+				if (state.depthMask)
+					executeD24DepthWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, depthBuffer);
+			}
+			else
+			{
+				executeDepthCompare(groupFirstFragNdx, numSamplesPerFragment, inputFragments, state.depthFunc, depthBuffer);
+
+				if (state.depthMask)
+					executeDepthWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, depthBuffer);
+			}
 		}
 
 		// Do dpFail and dpPass stencil writes.
@@ -934,7 +1162,9 @@ void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColor
 						{
 							int					fragSampleNdx	= regSampleNdx % numSamplesPerFragment;
 							const Fragment&		frag			= inputFragments[groupFirstFragNdx + regSampleNdx/numSamplesPerFragment];
-							Vec4				dstColor		= colorBuffer.getPixel(fragSampleNdx, frag.pixelCoord.x(), frag.pixelCoord.y());
+							Vec4				dstColor		= isRGBA8OrSRGBA8ColorBuffer
+																? readRGBA8Float((const deUint8*)colorBuffer.getPixelPtr(fragSampleNdx, frag.pixelCoord.x(), frag.pixelCoord.y()))
+																: colorBuffer.getPixel(fragSampleNdx, frag.pixelCoord.x(), frag.pixelCoord.y());
 
 							m_sampleRegister[regSampleNdx].clampedBlendSrcColor		= clamp(frag.value.get<float>(), minClampValue, maxClampValue);
 							m_sampleRegister[regSampleNdx].clampedBlendSrc1Color	= clamp(frag.value1.get<float>(), minClampValue, maxClampValue);
@@ -1003,13 +1233,18 @@ void FragmentProcessor::render (const rr::MultisamplePixelBufferAccess&		msColor
 
 				if (state.colorMask[0] && state.colorMask[1] && state.colorMask[2] && state.colorMask[3])
 				{
-					if (colorBuffer.getFormat() == tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8))
+					if (isRGBA8ColorBuffer)
 						executeRGBA8ColorWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, colorBuffer);
 					else
 						executeColorWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, sRGBTarget, colorBuffer);
 				}
 				else if (state.colorMask[0] || state.colorMask[1] || state.colorMask[2] || state.colorMask[3])
-					executeMaskedColorWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, colorMaskFactor, colorMaskNegationFactor, sRGBTarget, colorBuffer);
+				{
+					if (isRGBA8ColorBuffer)
+						executeRGBA8MaskedColorWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, state.colorMask, colorBuffer);
+					else
+						executeMaskedColorWrite(groupFirstFragNdx, numSamplesPerFragment, inputFragments, colorMaskFactor, colorMaskNegationFactor, sRGBTarget, colorBuffer);
+				}
 				break;
 			}
 			case rr::GENERICVECTYPE_INT32:
@@ -98,6 +98,9 @@ class FragmentProcessor
 public:
 				FragmentProcessor	(void);
 
+	//! Use generic getPixel()/setPixel() paths for all formats if disabled. Used for testing the format-specialized kernels.
+	void		setFormatKernelsEnabled	(bool enabled) { m_formatKernelsEnabled = enabled; }
+
 	void		render				(const rr::MultisamplePixelBufferAccess&	colorMultisampleBuffer,
 									 const rr::MultisamplePixelBufferAccess&	depthMultisampleBuffer,
 									 const rr::MultisamplePixelBufferAccess&	stencilMultisampleBuffer,
@@ -137,6 +140,10 @@ private:
 	void		executeDepthBoundsTest			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const float minDepthBound, const float maxDepthBound, const tcu::ConstPixelBufferAccess& depthBuffer);
 	void		executeDepthCompare				(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, TestFunc depthFunc, const tcu::ConstPixelBufferAccess& depthBuffer);
 	void		executeDepthWrite				(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::PixelBufferAccess& depthBuffer);
+	void		executeD32FDepthCompare			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, TestFunc depthFunc, const tcu::ConstPixelBufferAccess& depthBuffer);
+	void		executeD32FDepthWrite			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::PixelBufferAccess& depthBuffer);
+	void		executeD24DepthCompare			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, TestFunc depthFunc, const tcu::ConstPixelBufferAccess& depthBuffer);
+	void		executeD24DepthWrite			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::PixelBufferAccess& depthBuffer);
 	void		executeStencilDpFailAndPass		(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const StencilState& stencilState, int numStencilBits, const tcu::PixelBufferAccess& stencilBuffer);
 	void		executeBlendFactorComputeRGB	(const tcu::Vec4& blendColor, const BlendState& blendRGBState);
 	void		executeBlendFactorComputeA		(const tcu::Vec4& blendColor, const BlendState& blendAState);
@@ -146,10 +153,12 @@ private:
 	void		executeColorWrite				(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, bool isSRGB, const tcu::PixelBufferAccess& colorBuffer);
 	void		executeRGBA8ColorWrite			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::PixelBufferAccess& colorBuffer);
 	void		executeMaskedColorWrite			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::Vec4& colorMaskFactor, const tcu::Vec4& colorMaskNegationFactor, bool isSRGB, const tcu::PixelBufferAccess& colorBuffer);
+	void		executeRGBA8MaskedColorWrite	(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::BVec4& colorMask, const tcu::PixelBufferAccess& colorBuffer);
 	void		executeSignedValueWrite			(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::BVec4& colorMask, const tcu::PixelBufferAccess& colorBuffer);
 	void		executeUnsignedValueWrite		(int fragNdxOffset, int numSamplesPerFragment, const Fragment* inputFragments, const tcu::BVec4& colorMask, const tcu::PixelBufferAccess& colorBuffer);
 
 	SampleData	m_sampleRegister[SAMPLE_REGISTER_SIZE];
+	bool		m_formatKernelsEnabled;
 } DE_WARN_UNUSED_TYPE;
 
 } // rr
@@ -447,6 +447,27 @@ bool doesLineSegmentExitDiamond (const SubpixelLineSegment& line, const tcu::Vec
 
 TriangleRasterizer::TriangleRasterizer (const tcu::IVec4& viewport, const int numSamples, const RasterizationState& state)
 	: m_viewport				(viewport)
+	, m_tile					(viewport)
+	, m_numSamples				(numSamples)
+	, m_winding					(state.winding)
+	, m_horizontalFill			(state.horizontalFill)
+	, m_verticalFill			(state.verticalFill)
+	, m_face					(FACETYPE_LAST)
+	, m_viewportOrientation		(state.viewportOrientation)
+{
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Create triangle rasterizer restricted to a tile
+ *
+ * Generated fragment packets are identical to those generated without a
+ * tile, except that packets and samples outside tile are discarded. This
+ * allows rasterizing viewport in independent tiles without changing the
+ * 2x2 packet grid used for derivatives.
+ *//*--------------------------------------------------------------------*/
+TriangleRasterizer::TriangleRasterizer (const tcu::IVec4& viewport, const int numSamples, const RasterizationState& state, const tcu::IVec4& tile)
+	: m_viewport				(viewport)
+	, m_tile					(tile)
 	, m_numSamples				(numSamples)
 	, m_winding					(state.winding)
 	, m_horizontalFill			(state.horizontalFill)
@@ -530,9 +551,41 @@ void TriangleRasterizer::init (const tcu::Vec4& v0, const tcu::Vec4& v1, const t
 	m_bboxMax.x() = de::clamp(m_bboxMax.x(), wX0, wX1);
 	m_bboxMax.y() = de::clamp(m_bboxMax.y(), wY0, wY1);
 
+	// Clamp to tile. Bounding box start is moved only in steps of two pixels to retain packet alignment.
+	{
+		const int	tX0		= m_tile.x();
+		const int	tY0		= m_tile.y();
+		const int	tX1		= tX0 + m_tile.z() - 1;
+		const int	tY1		= tY0 + m_tile.w() - 1;
+
+		if (m_bboxMin.x() < tX0)
+			m_bboxMin.x() = tX0 - ((tX0 - m_bboxMin.x()) & 1);
+		if (m_bboxMin.y() < tY0)
+			m_bboxMin.y() = tY0 - ((tY0 - m_bboxMin.y()) & 1);
+
+		m_bboxMax.x() = de::min(m_bboxMax.x(), tX1);
+		m_bboxMax.y() = de::min(m_bboxMax.y(), tY1);
+	}
+
 	m_curPos = m_bboxMin;
 }
 
+deUint64 TriangleRasterizer::getTileCoverageMask (int x0, int y0) const
+{
+	const bool	inX0	= de::inRange(x0,	m_tile.x(), m_tile.x() + m_tile.z() - 1);
+	const bool	inX1	= de::inRange(x0+1,	m_tile.x(), m_tile.x() + m_tile.z() - 1);
+	const bool	inY0	= de::inRange(y0,	m_tile.y(), m_tile.y() + m_tile.w() - 1);
+	const bool	inY1	= de::inRange(y0+1,	m_tile.y(), m_tile.y() + m_tile.w() - 1);
+	deUint64	mask	= 0;
+
+	if (inX0 && inY0)	mask |= getCoverageFragmentSampleBits(m_numSamples, 0, 0);
+	if (inX1 && inY0)	mask |= getCoverageFragmentSampleBits(m_numSamples, 1, 0);
+	if (inX0 && inY1)	mask |= getCoverageFragmentSampleBits(m_numSamples, 0, 1);
+	if (inX1 && inY1)	mask |= getCoverageFragmentSampleBits(m_numSamples, 1, 1);
+
+	return mask;
+}
+
 void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized)
 {
 	DE_ASSERT(maxFragmentPackets > 0);
@@ -590,6 +643,9 @@ void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPa
 		coverage = setCoverageValue(coverage, 1, 0, 1, 0, !outY1 &&				isInsideCCW(m_edge01, e01[2]) && isInsideCCW(m_edge12, e12[2]) && isInsideCCW(m_edge20, e20[2]));
 		coverage = setCoverageValue(coverage, 1, 1, 1, 0, !outX1 && !outY1 &&	isInsideCCW(m_edge01, e01[3]) && isInsideCCW(m_edge12, e12[3]) && isInsideCCW(m_edge20, e20[3]));
 
+		// Discard fragments outside tile
+		coverage &= getTileCoverageMask(x0, y0);
+
 		// Advance to next location
 		m_curPos.x() += 2;
 		if (m_curPos.x() > m_bboxMax.x())
@@ -779,6 +835,9 @@ void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPac
 			coverage = setCoverageValue(coverage, NumSamples, 1, 1, sampleNdx, !outX1 && !outY1 &&	isInsideCCW(m_edge01, e01[sampleNdx][3]) && isInsideCCW(m_edge12, e12[sampleNdx][3]) && isInsideCCW(m_edge20, e20[sampleNdx][3]));
 		}
 
+		// Discard fragments outside tile
+		coverage &= getTileCoverageMask(x0, y0);
+
 		// Advance to next location
 		m_curPos.x() += 2;
 		if (m_curPos.x() > m_bboxMax.x())
@@ -1027,6 +1086,13 @@ MultiSampleLineRasterizer::MultiSampleLineRasterizer (const int numSamples, cons
 {
 }
 
+MultiSampleLineRasterizer::MultiSampleLineRasterizer (const int numSamples, const tcu::IVec4& viewport, const tcu::IVec4& tile)
+	: m_numSamples			(numSamples)
+	, m_triangleRasterizer0 (viewport, m_numSamples, RasterizationState(), tile)
+	, m_triangleRasterizer1 (viewport, m_numSamples, RasterizationState(), tile)
+{
+}
+
 MultiSampleLineRasterizer::~MultiSampleLineRasterizer ()
 {
 }
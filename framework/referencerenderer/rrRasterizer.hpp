@@ -114,6 +114,7 @@ struct EdgeFunction
  *  - Depth interpolation
  *  - Perspective-correct barycentric computation for interpolation
  *  - Visible face determination
+ *  - Restricting output to a tile while keeping 2x2 packet alignment
  *
  * It does not (and will not) implement following:
  *  - Triangle setup
@@ -128,6 +129,7 @@ class TriangleRasterizer
 {
 public:
 							TriangleRasterizer		(const tcu::IVec4& viewport, const int numSamples, const RasterizationState& state);
+							TriangleRasterizer		(const tcu::IVec4& viewport, const int numSamples, const RasterizationState& state, const tcu::IVec4& tile);
 
 	void					init					(const tcu::Vec4& v0, const tcu::Vec4& v1, const tcu::Vec4& v2);
 
@@ -141,8 +143,11 @@ private:
 	template<int NumSamples>
 	void					rasterizeMultiSample	(FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized);
 
+	deUint64				getTileCoverageMask		(int x0, int y0) const;
+
 	// Constant rasterization state.
 	const tcu::IVec4		m_viewport;
+	const tcu::IVec4		m_tile;					//!< Only fragments inside tile are generated. Packets are aligned as if rasterizing the whole viewport.
 	const int				m_numSamples;
 	const Winding			m_winding;
 	const HorizontalFill	m_horizontalFill;
@@ -220,6 +225,7 @@ class MultiSampleLineRasterizer
 {
 public:
 								MultiSampleLineRasterizer	(const int numSamples, const tcu::IVec4& viewport);
+								MultiSampleLineRasterizer	(const int numSamples, const tcu::IVec4& viewport, const tcu::IVec4& tile);
 								~MultiSampleLineRasterizer	();
 
 	void						init						(const tcu::Vec4& v0, const tcu::Vec4& v1, float lineWidth);
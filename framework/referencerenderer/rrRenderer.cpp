@@ -28,9 +28,10 @@
 #include "rrPrimitiveAssembler.hpp"
 #include "rrFragmentOperations.hpp"
 #include "rrRasterizer.hpp"
+#include "tcuWorkerPool.hpp"
 #include "deMemory.h"
-
-#include <set>
+#include "deInt32.h"
+#include "deSharedPtr.hpp"
 
 namespace rr
 {
@@ -41,11 +42,17 @@ typedef double ClipFloat; // floating point type used in clipping
 
 typedef tcu::Vector<ClipFloat, 4> ClipVec4;
 
+enum
+{
+	RASTERIZATION_TILE_SIZE		= 64	//!< Tile size used in parallel rasterization
+};
+
 struct RasterizationInternalBuffers
 {
 	std::vector<FragmentPacket>		fragmentPackets;
 	std::vector<GenericVec4>		shaderOutputs;
 	std::vector<Fragment>			shadedFragments;
+	std::vector<float>				depthValues;
 	float*							fragmentDepthBuffer;
 };
 
@@ -88,9 +95,103 @@ bool isEmpty (const rr::MultisampleConstPixelBufferAccess& access)
 	return access.raw().getWidth() == 0 || access.raw().getHeight() == 0 || access.raw().getDepth() == 0;
 }
 
+inline deUint32 hashKey (int key)					{ return deInt32Hash(key);	}
+inline deUint32 hashKey (const VertexPacket* key)	{ return dePointerHash(key);	}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Open-addressed hash map with constant-time clear
+ *
+ * Each entry stores the generation it was inserted in, and clear() only
+ * advances the current generation. Entries from earlier generations are
+ * treated as empty. Used for lookups repeated for each primitive batch.
+ *//*--------------------------------------------------------------------*/
+template <typename KeyType, typename ValueType>
+class GenerationHashMap
+{
+public:
+						GenerationHashMap	(void) : m_generation(0) {}
+
+	//! Remove all entries and make room for at least maxEntries entries.
+	void				clear				(size_t maxEntries);
+
+	//! Insert entry unless key is already present. Returns false if key was present.
+	bool				insert				(const KeyType& key, const ValueType& value);
+	const ValueType*	find				(const KeyType& key) const;
+
+private:
+	struct Entry
+	{
+		KeyType			key;
+		ValueType		value;
+		deUint32		generation;
+	};
+
+	size_t				findSlot			(const KeyType& key) const;
+
+	std::vector<Entry>	m_entries;
+	deUint32			m_generation;
+};
+
+template <typename KeyType, typename ValueType>
+void GenerationHashMap<KeyType, ValueType>::clear (size_t maxEntries)
+{
+	// Keep load factor at most 1/2
+	const size_t	minSize	= deSmallestGreaterOrEquallPowerOfTwoSize(de::max<size_t>(2*maxEntries, 16));
+	const Entry		empty	= { KeyType(), ValueType(), 0u };
+
+	if (m_entries.size() < minSize)
+		m_entries.assign(minSize, empty);
+	else if (m_generation == ~0u)
+	{
+		// Stamps would wrap around, reset all entries
+		std::fill(m_entries.begin(), m_entries.end(), empty);
+		m_generation = 0;
+	}
+
+	m_generation += 1;
+}
+
+template <typename KeyType, typename ValueType>
+size_t GenerationHashMap<KeyType, ValueType>::findSlot (const KeyType& key) const
+{
+	const size_t	mask	= m_entries.size()-1;
+	size_t			slot	= (size_t)hashKey(key) & mask;
+
+	DE_ASSERT(m_generation != 0);
+
+	// Linear probing, terminates at first empty slot
+	while (m_entries[slot].generation == m_generation && m_entries[slot].key != key)
+		slot = (slot + 1) & mask;
+
+	return slot;
+}
+
+template <typename KeyType, typename ValueType>
+bool GenerationHashMap<KeyType, ValueType>::insert (const KeyType& key, const ValueType& value)
+{
+	Entry& entry = m_entries[findSlot(key)];
+
+	if (entry.generation == m_generation)
+		return false;
+
+	entry.key			= key;
+	entry.value			= value;
+	entry.generation	= m_generation;
+	return true;
+}
+
+template <typename KeyType, typename ValueType>
+const ValueType* GenerationHashMap<KeyType, ValueType>::find (const KeyType& key) const
+{
+	const Entry& entry = m_entries[findSlot(key)];
+	return entry.generation == m_generation ? &entry.value : DE_NULL;
+}
+
 struct DrawContext
 {
-	int primitiveID;
+	int												primitiveID;
+	GenerationHashMap<const VertexPacket*, bool>	distinctVertices;	//!< Used by makeSharedVerticesDistinct()
+	std::vector<pa::Triangle>						clippedTriangles;	//!< Used by clipPrimitives()
 
 	DrawContext (void)
 		: primitiveID(0)
@@ -271,7 +372,50 @@ struct SubTriangle
 	TriangleVertex vertices[3];
 };
 
-void clipTriangleOneVertex (std::vector<TriangleVertex>& clippedEdges, const ClipVolumePlane& plane, const TriangleVertex& clipped, const TriangleVertex& v1, const TriangleVertex& v2)
+enum
+{
+	MAX_CONVEX_POLYGON_VERTICES	= 4,		//!< Clipping a triangle to a plane produces a triangle or a quad
+	MAX_SUBTRIANGLES			= 1 << 6	//!< Each of the 6 planes splits a subtriangle into at most two
+};
+
+struct ConvexPolygon
+{
+	TriangleVertex	vertices[MAX_CONVEX_POLYGON_VERTICES];
+	int				numVertices;
+
+	ConvexPolygon (void)
+		: numVertices(0)
+	{
+	}
+
+	void addVertex (const TriangleVertex& v)
+	{
+		DE_ASSERT(numVertices < MAX_CONVEX_POLYGON_VERTICES);
+		vertices[numVertices++] = v;
+	}
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get clip code of a point
+ *
+ * Bit N is set if the point is outside of plane N. Planes are in order
+ * +X, -X, +Y, -Y, +Z, -Z. Test matches ComponentPlane::pointInClipVolume().
+ *//*--------------------------------------------------------------------*/
+deUint32 getClipCode (const tcu::Vec4& position)
+{
+	const ClipFloat	clipVolumeSize	= (ClipFloat)1.0;
+	const ClipVec4	p				= vec4ToClipVec4(position);
+	const ClipFloat	w				= clipVolumeSize * p.w();
+
+	return (( p.x() <= w) ? (0u) : (1u << 0))
+		 | ((-p.x() <= w) ? (0u) : (1u << 1))
+		 | (( p.y() <= w) ? (0u) : (1u << 2))
+		 | ((-p.y() <= w) ? (0u) : (1u << 3))
+		 | (( p.z() <= w) ? (0u) : (1u << 4))
+		 | ((-p.z() <= w) ? (0u) : (1u << 5));
+}
+
+void clipTriangleOneVertex (ConvexPolygon& clippedEdges, const ClipVolumePlane& plane, const TriangleVertex& clipped, const TriangleVertex& v1, const TriangleVertex& v2)
 {
 	const ClipFloat	degenerateLimit = (ClipFloat)1.0;
 
@@ -331,21 +475,21 @@ void clipTriangleOneVertex (std::vector<TriangleVertex>& clippedEdges, const Cli
 	if (!outputDegenerate)
 	{
 		// gen quad (v1) -> mid1 -> mid2 -> (v2)
-		clippedEdges.push_back(v1);
-		clippedEdges.push_back(mid1);
-		clippedEdges.push_back(mid2);
-		clippedEdges.push_back(v2);
+		clippedEdges.addVertex(v1);
+		clippedEdges.addVertex(mid1);
+		clippedEdges.addVertex(mid2);
+		clippedEdges.addVertex(v2);
 	}
 	else
 	{
 		// don't modify
-		clippedEdges.push_back(v1);
-		clippedEdges.push_back(clipped);
-		clippedEdges.push_back(v2);
+		clippedEdges.addVertex(v1);
+		clippedEdges.addVertex(clipped);
+		clippedEdges.addVertex(v2);
 	}
 }
 
-void clipTriangleTwoVertices (std::vector<TriangleVertex>& clippedEdges, const ClipVolumePlane& plane, const TriangleVertex& v0, const TriangleVertex& clipped1, const TriangleVertex& clipped2)
+void clipTriangleTwoVertices (ConvexPolygon& clippedEdges, const ClipVolumePlane& plane, const TriangleVertex& v0, const TriangleVertex& clipped1, const TriangleVertex& clipped2)
 {
 	const ClipFloat	unclippableLimit = (ClipFloat)1.0;
 
@@ -406,34 +550,34 @@ void clipTriangleTwoVertices (std::vector<TriangleVertex>& clippedEdges, const C
 	if (!unclippableVertex1 && !unclippableVertex2)
 	{
 		// gen triangle (v0) -> mid1 -> mid2
-		clippedEdges.push_back(v0);
-		clippedEdges.push_back(mid1);
-		clippedEdges.push_back(mid2);
+		clippedEdges.addVertex(v0);
+		clippedEdges.addVertex(mid1);
+		clippedEdges.addVertex(mid2);
 	}
 	else if (!unclippableVertex1 && unclippableVertex2)
 	{
 		// clip just vertex 1
-		clippedEdges.push_back(v0);
-		clippedEdges.push_back(mid1);
-		clippedEdges.push_back(clipped2);
+		clippedEdges.addVertex(v0);
+		clippedEdges.addVertex(mid1);
+		clippedEdges.addVertex(clipped2);
 	}
 	else if (unclippableVertex1 && !unclippableVertex2)
 	{
 		// clip just vertex 2
-		clippedEdges.push_back(v0);
-		clippedEdges.push_back(clipped1);
-		clippedEdges.push_back(mid2);
+		clippedEdges.addVertex(v0);
+		clippedEdges.addVertex(clipped1);
+		clippedEdges.addVertex(mid2);
 	}
 	else
 	{
 		// don't modify
-		clippedEdges.push_back(v0);
-		clippedEdges.push_back(clipped1);
-		clippedEdges.push_back(clipped2);
+		clippedEdges.addVertex(v0);
+		clippedEdges.addVertex(clipped1);
+		clippedEdges.addVertex(clipped2);
 	}
 }
 
-void clipTriangleToPlane (std::vector<TriangleVertex>& clippedEdges, const TriangleVertex* vertices, const ClipVolumePlane& plane)
+void clipTriangleToPlane (ConvexPolygon& clippedEdges, const TriangleVertex* vertices, const ClipVolumePlane& plane)
 {
 	const bool v0Clipped = !plane.pointInClipVolume(vertices[0].position);
 	const bool v1Clipped = !plane.pointInClipVolume(vertices[1].position);
@@ -443,7 +587,9 @@ void clipTriangleToPlane (std::vector<TriangleVertex>& clippedEdges, const Trian
 	if (clipCount == 0)
 	{
 		// pass
-		clippedEdges.insert(clippedEdges.begin(), vertices, vertices + 3);
+		clippedEdges.addVertex(vertices[0]);
+		clippedEdges.addVertex(vertices[1]);
+		clippedEdges.addVertex(vertices[2]);
 	}
 	else if (clipCount == 1)
 	{
@@ -520,6 +666,7 @@ void flatshadeVertices (const Program& program, ContainerType& list)
 void clipPrimitives (std::vector<pa::Triangle>&		list,
 					 const Program&					program,
 					 bool							clipWithZPlanes,
+					 DrawContext&					drawContext,
 					 VertexPacketAllocator&			vpalloc)
 {
 	using namespace cliputil;
@@ -534,68 +681,59 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 	const std::vector<rr::VertexVaryingInfo>&	fragInputs			= (program.geometryShader) ? (program.geometryShader->getOutputs()) : (program.vertexShader->getOutputs());
 	const ClipVolumePlane*						planes[]			= { &clipPosX, &clipNegX, &clipPosY, &clipNegY, &clipPosZ, &clipNegZ };
 	const int									numPlanes			= (clipWithZPlanes) ? (6) : (4);
+	const deUint32								planeMask			= (1u << numPlanes) - 1u;
 
-	std::vector<pa::Triangle>					outputTriangles;
-
-	for (int inputTriangleNdx = 0; inputTriangleNdx < (int)list.size(); ++inputTriangleNdx)
-	{
-		bool clippedByPlane[6];
+	// Triangles are compacted in place until the first clipped triangle. Remaining
+	// output goes to outputTriangles as clipping may produce more than one triangle.
+	std::vector<pa::Triangle>&					outputTriangles		= drawContext.clippedTriangles;
+	size_t										numCompacted		= 0;
+	bool										useOutputTriangles	= false;
 
-		// Needs clipping?
-		{
-			bool discardPrimitive	= false;
-			bool fullyInClipVolume	= true;
+	SubTriangle									subTriangleBuffers[2][MAX_SUBTRIANGLES];
 
-			for (int planeNdx = 0; planeNdx < numPlanes; ++planeNdx)
-			{
-				const ClipVolumePlane*	plane			= planes[planeNdx];
-				const bool				v0InsidePlane	= plane->pointInClipVolume(vec4ToClipVec4(list[inputTriangleNdx].v0->position));
-				const bool				v1InsidePlane	= plane->pointInClipVolume(vec4ToClipVec4(list[inputTriangleNdx].v1->position));
-				const bool				v2InsidePlane	= plane->pointInClipVolume(vec4ToClipVec4(list[inputTriangleNdx].v2->position));
+	outputTriangles.clear();
 
-				// Fully outside
-				if (!v0InsidePlane && !v1InsidePlane && !v2InsidePlane)
-				{
-					discardPrimitive = true;
-					break;
-				}
-				// Partially outside
-				else if (!v0InsidePlane || !v1InsidePlane || !v2InsidePlane)
-				{
-					clippedByPlane[planeNdx] = true;
-					fullyInClipVolume = false;
-				}
-				// Fully inside
-				else
-					clippedByPlane[planeNdx] = false;
-			}
+	for (int inputTriangleNdx = 0; inputTriangleNdx < (int)list.size(); ++inputTriangleNdx)
+	{
+		pa::Triangle		inputTriangle	= list[inputTriangleNdx];
+		const deUint32		v0ClipCode		= getClipCode(inputTriangle.v0->position) & planeMask;
+		const deUint32		v1ClipCode		= getClipCode(inputTriangle.v1->position) & planeMask;
+		const deUint32		v2ClipCode		= getClipCode(inputTriangle.v2->position) & planeMask;
 
-			if (discardPrimitive)
-				continue;
+		// Fully outside of some plane
+		if ((v0ClipCode & v1ClipCode & v2ClipCode) != 0)
+			continue;
 
-			if (fullyInClipVolume)
-			{
-				outputTriangles.push_back(list[inputTriangleNdx]);
-				continue;
-			}
+		// Fully in clip volume
+		if ((v0ClipCode | v1ClipCode | v2ClipCode) == 0)
+		{
+			if (useOutputTriangles)
+				outputTriangles.push_back(inputTriangle);
+			else
+				list[numCompacted++] = inputTriangle;
+			continue;
 		}
 
 		// Clip
 		{
-			std::vector<SubTriangle>	subTriangles	(1);
-			SubTriangle&				initialTri		= subTriangles[0];
+			const deUint32	clippedByPlanes	= v0ClipCode | v1ClipCode | v2ClipCode;
+			SubTriangle*	subTriangles	= subTriangleBuffers[0];
+			int				numSubTriangles	= 1;
+			SubTriangle&	initialTri		= subTriangles[0];
 
-			initialTri.vertices[0].position = vec4ToClipVec4(list[inputTriangleNdx].v0->position);
+			useOutputTriangles = true;
+
+			initialTri.vertices[0].position = vec4ToClipVec4(inputTriangle.v0->position);
 			initialTri.vertices[0].weight[0] = (ClipFloat)1.0;
 			initialTri.vertices[0].weight[1] = (ClipFloat)0.0;
 			initialTri.vertices[0].weight[2] = (ClipFloat)0.0;
 
-			initialTri.vertices[1].position = vec4ToClipVec4(list[inputTriangleNdx].v1->position);
+			initialTri.vertices[1].position = vec4ToClipVec4(inputTriangle.v1->position);
 			initialTri.vertices[1].weight[0] = (ClipFloat)0.0;
 			initialTri.vertices[1].weight[1] = (ClipFloat)1.0;
 			initialTri.vertices[1].weight[2] = (ClipFloat)0.0;
 
-			initialTri.vertices[2].position = vec4ToClipVec4(list[inputTriangleNdx].v2->position);
+			initialTri.vertices[2].position = vec4ToClipVec4(inputTriangle.v2->position);
 			initialTri.vertices[2].weight[0] = (ClipFloat)0.0;
 			initialTri.vertices[2].weight[1] = (ClipFloat)0.0;
 			initialTri.vertices[2].weight[2] = (ClipFloat)1.0;
@@ -603,56 +741,58 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 			// Clip all subtriangles to all relevant planes
 			for (int planeNdx = 0; planeNdx < numPlanes; ++planeNdx)
 			{
-				std::vector<SubTriangle> nextPhaseSubTriangles;
+				SubTriangle* const	nextPhaseSubTriangles		= (subTriangles == subTriangleBuffers[0]) ? (subTriangleBuffers[1]) : (subTriangleBuffers[0]);
+				int					numNextPhaseSubTriangles	= 0;
 
-				if (!clippedByPlane[planeNdx])
+				if ((clippedByPlanes & (1u << planeNdx)) == 0)
 					continue;
 
-				for (int subTriangleNdx = 0; subTriangleNdx < (int)subTriangles.size(); ++subTriangleNdx)
+				for (int subTriangleNdx = 0; subTriangleNdx < numSubTriangles; ++subTriangleNdx)
 				{
-					std::vector<TriangleVertex> convexPrimitive;
+					ConvexPolygon convexPrimitive;
 
 					// Clip triangle and form a convex n-gon ( n c {3, 4} )
 					clipTriangleToPlane(convexPrimitive, subTriangles[subTriangleNdx].vertices, *planes[planeNdx]);
 
 					// Subtriangle completely discarded
-					if (convexPrimitive.empty())
+					if (convexPrimitive.numVertices == 0)
 						continue;
 
-					DE_ASSERT(convexPrimitive.size() == 3 || convexPrimitive.size() == 4);
+					DE_ASSERT(convexPrimitive.numVertices == 3 || convexPrimitive.numVertices == 4);
 
 					//Triangulate planar convex n-gon
 					{
-						TriangleVertex& v0 = convexPrimitive[0];
+						const TriangleVertex& v0 = convexPrimitive.vertices[0];
 
-						for (int subsubTriangleNdx = 1; subsubTriangleNdx + 1 < (int)convexPrimitive.size(); ++subsubTriangleNdx)
+						for (int subsubTriangleNdx = 1; subsubTriangleNdx + 1 < convexPrimitive.numVertices; ++subsubTriangleNdx)
 						{
 							const float				degenerateEpsilon	= 1.0e-6f;
-							const TriangleVertex&	v1					= convexPrimitive[subsubTriangleNdx];
-							const TriangleVertex&	v2					= convexPrimitive[subsubTriangleNdx + 1];
+							const TriangleVertex&	v1					= convexPrimitive.vertices[subsubTriangleNdx];
+							const TriangleVertex&	v2					= convexPrimitive.vertices[subsubTriangleNdx + 1];
 							const float				visibleArea			= de::abs(cross2D(to2DCartesian(clipVec4ToVec4(v1.position)) - to2DCartesian(clipVec4ToVec4(v0.position)),
 																						  to2DCartesian(clipVec4ToVec4(v2.position)) - to2DCartesian(clipVec4ToVec4(v0.position))));
 
 							// has surface area (is not a degenerate)
 							if (visibleArea >= degenerateEpsilon)
 							{
-								SubTriangle subsubTriangle;
+								SubTriangle& subsubTriangle = nextPhaseSubTriangles[numNextPhaseSubTriangles++];
+
+								DE_ASSERT(numNextPhaseSubTriangles <= MAX_SUBTRIANGLES);
 
 								subsubTriangle.vertices[0] = v0;
 								subsubTriangle.vertices[1] = v1;
 								subsubTriangle.vertices[2] = v2;
-
-								nextPhaseSubTriangles.push_back(subsubTriangle);
 							}
 						}
 					}
 				}
 
-				subTriangles.swap(nextPhaseSubTriangles);
+				subTriangles	= nextPhaseSubTriangles;
+				numSubTriangles	= numNextPhaseSubTriangles;
 			}
 
 			// Rebuild pa::Triangles from subtriangles
-			for (int subTriangleNdx = 0; subTriangleNdx < (int)subTriangles.size(); ++subTriangleNdx)
+			for (int subTriangleNdx = 0; subTriangleNdx < numSubTriangles; ++subTriangleNdx)
 			{
 				VertexPacket*	p0				= vpalloc.alloc();
 				VertexPacket*	p1				= vpalloc.alloc();
@@ -667,9 +807,9 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 				{
 					if (fragInputs[outputNdx].type == GENERICVECTYPE_FLOAT)
 					{
-						const tcu::Vec4 out0 = list[inputTriangleNdx].v0->outputs[outputNdx].get<float>();
-						const tcu::Vec4 out1 = list[inputTriangleNdx].v1->outputs[outputNdx].get<float>();
-						const tcu::Vec4 out2 = list[inputTriangleNdx].v2->outputs[outputNdx].get<float>();
+						const tcu::Vec4 out0 = inputTriangle.v0->outputs[outputNdx].get<float>();
+						const tcu::Vec4 out1 = inputTriangle.v1->outputs[outputNdx].get<float>();
+						const tcu::Vec4 out2 = inputTriangle.v2->outputs[outputNdx].get<float>();
 
 						p0->outputs[outputNdx] = (float)subTriangles[subTriangleNdx].vertices[0].weight[0] * out0
 											   + (float)subTriangles[subTriangleNdx].vertices[0].weight[1] * out1
@@ -686,9 +826,9 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 					else
 					{
 						// only floats are interpolated, all others must be flatshaded then
-						p0->outputs[outputNdx] = list[inputTriangleNdx].getProvokingVertex()->outputs[outputNdx];
-						p1->outputs[outputNdx] = list[inputTriangleNdx].getProvokingVertex()->outputs[outputNdx];
-						p2->outputs[outputNdx] = list[inputTriangleNdx].getProvokingVertex()->outputs[outputNdx];
+						p0->outputs[outputNdx] = inputTriangle.getProvokingVertex()->outputs[outputNdx];
+						p1->outputs[outputNdx] = inputTriangle.getProvokingVertex()->outputs[outputNdx];
+						p2->outputs[outputNdx] = inputTriangle.getProvokingVertex()->outputs[outputNdx];
 					}
 				}
 
@@ -698,7 +838,8 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 	}
 
 	// output result
-	list.swap(outputTriangles);
+	list.erase(list.begin() + numCompacted, list.end());
+	list.insert(list.end(), outputTriangles.begin(), outputTriangles.end());
 }
 
 /*--------------------------------------------------------------------*//*!
@@ -710,8 +851,10 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 void clipPrimitives (std::vector<pa::Line>&			list,
 					 const Program&					program,
 					 bool							clipWithZPlanes,
+					 DrawContext&					drawContext,
 					 VertexPacketAllocator&			vpalloc)
 {
+	DE_UNREF(drawContext);
 	DE_UNREF(vpalloc);
 
 	using namespace cliputil;
@@ -719,7 +862,7 @@ void clipPrimitives (std::vector<pa::Line>&			list,
 	// Lines are clipped only by the far and the near planes here. Line clipping by other planes done in the rasterization phase
 
 	const std::vector<rr::VertexVaryingInfo>&	fragInputs	= (program.geometryShader) ? (program.geometryShader->getOutputs()) : (program.vertexShader->getOutputs());
-	std::vector<pa::Line>						visibleLines;
+	size_t										numVisible	= 0;
 
 	// Z-clipping disabled, don't do anything
 	if (!clipWithZPlanes)
@@ -727,7 +870,7 @@ void clipPrimitives (std::vector<pa::Line>&			list,
 
 	for (size_t ndx = 0; ndx < list.size(); ++ndx)
 	{
-		pa::Line& l = list[ndx];
+		const pa::Line& l = list[ndx];
 
 		// Totally discarded?
 		if ((l.v0->position.z() < -l.v0->position.w() && l.v1->position.z() < -l.v1->position.w()) ||
@@ -744,7 +887,7 @@ void clipPrimitives (std::vector<pa::Line>&			list,
 		// Not clipped at all?
 		if (t0 == (ClipFloat)0.0 && t1 == (ClipFloat)0.0)
 		{
-			visibleLines.push_back(pa::Line(l.v0, l.v1, -1));
+			list[numVisible++] = pa::Line(l.v0, l.v1, -1);
 		}
 		else
 		{
@@ -766,12 +909,12 @@ void clipPrimitives (std::vector<pa::Line>&			list,
 				}
 			}
 
-			visibleLines.push_back(pa::Line(l.v0, l.v1, -1));
+			list[numVisible++] = pa::Line(l.v0, l.v1, -1);
 		}
 	}
 
-	// return visible in list
-	std::swap(visibleLines, list);
+	// compact visible lines in place
+	list.erase(list.begin() + numVisible, list.end());
 }
 
 /*--------------------------------------------------------------------*//*!
@@ -781,12 +924,14 @@ void clipPrimitives (std::vector<pa::Line>&			list,
 void clipPrimitives (std::vector<pa::Point>&		list,
 					 const Program&					program,
 					 bool							clipWithZPlanes,
+					 DrawContext&					drawContext,
 					 VertexPacketAllocator&			vpalloc)
 {
+	DE_UNREF(drawContext);
 	DE_UNREF(vpalloc);
 	DE_UNREF(program);
 
-	std::vector<pa::Point> visiblePoints;
+	size_t numVisible = 0;
 
 	// Z-clipping disabled, don't do anything
 	if (!clipWithZPlanes)
@@ -794,15 +939,15 @@ void clipPrimitives (std::vector<pa::Point>&		list,
 
 	for (size_t ndx = 0; ndx < list.size(); ++ndx)
 	{
-		pa::Point& p = list[ndx];
+		const pa::Point& p = list[ndx];
 
 		// points are discarded if Z is not in range. (Wide) point clipping is done in the rasterization phase
 		if (de::inRange(p.v0->position.z(), -p.v0->position.w(), p.v0->position.w()))
-			visiblePoints.push_back(pa::Point(p.v0));
+			list[numVisible++] = pa::Point(p.v0);
 	}
 
-	// return visible in list
-	std::swap(visiblePoints, list);
+	// compact visible points in place
+	list.erase(list.begin() + numVisible, list.end());
 }
 
 void transformVertexClipCoordsToWindowCoords (const RenderState& state, VertexPacket& packet)
@@ -857,52 +1002,55 @@ void transformClipCoordsToWindowCoords (const RenderState& state, ContainerType&
 		transformPrimitiveClipCoordsToWindowCoords(state, *it);
 }
 
-void makeSharedVerticeDistinct (VertexPacket*& packet, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void copyVertexPacketOutputs (VertexPacket& dst, const VertexPacket& src, size_t numVertexOutputs)
+{
+	dst.position	= src.position;
+	dst.pointSize	= src.pointSize;
+	dst.primitiveID	= src.primitiveID;
+
+	for (size_t outputNdx = 0; outputNdx < numVertexOutputs; ++outputNdx)
+		dst.outputs[outputNdx] = src.outputs[outputNdx];
+}
+
+void makeSharedVerticeDistinct (VertexPacket*& packet, GenerationHashMap<const VertexPacket*, bool>& vertices, VertexPacketAllocator& vpalloc)
 {
 	// distinct
-	if (vertices.find(packet) == vertices.end())
-	{
-		vertices.insert(packet);
-	}
-	else
+	if (!vertices.insert(packet, true))
 	{
 		VertexPacket* newPacket = vpalloc.alloc();
 
 		// copy packet output values
-		newPacket->position		= packet->position;
-		newPacket->pointSize	= packet->pointSize;
-		newPacket->primitiveID	= packet->primitiveID;
-
-		for (size_t outputNdx = 0; outputNdx < vpalloc.getNumVertexOutputs(); ++outputNdx)
-			newPacket->outputs[outputNdx] = packet->outputs[outputNdx];
+		copyVertexPacketOutputs(*newPacket, *packet, vpalloc.getNumVertexOutputs());
 
 		// no need to insert new packet to "vertices" as newPacket is unique
 		packet = newPacket;
 	}
 }
 
-void makeSharedVerticesDistinct (pa::Triangle& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Triangle& target, GenerationHashMap<const VertexPacket*, bool>& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v1, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v2, vertices, vpalloc);
 }
 
-void makeSharedVerticesDistinct (pa::Line& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Line& target, GenerationHashMap<const VertexPacket*, bool>& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v1, vertices, vpalloc);
 }
 
-void makeSharedVerticesDistinct (pa::Point& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Point& target, GenerationHashMap<const VertexPacket*, bool>& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 }
 
 template <typename ContainerType>
-void makeSharedVerticesDistinct (ContainerType& list, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (ContainerType& list, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
 {
-	std::set<VertexPacket*, std::less<void*> > vertices;
+	GenerationHashMap<const VertexPacket*, bool>& vertices = drawContext.distinctVertices;
+
+	vertices.clear(list.size() * ContainerType::value_type::NUM_VERTICES);
 
 	for (typename ContainerType::iterator it = list.begin(); it != list.end(); ++it)
 		makeSharedVerticesDistinct(*it, vertices, vpalloc);
@@ -1100,12 +1248,13 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Triangle&				triangle,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					tileRect,
 						 RasterizationInternalBuffers&		buffers)
 {
 	const int			numSamples		= renderTarget.getNumSamples();
 	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
 	const float			depthClampMax	= de::max(state.viewport.zn, state.viewport.zf);
-	TriangleRasterizer	rasterizer		(renderTargetRect, numSamples, state.rasterization);
+	TriangleRasterizer	rasterizer		(renderTargetRect, numSamples, state.rasterization, tileRect);
 	float				depthOffset		= 0.0f;
 
 	rasterizer.init(triangle.v0->position, triangle.v1->position, triangle.v2->position);
@@ -1168,6 +1317,7 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Line&					line,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					tileRect,
 						 RasterizationInternalBuffers&		buffers)
 {
 	const int					numSamples			= renderTarget.getNumSamples();
@@ -1175,8 +1325,8 @@ void rasterizePrimitive (const RenderState&					state,
 	const float					depthClampMax		= de::max(state.viewport.zn, state.viewport.zf);
 	const bool					msaa				= numSamples > 1;
 	FragmentShadingContext		shadingContext		(line.v0->outputs, line.v1->outputs, DE_NULL, &buffers.shaderOutputs[0], buffers.fragmentDepthBuffer, line.v1->primitiveID, (int)program.fragmentShader->getOutputs().size(), numSamples, FACETYPE_FRONT);
-	SingleSampleLineRasterizer	aliasedRasterizer	(renderTargetRect);
-	MultiSampleLineRasterizer	msaaRasterizer		(numSamples, renderTargetRect);
+	SingleSampleLineRasterizer	aliasedRasterizer	(rectIntersection(renderTargetRect, tileRect)); // \note Aliased line fragments do not depend on packet alignment
+	MultiSampleLineRasterizer	msaaRasterizer		(numSamples, renderTargetRect, tileRect);
 
 	// Initialize rasterization.
 	if (msaa)
@@ -1221,13 +1371,14 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Point&					point,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					tileRect,
 						 RasterizationInternalBuffers&		buffers)
 {
 	const int			numSamples		= renderTarget.getNumSamples();
 	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
 	const float			depthClampMax	= de::max(state.viewport.zn, state.viewport.zf);
-	TriangleRasterizer	rasterizer1		(renderTargetRect, numSamples, state.rasterization);
-	TriangleRasterizer	rasterizer2		(renderTargetRect, numSamples, state.rasterization);
+	TriangleRasterizer	rasterizer1		(renderTargetRect, numSamples, state.rasterization, tileRect);
+	TriangleRasterizer	rasterizer2		(renderTargetRect, numSamples, state.rasterization, tileRect);
 
 	// draw point as two triangles
 	const float offset				= point.v0->pointSize / 2.0f;
@@ -1281,52 +1432,243 @@ void rasterizePrimitive (const RenderState&					state,
 	}
 }
 
+void initRasterizationInternalBuffers (RasterizationInternalBuffers& buffers, const RenderTarget& renderTarget, const Program& program)
+{
+	const int		numSamples			= renderTarget.getNumSamples();
+	const int		numFragmentOutputs	= (int)program.fragmentShader->getOutputs().size();
+	const size_t	maxFragmentPackets	= 128;
+
+	buffers.fragmentPackets.resize(maxFragmentPackets);
+	buffers.shaderOutputs.resize(maxFragmentPackets*4*numFragmentOutputs);
+	buffers.shadedFragments.resize(maxFragmentPackets*4);
+	buffers.fragmentDepthBuffer = DE_NULL;
+
+	// calculate depth only if we have a depth buffer
+	if (!isEmpty(renderTarget.getDepthBuffer()))
+	{
+		buffers.depthValues.resize(maxFragmentPackets*4*numSamples);
+		buffers.fragmentDepthBuffer = &buffers.depthValues[0];
+	}
+}
+
+int floorToRange (float v, int minValue, int maxValue)
+{
+	// \note NaN maps to minValue
+	if (!(v > (float)minValue))
+		return minValue;
+	else if (v >= (float)maxValue)
+		return maxValue;
+	else
+		return deFloorFloatToInt32(v);
+}
+
+int ceilToRange (float v, int minValue, int maxValue)
+{
+	// \note NaN maps to maxValue
+	if (!(v < (float)maxValue))
+		return maxValue;
+	else if (v <= (float)minValue)
+		return minValue;
+	else
+		return deCeilFloatToInt32(v);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get conservative window-space bounds of window coordinates
+ * \return Inclusive bounds (x0, y0, x1, y1) clamped to rect. Empty if x0 > x1 or y0 > y1.
+ *//*--------------------------------------------------------------------*/
+tcu::IVec4 getWindowBounds (const tcu::Vec2& minPos, const tcu::Vec2& maxPos, float margin, const tcu::IVec4& rect)
+{
+	const int	rX0	= rect.x();
+	const int	rY0	= rect.y();
+	const int	rX1	= rect.x() + rect.z() - 1;
+	const int	rY1	= rect.y() + rect.w() - 1;
+
+	return tcu::IVec4(floorToRange(minPos.x() - margin, rX0, rX1 + 1),
+					  floorToRange(minPos.y() - margin, rY0, rY1 + 1),
+					  ceilToRange (maxPos.x() + margin, rX0 - 1, rX1),
+					  ceilToRange (maxPos.y() + margin, rY0 - 1, rY1));
+}
+
+tcu::IVec4 getPrimitiveWindowBounds (const RenderState& state, const pa::Triangle& triangle, const tcu::IVec4& rect)
+{
+	DE_UNREF(state);
+
+	const tcu::Vec2 p0 = triangle.v0->position.swizzle(0, 1);
+	const tcu::Vec2 p1 = triangle.v1->position.swizzle(0, 1);
+	const tcu::Vec2 p2 = triangle.v2->position.swizzle(0, 1);
+
+	return getWindowBounds(tcu::min(tcu::min(p0, p1), p2), tcu::max(tcu::max(p0, p1), p2), 2.0f, rect);
+}
+
+tcu::IVec4 getPrimitiveWindowBounds (const RenderState& state, const pa::Line& line, const tcu::IVec4& rect)
+{
+	// \note Wide lines may be shifted by up to line width in the minor direction
+	const tcu::Vec2 p0 = line.v0->position.swizzle(0, 1);
+	const tcu::Vec2 p1 = line.v1->position.swizzle(0, 1);
+
+	return getWindowBounds(tcu::min(p0, p1), tcu::max(p0, p1), de::max(state.line.lineWidth, 1.0f) + 2.0f, rect);
+}
+
+tcu::IVec4 getPrimitiveWindowBounds (const RenderState& state, const pa::Point& point, const tcu::IVec4& rect)
+{
+	DE_UNREF(state);
+
+	const tcu::Vec2 p0 = point.v0->position.swizzle(0, 1);
+
+	return getWindowBounds(p0, p0, point.v0->pointSize / 2.0f + 2.0f, rect);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Tile-parallel rasterization
+ *
+ * Primitives are binned to screen tiles and each tile is rasterized,
+ * shaded and written independently. Primitives within a tile are
+ * processed in submission order and fragment packets keep the same 2x2
+ * alignment as in serial rasterization, so the result is identical to
+ * rasterizing the whole primitive list on a single thread.
+ *//*--------------------------------------------------------------------*/
+template <typename ContainerType>
+class TiledRasterizer : public tcu::ParallelWork
+{
+public:
+								TiledRasterizer		(const RenderState& state, const RenderTarget& renderTarget, const Program& program, const ContainerType& list, const tcu::IVec4& renderTargetRect);
+
+	//! Bin primitives to tiles. Returns number of tiles that have primitives in them.
+	int							binPrimitives		(void);
+	void						execute				(int workerNdx, int itemNdx);
+
+private:
+	tcu::IVec4					getTileRect			(int tileNdx) const;
+
+	const RenderState&			m_state;
+	const RenderTarget&			m_renderTarget;
+	const Program&				m_program;
+	const ContainerType&		m_list;
+	const tcu::IVec4			m_renderTargetRect;
+	const int					m_numTilesX;
+	const int					m_numTilesY;
+
+	std::vector<std::vector<int> >								m_bins;
+	std::vector<int>											m_activeTiles;
+	std::vector<de::SharedPtr<RasterizationInternalBuffers> >	m_workerBuffers;
+};
+
+template <typename ContainerType>
+TiledRasterizer<ContainerType>::TiledRasterizer (const RenderState& state, const RenderTarget& renderTarget, const Program& program, const ContainerType& list, const tcu::IVec4& renderTargetRect)
+	: m_state				(state)
+	, m_renderTarget		(renderTarget)
+	, m_program				(program)
+	, m_list				(list)
+	, m_renderTargetRect	(renderTargetRect)
+	, m_numTilesX			(deDivRoundUp32(de::max(renderTargetRect.z(), 0), RASTERIZATION_TILE_SIZE))
+	, m_numTilesY			(deDivRoundUp32(de::max(renderTargetRect.w(), 0), RASTERIZATION_TILE_SIZE))
+	, m_bins				(m_numTilesX*m_numTilesY)
+	, m_workerBuffers		(tcu::getNumWorkerThreads())
+{
+}
+
+template <typename ContainerType>
+int TiledRasterizer<ContainerType>::binPrimitives (void)
+{
+	if (m_bins.empty())
+		return 0;
+
+	for (size_t primNdx = 0; primNdx < m_list.size(); ++primNdx)
+	{
+		const tcu::IVec4 bounds = getPrimitiveWindowBounds(m_state, m_list[primNdx], m_renderTargetRect);
+
+		if (bounds.x() > bounds.z() || bounds.y() > bounds.w())
+			continue;
+
+		const int tileX0 = (bounds.x() - m_renderTargetRect.x()) / RASTERIZATION_TILE_SIZE;
+		const int tileY0 = (bounds.y() - m_renderTargetRect.y()) / RASTERIZATION_TILE_SIZE;
+		const int tileX1 = (bounds.z() - m_renderTargetRect.x()) / RASTERIZATION_TILE_SIZE;
+		const int tileY1 = (bounds.w() - m_renderTargetRect.y()) / RASTERIZATION_TILE_SIZE;
+
+		for (int tileY = tileY0; tileY <= tileY1; ++tileY)
+		for (int tileX = tileX0; tileX <= tileX1; ++tileX)
+			m_bins[tileY*m_numTilesX + tileX].push_back((int)primNdx);
+	}
+
+	for (int tileNdx = 0; tileNdx < (int)m_bins.size(); ++tileNdx)
+	{
+		if (!m_bins[tileNdx].empty())
+			m_activeTiles.push_back(tileNdx);
+	}
+
+	return (int)m_activeTiles.size();
+}
+
+template <typename ContainerType>
+tcu::IVec4 TiledRasterizer<ContainerType>::getTileRect (int tileNdx) const
+{
+	const int x = m_renderTargetRect.x() + (tileNdx % m_numTilesX) * RASTERIZATION_TILE_SIZE;
+	const int y = m_renderTargetRect.y() + (tileNdx / m_numTilesX) * RASTERIZATION_TILE_SIZE;
+
+	return tcu::IVec4(x, y,
+					  de::min((int)RASTERIZATION_TILE_SIZE, m_renderTargetRect.x() + m_renderTargetRect.z() - x),
+					  de::min((int)RASTERIZATION_TILE_SIZE, m_renderTargetRect.y() + m_renderTargetRect.w() - y));
+}
+
+template <typename ContainerType>
+void TiledRasterizer<ContainerType>::execute (int workerNdx, int itemNdx)
+{
+	const int					tileNdx		= m_activeTiles[itemNdx];
+	const tcu::IVec4			tileRect	= getTileRect(tileNdx);
+	const std::vector<int>&		bin			= m_bins[tileNdx];
+
+	if (!m_workerBuffers[workerNdx])
+	{
+		m_workerBuffers[workerNdx] = de::SharedPtr<RasterizationInternalBuffers>(new RasterizationInternalBuffers());
+		initRasterizationInternalBuffers(*m_workerBuffers[workerNdx], m_renderTarget, m_program);
+	}
+
+	for (size_t ndx = 0; ndx < bin.size(); ++ndx)
+		rasterizePrimitive(m_state, m_renderTarget, m_program, m_list[bin[ndx]], m_renderTargetRect, tileRect, *m_workerBuffers[workerNdx]);
+}
+
 template <typename ContainerType>
 void rasterize (const RenderState&					state,
 				const RenderTarget&					renderTarget,
 				const Program&						program,
 				const ContainerType&				list)
 {
-	const int						numSamples			= renderTarget.getNumSamples();
-	const int						numFragmentOutputs	= (int)program.fragmentShader->getOutputs().size();
-	const size_t					maxFragmentPackets	= 128;
-
 	const tcu::IVec4				viewportRect		= tcu::IVec4(state.viewport.rect.left, state.viewport.rect.bottom, state.viewport.rect.width, state.viewport.rect.height);
 	const tcu::IVec4				bufferRect			= getBufferSize(renderTarget.getColorBuffer(0));
 	const tcu::IVec4				renderTargetRect	= rectIntersection(viewportRect, bufferRect);
 
-	// shared buffers for all primitives
-	std::vector<FragmentPacket>		fragmentPackets		(maxFragmentPackets);
-	std::vector<GenericVec4>		shaderOutputs		(maxFragmentPackets*4*numFragmentOutputs);
-	std::vector<Fragment>			shadedFragments		(maxFragmentPackets*4);
-	std::vector<float>				depthValues			(0);
-	float*							depthBufferPointer	= DE_NULL;
-
-	RasterizationInternalBuffers	buffers;
+	if (list.empty())
+		return;
 
-	// calculate depth only if we have a depth buffer
-	if (!isEmpty(renderTarget.getDepthBuffer()))
+	// Rasterize in parallel if there is more than one tile of work and the fragment shader allows concurrent shading
+	if (tcu::getNumWorkerThreads() > 1 && program.fragmentShader->isThreadSafe())
 	{
-		depthValues.resize(maxFragmentPackets*4*numSamples);
-		depthBufferPointer = &depthValues[0];
+		TiledRasterizer<ContainerType>	tiledRasterizer	(state, renderTarget, program, list, renderTargetRect);
+		const int						numActiveTiles	= tiledRasterizer.binPrimitives();
+
+		if (numActiveTiles > 1)
+		{
+			tcu::executeParallel(tiledRasterizer, numActiveTiles);
+			return;
+		}
 	}
 
-	// set buffers
-	buffers.fragmentPackets.swap(fragmentPackets);
-	buffers.shaderOutputs.swap(shaderOutputs);
-	buffers.shadedFragments.swap(shadedFragments);
-	buffers.fragmentDepthBuffer = depthBufferPointer;
+	// shared buffers for all primitives
+	RasterizationInternalBuffers	buffers;
+
+	initRasterizationInternalBuffers(buffers, renderTarget, program);
 
 	// rasterize
 	for (typename ContainerType::const_iterator it = list.begin(); it != list.end(); ++it)
-		rasterizePrimitive(state, renderTarget, program, *it, renderTargetRect, buffers);
+		rasterizePrimitive(state, renderTarget, program, *it, renderTargetRect, renderTargetRect, buffers);
 }
 
 /*--------------------------------------------------------------------*//*!
  * Draws transformed triangles, lines or points to render target
  *//*--------------------------------------------------------------------*/
 template <typename ContainerType>
-void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, ContainerType& primList, VertexPacketAllocator& vpalloc)
+void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, ContainerType& primList, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
 {
 	const bool clipZ = !state.fragOps.depthClampEnabled;
 
@@ -1336,8 +1678,7 @@ void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTa
 	flatshadeVertices(program, primList);
 
 	// Clipping
-	// \todo [jarkko] is creating & swapping std::vectors really a good solution?
-	clipPrimitives(primList, program, clipZ, vpalloc);
+	clipPrimitives(primList, program, clipZ, drawContext, vpalloc);
 
 	// Transform vertices to window coords
 	transformClipCoordsToWindowCoords(state, primList);
@@ -1383,7 +1724,7 @@ void copyVertexPacketPointers(const VertexPacket** dst, const pa::TriangleAdjace
 }
 
 template <PrimitiveType DrawPrimitiveType> // \note DrawPrimitiveType  can only be Points, line_strip, or triangle_strip
-void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, size_t numVertices, VertexPacketAllocator& vpalloc)
+void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, size_t numVertices, DrawContext& drawContext, VertexPacketAllocator& vpalloc)
 {
 	// Run primitive assembly for generated stream
 
@@ -1394,11 +1735,11 @@ void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const Rende
 
 	// Make shared vertices distinct
 
-	makeSharedVerticesDistinct(inputPrimitives, vpalloc);
+	makeSharedVerticesDistinct(inputPrimitives, drawContext, vpalloc);
 
 	// Draw assembled primitives
 
-	drawBasicPrimitives(state, renderTarget, program, inputPrimitives, vpalloc);
+	drawBasicPrimitives(state, renderTarget, program, inputPrimitives, drawContext, vpalloc);
 }
 
 template <PrimitiveType DrawPrimitiveType>
@@ -1453,9 +1794,9 @@ void drawWithGeometryShader(const RenderState& state, const RenderTarget& render
 
 			switch (program.geometryShader->getOutputType())
 			{
-				case rr::GEOMETRYSHADEROUTPUTTYPE_POINTS:			drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_POINTS>			(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
-				case rr::GEOMETRYSHADEROUTPUTTYPE_LINE_STRIP:		drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_LINE_STRIP>		(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
-				case rr::GEOMETRYSHADEROUTPUTTYPE_TRIANGLE_STRIP:	drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>	(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_POINTS:			drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_POINTS>			(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_LINE_STRIP:		drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_LINE_STRIP>		(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_TRIANGLE_STRIP:	drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>	(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, drawContext, vpalloc); break;
 				default:
 					DE_ASSERT(DE_FALSE);
 			}
@@ -1496,13 +1837,13 @@ void drawAsPrimitives (const RenderState& state, const RenderTarget& renderTarge
 		convertPrimitiveToBaseType(basePrimitives, inputPrimitives);
 
 		// Make shared vertices distinct. Needed for that the translation to screen space happens only once per vertex, and for flatshading
-		makeSharedVerticesDistinct(basePrimitives, vpalloc);
+		makeSharedVerticesDistinct(basePrimitives, drawContext, vpalloc);
 
 		// A primitive ID will be generated even if no geometry shader is active
 		generatePrimitiveIDs(basePrimitives, drawContext);
 
 		// Draw as a basic type
-		drawBasicPrimitives(state, renderTarget, program, basePrimitives, vpalloc);
+		drawBasicPrimitives(state, renderTarget, program, basePrimitives, drawContext, vpalloc);
 	}
 }
 
@@ -1764,10 +2105,13 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 
 	// Prepare transformation
 
-	const size_t				numVaryings = command.program.vertexShader->getOutputs().size();
-	VertexPacketAllocator		vpalloc(numVaryings);
-	std::vector<VertexPacket*>	vertexPackets = vpalloc.allocArray(command.primitives.getNumElements());
-	DrawContext					drawContext;
+	const size_t					numVaryings		= command.program.vertexShader->getOutputs().size();
+	VertexPacketAllocator			vpalloc			(numVaryings);
+	std::vector<VertexPacket*>		vertexPackets	= vpalloc.allocArray(command.primitives.getNumElements());
+	std::vector<VertexPacket*>		shadedPackets	(command.primitives.getNumElements());
+	std::vector<int>				sourcePackets	(command.primitives.getNumElements());
+	GenerationHashMap<int, int>		vertexCache;
+	DrawContext						drawContext;
 
 	for (int instanceID = 0; instanceID < numInstances; ++instanceID)
 	{
@@ -1777,20 +2121,35 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 		for (size_t elementNdx = 0; elementNdx < command.primitives.getNumElements(); ++elementNdx)
 		{
 			int numVertexPackets = 0;
+			int numShadedPackets = 0;
+
+			// Vertex cache maps vertex index to first packet with the same index. Instance is constant within the loop.
+			vertexCache.clear(command.primitives.getNumElements() - elementNdx);
 
 			// collect primitive vertices until restart
 
 			while (elementNdx < command.primitives.getNumElements() &&
 					!(command.state.restart.enabled && command.primitives.isRestartIndex(elementNdx, command.state.restart.restartIndex)))
 			{
+				const int vertexNdx = (int)command.primitives.getIndex(elementNdx);
+
 				// input
 				vertexPackets[numVertexPackets]->instanceNdx	= instanceID;
-				vertexPackets[numVertexPackets]->vertexNdx		= (int)command.primitives.getIndex(elementNdx);
+				vertexPackets[numVertexPackets]->vertexNdx		= vertexNdx;
 
 				// output
 				vertexPackets[numVertexPackets]->pointSize		= command.state.point.pointSize;	// default value from the current state
 				vertexPackets[numVertexPackets]->position		= tcu::Vec4(0, 0, 0, 0);			// no undefined values
 
+				// shade only first occurrence of each index
+				if (vertexCache.insert(vertexNdx, numVertexPackets))
+				{
+					sourcePackets[numVertexPackets]		= numVertexPackets;
+					shadedPackets[numShadedPackets++]	= vertexPackets[numVertexPackets];
+				}
+				else
+					sourcePackets[numVertexPackets]		= *vertexCache.find(vertexNdx);
+
 				++numVertexPackets;
 				++elementNdx;
 			}
@@ -1799,11 +2158,20 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 			if (numVertexPackets == 0)
 				continue;
 
-			// \todo Vertex cache?
-
 			// Transform vertices
 
-			command.program.vertexShader->shadeVertices(command.vertexAttribs, &vertexPackets[0], numVertexPackets);
+			command.program.vertexShader->shadeVertices(command.vertexAttribs, &shadedPackets[0], numShadedPackets);
+
+			// Copy results to repeated vertices. Each element keeps a packet of its own, so later stages see the same vertex list as without caching.
+
+			if (numShadedPackets != numVertexPackets)
+			{
+				for (int packetNdx = 0; packetNdx < numVertexPackets; ++packetNdx)
+				{
+					if (sourcePackets[packetNdx] != packetNdx)
+						copyVertexPacketOutputs(*vertexPackets[packetNdx], *vertexPackets[sourcePackets[packetNdx]], numVaryings);
+				}
+			}
 
 			// Draw primitives
 
@@ -122,10 +122,11 @@ protected:
 class FragmentShader
 {
 public:
-											FragmentShader		(size_t numInputs, size_t numOutputs) : m_inputs(numInputs), m_outputs(numOutputs) {}
+											FragmentShader		(size_t numInputs, size_t numOutputs) : m_inputs(numInputs), m_outputs(numOutputs), m_threadSafe(false) {}
 
-	const std::vector<FragmentInputInfo>&	getInputs			(void) const	{ return m_inputs;	}
-	const std::vector<FragmentOutputInfo>&	getOutputs			(void) const	{ return m_outputs;	}
+	const std::vector<FragmentInputInfo>&	getInputs			(void) const	{ return m_inputs;		}
+	const std::vector<FragmentOutputInfo>&	getOutputs			(void) const	{ return m_outputs;		}
+	bool									isThreadSafe		(void) const	{ return m_threadSafe;	} //!< Can shadeFragments() be called concurrently from multiple threads.
 
 	virtual void							shadeFragments		(FragmentPacket* packets, const int numPackets, const FragmentShadingContext& context) const = 0; // \note numPackets must be greater than zero.
 
@@ -134,6 +135,7 @@ protected:
 
 	std::vector<FragmentInputInfo>			m_inputs;
 	std::vector<FragmentOutputInfo>			m_outputs;
+	bool									m_threadSafe;	//!< Set by shaders that allow tile-parallel rasterization. Fragments are shaded serially otherwise.
 } DE_WARN_UNUSED_TYPE;
 
 /*--------------------------------------------------------------------*//*!
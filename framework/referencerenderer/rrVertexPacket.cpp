@@ -35,7 +35,11 @@ VertexPacket::~VertexPacket (void)
 }
 
 VertexPacketAllocator::VertexPacketAllocator (const size_t numberOfVertexOutputs)
-	: m_numberOfVertexOutputs(numberOfVertexOutputs)
+	: m_numberOfVertexOutputs	(numberOfVertexOutputs)
+	, m_packetSize				(sizeof(VertexPacket) + ((numberOfVertexOutputs == 0) ? (0) : (numberOfVertexOutputs-1)) * sizeof(GenericVec4))
+	, m_singleAllocPool			(DE_NULL)
+	, m_singleAllocPoolSize		(0)
+	, m_numFreeSingleAllocs		(0)
 {
 }
 
@@ -46,24 +50,12 @@ VertexPacketAllocator::~VertexPacketAllocator (void)
 	m_allocations.clear();
 }
 
-std::vector<VertexPacket*> VertexPacketAllocator::allocArray (size_t count)
+deInt8* VertexPacketAllocator::allocPackets (size_t count)
 {
-	if (!count)
-		return std::vector<VertexPacket*>();
+	deInt8* ptr = new deInt8[m_packetSize * count]; // throws bad_alloc => ok
 
-	const size_t extraVaryings	= (m_numberOfVertexOutputs == 0) ? (0) : (m_numberOfVertexOutputs-1);
-	const size_t packetSize		= sizeof(VertexPacket) + extraVaryings * sizeof(GenericVec4);
-
-	std::vector<VertexPacket*>	retVal;
-	deInt8*						ptr = new deInt8[packetSize * count]; // throws bad_alloc => ok
-
-	// *.push_back might throw bad_alloc
 	try
 	{
-		// run ctors
-		for (size_t i = 0; i < count; ++i)
-			retVal.push_back(new (ptr + i*packetSize) VertexPacket()); // throws bad_alloc
-
 		m_allocations.push_back(ptr); // throws bad_alloc
 	}
 	catch (std::bad_alloc& )
@@ -72,19 +64,47 @@ std::vector<VertexPacket*> VertexPacketAllocator::allocArray (size_t count)
 		throw;
 	}
 
+	return ptr;
+}
+
+std::vector<VertexPacket*> VertexPacketAllocator::allocArray (size_t count)
+{
+	if (!count)
+		return std::vector<VertexPacket*>();
+
+	std::vector<VertexPacket*>	retVal	(count); // throws bad_alloc
+	deInt8*						ptr		= allocPackets(count);
+
+	// run ctors
+	for (size_t i = 0; i < count; ++i)
+		retVal[i] = new (ptr + i*m_packetSize) VertexPacket();
+
 	return retVal;
 }
 
 VertexPacket* VertexPacketAllocator::alloc (void)
 {
-	const size_t poolSize = 8;
+	const size_t minPoolSize = 8;
+	const size_t maxPoolSize = 1024;
 
-	if (m_singleAllocPool.empty())
-		m_singleAllocPool = allocArray(poolSize);
+	if (m_numFreeSingleAllocs == 0)
+	{
+		// Clipping may request lots of packets, grow pool size to keep number of allocations low
+		const size_t poolSize = de::clamp(m_singleAllocPoolSize * 2, minPoolSize, maxPoolSize);
 
-	VertexPacket* packet = *--m_singleAllocPool.end();
-	m_singleAllocPool.pop_back();
-	return packet;
+		m_singleAllocPool		= allocPackets(poolSize);
+		m_singleAllocPoolSize	= poolSize;
+		m_numFreeSingleAllocs	= poolSize;
+	}
+
+	{
+		VertexPacket* const packet = new (m_singleAllocPool) VertexPacket();
+
+		m_singleAllocPool += m_packetSize;
+		m_numFreeSingleAllocs--;
+
+		return packet;
+	}
 }
 
 } // rr
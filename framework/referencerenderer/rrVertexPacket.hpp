@@ -106,9 +106,16 @@ private:
 								VertexPacketAllocator	(const VertexPacketAllocator&); // disabled, non-copyable
 	VertexPacketAllocator&		operator=				(const VertexPacketAllocator&); // disabled, non-copyable
 
+	deInt8*						allocPackets			(size_t count); // throws bad_alloc
+
 	const size_t				m_numberOfVertexOutputs;
+	const size_t				m_packetSize;
 	std::vector<deInt8*>		m_allocations;
-	std::vector<VertexPacket*>	m_singleAllocPool;
+
+	// Single packets are bump-allocated from pools of increasing size
+	deInt8*						m_singleAllocPool;
+	size_t						m_singleAllocPoolSize;
+	size_t						m_numFreeSingleAllocs;
 } DE_WARN_UNUSED_TYPE;
 
 } // rr
@@ -919,6 +919,8 @@ public:
 		this->rr::FragmentShader::m_inputs[0].flatshade	= false;
 
 		this->rr::FragmentShader::m_outputs[0].type		= rr::GENERICVECTYPE_FLOAT;
+
+		this->rr::FragmentShader::m_threadSafe			= true;
 	}
 
 	void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
@@ -711,6 +711,7 @@ FragmentShader::FragmentShader (int drawBufferNdx, const DrawBufferInfo& info)
 	, m_info				(info)
 {
 	m_inputs[0].type = rr::GENERICVECTYPE_FLOAT;
+	m_threadSafe = true;
 
 	switch (tcu::getTextureChannelClass(m_info.getFormat().type))
 	{
@@ -42,6 +42,7 @@
 #include "tcuVector.hpp"
 #include "tcuMatrix.hpp"
 #include "tcuResultCollector.hpp"
+#include "tcuWorkerPool.hpp"
 
 #include "gluContextInfo.hpp"
 #include "gluVarType.hpp"
@@ -55,7 +56,9 @@
 #include <sstream>
 #include <iostream>
 #include <map>
+#include <deque>
 #include <utility>
+#include <stdexcept>
 
 // Uncomment this to get evaluation trace dumps to std::cerr
 // #define GLS_ENABLE_TRACE
@@ -582,34 +585,106 @@ StatementP		compoundStatement	(const vector<StatementP>& statements);
  * An Environment object maintains the mapping between variables of the
  * abstract syntax tree and their values.
  *
+ * Variables are identified by the Variable object itself rather than by
+ * name, and storage of removed bindings is reused, so repeated evaluation
+ * of the same statements does not allocate memory.
+ *
  * \todo [2014-03-28 lauri] At least run-time type safety.
  *
  *//*--------------------------------------------------------------------*/
 class Environment
 {
 public:
+								Environment			(void) : m_numSlots(0) {}
+
 	template<typename T>
-	void						bind	(const Variable<T>&					variable,
-										 const typename Traits<T>::IVal&	value)
+	void						bind				(const Variable<T>&					variable,
+													 const typename Traits<T>::IVal&	value)
 	{
-		deUint8* const data = new deUint8[sizeof(value)];
+		deUint8* const data = getSlot(&variable, sizeof(value));
 
 		deMemcpy(data, &value, sizeof(value));
-		de::insert(m_map, variable.getName(), SharedPtr<deUint8>(data, de::ArrayDeleter<deUint8>()));
 	}
 
 	template<typename T>
-	typename Traits<T>::IVal&	lookup	(const Variable<T>& variable) const
+	typename Traits<T>::IVal&	lookup				(const Variable<T>& variable) const
 	{
-		deUint8* const data = de::lookup(m_map, variable.getName()).get();
+		deUint8* const data = findSlot(&variable);
+
+		if (!data)
+			throw std::out_of_range("Variable " + variable.getName() + " not bound");
 
 		return *reinterpret_cast<typename Traits<T>::IVal*>(data);
 	}
 
+	//! Remove all bindings. Storage is kept for later bindings.
+	void						clear				(void) { m_numSlots = 0; }
+
+	//! Get an empty environment for evaluating a function called from this environment.
+	Environment&				getCallEnvironment	(void);
+
 private:
-	map<string, SharedPtr<deUint8> >	m_map;
+								Environment			(const Environment&);
+	Environment&				operator=			(const Environment&);
+
+	struct Slot
+	{
+		const void*			variable;
+		vector<deUint8>		data;
+	};
+
+	deUint8*					getSlot				(const void* variable, size_t size);
+	deUint8*					findSlot			(const void* variable) const;
+
+	// \note Deque doesn't move existing slots when growing, so references
+	//		 returned by lookup() stay valid when new variables are bound.
+	mutable std::deque<Slot>	m_slots;
+	size_t						m_numSlots;			//!< Slots [0, m_numSlots) are bound
+	MovePtr<Environment>		m_callEnv;
 };
 
+deUint8* Environment::getSlot (const void* variable, size_t size)
+{
+	deUint8* const	bound	= findSlot(variable);
+
+	if (bound)
+		return bound;
+
+	if (m_numSlots == m_slots.size())
+		m_slots.push_back(Slot());
+
+	{
+		Slot&	slot	= m_slots[m_numSlots++];
+
+		slot.variable = variable;
+		slot.data.resize(size);
+
+		return &slot.data[0];
+	}
+}
+
+deUint8* Environment::findSlot (const void* variable) const
+{
+	for (size_t ndx = 0; ndx < m_numSlots; ++ndx)
+	{
+		if (m_slots[ndx].variable == variable)
+			return &m_slots[ndx].data[0];
+	}
+
+	return DE_NULL;
+}
+
+Environment& Environment::getCallEnvironment (void)
+{
+	// Calls can't be recursive, so one environment per call depth is enough
+	if (!m_callEnv)
+		m_callEnv = MovePtr<Environment>(new Environment());
+
+	m_callEnv->clear();
+
+	return *m_callEnv;
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Evaluation context.
  *
@@ -1499,9 +1574,9 @@ protected:
 	IRet						doApply			(const EvalContext&	ctx,
 												 const IArgs&		args) const
 	{
-		Environment	funEnv;
-		IArgs&		mutArgs		= const_cast<IArgs&>(args);
-		IRet		ret;
+		Environment&	funEnv		= ctx.env.getCallEnvironment();
+		IArgs&			mutArgs		= const_cast<IArgs&>(args);
+		IRet			ret;
 
 		initialize();
 
@@ -4611,6 +4686,145 @@ IterateResult PrecisionCase::iterate (void)
 	return STOP;
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Computes reference intervals of a statement for a set of inputs.
+ *
+ * Inputs are evaluated in batches using the worker pool. Each worker thread
+ * has its own environment, so evaluation doesn't allocate memory after the
+ * first batch.
+ *//*--------------------------------------------------------------------*/
+template <typename In, typename Out>
+class ReferenceEvaluator : public tcu::ParallelWork
+{
+public:
+	typedef typename	In::In0						In0;
+	typedef typename	In::In1						In1;
+	typedef typename	In::In2						In2;
+	typedef typename	In::In3						In3;
+	typedef typename	Out::Out0					Out0;
+	typedef typename	Out::Out1					Out1;
+	typedef typename	Traits<Out0>::IVal			IVal0;
+	typedef typename	Traits<Out1>::IVal			IVal1;
+
+								ReferenceEvaluator	(const Variables<In, Out>&	variables,
+													 const Inputs<In>&			inputs,
+													 const Statement&			stmt,
+													 const FloatFormat&			fmt,
+													 const FloatFormat&			highpFmt,
+													 Precision					precision,
+													 size_t						numValues);
+
+	//! Compute references for values [first, last).
+	void						evaluate			(size_t first, size_t last);
+
+	const IVal0&				getReference0		(size_t valueNdx) const { return m_reference0[valueNdx]; }
+	const IVal1&				getReference1		(size_t valueNdx) const { return m_reference1[valueNdx]; }
+
+	void						execute				(int workerNdx, int itemNdx);
+
+private:
+	enum
+	{
+		BATCH_SIZE = 64
+	};
+
+	void						evaluateValue		(Environment& env, size_t valueNdx);
+
+	const Variables<In, Out>&			m_variables;
+	const Inputs<In>&					m_inputs;
+	const Statement&					m_stmt;
+	const FloatFormat					m_fmt;
+	const FloatFormat					m_highpFmt;
+	const Precision						m_precision;
+	vector<SharedPtr<Environment> >		m_envs;			//!< Per worker thread
+	vector<IVal0>						m_reference0;
+	vector<IVal1>						m_reference1;
+	size_t								m_first;
+	size_t								m_last;
+};
+
+template <typename In, typename Out>
+ReferenceEvaluator<In, Out>::ReferenceEvaluator (const Variables<In, Out>&	variables,
+												 const Inputs<In>&			inputs,
+												 const Statement&			stmt,
+												 const FloatFormat&			fmt,
+												 const FloatFormat&			highpFmt,
+												 Precision					precision,
+												 size_t						numValues)
+	: m_variables	(variables)
+	, m_inputs		(inputs)
+	, m_stmt		(stmt)
+	, m_fmt			(fmt)
+	, m_highpFmt	(highpFmt)
+	, m_precision	(precision)
+	, m_reference0	(numValues)
+	, m_reference1	(numValues)
+	, m_first		(0)
+	, m_last		(0)
+{
+	// Initialize environments with dummy values so we don't need to bind in inner loop.
+	for (int workerNdx = 0; workerNdx < tcu::getNumWorkerThreads(); ++workerNdx)
+	{
+		const typename Traits<In0>::IVal	in0;
+		const typename Traits<In1>::IVal	in1;
+		const typename Traits<In2>::IVal	in2;
+		const typename Traits<In3>::IVal	in3;
+		const IVal0							reference0;
+		const IVal1							reference1;
+		const SharedPtr<Environment>		env			(new Environment());
+
+		env->bind(*variables.in0, in0);
+		env->bind(*variables.in1, in1);
+		env->bind(*variables.in2, in2);
+		env->bind(*variables.in3, in3);
+		env->bind(*variables.out0, reference0);
+		env->bind(*variables.out1, reference1);
+
+		m_envs.push_back(env);
+	}
+}
+
+template <typename In, typename Out>
+void ReferenceEvaluator<In, Out>::evaluateValue (Environment& env, size_t valueNdx)
+{
+	env.lookup(*m_variables.in0) = convert<In0>(m_fmt, round(m_fmt, m_inputs.in0[valueNdx]));
+	env.lookup(*m_variables.in1) = convert<In1>(m_fmt, round(m_fmt, m_inputs.in1[valueNdx]));
+	env.lookup(*m_variables.in2) = convert<In2>(m_fmt, round(m_fmt, m_inputs.in2[valueNdx]));
+	env.lookup(*m_variables.in3) = convert<In3>(m_fmt, round(m_fmt, m_inputs.in3[valueNdx]));
+
+	{
+		EvalContext	ctx (m_fmt, m_precision, env);
+		m_stmt.execute(ctx);
+	}
+
+	m_reference0[valueNdx] = convert<Out0>(m_highpFmt, env.lookup(*m_variables.out0));
+	m_reference1[valueNdx] = convert<Out1>(m_highpFmt, env.lookup(*m_variables.out1));
+}
+
+template <typename In, typename Out>
+void ReferenceEvaluator<In, Out>::evaluate (size_t first, size_t last)
+{
+	// First value is evaluated on the calling thread so that function
+	// instances used by the statement get constructed before going wide.
+	if (first == 0 && first < last)
+		evaluateValue(*m_envs[0], first++);
+
+	m_first	= first;
+	m_last	= last;
+
+	tcu::executeParallel(*this, (int)((last - first + BATCH_SIZE - 1) / BATCH_SIZE));
+}
+
+template <typename In, typename Out>
+void ReferenceEvaluator<In, Out>::execute (int workerNdx, int itemNdx)
+{
+	const size_t	first	= m_first + (size_t)itemNdx * BATCH_SIZE;
+	const size_t	last	= de::min(first + (size_t)BATCH_SIZE, m_last);
+
+	for (size_t valueNdx = first; valueNdx < last; valueNdx++)
+		evaluateValue(*m_envs[workerNdx], valueNdx);
+}
+
 template <typename In, typename Out>
 void PrecisionCase::testStatement (const Variables<In, Out>&	variables,
 								   const Inputs<In>&			inputs,
@@ -4618,10 +4832,6 @@ void PrecisionCase::testStatement (const Variables<In, Out>&	variables,
 {
 	using namespace ShaderExecUtil;
 
-	typedef typename	In::In0		In0;
-	typedef typename	In::In1		In1;
-	typedef typename	In::In2		In2;
-	typedef typename	In::In3		In3;
 	typedef typename	Out::Out0	Out0;
 	typedef typename	Out::Out1	Out1;
 
@@ -4634,7 +4844,6 @@ void PrecisionCase::testStatement (const Variables<In, Out>&	variables,
 	const FloatFormat	highpFmt	= m_ctx.highpFormat;
 	const int			maxMsgs		= 100;
 	int					numErrors	= 0;
-	Environment			env;		// Hoisted out of the inner loop for optimization.
 
 	switch (inCount)
 	{
@@ -4735,51 +4944,28 @@ void PrecisionCase::testStatement (const Variables<In, Out>&	variables,
 		executor->execute(int(numValues), inputArr, outputArr);
 	}
 
-	// Initialize environment with dummy values so we don't need to bind in inner loop.
-	{
-		const typename Traits<In0>::IVal		in0;
-		const typename Traits<In1>::IVal		in1;
-		const typename Traits<In2>::IVal		in2;
-		const typename Traits<In3>::IVal		in3;
-		const typename Traits<Out0>::IVal		reference0;
-		const typename Traits<Out1>::IVal		reference1;
+	// Compute reference intervals for all inputs.
+	ReferenceEvaluator<In, Out>	evaluator	(variables, inputs, stmt, fmt, highpFmt, m_ctx.precision, numValues);
 
-		env.bind(*variables.in0, in0);
-		env.bind(*variables.in1, in1);
-		env.bind(*variables.in2, in2);
-		env.bind(*variables.in3, in3);
-		env.bind(*variables.out0, reference0);
-		env.bind(*variables.out1, reference1);
+	for (size_t first = 0; first < numValues; first += (size_t)TOUCH_WATCHDOG_VALUE_FREQUENCY)
+	{
+		m_testCtx.touchWatchdog();
+		evaluator.evaluate(first, de::min(first + (size_t)TOUCH_WATCHDOG_VALUE_FREQUENCY, numValues));
 	}
 
-	// For each input tuple, compute output reference interval and compare
-	// shader output to the reference.
+	// Compare shader outputs to the references.
 	for (size_t valueNdx = 0; valueNdx < numValues; valueNdx++)
 	{
-		bool						result = true;
-		bool						inExpectedRange;
-		bool						inWarningRange;
-		const char*					failStr = "Fail";
-		typename Traits<Out0>::IVal	reference0;
-		typename Traits<Out1>::IVal	reference1;
-
-		if (valueNdx % (size_t)TOUCH_WATCHDOG_VALUE_FREQUENCY == 0)
-			m_testCtx.touchWatchdog();
-
-		env.lookup(*variables.in0) = convert<In0>(fmt, round(fmt, inputs.in0[valueNdx]));
-		env.lookup(*variables.in1) = convert<In1>(fmt, round(fmt, inputs.in1[valueNdx]));
-		env.lookup(*variables.in2) = convert<In2>(fmt, round(fmt, inputs.in2[valueNdx]));
-		env.lookup(*variables.in3) = convert<In3>(fmt, round(fmt, inputs.in3[valueNdx]));
-
-		{
-			EvalContext	ctx (fmt, m_ctx.precision, env);
-			stmt.execute(ctx);
-		}
+		bool								result = true;
+		bool								inExpectedRange;
+		bool								inWarningRange;
+		const char*							failStr = "Fail";
+		const typename Traits<Out0>::IVal&	reference0	= evaluator.getReference0(valueNdx);
+		const typename Traits<Out1>::IVal&	reference1	= evaluator.getReference1(valueNdx);
 
 		switch (outCount)
 		{
 			case 2:
-				reference1      = convert<Out1>(highpFmt, env.lookup(*variables.out1));
 				inExpectedRange = contains(reference1, outputs.out1[valueNdx]);
 				inWarningRange  = containsWarning(reference1, outputs.out1[valueNdx]);
 				if (!inExpectedRange && inWarningRange)
@@ -4797,7 +4983,6 @@ void PrecisionCase::testStatement (const Variables<In, Out>&	variables,
 			// Fallthrough
 
 			case 1:
-				reference0      = convert<Out0>(highpFmt, env.lookup(*variables.out0));
 				inExpectedRange = contains(reference0, outputs.out0[valueNdx]);
 				inWarningRange  = containsWarning(reference0, outputs.out0[valueNdx]);
 				if (!inExpectedRange && inWarningRange)
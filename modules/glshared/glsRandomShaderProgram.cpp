@@ -141,6 +141,9 @@ RandomShaderProgram::RandomShaderProgram (const rsg::Shader& vertexShader, const
 	TCU_CHECK_INTERNAL(m_positionVar && m_positionVar->getType().getBaseType() == rsg::VariableType::TYPE_FLOAT && m_positionVar->getType().getNumElements() == 4);
 	TCU_CHECK_INTERNAL(m_fragColorVar && m_fragColorVar->getType().getBaseType() == rsg::VariableType::TYPE_FLOAT && m_fragColorVar->getType().getNumElements() == 4);
 
+	// Shading uses single m_execCtx, so the reference renderer must not shade fragments of this program concurrently.
+	setFragmentShaderThreadSafe(false);
+
 	// Build list of vertex outputs.
 	for (vector<rsg::ShaderInput*>::const_iterator fragInIter = fragmentShader.getInputs().begin(); fragInIter != fragmentShader.getInputs().end(); ++fragInIter)
 	{
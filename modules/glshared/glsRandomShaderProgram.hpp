@@ -60,7 +60,7 @@ private:
 
 	rsg::Sampler2DMap					m_sampler2DMap;
 	rsg::SamplerCubeMap					m_samplerCubeMap;
-	mutable rsg::ExecutionContext		m_execCtx;
+	mutable rsg::ExecutionContext		m_execCtx;					//!< Shared by all invocations, shadeFragments() is not thread-safe.
 };
 
 } // gls
@@ -32,11 +32,21 @@
 #include "tcuCommandLine.hpp"
 
 #include "rrRenderer.hpp"
+#include "rrFragmentOperations.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuVectorUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuWorkerPool.hpp"
+#include "tcuCompressedTexture.hpp"
+#include "tcuAstcUtil.hpp"
+#include "tcuSurface.hpp"
+#include "tcuTexLookupVerifier.hpp"
+#include "tcuImageCompare.hpp"
+#include "tcuFuzzyImageCompare.hpp"
+#include "gluTextureTestUtil.hpp"
 
 #include "deRandom.hpp"
+#include "deAtomic.h"
 #include "deArrayUtil.hpp"
 
 #include <stdexcept>
@@ -278,6 +288,20 @@ public:
 			};
 			addChild(new CaseListParserCase(m_testCtx, "group_case", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
 		}
+		{
+			static const char* const	caseList	= "{a{b},c{d},a{e}}";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",		MatchCase::MATCH_GROUP	},
+				{ "a.b",	MatchCase::MATCH_CASE	},
+				{ "a.d",	MatchCase::NO_MATCH		},
+				{ "a.e",	MatchCase::MATCH_CASE	},
+				{ "c",		MatchCase::MATCH_GROUP	},
+				{ "c.d",	MatchCase::MATCH_CASE	},
+				{ "c.e",	MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "repeated_group", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
+		}
 		{
 			static const char* const	caseList	= "{test}\r";
 			static const MatchCase		subCases[]	=
@@ -880,6 +904,944 @@ protected:
 	vector<SubCase>::const_iterator	m_caseIter;
 };
 
+class TiledRasterizationTest : public tcu::TestCase
+{
+public:
+	TiledRasterizationTest (tcu::TestContext& testCtx)
+		: tcu::TestCase			(testCtx, "tiled_rasterization", "Compare tile-parallel rasterization to serial rasterization")
+		, m_origNumThreads		(1)
+		, m_primitiveTypeNdx	(0)
+	{
+	}
+
+	void init (void)
+	{
+		m_origNumThreads	= tcu::getNumWorkerThreads();
+		m_primitiveTypeNdx	= 0;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "All iterations passed");
+	}
+
+	void deinit (void)
+	{
+		tcu::setNumWorkerThreads(m_origNumThreads);
+	}
+
+	IterateResult iterate (void)
+	{
+		static const rr::PrimitiveType s_primitiveTypes[] =
+		{
+			rr::PRIMITIVETYPE_TRIANGLES,
+			rr::PRIMITIVETYPE_TRIANGLE_STRIP,
+			rr::PRIMITIVETYPE_LINES,
+			rr::PRIMITIVETYPE_LINE_STRIP,
+			rr::PRIMITIVETYPE_POINTS,
+		};
+
+		{
+			tcu::ScopedLogSection section(m_testCtx.getLog(), "SubCase", "");
+			runCase(s_primitiveTypes[m_primitiveTypeNdx], (deUint32)m_primitiveTypeNdx);
+		}
+
+		return (++m_primitiveTypeNdx < DE_LENGTH_OF_ARRAY(s_primitiveTypes)) ? CONTINUE : STOP;
+	}
+
+private:
+	class VtxShader : public rr::VertexShader
+	{
+	public:
+		VtxShader (void)
+			: rr::VertexShader(2, 1)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_inputs[1].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+		}
+
+		void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+		{
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				rr::readVertexAttrib(packets[packetNdx]->position, inputs[0], packets[packetNdx]->instanceNdx, packets[packetNdx]->vertexNdx);
+				packets[packetNdx]->outputs[0]	= rr::readVertexAttribFloat(inputs[1], packets[packetNdx]->instanceNdx, packets[packetNdx]->vertexNdx);
+				packets[packetNdx]->pointSize	= 5.0f;
+			}
+		}
+	};
+
+	//! Outputs varying and its derivative. Tracks how many invocations run concurrently.
+	class FragShader : public rr::FragmentShader
+	{
+	public:
+		FragShader (bool threadSafe)
+			: rr::FragmentShader	(1, 1)
+			, m_numActive			(0)
+			, m_maxActive			(0)
+		{
+			m_inputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_outputs[0].type	= rr::GENERICVECTYPE_FLOAT;
+			m_threadSafe		= threadSafe;
+		}
+
+		void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+		{
+			const int numActive = (int)deAtomicIncrement32(&m_numActive);
+
+			m_maxActive = de::max(m_maxActive, numActive);
+
+			for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+			{
+				tcu::Vec4 color[rr::NUM_FRAGMENTS_PER_PACKET];
+				tcu::Vec4 dFdx[rr::NUM_FRAGMENTS_PER_PACKET];
+
+				for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+					color[fragNdx] = rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx);
+
+				rr::dFdxLocal(dFdx, color);
+
+				for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+					rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, color[fragNdx] + 8.0f * tcu::abs(dFdx[fragNdx]));
+			}
+
+			deAtomicDecrement32(&m_numActive);
+		}
+
+		int getMaxActive (void) const { return m_maxActive; }
+
+	private:
+		mutable volatile deInt32	m_numActive;
+		mutable int					m_maxActive;
+	};
+
+	void render (const tcu::PixelBufferAccess& color, const tcu::PixelBufferAccess& depth, rr::PrimitiveType primitiveType, const vector<tcu::Vec4>& positions, const vector<tcu::Vec4>& colors, const FragShader& fragShader) const
+	{
+		const VtxShader							vtxShader;
+		const rr::Program						program			(&vtxShader, &fragShader);
+		const rr::MultisamplePixelBufferAccess	colorAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(color);
+		const rr::MultisamplePixelBufferAccess	depthAccess		= rr::MultisamplePixelBufferAccess::fromMultisampleAccess(depth);
+		const rr::RenderTarget					renderTarget	(colorAccess, depthAccess);
+		const rr::VertexAttrib					vertexAttribs[]	=
+		{
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &positions[0]),
+			rr::VertexAttrib(rr::VERTEXATTRIBTYPE_FLOAT, 4, 0, 0, &colors[0])
+		};
+		rr::RenderState							state			((rr::ViewportState(colorAccess)));
+		const rr::Renderer						renderer;
+
+		state.fragOps.depthTestEnabled			= true;
+		state.fragOps.depthFunc					= rr::TESTFUNC_LESS;
+		state.fragOps.blendMode					= rr::BLENDMODE_STANDARD;
+		state.fragOps.blendRGBState.srcFunc		= rr::BLENDFUNC_SRC_ALPHA;
+		state.fragOps.blendRGBState.dstFunc		= rr::BLENDFUNC_ONE_MINUS_SRC_ALPHA;
+		state.line.lineWidth					= 3.0f;
+
+		tcu::clear(color, tcu::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+		tcu::clearDepth(depth, 1.0f);
+
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, DE_LENGTH_OF_ARRAY(vertexAttribs), vertexAttribs, rr::PrimitiveList(primitiveType, (int)positions.size(), 0)));
+	}
+
+	void runCase (rr::PrimitiveType primitiveType, deUint32 seed)
+	{
+		using namespace tcu;
+
+		const int			numWorkerThreads	= 4;
+		const int			numVertices			= 600;
+		de::Random			rnd					(0x5a1ed ^ seed);
+		const int			width				= rnd.getInt(130, 300);
+		const int			height				= rnd.getInt(130, 300);
+		const TextureFormat	colorFormat			(TextureFormat::RGBA, TextureFormat::UNORM_INT8);
+		const TextureFormat	depthFormat			(TextureFormat::D, TextureFormat::FLOAT);
+		vector<Vec4>		positions			(numVertices);
+		vector<Vec4>		colors				(numVertices);
+
+		for (int vtxNdx = 0; vtxNdx < numVertices; vtxNdx++)
+		{
+			positions[vtxNdx]	= Vec4(rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.0f, 1.0f), 1.0f);
+			colors[vtxNdx]		= Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat(0.3f, 1.0f));
+		}
+
+		m_testCtx.getLog() << TestLog::Message << "Primitive type " << (int)primitiveType << ", " << numVertices << " vertices, render target " << width << "x" << height << TestLog::EndMessage;
+
+		// Reference: serial rendering
+		TextureLevel	refColor	(colorFormat, 1, width, height);
+		TextureLevel	refDepth	(depthFormat, 1, width, height);
+		{
+			const FragShader fragShader (true);
+
+			setNumWorkerThreads(1);
+			render(refColor.getAccess(), refDepth.getAccess(), primitiveType, positions, colors, fragShader);
+		}
+
+		setNumWorkerThreads(numWorkerThreads);
+
+		for (int threadSafe = 0; threadSafe < 2; threadSafe++)
+		{
+			const FragShader	fragShader	(threadSafe != 0);
+			TextureLevel		color		(colorFormat, 1, width, height);
+			TextureLevel		depth		(depthFormat, 1, width, height);
+
+			render(color.getAccess(), depth.getAccess(), primitiveType, positions, colors, fragShader);
+
+			if (!deMemoryEqual(refColor.getAccess().getDataPtr(), color.getAccess().getDataPtr(), (size_t)(width*height*colorFormat.getPixelSize())) ||
+				!deMemoryEqual(refDepth.getAccess().getDataPtr(), depth.getAccess().getDataPtr(), (size_t)(width*height*depthFormat.getPixelSize())))
+			{
+				m_testCtx.getLog() << TestLog::Message << "FAIL: Result with " << numWorkerThreads << " worker threads " << (threadSafe ? "(thread-safe shader)" : "(serial shader)") << " differs from serial rendering" << TestLog::EndMessage
+								   << TestLog::Image("Reference", "Serial rendering", rr::MultisampleConstPixelBufferAccess::fromMultisampleAccess(refColor.getAccess()).toSinglesampleAccess())
+								   << TestLog::Image("Result", "Parallel rendering", rr::MultisampleConstPixelBufferAccess::fromMultisampleAccess(color.getAccess()).toSinglesampleAccess());
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Result differs from serial rendering");
+			}
+
+			if (!threadSafe && fragShader.getMaxActive() > 1)
+			{
+				m_testCtx.getLog() << TestLog::Message << "FAIL: Fragment shader not marked thread-safe was executed concurrently" << TestLog::EndMessage;
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Fragment shader was executed concurrently");
+			}
+		}
+
+		setNumWorkerThreads(m_origNumThreads);
+	}
+
+	int		m_origNumThreads;
+	int		m_primitiveTypeNdx;
+};
+
+class FragmentOperationKernelTest : public tcu::TestCase
+{
+public:
+	FragmentOperationKernelTest (tcu::TestContext& testCtx)
+		: tcu::TestCase	(testCtx, "fragment_operation_kernels", "Compare format-specialized fragment operations to generic fragment operations")
+		, m_caseNdx		(0)
+	{
+	}
+
+	void init (void)
+	{
+		m_caseNdx = 0;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "All iterations passed");
+	}
+
+	IterateResult iterate (void)
+	{
+		static const tcu::TextureFormat s_depthFormats[] =
+		{
+			tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::UNORM_INT24),
+			tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::UNORM_INT16),
+		};
+		static const tcu::TextureFormat s_colorFormats[] =
+		{
+			tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::sRGBA, tcu::TextureFormat::UNORM_INT8),
+		};
+		static const int s_numSamples[] = { 1, 4 };
+
+		const int numCases = DE_LENGTH_OF_ARRAY(s_depthFormats) * DE_LENGTH_OF_ARRAY(s_colorFormats) * DE_LENGTH_OF_ARRAY(s_numSamples);
+
+		{
+			tcu::ScopedLogSection section(m_testCtx.getLog(), "SubCase", "");
+			runCase(s_depthFormats[m_caseNdx % DE_LENGTH_OF_ARRAY(s_depthFormats)],
+					s_colorFormats[(m_caseNdx / DE_LENGTH_OF_ARRAY(s_depthFormats)) % DE_LENGTH_OF_ARRAY(s_colorFormats)],
+					s_numSamples[m_caseNdx / (DE_LENGTH_OF_ARRAY(s_depthFormats) * DE_LENGTH_OF_ARRAY(s_colorFormats))],
+					(deUint32)m_caseNdx);
+		}
+
+		return (++m_caseNdx < numCases) ? CONTINUE : STOP;
+	}
+
+private:
+	//! Depth values are picked from a small set part of the time so that EQUAL and NOTEQUAL tests can pass.
+	static float getRandomDepth (de::Random& rnd)
+	{
+		return rnd.getBool() ? (float)rnd.getInt(0, 4) / 4.0f : rnd.getFloat(-0.1f, 1.1f);
+	}
+
+	void runCase (const tcu::TextureFormat& depthFormat, const tcu::TextureFormat& colorFormat, int numSamples, deUint32 seed)
+	{
+		using namespace tcu;
+
+		const int			width			= 37;
+		const int			height			= 29;
+		const int			numIterations	= 16;
+		de::Random			rnd				(0xf2a90 ^ seed);
+		TextureLevel		refColor		(colorFormat, numSamples, width, height);
+		TextureLevel		refDepth		(depthFormat, numSamples, width, height);
+		TextureLevel		color			(colorFormat, numSamples, width, height);
+		TextureLevel		depth			(depthFormat, numSamples, width, height);
+		const size_t		colorSize		= (size_t)(numSamples * width * height * colorFormat.getPixelSize());
+		const size_t		depthSize		= (size_t)(numSamples * width * height * depthFormat.getPixelSize());
+		vector<IVec2>		pixelCoords;
+
+		m_testCtx.getLog() << TestLog::Message << "Depth format " << depthFormat << ", color format " << colorFormat << ", " << numSamples << " samples" << TestLog::EndMessage;
+
+		for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+			pixelCoords.push_back(IVec2(x, y));
+
+		for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+		for (int s = 0; s < numSamples; s++)
+		{
+			refColor.getAccess().setPixel(Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat()), s, x, y);
+			refDepth.getAccess().setPixDepth(de::clamp(getRandomDepth(rnd), 0.0f, 1.0f), s, x, y);
+		}
+
+		copy(color.getAccess(), refColor.getAccess());
+		copy(depth.getAccess(), refDepth.getAccess());
+
+		for (int iterNdx = 0; iterNdx < numIterations; iterNdx++)
+		{
+			const int					numFragments	= rnd.getInt(1, width * height);
+			rr::FragmentOperationState	state;
+			vector<rr::Fragment>		fragments;
+			vector<float>				sampleDepths	((size_t)(numFragments * numSamples));
+
+			state.depthTestEnabled			= rnd.getInt(0, 3) != 0;
+			state.depthFunc					= (rr::TestFunc)rnd.getInt(0, rr::TESTFUNC_LAST - 1);
+			state.depthMask					= rnd.getInt(0, 3) != 0;
+			state.blendMode					= rnd.getBool() ? rr::BLENDMODE_STANDARD : rr::BLENDMODE_NONE;
+			state.blendRGBState.srcFunc		= rr::BLENDFUNC_SRC_ALPHA;
+			state.blendRGBState.dstFunc		= rr::BLENDFUNC_ONE_MINUS_SRC_ALPHA;
+			state.blendAState.srcFunc		= rr::BLENDFUNC_ONE;
+			state.blendAState.dstFunc		= rr::BLENDFUNC_DST_ALPHA;
+			state.sRGBEnabled				= rnd.getBool();
+			state.colorMask					= rnd.getBool() ? BVec4(true) : BVec4(rnd.getBool(), rnd.getBool(), rnd.getBool(), rnd.getBool());
+
+			rnd.shuffle(pixelCoords.begin(), pixelCoords.end());
+
+			for (int fragNdx = 0; fragNdx < numFragments; fragNdx++)
+			{
+				for (int s = 0; s < numSamples; s++)
+					sampleDepths[fragNdx * numSamples + s] = getRandomDepth(rnd);
+
+				fragments.push_back(rr::Fragment(pixelCoords[fragNdx],
+												 rr::GenericVec4(Vec4(rnd.getFloat(-0.1f, 1.1f), rnd.getFloat(-0.1f, 1.1f), rnd.getFloat(-0.1f, 1.1f), rnd.getFloat())),
+												 rnd.getUint32() & ((1u << numSamples) - 1u),
+												 &sampleDepths[fragNdx * numSamples]));
+			}
+
+			{
+				rr::FragmentProcessor	genericProcessor;
+				rr::FragmentProcessor	kernelProcessor;
+
+				genericProcessor.setFormatKernelsEnabled(false);
+
+				genericProcessor.render(rr::MultisamplePixelBufferAccess::fromMultisampleAccess(refColor.getAccess()), rr::MultisamplePixelBufferAccess::fromMultisampleAccess(refDepth.getAccess()),
+										rr::MultisamplePixelBufferAccess(), &fragments[0], numFragments, rr::FACETYPE_FRONT, state);
+				kernelProcessor.render(rr::MultisamplePixelBufferAccess::fromMultisampleAccess(color.getAccess()), rr::MultisamplePixelBufferAccess::fromMultisampleAccess(depth.getAccess()),
+									   rr::MultisamplePixelBufferAccess(), &fragments[0], numFragments, rr::FACETYPE_FRONT, state);
+			}
+
+			if (!deMemoryEqual(refColor.getAccess().getDataPtr(), color.getAccess().getDataPtr(), colorSize) ||
+				!deMemoryEqual(refDepth.getAccess().getDataPtr(), depth.getAccess().getDataPtr(), depthSize))
+			{
+				m_testCtx.getLog() << TestLog::Message << "FAIL: Iteration " << iterNdx << ": result differs from generic fragment operations" << TestLog::EndMessage;
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Result differs from generic fragment operations");
+				break;
+			}
+		}
+	}
+
+	int		m_caseNdx;
+};
+
+class CompressedTextureDecodeTest : public tcu::TestCase
+{
+public:
+	CompressedTextureDecodeTest (tcu::TestContext& testCtx)
+		: tcu::TestCase		(testCtx, "compressed_texture_decode", "Compare parallel and cached compressed texture decoding to serial decoding")
+		, m_origNumThreads	(1)
+		, m_formatNdx		(0)
+	{
+	}
+
+	void init (void)
+	{
+		m_origNumThreads	= tcu::getNumWorkerThreads();
+		m_formatNdx			= 0;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "All formats passed");
+	}
+
+	void deinit (void)
+	{
+		tcu::setNumWorkerThreads(m_origNumThreads);
+		tcu::setDecompressionCacheSize((size_t)de::max(0, m_testCtx.getCommandLine().getDecompressionCacheSize()) << 20);
+	}
+
+	IterateResult iterate (void)
+	{
+		const tcu::CompressedTexFormat		format			= (tcu::CompressedTexFormat)m_formatNdx;
+		const tcu::IVec3					blockPixelSize	= tcu::getBlockPixelSize(format);
+		const tcu::IVec3					size			(75, 43, 1);
+		const size_t						numBlocks		= (size_t)(deDivRoundUp32(size.x(), blockPixelSize.x()) * deDivRoundUp32(size.y(), blockPixelSize.y()));
+		const tcu::TexDecompressionParams	params			(tcu::isAstcFormat(format) ? tcu::TexDecompressionParams::ASTCMODE_LDR : tcu::TexDecompressionParams::ASTCMODE_LAST);
+		const deUint32						seed			= deInt32Hash(m_formatNdx) ^ 0x51a7c0deu;
+		const tcu::TextureFormat			dstFormat		= tcu::getUncompressedFormat(format);
+		std::vector<deUint8>				data			(numBlocks * (size_t)tcu::getBlockSize(format));
+
+		DE_ASSERT(blockPixelSize.z() == 1);
+
+		if (tcu::isAstcFormat(format))
+			tcu::astc::generateRandomValidBlocks(&data[0], numBlocks, format, params.astcMode, seed);
+		else
+		{
+			de::Random rnd (seed);
+
+			for (size_t ndx = 0; ndx < data.size(); ndx++)
+				data[ndx] = rnd.getUint8();
+
+			// ETC1 differential mode is undefined if base colors overflow, use individual mode only.
+			if (format == tcu::COMPRESSEDTEXFORMAT_ETC1_RGB8)
+			{
+				for (size_t blockNdx = 0; blockNdx < numBlocks; blockNdx++)
+					data[blockNdx * 8 + 3] &= (deUint8)~0x02u;
+			}
+		}
+
+		{
+			tcu::TextureLevel	serial		(dstFormat, size.x(), size.y(), size.z());
+			tcu::TextureLevel	parallel	(dstFormat, size.x(), size.y(), size.z());
+			tcu::TextureLevel	cacheMiss	(dstFormat, size.x(), size.y(), size.z());
+			tcu::TextureLevel	cacheHit	(dstFormat, size.x(), size.y(), size.z());
+			const size_t		levelSize	= (size_t)(size.x() * size.y() * size.z() * dstFormat.getPixelSize());
+
+			tcu::setDecompressionCacheSize(0);
+
+			tcu::setNumWorkerThreads(1);
+			tcu::decompress(serial.getAccess(), format, &data[0], params);
+
+			tcu::setNumWorkerThreads(4);
+			tcu::decompress(parallel.getAccess(), format, &data[0], params);
+
+			tcu::setDecompressionCacheSize(4 * levelSize);
+			tcu::decompress(cacheMiss.getAccess(), format, &data[0], params);
+			tcu::decompress(cacheHit.getAccess(), format, &data[0], params);
+			tcu::setDecompressionCacheSize(0);
+
+			check(deMemoryEqual(serial.getAccess().getDataPtr(), parallel.getAccess().getDataPtr(), levelSize), "parallel");
+			check(deMemoryEqual(serial.getAccess().getDataPtr(), cacheMiss.getAccess().getDataPtr(), levelSize), "first cached");
+			check(deMemoryEqual(serial.getAccess().getDataPtr(), cacheHit.getAccess().getDataPtr(), levelSize), "second cached");
+		}
+
+		return (++m_formatNdx < tcu::COMPRESSEDTEXFORMAT_LAST) ? CONTINUE : STOP;
+	}
+
+private:
+	void check (bool ok, const char* decodeName)
+	{
+		if (!ok)
+		{
+			m_testCtx.getLog() << TestLog::Message << "FAIL: Format " << m_formatNdx << ": " << decodeName << " decode differs from serial decode" << TestLog::EndMessage;
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Decoded images differ");
+		}
+	}
+
+	int		m_origNumThreads;
+	int		m_formatNdx;
+};
+
+class TextureSampleBatchTest : public tcu::TestCase
+{
+public:
+	TextureSampleBatchTest (tcu::TestContext& testCtx)
+		: tcu::TestCase	(testCtx, "texture_sample_batch", "Compare batched 2D texture sampling to per-coordinate sampling")
+		, m_formatNdx	(0)
+	{
+	}
+
+	void init (void)
+	{
+		m_formatNdx = 0;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "All formats passed");
+	}
+
+	IterateResult iterate (void)
+	{
+		// \note sRGBA8 and RGBA16 exercise the generic fallback of the batch path.
+		static const tcu::TextureFormat s_formats[] =
+		{
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGB,		tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::R,		tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::HALF_FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::UNORM_INT24),
+			tcu::TextureFormat(tcu::TextureFormat::sRGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_INT16),
+		};
+
+		{
+			tcu::ScopedLogSection section(m_testCtx.getLog(), "SubCase", "");
+			runCase(s_formats[m_formatNdx], (deUint32)m_formatNdx);
+		}
+
+		return (++m_formatNdx < DE_LENGTH_OF_ARRAY(s_formats)) ? CONTINUE : STOP;
+	}
+
+private:
+	void runCase (const tcu::TextureFormat& format, deUint32 seed)
+	{
+		using namespace tcu;
+
+		const int			numIterations	= 32;
+		const int			numCoords		= 256;
+		de::Random			rnd				(0xba7c4 ^ seed);
+		const int			width			= rnd.getInt(1, 67);
+		const int			height			= rnd.getInt(1, 67);
+		const bool			isDepth			= format.order == TextureFormat::D;
+		Texture2D			texture			(format, width, height);
+		vector<float>		s				(numCoords);
+		vector<float>		t				(numCoords);
+		vector<float>		lod				(numCoords);
+		vector<Vec4>		result			(numCoords);
+
+		m_testCtx.getLog() << TestLog::Message << "Format " << format << ", size " << width << "x" << height << ", " << texture.getNumLevels() << " levels" << TestLog::EndMessage;
+
+		for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		{
+			texture.allocLevel(levelNdx);
+
+			const PixelBufferAccess level = texture.getLevel(levelNdx);
+
+			for (int y = 0; y < level.getHeight(); y++)
+			for (int x = 0; x < level.getWidth(); x++)
+			{
+				if (isDepth)
+					level.setPixDepth(rnd.getFloat(), x, y);
+				else
+					level.setPixel(Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat()), x, y);
+			}
+		}
+
+		for (int iterNdx = 0; iterNdx < numIterations; iterNdx++)
+		{
+			const Sampler	sampler	((Sampler::WrapMode)rnd.getInt(0, Sampler::WRAPMODE_LAST - 1),
+									 (Sampler::WrapMode)rnd.getInt(0, Sampler::WRAPMODE_LAST - 1),
+									 Sampler::CLAMP_TO_EDGE,
+									 (Sampler::FilterMode)rnd.getInt(Sampler::NEAREST, Sampler::LINEAR_MIPMAP_LINEAR),
+									 (Sampler::FilterMode)rnd.getInt(Sampler::NEAREST, Sampler::LINEAR),
+									 rnd.getBool() ? 0.0f : 0.5f,
+									 true,
+									 Sampler::COMPAREMODE_NONE,
+									 0,
+									 Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat()));
+
+			for (int ndx = 0; ndx < numCoords; ndx++)
+			{
+				s[ndx]		= rnd.getFloat(-1.5f, 2.5f);
+				t[ndx]		= rnd.getFloat(-1.5f, 2.5f);
+				lod[ndx]	= rnd.getFloat(-1.0f, (float)texture.getNumLevels());
+			}
+
+			texture.sampleBatch(sampler, numCoords, &s[0], &t[0], &lod[0], &result[0]);
+
+			for (int ndx = 0; ndx < numCoords; ndx++)
+			{
+				const Vec4 reference = texture.sample(sampler, s[ndx], t[ndx], lod[ndx]);
+
+				if (!deMemoryEqual(&reference, &result[ndx], sizeof(Vec4)))
+				{
+					m_testCtx.getLog() << TestLog::Message << "FAIL: Iteration " << iterNdx << ": sample at (" << s[ndx] << ", " << t[ndx] << "), lod " << lod[ndx]
+														   << " is " << result[ndx] << ", expected " << reference << TestLog::EndMessage;
+					m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Batched sampling result differs");
+					return;
+				}
+			}
+		}
+	}
+
+	int		m_formatNdx;
+};
+
+class TextureLookupVerifierTest : public tcu::TestCase
+{
+public:
+	TextureLookupVerifierTest (tcu::TestContext& testCtx)
+		: tcu::TestCase		(testCtx, "texture_lookup_verifier", "Compare parallel texture lookup verification with early rejection to serial full verification")
+		, m_origNumThreads	(1)
+		, m_caseNdx			(0)
+	{
+	}
+
+	void init (void)
+	{
+		m_origNumThreads	= tcu::getNumWorkerThreads();
+		m_caseNdx			= 0;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "All iterations passed");
+	}
+
+	void deinit (void)
+	{
+		tcu::setNumWorkerThreads(m_origNumThreads);
+		glu::TextureTestUtil::setLookupColorBoundsEnabled(true);
+	}
+
+	IterateResult iterate (void)
+	{
+		const int numCases = 8;
+
+		{
+			tcu::ScopedLogSection section(m_testCtx.getLog(), "SubCase", "");
+			runCase((deUint32)m_caseNdx);
+		}
+
+		return (++m_caseNdx < numCases) ? CONTINUE : STOP;
+	}
+
+private:
+	static int countErrorPixels (const tcu::Surface& errorMask)
+	{
+		int numErrors = 0;
+
+		for (int y = 0; y < errorMask.getHeight(); y++)
+		for (int x = 0; x < errorMask.getWidth(); x++)
+		{
+			if (errorMask.getPixel(x, y) != tcu::RGBA::green())
+				numErrors += 1;
+		}
+
+		return numErrors;
+	}
+
+	void runCase (deUint32 seed)
+	{
+		using namespace tcu;
+		using namespace glu::TextureTestUtil;
+
+		static const Sampler::WrapMode s_wrapModes[] =
+		{
+			Sampler::CLAMP_TO_EDGE,
+			Sampler::CLAMP_TO_BORDER,
+			Sampler::REPEAT_GL,
+			Sampler::MIRRORED_REPEAT_GL,
+		};
+
+		const int			width			= 48;
+		const int			height			= 48;
+		const PixelFormat	pixelFormat		(8, 8, 8, 8);
+		de::Random			rnd				(0x7e21f ^ seed);
+		Texture2D			texture			(TextureFormat(TextureFormat::RGBA, TextureFormat::UNORM_INT8), rnd.getInt(4, 64), rnd.getInt(4, 64));
+		const Sampler		sampler			(rnd.choose<Sampler::WrapMode>(DE_ARRAY_BEGIN(s_wrapModes), DE_ARRAY_END(s_wrapModes)),
+											 rnd.choose<Sampler::WrapMode>(DE_ARRAY_BEGIN(s_wrapModes), DE_ARRAY_END(s_wrapModes)),
+											 Sampler::CLAMP_TO_EDGE,
+											 (Sampler::FilterMode)rnd.getInt(Sampler::NEAREST, Sampler::LINEAR_MIPMAP_LINEAR),
+											 (Sampler::FilterMode)rnd.getInt(Sampler::NEAREST, Sampler::LINEAR),
+											 0.0f,
+											 true,
+											 Sampler::COMPAREMODE_NONE,
+											 0,
+											 Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), 1.0f));
+		const ReferenceParams	sampleParams	(TEXTURETYPE_2D, sampler);
+		Surface					reference		(width, height);
+		Surface					result			(width, height);
+		vector<float>			texCoord;
+		LodPrecision			lodPrec;
+		LookupPrecision			lookupPrec;
+
+		lodPrec.derivateBits		= 18;
+		lodPrec.lodBits				= 6;
+		lookupPrec.colorThreshold	= computeFixedPointThreshold(IVec4(6));
+		lookupPrec.coordBits		= IVec3(20, 20, 0);
+		lookupPrec.uvwBits			= IVec3(7, 7, 0);
+		lookupPrec.colorMask		= getCompareMask(pixelFormat);
+
+		// Texel values from a narrow range, so that random results can be rejected by color bounds.
+		for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		{
+			texture.allocLevel(levelNdx);
+
+			const PixelBufferAccess level = texture.getLevel(levelNdx);
+
+			for (int y = 0; y < level.getHeight(); y++)
+			for (int x = 0; x < level.getWidth(); x++)
+				level.setPixel(Vec4(rnd.getFloat(0.25f, 0.75f), rnd.getFloat(0.25f, 0.75f), rnd.getFloat(0.25f, 0.75f), rnd.getFloat(0.25f, 0.75f)), x, y);
+		}
+
+		computeQuadTexCoord2D(texCoord, Vec2(rnd.getFloat(-1.0f, 1.0f), rnd.getFloat(-1.0f, 1.0f)), Vec2(rnd.getFloat(-1.0f, 3.0f), rnd.getFloat(-1.0f, 3.0f)));
+		sampleTexture(SurfaceAccess(reference, pixelFormat), texture.getView(), &texCoord[0], sampleParams);
+
+		m_testCtx.getLog() << TestLog::Message << "Texture " << texture.getWidth() << "x" << texture.getHeight() << ", wrap modes " << sampler.wrapS << ", " << sampler.wrapT << ", filters " << sampler.minFilter << ", " << sampler.magFilter << TestLog::EndMessage;
+
+		// Mix of exact, slightly off, wrong but plausible, and arbitrary result values.
+		for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+		{
+			const Vec4	refPix	= reference.getPixel(x, y).toVec();
+			const int	kind	= rnd.getInt(0, 9);
+			Vec4		resPix	= refPix;
+
+			if (kind >= 5 && kind < 7)
+				resPix = refPix + Vec4(rnd.getFloat(-0.02f, 0.02f), rnd.getFloat(-0.02f, 0.02f), rnd.getFloat(-0.02f, 0.02f), rnd.getFloat(-0.02f, 0.02f));
+			else if (kind >= 7 && kind < 9)
+				resPix = refPix + Vec4(rnd.getFloat(-0.15f, 0.15f), rnd.getFloat(-0.15f, 0.15f), rnd.getFloat(-0.15f, 0.15f), rnd.getFloat(-0.15f, 0.15f));
+			else if (kind == 9)
+				resPix = Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat());
+
+			result.getAccess().setPixel(clamp(resPix, Vec4(0.0f), Vec4(1.0f)), x, y);
+		}
+
+		{
+			Surface		refErrorMask	(width, height);
+			int			refNumFailed;
+
+			setNumWorkerThreads(1);
+			setLookupColorBoundsEnabled(false);
+			refNumFailed = computeTextureLookupDiff(result.getAccess(), reference.getAccess(), refErrorMask.getAccess(), texture.getView(), &texCoord[0], sampleParams, lookupPrec, lodPrec, m_testCtx.getWatchDog());
+
+			m_testCtx.getLog() << TestLog::Message << refNumFailed << " invalid pixels in serial full verification" << TestLog::EndMessage;
+
+			if (refNumFailed != countErrorPixels(refErrorMask))
+			{
+				m_testCtx.getLog() << TestLog::Message << "FAIL: Invalid pixel count doesn't match error mask" << TestLog::EndMessage;
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Invalid pixel count doesn't match error mask");
+			}
+
+			for (int configNdx = 0; configNdx < 3; configNdx++)
+			{
+				const int	numThreads		= (configNdx == 0) ? 1 : 4;
+				const bool	useColorBounds	= configNdx != 1;
+				Surface		errorMask		(width, height);
+				int			numFailed;
+
+				setNumWorkerThreads(numThreads);
+				setLookupColorBoundsEnabled(useColorBounds);
+				numFailed = computeTextureLookupDiff(result.getAccess(), reference.getAccess(), errorMask.getAccess(), texture.getView(), &texCoord[0], sampleParams, lookupPrec, lodPrec, m_testCtx.getWatchDog());
+
+				if (numFailed != refNumFailed || !deMemoryEqual(refErrorMask.getAccess().getDataPtr(), errorMask.getAccess().getDataPtr(), (size_t)(width * height * 4)))
+				{
+					m_testCtx.getLog() << TestLog::Message << "FAIL: Verification with " << numThreads << " worker threads" << (useColorBounds ? " and color bounds" : "")
+														   << " found " << numFailed << " invalid pixels, expected " << refNumFailed << TestLog::EndMessage
+									   << TestLog::Image("Reference", "Serial full verification error mask", refErrorMask)
+									   << TestLog::Image("ErrorMask", "Error mask", errorMask);
+					m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Verification result differs from serial full verification");
+				}
+			}
+		}
+
+		setNumWorkerThreads(m_origNumThreads);
+		setLookupColorBoundsEnabled(true);
+	}
+
+	int		m_origNumThreads;
+	int		m_caseNdx;
+};
+
+class ImageCompareKernelTest : public tcu::TestCase
+{
+public:
+	ImageCompareKernelTest (tcu::TestContext& testCtx)
+		: tcu::TestCase		(testCtx, "image_compare_kernels", "Compare row-parallel and format-specialized image comparisons to serial generic comparison")
+		, m_origNumThreads	(1)
+		, m_caseNdx			(0)
+	{
+	}
+
+	void init (void)
+	{
+		m_origNumThreads	= tcu::getNumWorkerThreads();
+		m_caseNdx			= 0;
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "All iterations passed");
+	}
+
+	void deinit (void)
+	{
+		tcu::setNumWorkerThreads(m_origNumThreads);
+	}
+
+	IterateResult iterate (void)
+	{
+		const int numCases = 6;
+
+		{
+			tcu::ScopedLogSection section(m_testCtx.getLog(), "SubCase", "");
+			runCase((deUint32)m_caseNdx);
+		}
+
+		return (++m_caseNdx < numCases) ? CONTINUE : STOP;
+	}
+
+private:
+	static tcu::UVec4 computeMaxIntDiff (const tcu::ConstPixelBufferAccess& reference, const tcu::ConstPixelBufferAccess& result)
+	{
+		tcu::UVec4 maxDiff (0u);
+
+		for (int y = 0; y < reference.getHeight(); y++)
+		for (int x = 0; x < reference.getWidth(); x++)
+			maxDiff = tcu::max(maxDiff, tcu::abs(reference.getPixelInt(x, y) - result.getPixelInt(x, y)).cast<deUint32>());
+
+		return maxDiff;
+	}
+
+	static tcu::Vec4 computeMaxFloatDiff (const tcu::ConstPixelBufferAccess& reference, const tcu::ConstPixelBufferAccess& result)
+	{
+		tcu::Vec4 maxDiff (0.0f);
+
+		for (int y = 0; y < reference.getHeight(); y++)
+		for (int x = 0; x < reference.getWidth(); x++)
+			maxDiff = tcu::max(maxDiff, tcu::abs(reference.getPixel(x, y) - result.getPixel(x, y)));
+
+		return maxDiff;
+	}
+
+	static bool isWithinThreshold (const tcu::IVec4& a, const tcu::IVec4& b, const tcu::UVec4& threshold)
+	{
+		return tcu::boolAll(tcu::lessThanEqual(tcu::abs(a - b).cast<deUint32>(), threshold));
+	}
+
+	static bool findDeviatedMatch (const tcu::ConstPixelBufferAccess& image, const tcu::IVec4& pixel, const tcu::UVec4& threshold, int x, int y, int maxDeviation)
+	{
+		for (int sy = de::max(0, y - maxDeviation); sy <= de::min(image.getHeight() - 1, y + maxDeviation); sy++)
+		for (int sx = de::max(0, x - maxDeviation); sx <= de::min(image.getWidth() - 1, x + maxDeviation); sx++)
+		{
+			if (isWithinThreshold(pixel, image.getPixelInt(sx, sy), threshold))
+				return true;
+		}
+
+		return false;
+	}
+
+	//! Serial per-pixel position deviation search, as done before the row-parallel implementation.
+	static int computeNumPositionDeviationFailures (const tcu::ConstPixelBufferAccess& reference, const tcu::ConstPixelBufferAccess& result, const tcu::UVec4& threshold, int maxDeviation, bool acceptOutOfBoundsAsAnyValue)
+	{
+		const int	border		= acceptOutOfBoundsAsAnyValue ? maxDeviation : 0;
+		int			numFailed	= 0;
+
+		for (int y = border; y < reference.getHeight() - border; y++)
+		for (int x = border; x < reference.getWidth() - border; x++)
+		{
+			const tcu::IVec4 refPix = reference.getPixelInt(x, y);
+			const tcu::IVec4 resPix = result.getPixelInt(x, y);
+
+			if (!isWithinThreshold(refPix, resPix, threshold) &&
+				(!findDeviatedMatch(result, refPix, threshold, x, y, maxDeviation) || !findDeviatedMatch(reference, resPix, threshold, x, y, maxDeviation)))
+				numFailed += 1;
+		}
+
+		return numFailed;
+	}
+
+	void check (bool ok, const char* compareName, int numThreads)
+	{
+		if (!ok)
+		{
+			m_testCtx.getLog() << TestLog::Message << "FAIL: " << compareName << " with " << numThreads << " worker threads differs from serial generic comparison" << TestLog::EndMessage;
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Comparison result differs");
+		}
+	}
+
+	void runCase (deUint32 seed)
+	{
+		using namespace tcu;
+
+		de::Random			rnd				(0x1c0a9 ^ seed);
+		const int			width			= rnd.getInt(3, 32);
+		const int			height			= rnd.getInt(3, 32);
+		const TextureFormat	rgba8Format		(TextureFormat::RGBA, TextureFormat::UNORM_INT8);
+		const TextureFormat	floatFormat		(TextureFormat::RGBA, TextureFormat::FLOAT);
+		TextureLevel		reference		(rgba8Format, width, height);
+		TextureLevel		result			(rgba8Format, width, height);
+		TextureLevel		floatReference	(floatFormat, width, height);
+		TextureLevel		floatResult		(floatFormat, width, height);
+		TestLog&			log				= m_testCtx.getLog();
+
+		log << TestLog::Message << "Image size " << width << "x" << height << TestLog::EndMessage;
+
+		// Reference is a noisy gradient. Some result pixels are off by small amounts, some are taken from neighbor pixels.
+		for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+		{
+			const IVec4	refPix		(x*7 + rnd.getInt(0, 6), y*7 + rnd.getInt(0, 6), (x + y)*4 + rnd.getInt(0, 6), 255 - (x + y)*3 - rnd.getInt(0, 6));
+			const Vec4	refValue	(rnd.getFloat(-2.0f, 2.0f), rnd.getFloat(-2.0f, 2.0f), rnd.getFloat(-2.0f, 2.0f), rnd.getFloat(-2.0f, 2.0f));
+			const bool	isOff		= rnd.getInt(0, 9) < 3;
+
+			reference.getAccess().setPixel(refPix.cast<deUint32>(), x, y);
+			floatReference.getAccess().setPixel(refValue, x, y);
+			floatResult.getAccess().setPixel(refValue + (isOff ? Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat()) * 0.1f : Vec4(0.0f)), x, y);
+
+			if (isOff)
+				result.getAccess().setPixel(clamp(refPix + IVec4(rnd.getInt(-20, 20), rnd.getInt(-20, 20), rnd.getInt(-20, 20), 0), IVec4(0), IVec4(255)).cast<deUint32>(), x, y);
+			else
+				result.getAccess().setPixel(refPix.cast<deUint32>(), x, y);
+		}
+
+		for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+		{
+			if (rnd.getInt(0, 9) < 2)
+				result.getAccess().setPixel(reference.getAccess().getPixelUint(de::clamp(x + rnd.getInt(-1, 1), 0, width - 1), de::clamp(y + rnd.getInt(-1, 1), 0, height - 1)), x, y);
+		}
+
+		{
+			// \note UINT8 views of the same data take the generic comparison paths.
+			const TextureFormat				uint8Format				(TextureFormat::RGBA, TextureFormat::UNSIGNED_INT8);
+			const ConstPixelBufferAccess	genericReference		(uint8Format, width, height, 1, reference.getAccess().getDataPtr());
+			const ConstPixelBufferAccess	genericResult			(uint8Format, width, height, 1, result.getAccess().getDataPtr());
+			const UVec4						maxIntDiff				= computeMaxIntDiff(reference, result);
+			const Vec4						maxFloatDiff			= computeMaxFloatDiff(floatReference, floatResult);
+			const UVec4						deviationThreshold		(8u);
+			const int						maxDeviation			= 1;
+			const bool						acceptOutOfBounds		= rnd.getBool();
+			const int						numDeviationFailures	= computeNumPositionDeviationFailures(reference, result, deviationThreshold, maxDeviation, acceptOutOfBounds);
+			TextureLevel					refFuzzyErrorMask		(rgba8Format, width, height);
+			float							refFuzzyError;
+
+			log << TestLog::Message << "Max difference " << maxIntDiff << ", " << numDeviationFailures << " pixels fail position deviation compare" << TestLog::EndMessage;
+
+			setNumWorkerThreads(1);
+			refFuzzyError = fuzzyCompare(FuzzyCompareParams(), reference, result, refFuzzyErrorMask);
+
+			for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+			{
+				TextureLevel fuzzyErrorMask (rgba8Format, width, height);
+
+				setNumWorkerThreads(numThreads);
+
+				check(intThresholdCompare(log, "Int", "", reference, result, maxIntDiff, COMPARE_LOG_ON_ERROR), "intThresholdCompare() at max difference", numThreads);
+				check(intThresholdCompare(log, "Int", "", genericReference, genericResult, maxIntDiff, COMPARE_LOG_ON_ERROR), "Generic intThresholdCompare() at max difference", numThreads);
+				check(floatThresholdCompare(log, "Float", "", floatReference, floatResult, maxFloatDiff, COMPARE_LOG_ON_ERROR), "floatThresholdCompare() at max difference", numThreads);
+
+				// Lowering the threshold of any channel with differences must fail the comparison.
+				for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+				{
+					UVec4	intFailThreshold	= maxIntDiff;
+					Vec4	floatFailThreshold	= maxFloatDiff;
+
+					if (maxIntDiff[channelNdx] > 0u)
+					{
+						intFailThreshold[channelNdx] -= 1u;
+
+						check(!intThresholdCompare(log, "Int", "", reference, result, intFailThreshold, COMPARE_LOG_ON_ERROR), "intThresholdCompare() below max difference", numThreads);
+						check(!intThresholdCompare(log, "Int", "", genericReference, genericResult, intFailThreshold, COMPARE_LOG_ON_ERROR), "Generic intThresholdCompare() below max difference", numThreads);
+					}
+
+					if (maxFloatDiff[channelNdx] > 0.0f)
+					{
+						floatFailThreshold[channelNdx] *= 0.5f;
+
+						check(!floatThresholdCompare(log, "Float", "", floatReference, floatResult, floatFailThreshold, COMPARE_LOG_ON_ERROR), "floatThresholdCompare() below max difference", numThreads);
+					}
+				}
+
+				check(intThresholdPositionDeviationErrorThresholdCompare(log, "Deviation", "", reference, result, deviationThreshold, IVec3(maxDeviation, maxDeviation, 0), acceptOutOfBounds, numDeviationFailures, COMPARE_LOG_ON_ERROR),
+					  "Position deviation compare at failure count", numThreads);
+
+				if (numDeviationFailures > 0)
+					check(!intThresholdPositionDeviationErrorThresholdCompare(log, "Deviation", "", reference, result, deviationThreshold, IVec3(maxDeviation, maxDeviation, 0), acceptOutOfBounds, numDeviationFailures - 1, COMPARE_LOG_ON_ERROR),
+						  "Position deviation compare below failure count", numThreads);
+
+				check(fuzzyCompare(FuzzyCompareParams(), reference, result, fuzzyErrorMask) == refFuzzyError &&
+					  deMemoryEqual(refFuzzyErrorMask.getAccess().getDataPtr(), fuzzyErrorMask.getAccess().getDataPtr(), (size_t)(width * height * rgba8Format.getPixelSize())),
+					  "fuzzyCompare()", numThreads);
+			}
+		}
+
+		setNumWorkerThreads(m_origNumThreads);
+	}
+
+	int		m_origNumThreads;
+	int		m_caseNdx;
+};
+
 class CommonFrameworkTests : public tcu::TestCaseGroup
 {
 public:
@@ -894,6 +1856,10 @@ public:
 								   tcu::FloatFormat_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "either","tcu::Either_selfTest()",
 								   tcu::Either_selfTest));
+		addChild(new CompressedTextureDecodeTest(m_testCtx));
+		addChild(new TextureSampleBatchTest(m_testCtx));
+		addChild(new TextureLookupVerifierTest(m_testCtx));
+		addChild(new ImageCompareKernelTest(m_testCtx));
 	}
 };
 
@@ -908,6 +1874,8 @@ public:
 	void init (void)
 	{
 		addChild(new ConstantInterpolationTest(m_testCtx));
+		addChild(new TiledRasterizationTest(m_testCtx));
+		addChild(new FragmentOperationKernelTest(m_testCtx));
 	}
 };
 
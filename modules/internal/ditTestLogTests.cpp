@@ -23,8 +23,13 @@
 
 #include "ditTestLogTests.hpp"
 #include "tcuTestLog.hpp"
+#include "deRandom.hpp"
+#include "deStringUtil.hpp"
+#include "deFile.h"
 
 #include <limits>
+#include <fstream>
+#include <iterator>
 
 namespace dit
 {
@@ -69,6 +74,345 @@ public:
 	}
 };
 
+namespace
+{
+
+typedef std::vector<deUint8> ByteVec;
+
+enum
+{
+	NUM_SCRIPTED_CASES	= 6
+};
+
+std::string getScriptedCasePath (int caseNdx)
+{
+	return "dit.testlog.scripted.case_" + de::toString(caseNdx);
+}
+
+//! Write fixed sequence of cases with image sets to log file. Last case is terminated.
+void writeScriptedLog (const char* fileName, deUint32 flags)
+{
+	TestLog		log		(fileName, flags);
+	de::Random	rnd		(0x3a41d2);
+
+	for (int caseNdx = 0; caseNdx < NUM_SCRIPTED_CASES; caseNdx++)
+	{
+		const std::string	casePath	= getScriptedCasePath(caseNdx);
+		const int			numImages	= caseNdx % 3;
+
+		log.startCase(casePath.c_str(), QP_TEST_CASE_TYPE_SELF_VALIDATE);
+		log << TestLog::Message << "Case " << caseNdx << " with " << numImages << " images" << TestLog::EndMessage;
+
+		log << TestLog::Section("Images", "Images")
+			<< TestLog::ImageSet("Result", "Result images");
+
+		for (int imageNdx = 0; imageNdx < numImages; imageNdx++)
+		{
+			const bool						hasAlpha	= rnd.getBool();
+			const qpImageFormat				format		= hasAlpha ? QP_IMAGE_FORMAT_RGBA8888 : QP_IMAGE_FORMAT_RGB888;
+			const qpImageCompressionMode	compression	= (imageNdx % 2 == 0) ? QP_IMAGE_COMPRESSION_MODE_PNG : QP_IMAGE_COMPRESSION_MODE_NONE;
+			const int						width		= rnd.getInt(1, 300);
+			const int						height		= rnd.getInt(1, 200);
+			const int						stride		= width * (hasAlpha ? 4 : 3);
+			ByteVec							pixels		(stride * height);
+			const std::string				name		= "Image" + de::toString(imageNdx);
+
+			for (size_t ndx = 0; ndx < pixels.size(); ndx++)
+				pixels[ndx] = rnd.getUint8();
+
+			log.writeImage(name.c_str(), "Random image", compression, format, width, height, stride, &pixels[0]);
+		}
+
+		log << TestLog::EndImageSet
+			<< TestLog::EndSection;
+
+		if (caseNdx == NUM_SCRIPTED_CASES-1)
+			log.terminateCase(QP_TEST_RESULT_CRASH);
+		else
+			log.endCase(QP_TEST_RESULT_PASS, "Pass");
+	}
+}
+
+ByteVec readFile (const std::string& fileName)
+{
+	std::ifstream	in		(fileName.c_str(), std::ios_base::binary);
+	ByteVec			data;
+
+	if (!in.good())
+		throw tcu::ResourceError("Failed to open '" + fileName + "'");
+
+	data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+	return data;
+}
+
+//! Removes log file and its case index when going out of scope.
+class TempLogFile
+{
+public:
+	TempLogFile (const std::string& fileName)
+		: m_fileName(fileName)
+	{
+		remove();
+	}
+
+	~TempLogFile (void)
+	{
+		remove();
+	}
+
+	const std::string&	getName		(void) const	{ return m_fileName;				}
+	std::string			getIndexName(void) const	{ return m_fileName + ".idx";		}
+
+private:
+	void remove (void)
+	{
+		deDeleteFile(m_fileName.c_str());
+		deDeleteFile(getIndexName().c_str());
+	}
+
+	const std::string	m_fileName;
+};
+
+struct CaseIndexEntry
+{
+	deUint64		offset;
+	deUint64		size;
+	std::string		status;
+	std::string		path;
+};
+
+class CaseIndexParser
+{
+public:
+	CaseIndexParser (const ByteVec& data)
+		: m_data	(data)
+		, m_pos		(0)
+	{
+	}
+
+	bool isEnd (void) const
+	{
+		return m_pos == m_data.size();
+	}
+
+	deUint64 readUint (int numBytes)
+	{
+		deUint64 value = 0;
+
+		require(numBytes);
+
+		for (int ndx = 0; ndx < numBytes; ndx++)
+			value |= (deUint64)m_data[m_pos + ndx] << (8*ndx);
+
+		m_pos += numBytes;
+		return value;
+	}
+
+	std::string readString (int numBytes)
+	{
+		require(numBytes);
+		m_pos += numBytes;
+		return std::string(m_data.begin() + m_pos - numBytes, m_data.begin() + m_pos);
+	}
+
+private:
+	void require (int numBytes) const
+	{
+		if (m_data.size() - m_pos < (size_t)numBytes)
+			throw tcu::TestError("Truncated case index");
+	}
+
+	const ByteVec&		m_data;
+	size_t				m_pos;
+};
+
+//! Parse case index, returns log size from end record.
+deUint64 parseCaseIndex (const ByteVec& data, std::vector<CaseIndexEntry>& entries)
+{
+	CaseIndexParser parser (data);
+
+	if (parser.readString(8) != "qpaIdx01")
+		throw tcu::TestError("Invalid case index magic");
+
+	for (;;)
+	{
+		const deUint64 type = parser.readUint(1);
+
+		if (type == 1)
+		{
+			CaseIndexEntry entry;
+
+			entry.offset	= parser.readUint(8);
+			entry.size		= parser.readUint(8);
+			parser.readUint(8); // duration
+			entry.status	= parser.readString((int)parser.readUint(1));
+			entry.path		= parser.readString((int)parser.readUint(2));
+
+			entries.push_back(entry);
+		}
+		else if (type == 2)
+		{
+			const deUint64 logSize = parser.readUint(8);
+
+			if (!parser.isEnd())
+				throw tcu::TestError("Data after case index end record");
+
+			return logSize;
+		}
+		else
+			throw tcu::TestError("Invalid case index record type " + de::toString(type));
+	}
+}
+
+bool hasPrefix (const std::string& str, const std::string& prefix)
+{
+	return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool hasSuffix (const std::string& str, const std::string& suffix)
+{
+	return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+class AsyncWriteCase : public tcu::TestCase
+{
+public:
+	AsyncWriteCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "async_write", "Compare log written in writer thread to synchronously written log")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const TempLogFile	syncFile	("dit-testlog-sync.qpa");
+		const TempLogFile	asyncFile	("dit-testlog-async.qpa");
+
+		writeScriptedLog(syncFile.getName().c_str(), 0);
+		writeScriptedLog(asyncFile.getName().c_str(), QP_TEST_LOG_ASYNC_WRITE);
+
+		{
+			const ByteVec	syncData	= readFile(syncFile.getName());
+			const ByteVec	asyncData	= readFile(asyncFile.getName());
+
+			m_testCtx.getLog() << TestLog::Message << "Synchronous log: " << syncData.size() << " bytes, asynchronous log: " << asyncData.size() << " bytes" << TestLog::EndMessage;
+
+			if (syncData == asyncData)
+				m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+			else
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Asynchronously written log differs");
+		}
+
+		return STOP;
+	}
+};
+
+//! Case start must reach the file before case runs, otherwise crash of the case is not visible in the log.
+class AsyncBeginCaseCase : public tcu::TestCase
+{
+public:
+	AsyncBeginCaseCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "async_begin_case", "Check that case start is written out by asynchronous log")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const TempLogFile	logFile		("dit-testlog-async-begin.qpa");
+		const std::string	casePath	= getScriptedCasePath(0);
+		bool				isWritten	= false;
+
+		{
+			TestLog log (logFile.getName().c_str(), QP_TEST_LOG_ASYNC_WRITE);
+
+			log.startCase(casePath.c_str(), QP_TEST_CASE_TYPE_SELF_VALIDATE);
+
+			{
+				const ByteVec		data		= readFile(logFile.getName());
+				const std::string	contents	(data.begin(), data.end());
+
+				isWritten = hasSuffix(contents, "\n#beginTestCaseResult " + casePath + "\n");
+			}
+
+			log.endCase(QP_TEST_RESULT_PASS, "Pass");
+		}
+
+		m_testCtx.setTestResult(isWritten ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								isWritten ? "Pass"				: "#beginTestCaseResult not written out by startCase()");
+		return STOP;
+	}
+};
+
+class CaseIndexCase : public tcu::TestCase
+{
+public:
+	CaseIndexCase (tcu::TestContext& testCtx, const char* name, const char* description, deUint32 logFlags)
+		: TestCase		(testCtx, name, description)
+		, m_logFlags	(logFlags)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const TempLogFile				logFile		(std::string("dit-testlog-") + getName() + ".qpa");
+		std::vector<CaseIndexEntry>		entries;
+		bool							allOk		= true;
+
+		writeScriptedLog(logFile.getName().c_str(), m_logFlags | QP_TEST_LOG_WRITE_CASE_INDEX);
+
+		const ByteVec		logData		= readFile(logFile.getName());
+		const deUint64		logSize		= parseCaseIndex(readFile(logFile.getIndexName()), entries);
+
+		if (logSize != (deUint64)logData.size())
+		{
+			m_testCtx.getLog() << TestLog::Message << "ERROR: End record has log size " << logSize << ", expected " << logData.size() << TestLog::EndMessage;
+			allOk = false;
+		}
+
+		if (entries.size() != (size_t)NUM_SCRIPTED_CASES)
+		{
+			m_testCtx.getLog() << TestLog::Message << "ERROR: Got " << entries.size() << " case records, expected " << (int)NUM_SCRIPTED_CASES << TestLog::EndMessage;
+			allOk = false;
+		}
+
+		for (size_t caseNdx = 0; caseNdx < entries.size() && caseNdx < (size_t)NUM_SCRIPTED_CASES; caseNdx++)
+		{
+			const CaseIndexEntry&	entry			= entries[caseNdx];
+			const bool				isTerminated	= caseNdx == (size_t)NUM_SCRIPTED_CASES-1;
+			const std::string		expectedPath	= getScriptedCasePath((int)caseNdx);
+			const std::string		expectedStatus	= isTerminated ? "Crash" : "Pass";
+			const std::string		expectedBegin	= "\n#beginTestCaseResult " + expectedPath + "\n";
+			const std::string		expectedEnd		= isTerminated ? "\n#terminateTestCaseResult Crash\n" : "\n#endTestCaseResult\n";
+			bool					caseOk			= entry.path == expectedPath && entry.status == expectedStatus;
+
+			if (caseOk && entry.offset <= logSize && entry.size <= logSize - entry.offset)
+			{
+				const std::string caseData (logData.begin() + (size_t)entry.offset, logData.begin() + (size_t)(entry.offset + entry.size));
+
+				caseOk = hasPrefix(caseData, expectedBegin) && hasSuffix(caseData, expectedEnd);
+			}
+			else
+				caseOk = false;
+
+			if (!caseOk)
+			{
+				m_testCtx.getLog() << TestLog::Message << "ERROR: Invalid record " << caseNdx << ": path '" << entry.path << "', status '" << entry.status
+													   << "', offset " << entry.offset << ", size " << entry.size << TestLog::EndMessage;
+				allOk = false;
+			}
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								allOk ? "Pass"				: "Invalid case index");
+		return STOP;
+	}
+
+private:
+	const deUint32	m_logFlags;
+};
+
+} // anonymous
+
 TestLogTests::TestLogTests (tcu::TestContext& testCtx)
 	: TestCaseGroup(testCtx, "testlog", "Test Log Tests")
 {
@@ -80,7 +424,11 @@ TestLogTests::~TestLogTests (void)
 
 void TestLogTests::init (void)
 {
-	addChild(new BasicSampleListCase(m_testCtx));
+	addChild(new BasicSampleListCase	(m_testCtx));
+	addChild(new AsyncWriteCase			(m_testCtx));
+	addChild(new AsyncBeginCaseCase		(m_testCtx));
+	addChild(new CaseIndexCase			(m_testCtx, "case_index",			"Case index offsets match case positions",		0u));
+	addChild(new CaseIndexCase			(m_testCtx, "async_case_index",	"Case index written by writer thread",			QP_TEST_LOG_ASYNC_WRITE));
 }
 
 } // dit
@@ -33,6 +33,7 @@
 #include "deArrayUtil.hpp"
 #include "deStringUtil.hpp"
 #include "deUniquePtr.hpp"
+#include "deMemory.h"
 
 #include <sstream>
 
@@ -1326,6 +1327,37 @@ void copyPixels (const ConstPixelBufferAccess& src, const PixelBufferAccess& dst
 	}
 }
 
+template<typename T>
+void copyRows (const ConstPixelBufferAccess& src, const PixelBufferAccess& dst)
+{
+	const tcu::ConstPixelRowAccess	srcRows		(src);
+	const tcu::PixelRowAccess		dstRows		(dst);
+	vector<T>						row			(src.getWidth());
+
+	srcRows.readRow(0, 0, 0, src.getWidth(), &row[0]);
+	dstRows.writeRow(0, 0, 0, src.getWidth(), &row[0]);
+}
+
+void copyRows (const ConstPixelBufferAccess& src, const PixelBufferAccess& dst)
+{
+	switch (getTextureChannelClass(dst.getFormat().type))
+	{
+		case tcu::TEXTURECHANNELCLASS_FLOATING_POINT:
+		case tcu::TEXTURECHANNELCLASS_SIGNED_FIXED_POINT:
+		case tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT:
+			copyRows<tcu::Vec4>(src, dst);
+			break;
+
+		case tcu::TEXTURECHANNELCLASS_SIGNED_INTEGER:
+		case tcu::TEXTURECHANNELCLASS_UNSIGNED_INTEGER:
+			copyRows<tcu::IVec4>(src, dst);
+			break;
+
+		default:
+			DE_FATAL("Unknown channel class");
+	}
+}
+
 const char* getTextureAccessTypeDescription (TextureAccessType type)
 {
 	static const char* s_desc[] =
@@ -1509,6 +1541,11 @@ public:
 			m_testCtx.getLog() << TestLog::Message << "Copying with getPixel() -> setPixel()" << TestLog::EndMessage;
 			copyPixels(inputAccess, tmpAccess);
 			verifyRead(tmpAccess);
+
+			m_testCtx.getLog() << TestLog::Message << "Copying with ConstPixelRowAccess::readRow() -> PixelRowAccess::writeRow()" << TestLog::EndMessage;
+			deMemset(&tmpMem[0], 0, tmpMem.size());
+			copyRows(inputAccess, tmpAccess);
+			verifyRead(tmpAccess);
 		}
 
 		return STOP;
@@ -1542,6 +1579,11 @@ public:
 		copyPixels(inputDepthAccess, tmpDepthAccess);
 		verifyRead(tmpDepthAccess);
 
+		m_testCtx.getLog() << TestLog::Message << "Copying with ConstPixelRowAccess::readRow() -> PixelRowAccess::writeRow()" << TestLog::EndMessage;
+		tcu::clear(tmpDepthAccess, tcu::Vec4(0.0f));
+		copyRows(inputDepthAccess, tmpDepthAccess);
+		verifyRead(tmpDepthAccess);
+
 		verifyGetPixDepth(inputDepthAccess, inputAccess);
 
 		m_testCtx.getLog() << TestLog::Message << "Copying both depth getPixDepth() -> setPixDepth()" << TestLog::EndMessage;